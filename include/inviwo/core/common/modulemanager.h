@@ -42,6 +42,7 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <set>
+#include <chrono>
 #include <warn/pop>
 
 namespace inviwo {
@@ -59,6 +60,15 @@ class IVW_CORE_API ModuleManager {
 public:
     using IdSet = std::set<std::string, CaseInsensitiveCompare>;
 
+    /**
+     * Time spent on registering a module at startup
+     */
+    struct Timing {
+        std::string module;
+        std::chrono::nanoseconds library;  ///< Loading the library and finding createModule
+        std::chrono::nanoseconds create;   ///< Constructing the module
+    };
+
     ModuleManager(InviwoApplication* app);
     ModuleManager(const ModuleManager& rhs) = delete;
     ModuleManager& operator=(const ModuleManager& that) = delete;
@@ -79,7 +89,8 @@ public:
      * \brief Load modules from dynamic library files in the specified search paths.
      *
      * Will recursively search for all dll/so/dylib/bundle files in the specified search paths.
-     * The library filename must contain "inviwo-module" to be loaded.
+     * The library filename must contain "inviwo-module" to be loaded. The libraries are loaded
+     * concurrently on the thread pool of the application.
      *
      * @note Which modules to load can be specified by creating a file
      * (application_name-enabled-modules.txt) containing the names of the modules to load.
@@ -108,6 +119,12 @@ public:
     InviwoModuleFactoryObject* getFactoryObject(const std::string& identifier) const;
     std::vector<std::string> findDependentModules(const std::string& module) const;
 
+    /**
+     * \brief Time spent on loading and constructing each registered module.
+     * A breakdown is also logged once the application is running.
+     */
+    const std::vector<Timing>& getTimings() const;
+
     /**
      * \brief Register callback for monitoring when modules have been registered.
      * Invoked in registerModules.
@@ -135,6 +152,8 @@ public:
 
 private:
     void registerModule(std::unique_ptr<InviwoModule> module);
+    Timing& getTiming(const std::string& module);
+    void printTimings() const;
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
         const std::vector<std::string>& toDeregister);
@@ -155,6 +174,7 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+    std::vector<Timing> timings_;
 };
 
 template <class T>
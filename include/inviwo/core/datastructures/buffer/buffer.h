@@ -34,13 +34,15 @@
 #include <inviwo/core/datastructures/data.h>
 #include <inviwo/core/datastructures/buffer/bufferrepresentation.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/util/document.h>
 
 namespace inviwo {
 
 class DataFormatBase;
 
-class IVW_CORE_API BufferBase : public Data<BufferBase, BufferRepresentation> {
+class IVW_CORE_API BufferBase : public Data<BufferBase, BufferRepresentation>,
+                               public HistogramSupplier {
 public:
     BufferBase(size_t defaultSize, const DataFormatBase* defaultFormat, BufferUsage usage,
                BufferTarget target);
@@ -75,6 +77,15 @@ public:
 
     virtual void append(const BufferBase&) = 0;
 
+    /**
+     * Start a calculation of histograms over the range of values in the buffer. Buffers are
+     * frequently modified in place, hence any previous histograms are discarded and the
+     * calculation is always restarted. The range is found by the calculation on the thread pool,
+     * the calling thread does not pass over the data.
+     * @see HistogramCalculationState
+     */
+    std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
+
     virtual Document getInfo() const = 0;
     static uvec3 colorCode;
     static const std::string classIdentifier;
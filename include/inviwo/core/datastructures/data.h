@@ -151,6 +151,20 @@ public:
      * @param representation The representation to keep
      */
     void removeOtherRepresentations(const Repr* representation);
+
+    /**
+     * Remove the representation of type T if there is a valid representation of type U that it can
+     * be recreated from. The U representation becomes the last valid one. Used to release the
+     * memory of data that can be loaded again, like a VolumeRAM that has a valid VolumeDisk.
+     * Example:
+     * \code{.cpp}
+     *     volume.releaseRepresentation<VolumeRAM, VolumeDisk>();
+     * \endcode
+     * @return true if the representation of type T was removed
+     */
+    template <typename T, typename U>
+    bool releaseRepresentation();
+
     /**
      * Delete all representations.
      */
@@ -347,6 +361,22 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
     std::swap(repr, representations_);
 }
 
+template <typename Self, typename Repr>
+template <typename T, typename U>
+bool Data<Self, Repr>::releaseRepresentation() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    const auto it = representations_.find(std::type_index(typeid(T)));
+    const auto source = representations_.find(std::type_index(typeid(U)));
+    if (it == representations_.end() || source == representations_.end() || it == source ||
+        !source->second->isValid()) {
+        return false;
+    }
+    lastValidRepresentation_ = source->second;
+    representations_.erase(it);
+    return true;
+}
+
 template <typename Self, typename Repr>
 bool Data<Self, Repr>::hasRepresentations() const {
     std::unique_lock<std::mutex> lock(mutex_);
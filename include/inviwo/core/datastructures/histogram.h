@@ -76,6 +76,7 @@ protected:
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -0,0 +1,226 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+class LayerRAM;
+class BufferRAM;
+
+namespace util {
+
+/**
+ * Per channel minimum, maximum, sum, and sum of squares of a set of values.
+ * @see util::summarize
+ */
+template <typename T>
+struct DataSummary {
+    using D = typename util::same_extent<T, double>::type;
+
+    D min{std::numeric_limits<double>::max()};
+    D max{std::numeric_limits<double>::lowest()};
+    D sum{0.0};
+    D sum2{0.0};
+    size_t count = 0;
+
+    void merge(const DataSummary& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+        sum += other.sum;
+        sum2 += other.sum2;
+        count += other.count;
+    }
+
+    D mean() const { return sum / static_cast<double>(count); }
+    D standardDeviation() const {
+        const auto n = static_cast<double>(count);
+        return glm::sqrt((n * sum2 - sum * sum) / (n * (n - 1.0)));
+    }
+};
+
+/**
+ * Calculate the minimum, maximum, sum and sum of squares of every \p stride value of the first
+ * \p size values in \p data. Contiguous data is processed in independent lanes to let the compiler
+ * vectorize the loop.
+ */
+template <typename T>
+DataSummary<T> summarize(const T* data, size_t size, size_t stride = 1) {
+    using D = typename DataSummary<T>::D;
+    constexpr size_t lanes = 8;
+
+    std::array<DataSummary<T>, lanes> res{};
+    const size_t count = (size + stride - 1) / stride;
+    size_t i = 0;
+    if (stride == 1) {
+        for (; i + lanes <= count; i += lanes) {
+            for (size_t l = 0; l < lanes; ++l) {
+                const auto val = static_cast<D>(data[i + l]);
+                res[l].min = glm::min(res[l].min, val);
+                res[l].max = glm::max(res[l].max, val);
+                res[l].sum += val;
+                res[l].sum2 += val * val;
+            }
+        }
+    }
+    for (; i < count; ++i) {
+        const auto val = static_cast<D>(data[i * stride]);
+        res[0].min = glm::min(res[0].min, val);
+        res[0].max = glm::max(res[0].max, val);
+        res[0].sum += val;
+        res[0].sum2 += val * val;
+    }
+    for (size_t l = 1; l < lanes; ++l) res[0].merge(res[l]);
+    res[0].count = count;
+    return res[0];
+}
+
+/**
+ * Calculate one histogram per channel of every \p stride value of the first \p size values in
+ * \p data. The data is split into chunks that are processed in parallel by the thread pool, each
+ * task counts into its own integer bins which are summed at the end. The result is the same as
+ * HistogramContainer(dataRange, bins, data, data + size) for a stride of one.
+ *
+ * @param data       the values
+ * @param size       number of values in data
+ * @param dataRange  values in this range are mapped to the bins
+ * @param bins       number of bins, clamped to the size of the data range for integer types
+ * @param stride     only use every stride value, larger strides give a quick approximation
+ * @param stop       if set, checked before every chunk. The calculation is aborted when it becomes
+ *                   true.
+ * @return the histograms or std::nullopt if the calculation was stopped
+ */
+template <typename T>
+std::optional<HistogramContainer> calculateHistograms(const T* data, size_t size, dvec2 dataRange,
+                                                      size_t bins, size_t stride = 1,
+                                                      const std::atomic<bool>* stop = nullptr) {
+    using D = typename DataSummary<T>::D;
+    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    constexpr size_t chunkSize = size_t{1} << 16;
+
+    if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
+        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
+    }
+    const double rangeScaleFactor = static_cast<double>(bins - 1) / (dataRange.y - dataRange.x);
+    const double dbins = static_cast<double>(bins);
+
+    const size_t count = (size + stride - 1) / stride;
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+    std::vector<uint64_t> counts(extent * bins, 0);
+    DataSummary<T> summary;
+    std::mutex mutex;
+    std::atomic<bool> aborted{false};
+
+    util::parallelFor(size_t{0}, chunks, [&](size_t firstChunk, size_t lastChunk) {
+        std::vector<uint64_t> localCounts(extent * bins, 0);
+        DataSummary<T> localSummary;
+        for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            if ((stop && *stop) || aborted) {
+                aborted = true;
+                return;
+            }
+            const size_t chunkCount = std::min(chunkSize, count - chunk * chunkSize);
+            const T* chunkData = data + chunk * chunkSize * stride;
+
+            localSummary.merge(summarize(chunkData, (chunkCount - 1) * stride + 1, stride));
+            for (size_t i = 0; i < chunkCount; ++i) {
+                const auto val = static_cast<D>(chunkData[i * stride]);
+                for (size_t c = 0; c < extent; ++c) {
+                    // truncate towards zero like the integer conversion in HistogramContainer
+                    const double bin = (util::glmcomp(val, c) - dataRange.x) * rangeScaleFactor;
+                    if (bin > -1.0 && bin < dbins) {
+                        ++localCounts[c * bins + static_cast<size_t>(bin)];
+                    }
+                }
+            }
+        }
+        std::scoped_lock lock{mutex};
+        summary.merge(localSummary);
+        std::transform(counts.begin(), counts.end(), localCounts.begin(), counts.begin(),
+                       [](uint64_t a, uint64_t b) { return a + b; });
+    });
+    if (aborted || (stop && *stop)) return std::nullopt;
+
+    const auto mean = summary.mean();
+    const auto stddev = summary.standardDeviation();
+    std::vector<NormalizedHistogram> histograms;
+    for (size_t c = 0; c < extent; ++c) {
+        std::vector<double> binCounts(counts.begin() + c * bins,
+                                      counts.begin() + (c + 1) * bins);
+        histograms.emplace_back(dataRange, std::move(binCounts), util::glmcomp(summary.min, c),
+                                util::glmcomp(summary.max, c), util::glmcomp(mean, c),
+                                util::glmcomp(stddev, c));
+    }
+    return HistogramContainer{std::move(histograms)};
+}
+
+/**
+ * Calculate histograms of the data in a VolumeRAM, LayerRAM, or BufferRAM.
+ * @see calculateHistograms(const T*, size_t, dvec2, size_t, size_t, const std::atomic<bool>*)
+ */
+IVW_CORE_API std::optional<HistogramContainer> calculateHistograms(
+    const VolumeRAM& volume, dvec2 dataRange, size_t bins, size_t stride = 1,
+    const std::atomic<bool>* stop = nullptr);
+IVW_CORE_API std::optional<HistogramContainer> calculateHistograms(
+    const LayerRAM& layer, dvec2 dataRange, size_t bins, size_t stride = 1,
+    const std::atomic<bool>* stop = nullptr);
+IVW_CORE_API std::optional<HistogramContainer> calculateHistograms(
+    const BufferRAM& buffer, dvec2 dataRange, size_t bins, size_t stride = 1,
+    const std::atomic<bool>* stop = nullptr);
+
+/**
+ * The smallest and largest value over all channels of a LayerRAM or BufferRAM, calculated in
+ * parallel.
+ */
+IVW_CORE_API dvec2 dataValueRange(const LayerRAM& layer);
+IVW_CORE_API dvec2 dataValueRange(const BufferRAM& buffer);
+
+/**
+ * The stride to use for a quick approximate histogram of \p size values, such that about
+ * \p samples values are used. Returns 1 if there are fewer values than that.
+ */
+IVW_CORE_API size_t histogramSubsampleStride(size_t size, size_t samples = size_t{1} << 20);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -34,12 +34,16 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace inviwo {
 
 class HistogramSupplier;
+class LayerRAM;
+class BufferRAM;
 
 class IVW_CORE_API HistogramCalculationState {
 public:
@@ -53,14 +57,35 @@ public:
 
     ~HistogramCalculationState() { *stop_ = true; }
 
+    /**
+     * Call \p callback with the final histograms once they are done, or directly if they are
+     * already done.
+     */
     void whenDone(std::function<void(const HistogramContainer&)> callback);
 
+    /**
+     * Call \p callback each time new histograms are available. For large data a quick approximate
+     * histogram from a subsample of the data is published first, followed by the exact one.
+     * Calls \p callback directly if the histograms are already done.
+     */
+    void whenUpdated(std::function<void(const HistogramContainer&)> callback);
+
+    /**
+     * Stop the calculation, no more callbacks will be called. The calculation is also stopped when
+     * the state is destroyed.
+     */
+    void cancel() { *stop_ = true; }
+    bool isCancelled() const { return *stop_; }
+    bool isDone() const { return done; }
+
     size_t getBins() const { return bins_; }
+    /// The range the histograms are calculated over, zero if it is computed by the calculation
     dvec2 getDataRange() const { return dataRange_; }
 
 private:
     std::weak_ptr<HistogramContainer> container_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
+    Dispatcher<void(const HistogramContainer&)> updateCallbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
     bool done = false;
@@ -79,19 +104,46 @@ public:
 
     virtual ~HistogramSupplier() = default;
 
-    bool hasHistograms() const { return !histograms_->empty(); }
-    const HistogramContainer& getHistograms() const { return *histograms_; }
-    HistogramContainer& getHistograms() { return *histograms_; }
+    bool hasHistograms() const { return histograms_ && !histograms_->empty(); }
+    const HistogramContainer& getHistograms() const;
+    HistogramContainer& getHistograms();
 
 protected:
     std::shared_ptr<HistogramCalculationState> startCalculation(
         std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const;
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        std::shared_ptr<const LayerRAM> layerRam, dvec2 dataRange, size_t bins) const;
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        std::shared_ptr<const BufferRAM> bufferRam, dvec2 dataRange, size_t bins) const;
+    /**
+     * Start a calculation over the value range of the data, see util::dataValueRange. The range
+     * is computed by the job on the thread pool, before the binning.
+     */
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        std::shared_ptr<const LayerRAM> layerRam, size_t bins) const;
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        std::shared_ptr<const BufferRAM> bufferRam, size_t bins) const;
+
+    /**
+     * Cancel any running calculation and drop the current histograms, for data that might have
+     * been modified since they were calculated.
+     */
+    void invalidateHistograms() const;
 
 private:
+    using Calculation = std::function<std::optional<HistogramContainer>(
+        size_t stride, const std::atomic<bool>& stop)>;
+
+    std::shared_ptr<HistogramCalculationState> startCalculation(size_t size, dvec2 dataRange,
+                                                                size_t bins,
+                                                                Calculation calculation) const;
+    static void update(std::shared_ptr<HistogramCalculationState> state,
+                       const HistogramContainer& histograms);
     static void done(std::shared_ptr<HistogramCalculationState> state,
                      HistogramContainer histograms);
 
     mutable std::shared_ptr<HistogramCalculationState> calculation_;
+    // Only allocated once histograms are calculated or requested for modification
     mutable std::shared_ptr<HistogramContainer> histograms_;
 };
 
@@ -35,6 +35,7 @@
 #include <inviwo/core/datastructures/spatialdata.h>
 #include <inviwo/core/datastructures/image/imagetypes.h>
 #include <inviwo/core/datastructures/image/layerrepresentation.h>
+#include <inviwo/core/datastructures/histogramtools.h>
 
 #include <inviwo/core/io/datareader.h>
 #include <inviwo/core/io/datawriter.h>
@@ -46,7 +47,9 @@ class DataFormatBase;
 /**
  * \ingroup datastructures
  */
-class IVW_CORE_API Layer : public Data<Layer, LayerRepresentation>, public StructuredGridEntity<2> {
+class IVW_CORE_API Layer : public Data<Layer, LayerRepresentation>,
+                          public StructuredGridEntity<2>,
+                          public HistogramSupplier {
 public:
     explicit Layer(size2_t defaultDimensions = size2_t(8, 8),
                    const DataFormatBase* defaultFormat = DataVec4UInt8::get(),
@@ -112,6 +115,15 @@ public:
     std::unique_ptr<std::vector<unsigned char>> getAsCodedBuffer(
         const std::string& fileExtension) const;
 
+    /**
+     * Start a calculation of histograms over the range of values in the layer. Layers are
+     * frequently modified in place, hence any previous histograms are discarded and the
+     * calculation is always restarted. The range is found by the calculation on the thread pool,
+     * the calling thread does not pass over the data.
+     * @see HistogramCalculationState
+     */
+    std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
+
 private:
     friend class LayerRepresentation;
 
@@ -31,6 +31,7 @@
 #define IVW_LAYERRAMPRECISION_H
 
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/rammemorypool.h>
 
 #include <algorithm>
 
@@ -49,14 +50,39 @@ public:
                                const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                InterpolationType interpolation = InterpolationType::Linear,
                                const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a representation with data from the RAMMemoryPool. Use
+     * util::DataInitialization::Uninitialized to skip clearing data that will be overwritten.
+     */
+    LayerRAMPrecision(size2_t dimensions, util::DataInitialization init,
+                      LayerType type = LayerType::Color,
+                      const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                      InterpolationType interpolation = InterpolationType::Linear,
+                      const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a representation that takes ownership of data, which has to be allocated with new[].
+     * If data is nullptr, cleared data is allocated from the RAMMemoryPool.
+     */
     LayerRAMPrecision(T* data, size2_t dimensions, LayerType type = LayerType::Color,
                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                       InterpolationType interpolation = InterpolationType::Linear,
                       const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a representation of data owned by someone else, for example a NumPy array. The data
+     * is never deleted by the representation, instead dataOwner is kept alive for as long as the
+     * representation refers to data. The external data is treated as read only, any non-const
+     * access to the data first copies it into memory owned by the representation
+     * (copy-on-write). Copies of the representation make a deep copy.
+     */
+    LayerRAMPrecision(T* data, std::shared_ptr<void> dataOwner, size2_t dimensions,
+                      LayerType type = LayerType::Color,
+                      const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                      InterpolationType interpolation = InterpolationType::Linear,
+                      const Wrapping2D& wrap = wrapping2d::clampAll);
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
-    virtual ~LayerRAMPrecision() = default;
+    virtual ~LayerRAMPrecision();
 
     T* getDataTyped();
     const T* getDataTyped() const;
@@ -102,8 +128,14 @@ public:
     virtual void setFromNormalizedDVec4(const size2_t& pos, dvec4 val) override;
 
 private:
+    /**
+     * Copy externally owned data into memory owned by the representation, before it is modified.
+     */
+    void detach();
+
     size2_t dimensions_;
-    std::unique_ptr<T[]> data_;
+    util::RAMDataPtr<T> data_;
+    std::shared_ptr<void> dataOwner_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping2D wrapping_;
@@ -125,13 +157,25 @@ IVW_CORE_API std::shared_ptr<LayerRAM> createLayerRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping2D& wrapping = wrapping2d::clampAll);
 
+/**
+ * Factory for layers with data from the RAMMemoryPool.
+ * @see createLayerRAM
+ * @param init use util::DataInitialization::Uninitialized for data that will be overwritten
+ */
+IVW_CORE_API std::shared_ptr<LayerRAM> createLayerRAM(
+    const size2_t& dimensions, LayerType type, const DataFormatBase* format,
+    util::DataInitialization init, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping2D& wrapping = wrapping2d::clampAll);
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(new T[dimensions_.x * dimensions_.y]())
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                     util::DataInitialization::Uninitialized))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
@@ -139,13 +183,32 @@ LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
               (type == LayerType::Depth) ? T{1} : T{0});
 }
 
+template <typename T>
+LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, util::DataInitialization init,
+                                        LayerType type, const SwizzleMask& swizzleMask,
+                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+    : LayerRAM(type, DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                     util::DataInitialization::Uninitialized))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+    if (init == util::DataInitialization::Zero) {
+        std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
+                  (type == LayerType::Depth) ? T{1} : T{0});
+    }
+}
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
+    , data_(data ? util::RAMDataPtr<T>(data)
+                 : util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                            util::DataInitialization::Uninitialized))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
@@ -155,11 +218,25 @@ LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType t
     }
 }
 
+template <typename T>
+LayerRAMPrecision<T>::LayerRAMPrecision(T* data, std::shared_ptr<void> dataOwner,
+                                        size2_t dimensions, LayerType type,
+                                        const SwizzleMask& swizzleMask,
+                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+    : LayerRAM(type, DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(data)
+    , dataOwner_(std::move(dataOwner))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
     , dimensions_(rhs.dimensions_)
-    , data_(new T[dimensions_.x * dimensions_.y])
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                     util::DataInitialization::Uninitialized))
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
@@ -172,9 +249,12 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
         LayerRAM::operator=(that);
 
         const auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y);
+        auto data =
+            util::allocateRAMData<T>(glm::compMul(dim), util::DataInitialization::Uninitialized);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
         data_.swap(data);
+        if (dataOwner_) data.release();
+        dataOwner_.reset();
 
         dimensions_ = that.dimensions_;
         swizzleMask_ = that.swizzleMask_;
@@ -184,6 +264,22 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
     return *this;
 }
 
+template <typename T>
+LayerRAMPrecision<T>::~LayerRAMPrecision() {
+    if (dataOwner_) data_.release();
+}
+
+template <typename T>
+void LayerRAMPrecision<T>::detach() {
+    if (!dataOwner_) return;
+    auto data = util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                         util::DataInitialization::Uninitialized);
+    std::memcpy(data.get(), data_.get(), glm::compMul(dimensions_) * sizeof(T));
+    data_.swap(data);
+    data.release();
+    dataOwner_.reset();
+}
+
 template <typename T>
 LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
     return new LayerRAMPrecision<T>(*this);
@@ -191,6 +287,7 @@ LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
 
 template <typename T>
 T* inviwo::LayerRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
@@ -201,6 +298,7 @@ const T* inviwo::LayerRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 void* LayerRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -210,17 +308,21 @@ const void* LayerRAMPrecision<T>::getData() const {
 
 template <typename T>
 void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
+    util::RAMDataPtr<T> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
+    if (dataOwner_) data.release();
+    dataOwner_.reset();
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
     if (dimensions != dimensions_) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
+        auto data = util::allocateRAMData<T>(glm::compMul(dimensions));
         data_.swap(data);
         std::swap(dimensions, dimensions_);
+        if (dataOwner_) data.release();
+        dataOwner_.reset();
     }
 }
 
@@ -281,21 +383,25 @@ dvec4 LayerRAMPrecision<T>::getAsDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -321,21 +427,25 @@ dvec4 LayerRAMPrecision<T>::getAsNormalizedDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
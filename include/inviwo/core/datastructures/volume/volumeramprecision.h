@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/rammemorypool.h>
 
 namespace inviwo {
 
@@ -48,10 +49,34 @@ public:
                                 const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                 InterpolationType interpolation = InterpolationType::Linear,
                                 const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a representation with data from the RAMMemoryPool. Use
+     * util::DataInitialization::Uninitialized to skip zeroing data that will be overwritten.
+     */
+    VolumeRAMPrecision(size3_t dimensions, util::DataInitialization init,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a representation that takes ownership of data, which has to be allocated with new[].
+     * If data is nullptr, zeroed data is allocated from the RAMMemoryPool.
+     */
     VolumeRAMPrecision(T* data, size3_t dimensions,
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
                        const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a representation of data owned by someone else, for example a memory mapped file.
+     * The data is never deleted by the representation, instead dataOwner is kept alive for as long
+     * as the representation refers to data. Copies of the representation make a deep copy.
+     * The external data is treated as read only, any non-const access to the data, like
+     * getDataTyped() or setFromDouble(), first copies it into memory owned by the representation
+     * (copy-on-write).
+     */
+    VolumeRAMPrecision(T* data, std::shared_ptr<void> dataOwner, size3_t dimensions,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
@@ -110,9 +135,15 @@ public:
     virtual size_t getNumberOfBytes() const override;
 
 private:
+    /**
+     * Copy externally owned data into memory owned by the representation, before it is modified.
+     */
+    void detach();
+
     size3_t dimensions_;
     bool ownsDataPtr_;
-    std::unique_ptr<T[]> data_;
+    util::RAMDataPtr<T> data_;
+    std::shared_ptr<void> dataOwner_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -133,6 +164,34 @@ IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping3D& wrapping = wrapping3d::clampAll);
 
+/**
+ * Factory for volumes referring to data owned by someone else.
+ * Creates an VolumeRAM with data type specified by format, that uses dataPtr without taking
+ * ownership of it and keeps dataOwner alive instead.
+ *
+ * @param dimensions of volume to create.
+ * @param format of volume to create.
+ * @param dataPtr pointer to the data, has to be valid for as long as dataOwner is alive.
+ * @param dataOwner the owner of the data.
+ * @return nullptr if no valid format was specified.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const size3_t& dimensions, const DataFormatBase* format, void* dataPtr,
+    std::shared_ptr<void> dataOwner, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
+/**
+ * Factory for volumes with data from the RAMMemoryPool.
+ * @see createVolumeRAM
+ * @param init use util::DataInitialization::Uninitialized for data that will be overwritten
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const size3_t& dimensions, const DataFormatBase* format, util::DataInitialization init,
+    const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
@@ -140,7 +199,20 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask&
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_)))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, util::DataInitialization init,
+                                          const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , ownsDataPtr_(true)
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_), init))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -153,7 +225,21 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(data ? util::RAMDataPtr<T>(data) : util::allocateRAMData<T>(glm::compMul(dimensions_)))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, std::shared_ptr<void> dataOwner,
+                                          size3_t dimensions, const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , ownsDataPtr_(false)
+    , data_(data)
+    , dataOwner_(std::move(dataOwner))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -163,7 +249,8 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
     : VolumeRAM(rhs)
     , dimensions_(rhs.dimensions_)
     , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z])
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                     util::DataInitialization::Uninitialized))
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
@@ -176,11 +263,14 @@ VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision
     if (this != &that) {
         VolumeRAM::operator=(that);
         auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
+        auto data =
+            util::allocateRAMData<T>(glm::compMul(dim), util::DataInitialization::Uninitialized);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
         data_.swap(data);
         std::swap(dim, dimensions_);
+        if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
+        dataOwner_.reset();
         swizzleMask_ = that.swizzleMask_;
         interpolation_ = that.interpolation_;
         wrapping_ = that.wrapping_;
@@ -193,6 +283,18 @@ VolumeRAMPrecision<T>::~VolumeRAMPrecision() {
     if (!ownsDataPtr_) data_.release();
 }
 
+template <typename T>
+void VolumeRAMPrecision<T>::detach() {
+    if (!dataOwner_) return;
+    auto data = util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                         util::DataInitialization::Uninitialized);
+    std::memcpy(data.get(), data_.get(), getNumberOfBytes());
+    data_.swap(data);
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+    dataOwner_.reset();
+}
+
 template <typename T>
 VolumeRAMPrecision<T>* VolumeRAMPrecision<T>::clone() const {
     return new VolumeRAMPrecision<T>(*this);
@@ -205,11 +307,13 @@ const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -219,6 +323,7 @@ const void* VolumeRAMPrecision<T>::getData() const {
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
+    detach();
     return data_.get() + pos;
 }
 
@@ -229,12 +334,13 @@ const void* VolumeRAMPrecision<T>::getData(size_t pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
+    util::RAMDataPtr<T> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
 
     if (!ownsDataPtr_) data.release();
     ownsDataPtr_ = true;
+    dataOwner_.reset();
 }
 
 template <typename T>
@@ -255,11 +361,12 @@ size_t VolumeRAMPrecision<T>::getNumberOfBytes() const {
 template <typename T>
 void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
     if (dimensions_ != dimensions) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y * dimensions.z);
+        auto data = util::allocateRAMData<T>(glm::compMul(dimensions));
         data_.swap(data);
         dimensions_ = dimensions;
         if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
+        dataOwner_.reset();
     }
 }
 
@@ -315,21 +422,25 @@ dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -355,21 +466,25 @@ dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
@@ -36,6 +36,8 @@
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/util/exception.h>
 
+#include <type_traits>
+
 namespace inviwo {
 
 /**
@@ -62,13 +64,25 @@ private:
     std::vector<FileExtension> extensions_;
 };
 
+namespace detail {
+// The representation type of T, or void for types that have no representations
+template <typename T, typename = void>
+struct DataWriterRepr {
+    using type = void;
+};
+template <typename T>
+struct DataWriterRepr<T, std::void_t<typename T::repr>> {
+    using type = typename T::repr;
+};
+}  // namespace detail
+
 /**
  * \ingroup dataio
  */
 template <typename T>
 class DataWriterType : public DataWriter {
 public:
-    using repr = typename T::repr;
+    using repr = typename detail::DataWriterRepr<T>::type;
 
     DataWriterType() = default;
     DataWriterType(const DataWriterType& rhs) = default;
@@ -35,6 +35,9 @@
 
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/io/datawriter.h>
+
+#include <memory>
 
 namespace inviwo {
 
@@ -45,6 +48,13 @@ IVW_CORE_API void saveLayer(const Layer& layer, const std::string& path,
 
 IVW_CORE_API void saveLayer(const Layer& layer);
 
+/**
+ * Get a layer writer for \p extension, or for the extension of \p path if there is no writer for
+ * \p extension. Returns nullptr if neither is found.
+ */
+IVW_CORE_API std::unique_ptr<DataWriterType<Layer>> getLayerWriter(
+    const std::string& path, const FileExtension& extension = FileExtension());
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -43,6 +43,10 @@ namespace inviwo {
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ * Data stored in native byte order at an offset aligned to the component size is memory mapped
+ * instead of read, the mapping is released when the last VolumeRAM using it is destroyed. Other
+ * data, or files that can not be mapped, are read into a newly allocated buffer.
+ * Note that a mapped file should not be modified or truncated while it is in use.
  */
 
 class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
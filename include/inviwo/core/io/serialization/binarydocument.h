@@ -0,0 +1,87 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BINARYDOCUMENT_H
+#define IVW_BINARYDOCUMENT_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <iosfwd>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Compact binary encoding of the documents written by the Serializer
+ *
+ * The encoding holds the same tree of elements, attributes, text, and comments as the xml, but
+ * all names and values are stored once in a string table and referred to by index. Reading it
+ * needs no xml parsing or entity decoding, and writing needs no formatting or escaping.
+ *
+ * Layout, all integers are unsigned LEB128 varints:
+ *   - Magic bytes `\x89IVB` and one byte with the encoding version
+ *   - The number of strings followed by the strings, each as a length and the utf-8 bytes
+ *   - A sequence of nodes terminated by End. Element nodes hold the index of the name, the number
+ *     of attributes, name and value index of each attribute, and then their child nodes
+ *     terminated by End. Text, CDATA, and comment nodes hold the index of their value.
+ *
+ * The xml declaration is not stored, a default one is added when reading.
+ */
+struct IVW_CORE_API BinaryDocument {
+    enum class Node : unsigned char { End = 0, Element = 1, Text = 2, CData = 3, Comment = 4 };
+
+    static constexpr char magic[4] = {'\x89', 'I', 'V', 'B'};
+    static constexpr unsigned char version = 1;
+};
+
+/**
+ * Check whether \p stream holds a binary encoded document. Only looks at the next character of
+ * the stream, which is not extracted.
+ */
+IVW_CORE_API bool isBinaryDocument(std::istream& stream);
+
+/**
+ * Write \p doc binary encoded to \p stream. The stream should be opened in binary mode.
+ * @throws SerializationException if the stream could not be written
+ */
+IVW_CORE_API void writeBinaryDocument(const TxDocument& doc, std::ostream& stream);
+
+/**
+ * Read a binary encoded document from \p stream and append its nodes to \p doc.
+ * @throws SerializationException if the stream does not hold a valid binary document
+ */
+IVW_CORE_API void readBinaryDocument(std::istream& stream, TxDocument& doc);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_BINARYDOCUMENT_H
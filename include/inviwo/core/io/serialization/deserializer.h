@@ -43,6 +43,7 @@
 #include <list>
 #include <istream>
 #include <bitset>
+#include <unordered_set>
 #include <array>
 #include <vector>
 
@@ -452,11 +453,21 @@ public:
     template <typename C>
     void operator()(Deserializer& d, C& container) {
         T tmp{};
-        auto toRemove = util::transform(container, [&](const T& x) -> K { return getID_(x); });
+        const auto existing =
+            util::transform(container, [&](const T& x) -> K { return getID_(x); });
+        std::unordered_set<K> found;
         ContainerWrapper<T, K> cont(
             itemKey_, [&](K id, size_t ind) -> typename ContainerWrapper<T, K>::Item {
-                util::erase_remove(toRemove, id);
-                auto it = util::find_if(container, [&](T& i) { return getID_(i) == id; });
+                found.insert(id);
+                // Items are usually deserialized in the order of the container, check the item at
+                // the same position before searching.
+                auto it = std::end(container);
+                if (ind < std::size(container) &&
+                    getID_(*std::next(std::begin(container), ind)) == id) {
+                    it = std::next(std::begin(container), ind);
+                } else {
+                    it = util::find_if(container, [&](T& i) { return getID_(i) == id; });
+                }
                 if (it != container.end()) {
                     return {true, *it, [&](T& /*val*/) {}};
                 } else {
@@ -466,7 +477,9 @@ public:
             });
 
         d.deserialize(key_, cont);
-        for (auto& id : toRemove) onRemoveItem_(id);
+        for (auto& id : existing) {
+            if (found.count(id) == 0) onRemoveItem_(id);
+        }
     }
 
 private:
@@ -67,6 +67,13 @@ private:
 
 enum class SerializationTarget { Node, Attribute };
 
+/**
+ * Encoding of serialized documents. Xml is human readable, Binary is a compact encoding of the
+ * same document that is faster to read and write, see util::writeBinaryDocument. Deserializers
+ * detect the encoding automatically.
+ */
+enum class SerializationFormat { Xml, Binary };
+
 class NodeSwitch;
 class Serializable;
 
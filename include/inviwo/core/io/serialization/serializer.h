@@ -79,6 +79,17 @@ public:
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
 
+    /**
+     * \brief Writes serialized data to stream in the given format.
+     *
+     * @param stream Stream to be written to, has to be opened in binary mode for
+     *        SerializationFormat::Binary.
+     * @param format Xml writes formatted xml, Binary the binary encoding of the same document.
+     * @throws SerializationException
+     * @see util::writeBinaryDocument
+     */
+    void writeFile(std::ostream& stream, SerializationFormat format);
+
     // std containers
     template <typename T>
     void serialize(const std::string& key, const std::vector<T>& sVector,
@@ -36,11 +36,15 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/util/dynamictopologicalorder.h>
+
+#include <unordered_map>
 
 namespace inviwo {
 
 class Processor;
 class ProcessorNetwork;
+class ThreadPool;
 
 class IVW_CORE_API ProcessorNetworkEvaluator : public ProcessorNetworkObserver,
                                                public ProcessorObserver,
@@ -48,10 +52,25 @@ class IVW_CORE_API ProcessorNetworkEvaluator : public ProcessorNetworkObserver,
     friend class Processor;
 
 public:
+    /**
+     * Serial evaluates one processor at a time on the main thread in topological order.
+     * Parallel evaluates the network in waves, where each wave consists of all processors whose
+     * predecessors have been evaluated. Within a wave, processors that are marked as thread safe
+     * (ProcessorInfo::threadSafe) are processed concurrently on the thread pool, the rest are
+     * processed on the main thread afterwards. Processors tagged with Tag::GL are always processed
+     * on the main thread, since framebuffers and vertex arrays can not be shared between contexts.
+     * Initialization of resources, inport onChange callbacks and all observer notifications still
+     * happen on the main thread, in topological order.
+     */
+    enum class EvaluationMode { Serial, Parallel };
+
     ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork);
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    void setEvaluationMode(EvaluationMode mode);
+    EvaluationMode getEvaluationMode() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -67,12 +86,42 @@ private:
 
     void requestEvaluate();
     void evaluate();
+    void evaluateSerial();
+    void evaluateParallel(ThreadPool& pool);
+
+    /**
+     * Handles everything before Processor::process, returns true if the processor should be
+     * processed.
+     */
+    bool prepare(Processor* processor);
+    void process(Processor* processor);
+    void finish(Processor* processor);
+    /// True if the processor is thread safe and does not use OpenGL
+    bool isConcurrent(Processor* processor);
+
+    /// Cached from the ProcessorInfo, which is created on every call
+    struct ProcessorTraits {
+        bool threadSafe;
+        bool gl;
+    };
+    const ProcessorTraits& getTraits(Processor* processor);
+
+    /**
+     * Rebuild processorsSorted_ from the incrementally maintained order if the network topology,
+     * the sinks or the active connections have changed since the last evaluation.
+     */
+    void updateProcessorOrder();
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
+    // topological order of all processors, updated incrementally as the network changes
+    util::DynamicTopologicalOrder<Processor*> order_;
+    // the sorted list of processors that need evaluation, i.e. that are connected to a sink
     std::vector<Processor*> processorsSorted_;
+    bool sortDirty_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    EvaluationMode mode_;
+    std::unordered_map<Processor*, ProcessorTraits> traits_;
 };
 
 }  // namespace inviwo
@@ -89,23 +89,28 @@ public:
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format the encoding of the workspace, the stream has to be opened in binary mode for
+     *      SerializationFormat::Binary. Both formats can be loaded.
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
      * Save the current workspace to a file
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format the encoding of the workspace
      */
     void save(const std::string& path,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
-     * Load a workspace from a stream
+     * Load a workspace from a stream, in xml or binary format
      * \param stream the stream to read from.
      * \param refPath a reference that that can be use by the deserializer to calculate relative
      *      paths. The same refPath should be given when loading. Most often this should be the
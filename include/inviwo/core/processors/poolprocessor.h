@@ -36,6 +36,8 @@
 #include <inviwo/core/processors/activityindicator.h>
 #include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/util/timer.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/network/processornetwork.h>
 
 #include <atomic>
@@ -281,7 +283,7 @@ private:
 
     struct Submission {
         std::shared_ptr<pool::detail::State> state;
-        std::vector<std::function<void()>> tasks;
+        std::vector<ThreadPool::Task> tasks;
         std::function<void()> setupProgress;
     };
 
@@ -298,8 +300,7 @@ private:
     bool removeState(const std::shared_ptr<pool::detail::State>& state);
 
     template <typename Result, typename Job>
-    std::shared_ptr<std::packaged_task<Result()>> makeTask(Job&& job, pool::Stop stop,
-                                                           pool::Progress progress);
+    std::packaged_task<Result()> makeTask(Job&& job, pool::Stop stop, pool::Progress progress);
 
     template <typename Result, typename Done>
     static void callDone(InviwoApplication* app,
@@ -380,7 +381,7 @@ inline void PoolProcessor::callDone(
                 for (auto& res : state->futures) {
                     results.push_back(res.get());
                 }
-                state->done(results);
+                state->done(std::move(results));
             }
         } catch (...) {
             p.handleError();
@@ -426,11 +427,15 @@ void PoolProcessor::dispatchMany(std::vector<Job> jobs, Done&& done) {
     size_t i = 0;
     for (auto& job : jobs) {
         auto task = makeTask<Result>(std::move(job), state->getStop(), state->getProgress(i++));
-        state->futures.push_back(task->get_future());
-        sub.tasks.emplace_back([state, task, app]() {
-            if (!state->stop) (*task)();
-            callDone(app, state);
-        });
+        state->futures.push_back(task.get_future());
+        sub.tasks.emplace_back(
+            [state, task = std::move(task), app, id = getIdentifier()]() mutable {
+                if (!state->stop) {
+                    IVW_TRACE_SCOPE_DETAIL("pool", "Job", id);
+                    task();
+                }
+                callDone(app, state);
+            });
     }
 
     if (delayDispatch()) {
@@ -457,15 +462,17 @@ void PoolProcessor::dispatchOne(Job&& job, Done&& done) {
 
     auto state = makeState<Result, Done>(1, std::forward<Done>(done));
     auto task = makeTask<Result>(std::forward<Job>(job), state->getStop(), state->getProgress(0));
-    state->futures.push_back(task->get_future());
+    state->futures.push_back(task.get_future());
     auto app = getNetwork()->getApplication();
 
-    Submission sub{state,
-                   {[state, task, app]() {
-                       if (!state->stop) (*task)();
-                       callDone(app, state);
-                   }},
-                   [this]() { setupProgress<Job>(); }};
+    Submission sub{state, {}, [this]() { setupProgress<Job>(); }};
+    sub.tasks.emplace_back([state, task = std::move(task), app, id = getIdentifier()]() mutable {
+        if (!state->stop) {
+            IVW_TRACE_SCOPE_DETAIL("pool", "Job", id);
+            task();
+        }
+        callDone(app, state);
+    });
 
     if (delayDispatch()) {
         queue_.clear();
@@ -500,22 +507,23 @@ inline std::shared_ptr<pool::detail::StateTemplate<Result, Done>> PoolProcessor:
 }
 
 template <typename Result, typename Job>
-inline std::shared_ptr<std::packaged_task<Result()>> PoolProcessor::makeTask(
-    Job&& job, [[maybe_unused]] pool::Stop stop, [[maybe_unused]] pool::Progress progress) {
+inline std::packaged_task<Result()> PoolProcessor::makeTask(Job&& job,
+                                                            [[maybe_unused]] pool::Stop stop,
+                                                            [[maybe_unused]] pool::Progress progress) {
     if constexpr (std::is_invocable_v<Job, pool::Stop, pool::Progress>) {
-        return std::make_shared<std::packaged_task<Result()>>(
+        return std::packaged_task<Result()>(
             [job = std::forward<Job>(job), stop, progress]() { return job(stop, progress); });
     } else if constexpr (std::is_invocable_v<Job, pool::Progress, pool::Stop>) {
-        return std::make_shared<std::packaged_task<Result()>>(
+        return std::packaged_task<Result()>(
             [job = std::forward<Job>(job), stop, progress]() { return job(progress, stop); });
     } else if constexpr (std::is_invocable_v<Job, pool::Stop>) {
-        return std::make_shared<std::packaged_task<Result()>>(
+        return std::packaged_task<Result()>(
             [job = std::forward<Job>(job), stop]() { return job(stop); });
     } else if constexpr (std::is_invocable_v<Job, pool::Progress>) {
-        return std::make_shared<std::packaged_task<Result()>>(
+        return std::packaged_task<Result()>(
             [job = std::forward<Job>(job), progress]() { return job(progress); });
     } else {
-        return std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+        return std::packaged_task<Result()>(std::forward<Job>(job));
     }
 }
 
@@ -46,7 +46,8 @@ namespace inviwo {
 struct IVW_CORE_API ProcessorInfo {
 public:
     ProcessorInfo(std::string aClassIdentifier, std::string aDisplayName, std::string aCategory,
-                  CodeState aCodeState, Tags someTags, bool visible = true);
+                  CodeState aCodeState, Tags someTags, bool visible = true,
+                  bool threadSafe = false);
     /// Identifier must be unique for all processors, example org.inviwo.yourprocessor
     const std::string classIdentifier;
     const std::string displayName;  ///< Processor::getDisplayName
@@ -54,11 +55,19 @@ public:
     const CodeState codeState;
     const Tags tags;     ///< Searchable tags, platform tags are shown in ProcessorTreeWidget
     const bool visible;  ///< Show in processor list (ProcessorTreeWidget), enabling drag&drop
+    /**
+     * Processor::process may be called from a worker thread when the network is evaluated in
+     * parallel. The processor must not use the OpenGL context, must not modify any properties, and
+     * may only touch its own ports and properties in process().
+     * @see ProcessorNetworkEvaluator::EvaluationMode
+     */
+    const bool threadSafe;
 };
 
 inline bool operator==(const ProcessorInfo& a, const ProcessorInfo& b) {
-    return std::tie(a.classIdentifier, a.displayName, a.category, a.codeState, a.tags, a.visible) ==
-           std::tie(b.classIdentifier, b.displayName, b.category, b.codeState, b.tags, b.visible);
+    return std::tie(a.classIdentifier, a.displayName, a.category, a.codeState, a.tags, a.visible,
+                    a.threadSafe) == std::tie(b.classIdentifier, b.displayName, b.category,
+                                              b.codeState, b.tags, b.visible, b.threadSafe);
 }
 
 inline bool operator!=(const ProcessorInfo& a, const ProcessorInfo& b) { return !(a == b); }
@@ -194,10 +194,24 @@ public:
      */
     virtual void insertProperty(size_t index, Property& property) override;
 
+    /**
+     * \brief insert all \p properties in the list at position \p index
+     * Like insertProperty, but with a single notification of the observers and a single
+     * propertyModified(). Properties exceeding the maximum number of elements are not added.
+     *
+     * @param index        insertion point for the properties
+     * @param properties   properties to be inserted
+     * @param owner        if true, the list property takes ownership of the properties
+     * @throw Exception    if the type of a property does not match any prefab object
+     */
+    virtual void insertProperties(size_t index, const std::vector<Property*>& properties,
+                                  bool owner = true) override;
+
     virtual Property* removeProperty(const std::string& identifier) override;
     virtual Property* removeProperty(Property* property) override;
     virtual Property* removeProperty(Property& property) override;
     virtual Property* removeProperty(size_t index) override;
+    virtual void removeProperties(std::vector<Property*> properties) override;
 
     /**
      * \brief return number of prefab objects
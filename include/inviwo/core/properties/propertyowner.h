@@ -36,6 +36,8 @@
 #include <inviwo/core/properties/property.h>
 #include <inviwo/core/interaction/events/eventlistener.h>
 
+#include <unordered_map>
+
 namespace inviwo {
 
 class Processor;
@@ -81,6 +83,19 @@ public:
      */
     virtual void insertProperty(size_t index, Property& property);
 
+    /**
+     * \brief insert all \p properties at position \p index
+     * The observers are notified once for all properties, see
+     * PropertyOwnerObserver::onWillAddProperties. If \p index is not valid, the properties are
+     * appended. No property is added if any of the identifiers already exist.
+     *
+     * @param index        insertion point for the properties
+     * @param properties   properties to be inserted, with unique identifiers
+     * @param owner        PropertyOwner will take ownership of the properties if true
+     */
+    virtual void insertProperties(size_t index, const std::vector<Property*>& properties,
+                                  bool owner = true);
+
     virtual Property* removeProperty(const std::string& identifier);
     virtual Property* removeProperty(Property* property);
     virtual Property* removeProperty(Property& property);
@@ -92,6 +107,14 @@ public:
      */
     virtual Property* removeProperty(size_t index);
 
+    /**
+     * \brief remove all \p properties that belong to this owner
+     * The observers are notified once for all properties, see
+     * PropertyOwnerObserver::onWillRemoveProperties. Owned properties are deleted, properties of
+     * other owners are ignored.
+     */
+    virtual void removeProperties(std::vector<Property*> properties);
+
     virtual std::vector<std::string> getPath() const;
 
     const std::vector<Property*>& getProperties() const;
@@ -153,9 +176,17 @@ protected:
     std::vector<std::unique_ptr<Property>> ownedProperties_;
 
 private:
+    friend class Property;
+    // Called by Property::setIdentifier and Property::deserialize to update the identifier index
+    void checkIdentifier(const Property* property, const std::string& identifier) const;
+    void onPropertyIdentifierChanged(Property* property, const std::string& oldIdentifier);
+
     Property* removeProperty(std::vector<Property*>::iterator it);
     bool findPropsForComposites(TxElement*);
     InvalidationLevel invalidationLevel_;
+
+    // Index of properties_ by identifier
+    std::unordered_map<std::string, Property*> propertiesByIdentifier_;
 };
 
 template <class T>
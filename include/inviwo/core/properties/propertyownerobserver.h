@@ -54,6 +54,25 @@ public:
 
     virtual void onWillRemoveProperty(Property* property, size_t index);
     virtual void onDidRemoveProperty(Property* property, size_t index);
+
+    /**
+     * Called once for all properties added by PropertyOwner::insertProperties. The properties are
+     * inserted at consecutive positions starting at \p index. The default implementations call
+     * onWillAddProperty and onDidAddProperty for each property, in order.
+     */
+    virtual void onWillAddProperties(const std::vector<Property*>& properties, size_t index);
+    virtual void onDidAddProperties(const std::vector<Property*>& properties, size_t index);
+
+    /**
+     * Called once for all properties removed by PropertyOwner::removeProperties. \p indices are
+     * the positions of the properties before the removal, in descending order. The default
+     * implementations call onWillRemoveProperty and onDidRemoveProperty for each property, in
+     * that order.
+     */
+    virtual void onWillRemoveProperties(const std::vector<Property*>& properties,
+                                        const std::vector<size_t>& indices);
+    virtual void onDidRemoveProperties(const std::vector<Property*>& properties,
+                                       const std::vector<size_t>& indices);
 };
 
 class IVW_CORE_API PropertyOwnerObservable : public Observable<PropertyOwnerObserver> {
@@ -66,6 +85,14 @@ public:
 
     void notifyObserversWillRemoveProperty(Property* property, size_t index);
     void notifyObserversDidRemoveProperty(Property* property, size_t index);
+
+    void notifyObserversWillAddProperties(const std::vector<Property*>& properties, size_t index);
+    void notifyObserversDidAddProperties(const std::vector<Property*>& properties, size_t index);
+
+    void notifyObserversWillRemoveProperties(const std::vector<Property*>& properties,
+                                             const std::vector<size_t>& indices);
+    void notifyObserversDidRemoveProperties(const std::vector<Property*>& properties,
+                                            const std::vector<size_t>& indices);
 };
 
 }  // namespace inviwo
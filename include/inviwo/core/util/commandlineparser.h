@@ -109,6 +109,11 @@ public:
     bool getLogToFile() const;
     bool getLogToConsole() const;
     bool getDisableResourceManager() const;
+    /**
+     * File to write a Chrome trace of the session to on exit, empty if tracing was not requested.
+     * \see trace::saveChromeTrace
+     */
+    const std::string getTraceFileName() const;
 
     int getARGC() const;
     char** getARGV() const;
@@ -135,6 +140,7 @@ private:
     TCLAP::SwitchArg helpQuiet_;
     TCLAP::SwitchArg versionQuiet_;
     TCLAP::SwitchArg disableResourceManager_;
+    TCLAP::ValueArg<std::string> traceFile_;
 
     std::vector<std::tuple<int, TCLAP::Arg*, std::function<void()>>> callbacks_;
 };
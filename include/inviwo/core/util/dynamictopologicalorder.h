@@ -0,0 +1,234 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <warn/pop>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Maintains a topological order of a directed acyclic graph under insertion and removal of nodes
+ * and edges, similar to the algorithm by Pearce and Kelly: "A Dynamic Topological Sort Algorithm
+ * for Directed Acyclic Graphs", ACM Journal of Experimental Algorithmics, 2006.
+ *
+ * Adding an edge that is consistent with the current order is O(1). Otherwise the region between
+ * the two endpoints in the current order is searched forwards from the target and backwards from
+ * the source at the same time, and the set that is found first is moved to the other end of the
+ * region. New nodes are placed last. Removing nodes or edges never invalidates the order.
+ * Parallel edges are allowed. An edge that would introduce a cycle is recorded but does not affect
+ * the order, in that case addEdge returns false.
+ */
+template <typename T, typename Hash = std::hash<T>>
+class DynamicTopologicalOrder {
+public:
+    DynamicTopologicalOrder() = default;
+
+    bool contains(const T& value) const { return nodes_.count(value) != 0; }
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+
+    /**
+     * Add a node last in the order, does nothing if the node already exists.
+     */
+    void addNode(const T& value) {
+        auto [it, inserted] = nodes_.try_emplace(value);
+        if (!inserted) return;
+        it->second.value = value;
+        it->second.ord = positions_.size();
+        positions_.push_back(&it->second);
+    }
+
+    /**
+     * Remove a node and all its edges
+     */
+    void removeNode(const T& value) {
+        auto it = nodes_.find(value);
+        if (it == nodes_.end()) return;
+        auto& node = it->second;
+        for (auto succ : node.out) erase(succ->in, &node);
+        for (auto pred : node.in) erase(pred->out, &node);
+        positions_[node.ord] = nullptr;
+        ++holes_;
+        nodes_.erase(it);
+        if (holes_ > 32 && holes_ > positions_.size() / 2) compact();
+    }
+
+    /**
+     * Add an edge from -> to, both nodes have to exist.
+     * @return false if the edge introduces a cycle, in which case the order will not respect it.
+     */
+    bool addEdge(const T& from, const T& to) {
+        auto& source = nodes_.at(from);
+        auto& target = nodes_.at(to);
+        source.out.push_back(&target);
+        target.in.push_back(&source);
+
+        if (source.ord < target.ord) return true;  // Already consistent
+        if (&source == &target) return false;
+
+        const auto lower = target.ord;
+        const auto upper = source.ord;
+        const auto [result, acyclic] = search(&target, &source);
+        if (acyclic) {
+            const auto first = positions_.begin() + lower;
+            const auto last = positions_.begin() + upper + 1;
+            if (result == Found::Forward) {
+                // Everything reachable from the target goes after the source
+                std::stable_partition(first, last,
+                                      [](Node* n) { return !n || n->mark != Mark::Forward; });
+            } else {
+                // Everything reaching the source goes before the target
+                std::stable_partition(first, last,
+                                      [](Node* n) { return n && n->mark == Mark::Backward; });
+            }
+            for (auto i = lower; i <= upper; ++i) {
+                if (positions_[i]) positions_[i]->ord = i;
+            }
+        }
+        for (auto n : touched_) n->mark = Mark::Unmarked;
+        touched_.clear();
+        return acyclic;
+    }
+
+    /**
+     * Remove one edge from -> to if it exists.
+     */
+    void removeEdge(const T& from, const T& to) {
+        auto sit = nodes_.find(from);
+        auto tit = nodes_.find(to);
+        if (sit == nodes_.end() || tit == nodes_.end()) return;
+        erase(sit->second.out, &tit->second);
+        erase(tit->second.in, &sit->second);
+    }
+
+    /**
+     * Call f for each node in topological order
+     */
+    template <typename F>
+    void forEach(F f) const {
+        for (auto node : positions_) {
+            if (node) f(node->value);
+        }
+    }
+
+    std::vector<T> order() const {
+        std::vector<T> res;
+        res.reserve(nodes_.size());
+        forEach([&](const T& value) { res.push_back(value); });
+        return res;
+    }
+
+private:
+    enum class Mark : unsigned char { Unmarked, Forward, Backward };
+
+    struct Node {
+        T value{};
+        size_t ord = 0;
+        Mark mark = Mark::Unmarked;
+        std::vector<Node*> out;
+        std::vector<Node*> in;
+    };
+
+    static void erase(std::vector<Node*>& nodes, Node* node) {
+        auto it = std::find(nodes.begin(), nodes.end(), node);
+        if (it != nodes.end()) nodes.erase(it);
+    }
+
+    enum class Found { Forward, Backward };
+
+    /**
+     * Search forwards from target and backwards from source in lock step, limited to the region
+     * between them. Stops when either search is exhausted, the nodes found are marked. Meeting the
+     * other search means that the new edge closes a cycle.
+     */
+    std::pair<Found, bool> search(Node* target, Node* source) {
+        const auto lower = target->ord;
+        const auto upper = source->ord;
+        std::vector<Node*> forward{target};
+        std::vector<Node*> backward{source};
+        target->mark = Mark::Forward;
+        source->mark = Mark::Backward;
+        touched_.push_back(target);
+        touched_.push_back(source);
+
+        while (true) {
+            if (forward.empty()) return {Found::Forward, true};
+            auto node = forward.back();
+            forward.pop_back();
+            for (auto succ : node->out) {
+                if (succ->ord > upper) continue;
+                if (succ->mark == Mark::Backward) return {Found::Forward, false};
+                if (succ->mark == Mark::Unmarked) {
+                    succ->mark = Mark::Forward;
+                    touched_.push_back(succ);
+                    forward.push_back(succ);
+                }
+            }
+
+            if (backward.empty()) return {Found::Backward, true};
+            node = backward.back();
+            backward.pop_back();
+            for (auto pred : node->in) {
+                if (pred->ord < lower) continue;
+                if (pred->mark == Mark::Forward) return {Found::Backward, false};
+                if (pred->mark == Mark::Unmarked) {
+                    pred->mark = Mark::Backward;
+                    touched_.push_back(pred);
+                    backward.push_back(pred);
+                }
+            }
+        }
+    }
+
+    void compact() {
+        auto it = std::remove(positions_.begin(), positions_.end(), nullptr);
+        positions_.erase(it, positions_.end());
+        for (size_t i = 0; i < positions_.size(); ++i) positions_[i]->ord = i;
+        holes_ = 0;
+    }
+
+    std::unordered_map<T, Node, Hash> nodes_;
+    std::vector<Node*> positions_;
+    size_t holes_ = 0;
+    std::vector<Node*> touched_;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -37,6 +37,7 @@
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/util/taskgroup.h>
 
 namespace inviwo {
 
@@ -68,25 +69,19 @@ void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
         }
     }
 
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size2_t start = size2_t(0, job * dims.y / jobs);
-        size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
+    // Split the image into rows of blocks, the calling thread helps out while waiting.
+    const size_t grain = std::max(size_t{1}, (dims.y + jobs - 1) / jobs);
+    parallelFor(
+        size_t{0}, dims.y,
+        [&callback, &dims](size_t yBegin, size_t yEnd) {
             size2_t pos{0};
-
-            for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+            for (pos.y = yBegin; pos.y < yEnd; ++pos.y) {
+                for (pos.x = 0; pos.x < dims.x; ++pos.x) {
                     callback(pos);
                 }
             }
-        }));
-    }
-
-    for (const auto &e : futures) {
-        e.wait();
-    }
+        },
+        grain);
 }
 
 template <typename C>
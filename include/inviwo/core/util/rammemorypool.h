@@ -0,0 +1,182 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \class RAMMemoryPool
+ * \brief A process wide pool of memory for the data of RAM representations.
+ *
+ * Large blocks that are freed are kept in the pool, up to a capacity, and handed out again for
+ * allocations of the same size class. This avoids returning multi-GB blocks to the operating
+ * system only to request them again in the next evaluation, as happens when volumes are subsampled
+ * repeatedly or images are processed every frame. Sizes are rounded up to size classes with four
+ * steps per power of two, such that at most 25% of a block is unused.
+ *
+ * Blocks of at least 2 MB can optionally be aligned to 2 MB and marked as candidates for
+ * transparent huge pages, which reduces TLB misses when iterating over large volumes.
+ *
+ * The memory is neither constructed nor initialized, use allocateRAMData to get typed data.
+ * @see allocateRAMData
+ */
+class IVW_CORE_API RAMMemoryPool {
+public:
+    struct Stats {
+        size_t liveBytes = 0;    ///< Bytes currently handed out by the pool
+        size_t liveBlocks = 0;   ///< Number of blocks currently handed out
+        size_t peakBytes = 0;    ///< The largest value of liveBytes so far
+        size_t pooledBytes = 0;  ///< Bytes kept in the pool for reuse
+        size_t pooledBlocks = 0;
+        size_t hits = 0;    ///< Allocations that reused a pooled block
+        size_t misses = 0;  ///< Allocations that requested a new block
+    };
+
+    /**
+     * Blocks smaller than this are never pooled
+     */
+    static constexpr size_t minPooledSize = size_t{1} << 16;
+    static constexpr size_t hugePageSize = size_t{2} << 20;
+
+    /**
+     * The pool used by the RAM representations. It is never destroyed, since representations can
+     * outlive any static object.
+     */
+    static RAMMemoryPool& getInstance();
+
+    /**
+     * Pooled blocks stay allocated for the life of the pool, hence the default capacity is kept
+     * small. The application sets it from the `RAM Pool Size (MB)` system setting.
+     */
+    static constexpr size_t defaultCapacity = size_t{128} << 20;
+
+    RAMMemoryPool(size_t capacity = defaultCapacity, bool hugePages = false);
+    RAMMemoryPool(const RAMMemoryPool&) = delete;
+    RAMMemoryPool& operator=(const RAMMemoryPool&) = delete;
+    ~RAMMemoryPool();
+
+    /**
+     * Allocate at least `bytes` bytes aligned to at least 64 bytes.
+     * @throw std::bad_alloc if the allocation failed, even after releasing all pooled memory.
+     */
+    void* allocate(size_t bytes);
+    /**
+     * Return a block from allocate, `bytes` has to be the size that was requested.
+     */
+    void deallocate(void* ptr, size_t bytes) noexcept;
+
+    /**
+     * Set the maximum number of bytes to keep in the pool, pooled blocks above the capacity are
+     * freed. A capacity of 0 disables pooling.
+     */
+    void setCapacity(size_t bytes);
+    size_t getCapacity() const;
+
+    /**
+     * Align new blocks of at least hugePageSize bytes to hugePageSize and advise the operating
+     * system to back them with transparent huge pages. The advice is only given on Linux.
+     */
+    void setUseHugePages(bool enable);
+    bool getUseHugePages() const;
+
+    /**
+     * Free all pooled blocks
+     */
+    void clear();
+
+    Stats getStats() const;
+
+    /**
+     * The number of bytes actually allocated for a request of `bytes` bytes
+     */
+    static size_t sizeClass(size_t bytes);
+
+private:
+    void trim(size_t capacity);  // requires mutex_ to be locked
+
+    mutable std::mutex mutex_;
+    std::multimap<size_t, void*> pool_;
+    size_t capacity_;
+    bool hugePages_;
+    Stats stats_;
+};
+
+enum class DataInitialization {
+    Zero,          ///< Set all values to zero
+    Uninitialized  ///< Leave the values uninitialized, for data that will be overwritten anyway
+};
+
+/**
+ * Deleter for data from allocateRAMData. Default constructed it deletes data allocated with
+ * new T[], which allows representations to take ownership of data from both sources.
+ */
+template <typename T>
+struct RAMDataDeleter {
+    size_t bytes = 0;
+    bool pooled = false;
+
+    void operator()(T* ptr) const noexcept {
+        if (pooled) {
+            RAMMemoryPool::getInstance().deallocate(ptr, bytes);
+        } else {
+            delete[] ptr;
+        }
+    }
+};
+
+template <typename T>
+using RAMDataPtr = std::unique_ptr<T[], RAMDataDeleter<T>>;
+
+/**
+ * Allocate data for `count` values of T from the RAMMemoryPool.
+ */
+template <typename T>
+RAMDataPtr<T> allocateRAMData(size_t count,
+                              DataInitialization init = DataInitialization::Zero) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "RAM representation data has to be trivially copyable");
+    const auto bytes = count * sizeof(T);
+    auto ptr = static_cast<T*>(RAMMemoryPool::getInstance().allocate(bytes));
+    if (init == DataInitialization::Zero) std::memset(ptr, 0, bytes);
+    return RAMDataPtr<T>(ptr, RAMDataDeleter<T>{bytes, true});
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -52,6 +52,9 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    IntSizeTProperty ramPoolSize_;
+    BoolProperty ramHugePages_;
+    BoolProperty parallelEvaluation_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <warn/pop>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * A move only type erased `void()` callable used by the ThreadPool. Unlike std::function it does
+ * not require the callable to be copyable, which means that std::packaged_task can be stored
+ * directly, and callables with captures smaller than Task::bufferSize are stored inline without
+ * any heap allocation.
+ */
+class Task {
+public:
+    static constexpr size_t bufferSize = 6 * sizeof(void*);
+
+    Task() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> &&
+                                                      std::is_invocable_v<std::decay_t<F>&>>>
+    Task(F&& f) {
+        using Func = std::decay_t<F>;
+        if constexpr (isSmall<Func>()) {
+            ::new (static_cast<void*>(&buffer_)) Func(std::forward<F>(f));
+        } else {
+            ::new (static_cast<void*>(&buffer_)) Func*(new Func(std::forward<F>(f)));
+        }
+        ops_ = &opsFor<Func>;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& rhs) noexcept : ops_{rhs.ops_} {
+        if (ops_) {
+            ops_->move(&buffer_, &rhs.buffer_);
+            rhs.ops_ = nullptr;
+        }
+    }
+    Task& operator=(Task&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            if (rhs.ops_) {
+                rhs.ops_->move(&buffer_, &rhs.buffer_);
+                ops_ = rhs.ops_;
+                rhs.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+    ~Task() { reset(); }
+
+    void operator()() { ops_->invoke(&buffer_); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(&buffer_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    using Buffer = std::aligned_storage_t<bufferSize, alignof(std::max_align_t)>;
+
+    template <typename F>
+    static constexpr bool isSmall() {
+        return sizeof(F) <= sizeof(Buffer) && alignof(F) <= alignof(Buffer) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+    template <typename F>
+    static F& get(void* buffer) noexcept {
+        if constexpr (isSmall<F>()) {
+            return *std::launder(static_cast<F*>(buffer));
+        } else {
+            return **std::launder(static_cast<F**>(buffer));
+        }
+    }
+
+    template <typename F>
+    static void invokeImpl(void* buffer) {
+        get<F>(buffer)();
+    }
+
+    template <typename F>
+    static void moveImpl(void* dst, void* src) noexcept {
+        if constexpr (isSmall<F>()) {
+            auto& func = get<F>(src);
+            ::new (dst) F(std::move(func));
+            func.~F();
+        } else {
+            ::new (dst) F*(*std::launder(static_cast<F**>(src)));
+        }
+    }
+
+    template <typename F>
+    static void destroyImpl(void* buffer) noexcept {
+        if constexpr (isSmall<F>()) {
+            get<F>(buffer).~F();
+        } else {
+            delete *std::launder(static_cast<F**>(buffer));
+        }
+    }
+
+    template <typename F>
+    static constexpr Ops opsFor{&invokeImpl<F>, &moveImpl<F>, &destroyImpl<F>};
+
+    Buffer buffer_;
+    const Ops* ops_ = nullptr;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,208 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <warn/pop>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * A TaskGroup submits a set of tasks to a ThreadPool and lets the caller wait for all of them to
+ * finish. While waiting, the calling thread helps out by running the not yet started tasks of the
+ * group itself. It never runs unrelated pool tasks, so waiting does not re-enter arbitrary code
+ * and it is safe to wait while holding a lock that only other pool tasks need. Waiting on a
+ * TaskGroup from inside another pool task is fine, i.e. groups can be nested. If a task throws,
+ * the remaining not yet started tasks of the group are skipped and the first exception is
+ * rethrown from wait().
+ *
+ * Tasks should only be added from the thread that owns the group.
+ * ```{.cpp}
+ * util::TaskGroup group{pool};
+ * for (auto& item : items) {
+ *     group.run([&item]() { process(item); });
+ * }
+ * group.wait();
+ * ```
+ * \see util::parallelFor
+ */
+class IVW_CORE_API TaskGroup {
+public:
+    /**
+     * Create a group that uses the InviwoApplication thread pool. If there is no application the
+     * tasks are run directly in the calling thread.
+     */
+    TaskGroup();
+    explicit TaskGroup(ThreadPool& pool);
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    /**
+     * Waits for all remaining tasks, any exception is discarded.
+     */
+    ~TaskGroup();
+
+    template <typename F>
+    void run(F&& f);
+
+    /**
+     * Wait for all tasks in the group to finish, rethrows the first exception thrown by any task.
+     * @param help if true the calling thread runs the group's not yet started tasks while waiting,
+     * otherwise it just blocks. Use false when the calling thread has to stay responsive, like
+     * the main thread.
+     */
+    void wait(bool help = true);
+
+    /**
+     * Skip all tasks in the group that have not yet started.
+     */
+    void cancel() noexcept { state_->cancelled = true; }
+    bool isCancelled() const noexcept { return state_->cancelled; }
+
+private:
+    /**
+     * Shared with the pool jobs, since a job can be picked up after its task has already been run
+     * by a waiting thread and the group is gone.
+     */
+    struct State {
+        /**
+         * Run the first queued task, if any. The remaining count is only decremented, under the
+         * mutex, after the task and its captures are destroyed.
+         * @return false if there was nothing left to run.
+         */
+        bool runOne() noexcept;
+        void setException(std::exception_ptr e) noexcept;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Task> queue;
+        size_t remaining = 0;
+        std::atomic<bool> cancelled{false};
+        std::exception_ptr exception;
+    };
+
+    ThreadPool* pool_;
+    std::shared_ptr<State> state_;
+};
+
+template <typename F>
+void TaskGroup::run(F&& f) {
+    if (!pool_) {
+        if (state_->cancelled) return;
+        try {
+            f();
+        } catch (...) {
+            state_->setException(std::current_exception());
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->queue.emplace_back(std::forward<F>(f));
+        ++state_->remaining;
+    }
+    // The pool job only pulls the next task from the group, if the owner already ran it while
+    // waiting the job does nothing.
+    pool_->enqueueRaw([state = state_]() { state->runOne(); });
+}
+
+namespace detail {
+
+IVW_CORE_API ThreadPool* defaultThreadPool();
+
+}  // namespace detail
+
+/**
+ * Call `f` for each index in the range [begin, end) using the given thread pool. `f` can either
+ * take a single index, `[](size_t i){}`, or a sub range, `[](size_t begin, size_t end){}`, in which
+ * case it is called once per chunk. The range is split into chunks of `grain` indices. If grain is
+ * zero the range is split into four chunks per worker. The calling thread takes part in the work
+ * and the function returns once all indices have been processed. Exceptions are propagated to the
+ * caller.
+ */
+template <typename Index, typename F>
+void parallelFor(ThreadPool* pool, Index begin, Index end, F&& f, size_t grain = 0) {
+    static_assert(std::is_integral_v<Index>, "Index has to be an integral type");
+    if (end <= begin) return;
+
+    const auto callRange = [&f](Index rangeBegin, Index rangeEnd) {
+        if constexpr (std::is_invocable_v<F&, Index, Index>) {
+            f(rangeBegin, rangeEnd);
+        } else {
+            for (auto i = rangeBegin; i < rangeEnd; ++i) f(i);
+        }
+    };
+
+    const auto size = static_cast<size_t>(end - begin);
+    const auto workers = pool ? pool->getSize() : size_t{0};
+    if (workers == 0 || size == 1) {
+        callRange(begin, end);
+        return;
+    }
+    if (grain == 0) {
+        grain = std::max(size_t{1}, size / (4 * (workers + 1)));
+    }
+
+    TaskGroup group{*pool};
+    for (size_t first = 0; first < size; first += grain) {
+        const auto last = std::min(size, first + grain);
+        group.run([&callRange, rangeBegin = static_cast<Index>(begin + first),
+                   rangeEnd = static_cast<Index>(begin + last)]() {
+            callRange(rangeBegin, rangeEnd);
+        });
+    }
+    group.wait();
+}
+
+/**
+ * Overload of parallelFor that uses the InviwoApplication thread pool. Runs serially if there is
+ * no application.
+ */
+template <typename Index, typename F>
+void parallelFor(Index begin, Index end, F&& f, size_t grain = 0) {
+    parallelFor(detail::defaultThreadPool(), begin, end, std::forward<F>(f), grain);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
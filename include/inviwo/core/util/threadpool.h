@@ -58,14 +58,16 @@
 #define IVW_THREADPOOL_H
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/task.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
@@ -75,8 +77,19 @@
 
 namespace inviwo {
 
+/**
+ * A work-stealing thread pool. Every worker owns a task queue, tasks submitted from a worker
+ * thread are put in that worker's own queue while tasks from other threads are distributed
+ * round-robin over the workers. A worker runs the newest task of its own queue first. A worker
+ * that runs out of work will try to steal the oldest task of the other workers before going to
+ * sleep. Hence there is no single queue mutex that all threads have to contend for. Tasks are
+ * therefore not started in the order they were submitted.
+ * \see util::TaskGroup, util::parallelFor
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    using Task = util::Task;
+
     ThreadPool(size_t threads, std::function<void()> onThreadStart = []() {},
                std::function<void()> onThreadStop = []() {});
     ~ThreadPool();
@@ -91,13 +104,18 @@ public:
     /**
      * Enqueue a plain functor. The functor may not throw exceptions.
      */
-    void enqueueRaw(std::function<void()> f);
+    void enqueueRaw(Task task);
 
     size_t trySetSize(size_t size);
     size_t getSize() const;
 
     size_t getQueueSize();
 
+    /**
+     * Returns true if the calling thread is one of the worker threads of this pool.
+     */
+    bool isWorkerThread() const;
+
 private:
     enum class State {
         Free,     //< Worker is waiting for tasks.
@@ -107,6 +125,11 @@ private:
         Done      //< Worker is waiting to be joined.
     };
 
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
     struct Worker {
         Worker(ThreadPool& pool);
         Worker(const Worker&) = delete;
@@ -115,18 +138,29 @@ private:
         Worker& operator=(Worker&& rhs) = delete;
         ~Worker();
 
+        Queue queue;
         std::atomic<State> state;  //< State of the worker
         std::thread thread;
     };
-    // need to keep track of threads so we can join them
+
+    bool push(Task& task);
+    bool pop(Worker* self, Task& task);
+    void notify(bool all);
+    static void runTask(Task& task);
+
+    // need to keep track of threads so we can join them, guarded by workers_mutex
     std::vector<std::unique_ptr<Worker>> workers;
+    mutable std::shared_mutex workers_mutex;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
+    // number of tasks in all the worker queues
+    std::atomic<size_t> pending;
+    // used to spread tasks submitted from outside the pool over the workers
+    std::atomic<size_t> next;
 
-    // synchronization
-    std::mutex queue_mutex;
+    // synchronization for sleeping workers
+    std::mutex sleep_mutex;
     std::condition_variable condition;
+    std::atomic<size_t> sleepers;
 
     // Thread start end exit actions
     std::function<void()> onThreadStart_;
@@ -139,18 +173,13 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type> {
     using return_type = typename std::result_of<F(Args...)>::type;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
+    // The packaged_task is stored directly in the Task, no extra shared_ptr or std::function is
+    // needed.
+    std::packaged_task<return_type()> task(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
-    std::future<return_type> res = task->get_future();
-
-    if (workers.empty()) {
-        (*task)();  // No worker threads, just run the task.
-    } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
-    }
-    condition.notify_one();
+    std::future<return_type> res = task.get_future();
+    enqueueRaw(Task{std::move(task)});
     return res;
 }
 
@@ -0,0 +1,182 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_TRACING_H
+#define IVW_TRACING_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Low overhead tracing of the work done by the application. Spans are recorded into a ring buffer
+ * per thread, and can be exported in the Chrome Trace Event format, which can be viewed in
+ * chrome://tracing or https://ui.perfetto.dev. Tracing is disabled by default, then a span only
+ * costs a check of an atomic flag.
+ *
+ * Spans are added with the IVW_TRACE_SCOPE macros, names and categories have to be string
+ * literals. A short dynamic detail, like a processor identifier, can be added to each span:
+ * ```{.cpp}
+ * void MyProcessor::process() {
+ *     IVW_TRACE_SCOPE_DETAIL("processor", "Upload", getIdentifier());
+ *     ...
+ * }
+ * ```
+ * Use `--trace <file>` on the command line to record a trace and write it on exit.
+ */
+namespace trace {
+
+/**
+ * A completed span. Times are in nanoseconds since the start of the application.
+ */
+struct Event {
+    static constexpr size_t detailSize = 48;
+
+    const char* category;
+    const char* name;
+    std::int64_t start;
+    std::int64_t duration;
+    char detail[detailSize];  ///< Null terminated, truncated if too long
+};
+
+/**
+ * All events of one thread, oldest first
+ */
+struct ThreadTrace {
+    size_t id;
+    std::string name;
+    std::vector<Event> events;
+};
+
+/**
+ * Number of events kept per thread, older events are overwritten.
+ */
+constexpr size_t eventsPerThread = size_t{1} << 14;
+
+namespace detail {
+IVW_CORE_API extern std::atomic<bool> enabled;
+IVW_CORE_API std::int64_t now();
+IVW_CORE_API void record(const char* category, const char* name, std::int64_t start,
+                         std::string_view detail);
+}  // namespace detail
+
+inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+/**
+ * Start or stop recording of spans. Recorded events are kept when tracing is disabled.
+ */
+IVW_CORE_API void setEnabled(bool enabled);
+
+/**
+ * Set the name of the calling thread as shown in the exported trace.
+ */
+IVW_CORE_API void setThreadName(std::string_view name);
+
+/**
+ * Discard all recorded events, and forget threads that have exited.
+ */
+IVW_CORE_API void clear();
+
+/**
+ * Get a copy of the recorded events of all threads. Can be called while other threads record
+ * events, events that are overwritten during the copy are dropped.
+ */
+IVW_CORE_API std::vector<ThreadTrace> collect();
+
+/**
+ * Write all recorded events as Chrome Trace Event json.
+ */
+IVW_CORE_API void writeChromeTrace(std::ostream& os);
+
+/**
+ * Write all recorded events as Chrome Trace Event json to the file \p path.
+ * @throws FileException if the file could not be opened
+ */
+IVW_CORE_API void saveChromeTrace(const std::string& path);
+
+/**
+ * Records a span from construction to destruction on the constructing thread, if tracing is
+ * enabled at construction. Use the IVW_TRACE_SCOPE macros rather than this class directly.
+ */
+class Scope {
+public:
+    template <size_t N, size_t M>
+    Scope(const char (&category)[N], const char (&name)[M], std::string_view detail = {})
+        : category_{category}
+        , name_{name}
+        , detail_{detail}
+        , start_{isEnabled() ? detail::now() : -1} {}
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope& operator=(Scope&&) = delete;
+    ~Scope() {
+        if (start_ >= 0) detail::record(category_, name_, start_, detail_);
+    }
+
+private:
+    const char* category_;
+    const char* name_;
+    std::string_view detail_;
+    std::int64_t start_;
+};
+
+}  // namespace trace
+
+#define IVW_TRACE_ADDLINE_PART1(x, y) x##y
+#define IVW_TRACE_ADDLINE_PART2(x, y) IVW_TRACE_ADDLINE_PART1(x, y)
+
+/**
+ * \def IVW_TRACE_SCOPE(category, name)
+ * Record a span for the rest of the enclosing scope. \p category and \p name must be string
+ * literals.
+ */
+#define IVW_TRACE_SCOPE(category, name) \
+    const ::inviwo::trace::Scope IVW_TRACE_ADDLINE_PART2(ivwTrace, __LINE__)("" category, "" name)
+
+/**
+ * \def IVW_TRACE_SCOPE_DETAIL(category, name, detail)
+ * Record a span for the rest of the enclosing scope. \p category and \p name must be string
+ * literals, \p detail is anything convertible to a std::string_view that outlives the scope.
+ */
+#define IVW_TRACE_SCOPE_DETAIL(category, name, detail)                          \
+    const ::inviwo::trace::Scope IVW_TRACE_ADDLINE_PART2(ivwTrace, __LINE__)("" category, \
+                                                                             "" name, detail)
+
+}  // namespace inviwo
+
+#endif  // IVW_TRACING_H
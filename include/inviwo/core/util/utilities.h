@@ -34,10 +34,13 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace inviwo {
 
 class ProcessorNetwork;
+class CanvasProcessor;
 
 class Property;
 class ProcessorWidget;
@@ -50,6 +53,14 @@ IVW_CORE_API void saveAllCanvases(ProcessorNetwork* network, const std::string&
                                   const std::string& name = "UPN", const std::string& ext = ".png",
                                   bool onlyActiveCanvases = false);
 
+/**
+ * The canvases saved by saveAllCanvases together with the path of the image file of each canvas.
+ * Canvases that are not ready or not valid are skipped with an error message.
+ */
+IVW_CORE_API std::vector<std::pair<CanvasProcessor*, std::string>> getCanvasSavePaths(
+    ProcessorNetwork* network, const std::string& dir, const std::string& name = "UPN",
+    const std::string& ext = ".png", bool onlyActiveCanvases = false);
+
 IVW_CORE_API bool isValidIdentifierCharacter(char c, const std::string& extra = "");
 
 IVW_CORE_API void validateIdentifier(const std::string& identifier, const std::string& type,
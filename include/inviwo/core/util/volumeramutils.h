@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/taskgroup.h>
 
 namespace inviwo {
 
@@ -58,37 +59,32 @@ void forEachVoxel(const VolumeRAM &v, C callback) {
 
 template <typename C>
 void forEachVoxelParallel(const size3_t dims, C callback, size_t jobs = 0) {
-    if (InviwoApplication::isInitialized() && jobs == 0) {
-        jobs = 4 * InviwoApplication::getPtr()->getPoolSize();
+    auto pool = detail::defaultThreadPool();
+    if (pool && jobs == 0) {
+        jobs = 4 * pool->getSize();
     }
 
-    if (jobs == 0 || !InviwoApplication::isInitialized()) {
+    if (jobs == 0 || !pool) {
         // fallback to serial version
         forEachVoxel(dims, callback);
         return;
     }
 
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size3_t start = size3_t(0, 0, job * dims.z / jobs);
-        size3_t stop = size3_t(dims.x, dims.y, std::min(dims.z, (job + 1) * dims.z / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
+    // Split the volume into slabs along z, the calling thread helps out while waiting.
+    const size_t grain = std::max(size_t{1}, (dims.z + jobs - 1) / jobs);
+    parallelFor(
+        pool, size_t{0}, dims.z,
+        [&callback, &dims](size_t zBegin, size_t zEnd) {
             size3_t pos{0};
-
-            for (pos.z = start.z; pos.z < stop.z; ++pos.z) {
-                for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                    for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+            for (pos.z = zBegin; pos.z < zEnd; ++pos.z) {
+                for (pos.y = 0; pos.y < dims.y; ++pos.y) {
+                    for (pos.x = 0; pos.x < dims.x; ++pos.x) {
                         callback(pos);
                     }
                 }
             }
-        }));
-    }
-
-    for (const auto &e : futures) {
-        e.wait();
-    }
+        },
+        grain);
 }
 template <typename C>
 void forEachVoxelParallel(const VolumeRAM &v, C callback, size_t jobs = 0) {
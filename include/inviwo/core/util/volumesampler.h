@@ -37,13 +37,92 @@
 #include <inviwo/core/util/interpolation.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
 #include <inviwo/core/util/spatialsampler.h>
 
+#include <tcb/span.hpp>
+
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Type erased interface of TypedVolumeDoubleSampler, used by VolumeDoubleSampler to reach the
+ * typed implementation with a single virtual call per sample, or per batch of samples.
+ */
+template <unsigned int DataDims>
+class VolumeDoubleSamplerBackend {
+public:
+    using Value = Vector<DataDims, double>;
+    virtual ~VolumeDoubleSamplerBackend() = default;
+    virtual Value sample(const dvec3 &pos) const = 0;
+    virtual void sample(util::span<const dvec3> positions, util::span<Value> result) const = 0;
+};
+
+}  // namespace detail
+
+/**
+ * \class TypedVolumeDoubleSampler
+ * Trilinear sampling in data space of a volume with known voxel type T. The eight corners are read
+ * directly from the voxel data and converted to Vector<DataDims, double> in the same way as
+ * VolumeRAM::getAsDVec4 and friends. Usually reached through VolumeDoubleSampler, which dispatches
+ * on the volume format.
+ */
+template <typename T, unsigned int DataDims>
+class TypedVolumeDoubleSampler final : public detail::VolumeDoubleSamplerBackend<DataDims> {
+public:
+    using Value = Vector<DataDims, double>;
+
+    explicit TypedVolumeDoubleSampler(const VolumeRAMPrecision<T> &ram)
+        : data_{ram.getDataTyped()}, dims_{ram.getDimensions()} {}
+
+    /**
+     * Sample at pos in data space, returns zero outside of [0,1]^3.
+     */
+    virtual Value sample(const dvec3 &pos) const override {
+        if (glm::any(glm::lessThan(pos, dvec3(0.0))) ||
+            glm::any(glm::greaterThan(pos, dvec3(1.0)))) {
+            return Value(0.0);
+        }
+        const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
+        const size3_t i0{samplePos};
+        const dvec3 interpolants = samplePos - dvec3(i0);
+
+        // Offsets to the next voxel in each direction, zero on the upper border
+        const size_t dx = i0.x + 1 < dims_.x ? 1 : 0;
+        const size_t dy = i0.y + 1 < dims_.y ? dims_.x : 0;
+        const size_t dz = i0.z + 1 < dims_.z ? dims_.x * dims_.y : 0;
+        const T *p = data_ + i0.x + dims_.x * (i0.y + dims_.y * i0.z);
+
+        const Value samples[8] = {get(p),           get(p + dx),           get(p + dy),
+                                  get(p + dx + dy), get(p + dz),           get(p + dx + dz),
+                                  get(p + dy + dz), get(p + dx + dy + dz)};
+        return Interpolation<Value>::trilinear(samples, interpolants);
+    }
+
+    /**
+     * Sample all positions in data space, result has to have the same size as positions.
+     */
+    virtual void sample(util::span<const dvec3> positions,
+                        util::span<Value> result) const override {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            result[i] = TypedVolumeDoubleSampler::sample(positions[i]);
+        }
+    }
+
+private:
+    static Value get(const T *voxel) { return util::glm_convert<Value>(*voxel); }
+
+    const T *data_;
+    size3_t dims_;
+};
+
 /**
  * \class VolumeDoubleSampler
+ * Trilinear sampler of a volume that returns Vector<DataDims, double> regardless of the volume
+ * format. The sampling is delegated to a TypedVolumeDoubleSampler matching the format of the
+ * volume.
  */
 template <unsigned int DataDims>
 class VolumeDoubleSampler : public SpatialSampler<3, DataDims, double> {
@@ -55,15 +134,23 @@ public:
 
     VolumeDoubleSampler &operator=(const VolumeDoubleSampler &) = default;
 
+    using SpatialSampler<3, DataDims, double>::sample;
+
+    /**
+     * Sample all positions, given in the coordinate space of the sampler. result has to have the
+     * same size as positions.
+     */
+    void sample(util::span<const dvec3> positions,
+                util::span<Vector<DataDims, double>> result) const;
+
     virtual Vector<DataDims, double> sampleDataSpace(const dvec3 &pos) const override;
     virtual bool withinBoundsDataSpace(const dvec3 &pos) const override;
 
 protected:
-    Vector<DataDims, double> getVoxel(const size3_t &pos) const;
-
     std::shared_ptr<const Volume> volume_;
     const VolumeRAM *ram_;
     size3_t dims_;
+    std::shared_ptr<const detail::VolumeDoubleSamplerBackend<DataDims>> typed_;
 };
 
 using VolumeSampler = VolumeDoubleSampler<4>;
@@ -79,53 +166,30 @@ template <unsigned int DataDims>
 VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(const Volume &vol, CoordinateSpace space)
     : SpatialSampler<3, DataDims, double>(vol, space)
     , ram_(vol.getRepresentation<VolumeRAM>())
-    , dims_(vol.getDimensions()) {}
+    , dims_(vol.getDimensions())
+    , typed_(ram_->dispatch<std::shared_ptr<const detail::VolumeDoubleSamplerBackend<DataDims>>>(
+          [](auto vrprecision) {
+              using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+              return std::make_shared<TypedVolumeDoubleSampler<ValueType, DataDims>>(
+                  *vrprecision);
+          })) {}
 
 template <unsigned int DataDims>
-Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3 &pos) const {
-    if (!withinBoundsDataSpace(pos)) {
-        return Vector<DataDims, double>(0.0);
+void VolumeDoubleSampler<DataDims>::sample(util::span<const dvec3> positions,
+                                           util::span<Vector<DataDims, double>> result) const {
+    if (this->space_ == CoordinateSpace::Data) {
+        typed_->sample(positions, result);
+    } else {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const auto p = this->transform_ * dvec4(positions[i], 1.0);
+            result[i] = typed_->sample(dvec3(p) / p.w);
+        }
     }
-    const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
-    const size3_t indexPos = size3_t(samplePos);
-    const dvec3 interpolants = samplePos - dvec3(indexPos);
-
-    Vector<DataDims, double> samples[8];
-    samples[0] = getVoxel(indexPos);
-    samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
-    samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
-    samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
-
-    samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
-    samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
-    samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
-    samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
-
-    return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
 }
 
-template <>
-inline Vector<1, double> VolumeDoubleSampler<1>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDouble(p);
-}
-
-template <>
-inline Vector<2, double> VolumeDoubleSampler<2>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec2(p);
-}
-
-template <>
-inline Vector<3, double> VolumeDoubleSampler<3>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec3(p);
-}
-
-template <>
-inline Vector<4, double> VolumeDoubleSampler<4>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec4(p);
+template <unsigned int DataDims>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3 &pos) const {
+    return typed_->sample(pos);
 }
 
 template <unsigned int DataDims>
@@ -39,7 +39,9 @@
 #include <modules/animation/datastructures/animationtime.h>
 #include <modules/animation/datastructures/animationstate.h>
 #include <modules/animation/animationcontrollerobserver.h>
+#include <modules/animation/frameexporter.h>
 
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/directoryproperty.h>
@@ -124,6 +126,8 @@ public:
     StringProperty renderBaseName;
     OptionPropertyString renderImageExtension;
     IntProperty renderNumFrames;
+    BoolProperty renderPipelined;
+    IntSizeTProperty renderMaxPendingFrames;
     ButtonProperty renderAction;
     ButtonProperty renderActionStop;
 
@@ -183,6 +187,9 @@ protected:
 
     /// State needed during rendering
     RenderState renderState_;
+
+    /// Writes the rendered frames on the thread pool when rendering pipelined
+    std::unique_ptr<FrameExporter> frameExporter_;
 };
 
 }  // namespace animation
@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/animation/animationmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/fileextension.h>
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class CanvasProcessor;
+class InviwoApplication;
+class ThreadPool;
+
+namespace animation {
+
+/**
+ * \brief Writes rendered frames to disk on the thread pool
+ *
+ * exportFrame reads back the visible layer of each canvas into a RAM snapshot on the calling
+ * thread, which has to be the main thread. The snapshots are then encoded and written by the
+ * layer writers on the thread pool, while the network renders the next frame. At most
+ * maxPendingFrames frames are in flight, exportFrame waits for the oldest frame to be written
+ * before starting a new one. This bounds the memory used by the snapshots.
+ */
+class IVW_MODULE_ANIMATION_API FrameExporter {
+public:
+    /// Write the frames on the thread pool of \p app
+    FrameExporter(InviwoApplication* app, size_t maxPendingFrames = 4);
+    FrameExporter(ThreadPool& pool, size_t maxPendingFrames = 4);
+    FrameExporter(const FrameExporter&) = delete;
+    FrameExporter& operator=(const FrameExporter&) = delete;
+    /**
+     * Waits for all pending frames to be written
+     */
+    ~FrameExporter();
+
+    /**
+     * \brief Snapshot the canvases and write them to the paired paths asynchronously
+     * @param canvases   canvases and file paths, see util::getCanvasSavePaths
+     * @param extension  type of the image files, the extension of the path is used if there is no
+     *                   writer for it
+     */
+    void exportFrame(const std::vector<std::pair<CanvasProcessor*, std::string>>& canvases,
+                     const FileExtension& extension = FileExtension());
+
+    /**
+     * \brief Run \p write on the thread pool as a new frame
+     * Waits for the oldest frame first if maxPendingFrames frames are pending. Exceptions thrown
+     * by \p write are logged.
+     */
+    void dispatchFrame(std::function<void()> write);
+
+    /**
+     * Wait until all frames are written. Errors are logged.
+     */
+    void wait();
+
+    size_t getPendingFrames() const;
+    size_t getMaxPendingFrames() const;
+    void setMaxPendingFrames(size_t maxPendingFrames);
+
+private:
+    void waitForOldest();
+
+    ThreadPool* pool_;
+    size_t maxPendingFrames_;
+    std::deque<std::future<void>> pending_;
+};
+
+}  // namespace animation
+
+}  // namespace inviwo
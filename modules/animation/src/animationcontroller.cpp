@@ -93,6 +93,8 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
           }())
     , renderNumFrames("RenderNumFrames", "# Frames", 100, 2, 1000000, 1,
                       InvalidationLevel::InvalidOutput, PropertySemantics::Text)
+    , renderPipelined("RenderPipelined", "Pipelined Export", true)
+    , renderMaxPendingFrames("RenderMaxPendingFrames", "Max Pending Frames", 4, 1, 64)
     , renderAction("RenderAction", "Render")
     , renderActionStop("RenderActionStop", "Stop")
     , controlOptions("ControlOptions", "Control Track")
@@ -131,6 +133,10 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     renderSize.setVisible(renderSizeMode.get() == 3);
     renderAspectRatio.setVisible(renderSizeMode.get() > 0);
 
+    renderPipelined.onChange(
+        [&]() { renderMaxPendingFrames.setVisible(renderPipelined.get()); });
+    renderMaxPendingFrames.setVisible(renderPipelined.get());
+
     renderAction.onChange([&]() { render(); });
     renderAction.setVisible(state_ != AnimationState::Rendering);
 
@@ -146,6 +152,8 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     renderOptions.addProperty(renderLocation);
     renderOptions.addProperty(renderBaseName);
     renderOptions.addProperty(renderImageExtension);
+    renderOptions.addProperty(renderPipelined);
+    renderOptions.addProperty(renderMaxPendingFrames);
     renderOptions.addProperty(renderAction);
     renderOptions.addProperty(renderActionStop);
     renderOptions.setCollapsed(true);
@@ -306,11 +314,18 @@ void AnimationController::render() {
     renderAction.setVisible(false);
     renderActionStop.setVisible(true);
 
+    if (renderPipelined.get()) {
+        frameExporter_ = std::make_unique<FrameExporter>(app_, renderMaxPendingFrames.get());
+    }
+
     // Go for it!
     setState(AnimationState::Rendering);
 }
 
 void AnimationController::afterRender() {
+    // Flush the frames still being written
+    frameExporter_.reset();
+
     // Switch Buttons
     renderActionStop.setVisible(false);
     renderAction.setVisible(true);
@@ -424,9 +439,16 @@ void AnimationController::tickRender() {
         fileNamePattern << renderBaseName.get() << renderState_.canvasIndicator << std::setfill('0')
                         << std::setw(renderState_.digits) << renderState_.currentFrame;
         auto ext = FileExtension::createFileExtensionFromString(renderImageExtension.get());
-        // - save active canvases
-        util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
-                              fileNamePattern.str(), ext.extension_, true);
+        // - save active canvases, the pipelined exporter writes them while the next frame renders
+        if (frameExporter_) {
+            frameExporter_->exportFrame(
+                util::getCanvasSavePaths(app_->getProcessorNetwork(), renderLocation.get(),
+                                         fileNamePattern.str(), ext.extension_, true),
+                ext);
+        } else {
+            util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
+                                  fileNamePattern.str(), ext.extension_, true);
+        }
     }
 
     // Next!
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/animation/frameexporter.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/processors/canvasprocessor.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace animation {
+
+FrameExporter::FrameExporter(InviwoApplication* app, size_t maxPendingFrames)
+    : FrameExporter(app->getThreadPool(), maxPendingFrames) {}
+
+FrameExporter::FrameExporter(ThreadPool& pool, size_t maxPendingFrames)
+    : pool_{&pool}, maxPendingFrames_{std::max(maxPendingFrames, size_t{1})} {}
+
+FrameExporter::~FrameExporter() { wait(); }
+
+void FrameExporter::exportFrame(
+    const std::vector<std::pair<CanvasProcessor*, std::string>>& canvases,
+    const FileExtension& extension) {
+
+    // Back-pressure, do not hold more than maxPendingFrames_ snapshots
+    while (pending_.size() >= maxPendingFrames_) waitForOldest();
+
+    struct Item {
+        std::shared_ptr<const Layer> snapshot;
+        std::shared_ptr<DataWriterType<Layer>> writer;
+        std::string path;
+    };
+    std::vector<Item> items;
+    for (const auto& [canvas, path] : canvases) {
+        const auto layer = canvas->getVisibleLayer();
+        if (!layer) {
+            LogError("Could not find visible layer of " << canvas->getIdentifier());
+            continue;
+        }
+        auto writer = util::getLayerWriter(path, extension);
+        if (!writer) {
+            LogError("Could not find a writer for " << path);
+            continue;
+        }
+        writer->setOverwrite(true);
+
+        // Read back on this thread, the copy keeps the frame while the canvas renders the next
+        auto ram = std::shared_ptr<LayerRepresentation>(
+            layer->getRepresentation<LayerRAM>()->clone());
+        items.push_back({std::make_shared<const Layer>(std::move(ram)), std::move(writer), path});
+    }
+    if (items.empty()) return;
+
+    dispatchFrame([items = std::move(items)]() {
+        for (const auto& item : items) {
+            try {
+                item.writer->writeData(item.snapshot.get(), item.path);
+                LogInfoCustom("FrameExporter", "Canvas layer exported to disk: " << item.path);
+            } catch (const DataWriterException& e) {
+                LogErrorCustom("FrameExporter", e.getMessage());
+            }
+        }
+    });
+}
+
+void FrameExporter::dispatchFrame(std::function<void()> write) {
+    while (pending_.size() >= maxPendingFrames_) waitForOldest();
+    pending_.push_back(pool_->enqueue(std::move(write)));
+}
+
+void FrameExporter::wait() {
+    while (!pending_.empty()) waitForOldest();
+}
+
+size_t FrameExporter::getPendingFrames() const { return pending_.size(); }
+
+size_t FrameExporter::getMaxPendingFrames() const { return maxPendingFrames_; }
+
+void FrameExporter::setMaxPendingFrames(size_t maxPendingFrames) {
+    maxPendingFrames_ = std::max(maxPendingFrames, size_t{1});
+}
+
+void FrameExporter::waitForOldest() {
+    auto frame = std::move(pending_.front());
+    pending_.pop_front();
+
+    // Block instead of running other pool tasks on this thread, those might be processor jobs
+    // that activate a render context of their own.
+    try {
+        frame.get();
+    } catch (const Exception& e) {
+        LogError(e.getMessage());
+    } catch (const std::exception& e) {
+        LogError(e.what());
+    }
+}
+
+}  // namespace animation
+
+}  // namespace inviwo
@@ -0,0 +1,99 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/animation/frameexporter.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+namespace animation {
+
+TEST(FrameExporter, WritesFramesInOrder) {
+    ThreadPool pool(4);
+    FrameExporter exporter(pool, 1);
+
+    std::mutex mutex;
+    std::vector<size_t> written;
+    for (size_t i = 0; i < 20; ++i) {
+        exporter.dispatchFrame([&, i]() {
+            std::scoped_lock lock{mutex};
+            written.push_back(i);
+        });
+        EXPECT_LE(exporter.getPendingFrames(), size_t{1});
+    }
+    exporter.wait();
+
+    std::vector<size_t> expected(20);
+    std::iota(expected.begin(), expected.end(), size_t{0});
+    EXPECT_EQ(expected, written);
+}
+
+TEST(FrameExporter, LimitsPendingFrames) {
+    ThreadPool pool(4);
+    FrameExporter exporter(pool, 3);
+
+    std::atomic<size_t> finished{0};
+    for (size_t i = 0; i < 32; ++i) {
+        exporter.dispatchFrame([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++finished;
+        });
+        EXPECT_LE(exporter.getPendingFrames(), size_t{3});
+        EXPECT_LE(i + 1 - finished, size_t{3});
+    }
+    exporter.wait();
+    EXPECT_EQ(size_t{0}, exporter.getPendingFrames());
+    EXPECT_EQ(size_t{32}, finished);
+}
+
+TEST(FrameExporter, LogsErrors) {
+    ThreadPool pool(2);
+    FrameExporter exporter(pool, 2);
+
+    bool written = false;
+    exporter.dispatchFrame([]() { throw Exception("Failed to write frame"); });
+    exporter.dispatchFrame([&]() { written = true; });
+    EXPECT_NO_THROW(exporter.wait());
+    EXPECT_TRUE(written);
+}
+
+}  // namespace animation
+}  // namespace inviwo
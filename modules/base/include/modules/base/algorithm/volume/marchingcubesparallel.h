@@ -0,0 +1,87 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <functional>
+#include <memory>
+
+namespace inviwo {
+
+class VolumeMinMaxHierarchy;
+
+namespace util {
+
+/**
+ * Extracts an iso surface from a volume using the Marching Cubes algorithm
+ *
+ * Note: Shares interface with util::marchingCubesOpt and produces the same vertices and triangles,
+ * but in a different order.
+ * The volume is divided into blocks of VolumeMinMaxHierarchy::blockSize cells, blocks that can not
+ * contain the iso-value are skipped using the value ranges of a VolumeMinMaxHierarchy. The
+ * remaining blocks are processed in parallel and the vertices on the shared block faces are merged
+ * afterwards.
+ *
+ * @param volume the scalar volume
+ * @param iso iso-value for the extracted surface
+ * @param color the color of the resulting surface
+ * @param invert flips the normals of the surface normals (useful when values greater than the
+ * iso-value is 'outside' of the surface)
+ * @param enclose whether to create surface where the iso surface intersects the volume boundaries
+ * @param progressCallback if set, will be called will executing with the current progress in the
+ * interval [0,1], useful for progress bars. Might be called from worker threads, but never
+ * concurrently
+ * @param maskingCallback optional callback to test whether current cell should be evaluated or not
+ * (return true to include current cell). Will be called concurrently from worker threads
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesParallel(
+    std::shared_ptr<const Volume> volume, double iso, const vec4& color, bool invert,
+    bool enclose, std::function<void(float)> progressCallback = nullptr,
+    std::function<bool(const size3_t&)> maskingCallback = nullptr);
+
+/**
+ * Same as above but uses the given \p hierarchy of the volume instead of building a new one. Use
+ * this to avoid a pass over the volume when extracting several iso surfaces from the same data.
+ * The hierarchy has to be rebuilt whenever the volume data changes.
+ * @throws Exception if the hierarchy does not match the dimensions of the volume
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesParallel(
+    std::shared_ptr<const Volume> volume, const VolumeMinMaxHierarchy& hierarchy, double iso,
+    const vec4& color, bool invert, bool enclose,
+    std::function<void(float)> progressCallback = nullptr,
+    std::function<bool(const size3_t&)> maskingCallback = nullptr);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,88 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * A hierarchy of value ranges over blocks of a scalar volume. Level 0 stores the minimum and
+ * maximum value of each block of `blockSize`^3 cells, including the voxels on the far faces of the
+ * block, and each coarser level merges 2x2x2 blocks of the level below. The hierarchy is used to
+ * quickly find the parts of a volume that can contain a given iso value.
+ *
+ * The hierarchy is a snapshot of the data, it is not updated when the volume changes. Owners that
+ * keep it around, like the SurfaceExtraction processor, rebuild it when their inport changes.
+ */
+class IVW_MODULE_BASE_API VolumeMinMaxHierarchy {
+public:
+    /// Number of cells along each side of a level 0 block
+    static constexpr size_t blockSize = 16;
+
+    /**
+     * Build the hierarchy for the first channel of \p volume. Blocks that contain NaN values
+     * are given an infinite range.
+     */
+    explicit VolumeMinMaxHierarchy(const VolumeRAM& volume);
+
+    /// Dimensions of the volume the hierarchy was built from
+    size3_t getVolumeDimensions() const { return volumeDims_; }
+
+    size_t getNumberOfLevels() const { return levels_.size(); }
+    size3_t getBlockDimensions(size_t level = 0) const { return levels_[level].dims; }
+
+    /// The value range of a block, as (min, max)
+    dvec2 getRange(const size3_t& block, size_t level = 0) const;
+
+    /// The cells covered by a level 0 block, as [begin, end)
+    std::pair<size3_t, size3_t> getCellRange(const size3_t& block) const;
+
+    /**
+     * Linear indices of all level 0 blocks where `min <= value <= max`, in increasing order.
+     */
+    std::vector<size_t> findBlocksContaining(double value) const;
+
+private:
+    struct Level {
+        size3_t dims;
+        std::vector<dvec2> ranges;
+    };
+    size3_t volumeDims_;
+    std::vector<Level> levels_;
+};
+
+}  // namespace inviwo
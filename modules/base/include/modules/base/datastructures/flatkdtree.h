@@ -0,0 +1,369 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <tcb/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A balanced KD-tree stored in flat arrays, built in bulk from a set of points.
+ *
+ * The points are reordered so that every subtree covers a contiguous range. A range with more
+ * than `leafSize` points is split at the median along the axis of its largest extent. The median
+ * point is placed in the middle of the range and the two halves form the subtrees. Only the
+ * reordered coordinates, one array per axis, the original indices, and the split axis of each
+ * inner node are stored. Leaves are searched by brute force over the contiguous coordinates, in a
+ * loop without branches that the compiler can vectorize.
+ *
+ * The build splits the upper levels of the tree in the calling thread and builds the remaining
+ * subtrees in parallel using util::parallelFor. Queries are const and may run concurrently. The
+ * batched queries process the query points in parallel. Queries return indices into the points
+ * given to the constructor, and write their results into buffers owned by the caller.
+ *
+ * \see KDTree for a tree that supports inserting and removing points
+ */
+template <unsigned int N, typename P = double>
+class FlatKDTree {
+    static_assert(N > 1, "FlatKDTree requires at least two dimensions");
+    static_assert(std::is_floating_point<P>::value, "FlatKDTree requires floating point positions");
+
+public:
+    using Point = Vector<N, P>;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t leafSize = 16;
+
+    FlatKDTree() = default;
+    explicit FlatKDTree(util::span<const Point> points);
+    explicit FlatKDTree(const std::vector<Point>& points)
+        : FlatKDTree(util::span<const Point>(points.data(), points.size())) {}
+
+    size_t size() const { return indices_.size(); }
+    bool empty() const { return indices_.empty(); }
+
+    /**
+     * Index of the point closest to \p pos, or npos if the tree is empty.
+     */
+    size_t findNearest(const Point& pos) const;
+
+    /**
+     * Find the `indices.size()` points closest to \p pos, sorted by increasing distance.
+     * @param pos          query position
+     * @param indices      receives the indices of the closest points
+     * @param sqDistances  receives the squared distances, must have the same size as \p indices
+     * @return the number of points found, less than the requested number only if the tree has
+     * fewer points
+     */
+    size_t findNNearest(const Point& pos, util::span<size_t> indices,
+                        util::span<P> sqDistances) const;
+
+    /**
+     * Batched version of findNNearest. The \p k results for query `i` are written to
+     * `[i * k, (i + 1) * k)` in \p indices and \p sqDistances, which need room for
+     * `positions.size() * k` values. Unused entries are set to npos and infinity.
+     */
+    void findNNearest(util::span<const Point> positions, size_t k, util::span<size_t> indices,
+                      util::span<P> sqDistances) const;
+
+    /**
+     * Replace the contents of \p indices with the indices of all points within \p radius of
+     * \p pos, in no particular order.
+     * @return the number of points found
+     */
+    size_t findWithinRadius(const Point& pos, P radius, std::vector<size_t>& indices) const;
+
+    /**
+     * Batched version of findWithinRadius. \p indices is resized to the number of positions, and
+     * `indices[i]` receives the points within \p radius of `positions[i]`. Reusing the same
+     * \p indices for several calls avoids reallocations.
+     */
+    void findWithinRadius(util::span<const Point> positions, P radius,
+                          std::vector<std::vector<size_t>>& indices) const;
+
+    /**
+     * Call `callback(index, squaredDistance)` for each point within \p radius of \p pos.
+     */
+    template <typename Callback>
+    void forEachWithinRadius(const Point& pos, P radius, Callback&& callback) const;
+
+private:
+    struct Item {
+        Point pos;
+        size_t index;
+    };
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+    // The closest points found so far, sorted by distance
+    struct Neighbors {
+        size_t* indices;
+        P* sqDistances;
+        size_t capacity;
+        size_t count;
+
+        P worst() const {
+            return count < capacity ? std::numeric_limits<P>::infinity() : sqDistances[count - 1];
+        }
+        void insert(size_t index, P sqDist);
+    };
+
+    static void split(std::vector<Item>& items, std::vector<std::uint8_t>& splitAxes, Range range,
+                      size_t minSize, std::vector<Range>* remaining);
+    void distances(Range range, const Point& pos, P* result) const;
+    void nearest(Range range, const Point& pos, Neighbors& neighbors) const;
+    template <typename Callback>
+    void withinRadius(Range range, const Point& pos, P sqRadius, Callback& callback) const;
+
+    std::array<std::vector<P>, N> coords_;
+    std::vector<size_t> indices_;
+    std::vector<std::uint8_t> splitAxes_;
+};
+
+template <unsigned int N, typename P>
+FlatKDTree<N, P>::FlatKDTree(util::span<const Point> points) {
+    const size_t size = points.size();
+    std::vector<Item> items(size);
+    for (size_t i = 0; i < size; ++i) items[i] = Item{points[i], i};
+    splitAxes_.resize(size, 0);
+
+    // Split the upper levels here until there are enough subtrees to keep the pool busy
+    const size_t minParallelSize = std::max<size_t>(leafSize, size / 64);
+    std::vector<Range> subtrees;
+    split(items, splitAxes_, Range{0, size}, minParallelSize, &subtrees);
+    util::parallelFor(size_t{0}, subtrees.size(), [&](size_t i) {
+        split(items, splitAxes_, subtrees[i], leafSize, nullptr);
+    });
+
+    indices_.resize(size);
+    for (auto& coords : coords_) coords.resize(size);
+    util::parallelFor(size_t{0}, size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            indices_[i] = items[i].index;
+            for (unsigned int d = 0; d < N; ++d) coords_[d][i] = items[i].pos[d];
+        }
+    });
+}
+
+/**
+ * Recursively split \p range at the median until the ranges have at most \p minSize points. The
+ * ranges that are not split further are appended to \p remaining, if given.
+ */
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::split(std::vector<Item>& items, std::vector<std::uint8_t>& splitAxes,
+                             Range range, size_t minSize, std::vector<Range>* remaining) {
+    if (range.end - range.begin <= minSize) {
+        if (remaining) remaining->push_back(range);
+        return;
+    }
+    const auto first = items.begin() + range.begin;
+    const auto last = items.begin() + range.end;
+
+    Point lower{first->pos};
+    Point upper{first->pos};
+    for (auto it = first; it != last; ++it) {
+        for (unsigned int d = 0; d < N; ++d) {
+            lower[d] = std::min(lower[d], it->pos[d]);
+            upper[d] = std::max(upper[d], it->pos[d]);
+        }
+    }
+    unsigned int axis = 0;
+    for (unsigned int d = 1; d < N; ++d) {
+        if (upper[d] - lower[d] > upper[axis] - lower[axis]) axis = d;
+    }
+
+    const size_t mid = range.begin + (range.end - range.begin) / 2;
+    std::nth_element(first, items.begin() + mid, last, [axis](const Item& a, const Item& b) {
+        return a.pos[axis] < b.pos[axis];
+    });
+    splitAxes[mid] = static_cast<std::uint8_t>(axis);
+
+    split(items, splitAxes, Range{range.begin, mid}, minSize, remaining);
+    split(items, splitAxes, Range{mid + 1, range.end}, minSize, remaining);
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::Neighbors::insert(size_t index, P sqDist) {
+    if (count < capacity) {
+        ++count;
+    } else if (!(sqDist < sqDistances[count - 1])) {
+        return;
+    }
+    size_t i = count - 1;
+    for (; i > 0 && sqDistances[i - 1] > sqDist; --i) {
+        sqDistances[i] = sqDistances[i - 1];
+        indices[i] = indices[i - 1];
+    }
+    sqDistances[i] = sqDist;
+    indices[i] = index;
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::distances(Range range, const Point& pos, P* result) const {
+    const size_t count = range.end - range.begin;
+    for (size_t i = 0; i < count; ++i) result[i] = P{0};
+    for (unsigned int d = 0; d < N; ++d) {
+        const P* coords = coords_[d].data() + range.begin;
+        const P p = pos[d];
+        for (size_t i = 0; i < count; ++i) {
+            const P diff = coords[i] - p;
+            result[i] += diff * diff;
+        }
+    }
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::nearest(Range range, const Point& pos, Neighbors& neighbors) const {
+    if (range.end - range.begin <= leafSize) {
+        std::array<P, leafSize> sqDists;
+        distances(range, pos, sqDists.data());
+        for (size_t i = range.begin; i < range.end; ++i) {
+            const P sqDist = sqDists[i - range.begin];
+            if (sqDist < neighbors.worst()) neighbors.insert(indices_[i], sqDist);
+        }
+        return;
+    }
+    const size_t mid = range.begin + (range.end - range.begin) / 2;
+    const auto axis = splitAxes_[mid];
+    const P diff = pos[axis] - coords_[axis][mid];
+
+    P sqDist{0};
+    for (unsigned int d = 0; d < N; ++d) {
+        const P dd = coords_[d][mid] - pos[d];
+        sqDist += dd * dd;
+    }
+    if (sqDist < neighbors.worst()) neighbors.insert(indices_[mid], sqDist);
+
+    const Range lower{range.begin, mid};
+    const Range upper{mid + 1, range.end};
+    nearest(diff < P{0} ? lower : upper, pos, neighbors);
+    if (diff * diff < neighbors.worst()) nearest(diff < P{0} ? upper : lower, pos, neighbors);
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findNearest(const Point& pos) const {
+    size_t index = npos;
+    P sqDist;
+    findNNearest(pos, util::span<size_t>(&index, 1), util::span<P>(&sqDist, 1));
+    return index;
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findNNearest(const Point& pos, util::span<size_t> indices,
+                                      util::span<P> sqDistances) const {
+    const size_t k = std::min(indices.size(), sqDistances.size());
+    Neighbors neighbors{indices.data(), sqDistances.data(), k, 0};
+    if (k > 0 && !empty()) nearest(Range{0, size()}, pos, neighbors);
+    std::fill(indices.begin() + neighbors.count, indices.end(), npos);
+    std::fill(sqDistances.begin() + neighbors.count, sqDistances.end(),
+              std::numeric_limits<P>::infinity());
+    return neighbors.count;
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findNNearest(util::span<const Point> positions, size_t k,
+                                    util::span<size_t> indices, util::span<P> sqDistances) const {
+    if (indices.size() < positions.size() * k || sqDistances.size() < positions.size() * k) {
+        throw Exception("Result buffers are too small for the batched query",
+                        IVW_CONTEXT_CUSTOM("FlatKDTree"));
+    }
+    util::parallelFor(size_t{0}, positions.size(), [&](size_t i) {
+        findNNearest(positions[i], indices.subspan(i * k, k), sqDistances.subspan(i * k, k));
+    });
+}
+
+template <unsigned int N, typename P>
+template <typename Callback>
+void FlatKDTree<N, P>::withinRadius(Range range, const Point& pos, P sqRadius,
+                                    Callback& callback) const {
+    if (range.end - range.begin <= leafSize) {
+        std::array<P, leafSize> sqDists;
+        distances(range, pos, sqDists.data());
+        for (size_t i = range.begin; i < range.end; ++i) {
+            const P sqDist = sqDists[i - range.begin];
+            if (sqDist <= sqRadius) callback(indices_[i], sqDist);
+        }
+        return;
+    }
+    const size_t mid = range.begin + (range.end - range.begin) / 2;
+    const auto axis = splitAxes_[mid];
+    const P diff = pos[axis] - coords_[axis][mid];
+
+    P sqDist{0};
+    for (unsigned int d = 0; d < N; ++d) {
+        const P dd = coords_[d][mid] - pos[d];
+        sqDist += dd * dd;
+    }
+    if (sqDist <= sqRadius) callback(indices_[mid], sqDist);
+
+    if (diff <= P{0} || diff * diff <= sqRadius) {
+        withinRadius(Range{range.begin, mid}, pos, sqRadius, callback);
+    }
+    if (diff >= P{0} || diff * diff <= sqRadius) {
+        withinRadius(Range{mid + 1, range.end}, pos, sqRadius, callback);
+    }
+}
+
+template <unsigned int N, typename P>
+template <typename Callback>
+void FlatKDTree<N, P>::forEachWithinRadius(const Point& pos, P radius,
+                                           Callback&& callback) const {
+    if (empty() || radius < P{0}) return;
+    withinRadius(Range{0, size()}, pos, radius * radius, callback);
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findWithinRadius(const Point& pos, P radius,
+                                          std::vector<size_t>& indices) const {
+    indices.clear();
+    forEachWithinRadius(pos, radius, [&](size_t index, P) { indices.push_back(index); });
+    return indices.size();
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findWithinRadius(util::span<const Point> positions, P radius,
+                                        std::vector<std::vector<size_t>>& indices) const {
+    indices.resize(positions.size());
+    util::parallelFor(size_t{0}, positions.size(),
+                      [&](size_t i) { findWithinRadius(positions[i], radius, indices[i]); });
+}
+
+}  // namespace inviwo
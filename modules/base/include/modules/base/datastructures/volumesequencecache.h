@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_VOLUMESEQUENCECACHE_H
+#define IVW_VOLUMESEQUENCECACHE_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <chrono>
+#include <future>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace inviwo {
+
+class ThreadPool;
+
+/**
+ * \brief Streams the time steps of a VolumeSequence into RAM during playback.
+ *
+ * Every call to get() loads the requested time step if needed, and starts loading the next
+ * `prefetchCount` time steps in the current play direction on the thread pool. The direction is
+ * given by the two latest requests, wrapping around at the ends of the sequence.
+ *
+ * Eviction is off by default. With a non zero byte budget, RAM representations of time steps
+ * that have not been used recently are released as soon as the resident size exceeds the budget.
+ * Only RAM representations that the cache loaded itself from a VolumeDisk are released, and never
+ * the requested one, the prefetched ones, or volumes that are referenced from outside of the
+ * sequence, for example by an outport.
+ * \warning The volumes are shared with everyone that has access to the sequence. Other users can
+ * get hold of a RAM representation through the sequence without the cache noticing, releasing
+ * it invalidates any VolumeRAM pointer they keep. Only set a budget when the cache is the sole
+ * consumer of the RAM representations of the sequence.
+ *
+ * The cache is not thread safe, it should be used from one thread, usually in a process function.
+ */
+class IVW_MODULE_BASE_API VolumeSequenceCache {
+public:
+    struct Stats {
+        size_t hits = 0;        ///< Requests for a time step that was already in RAM
+        size_t misses = 0;      ///< Requests that had to load or wait for a time step
+        size_t prefetches = 0;  ///< Time steps loaded ahead of a request
+        size_t evictions = 0;   ///< RAM representations released to stay within the budget
+        std::chrono::nanoseconds totalLatency{0};  ///< Time spent in get() waiting for data
+        std::chrono::nanoseconds maxLatency{0};
+
+        std::chrono::nanoseconds averageLatency() const;
+    };
+
+    /**
+     * @param prefetchCount number of time steps to load ahead of the requested one
+     * @param byteBudget number of bytes of RAM representations to keep, 0 disables eviction
+     * @param pool thread pool for prefetching, if null the prefetching is done in get()
+     */
+    explicit VolumeSequenceCache(size_t prefetchCount = 2, size_t byteBudget = 0,
+                                 ThreadPool* pool = util::detail::defaultThreadPool());
+    VolumeSequenceCache(const VolumeSequenceCache&) = delete;
+    VolumeSequenceCache& operator=(const VolumeSequenceCache&) = delete;
+    ~VolumeSequenceCache() = default;
+
+    /**
+     * Use a new sequence, the RAM representations of the previous one are left as they are.
+     */
+    void setSequence(std::shared_ptr<const VolumeSequence> sequence);
+    const std::shared_ptr<const VolumeSequence>& getSequence() const { return sequence_; }
+
+    /**
+     * Returns the time step \p index with its RAM representation loaded. Throws the exception of
+     * the loader if the time step could not be loaded.
+     */
+    std::shared_ptr<Volume> get(size_t index);
+
+    void setPrefetchCount(size_t count);
+    size_t getPrefetchCount() const { return prefetchCount_; }
+    void setByteBudget(size_t bytes);
+    size_t getByteBudget() const { return byteBudget_; }
+
+    /**
+     * Size of the RAM representations of the time steps that are tracked by the cache
+     */
+    size_t getResidentBytes() const { return residentBytes_; }
+
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    size_t step(size_t index, size_t distance, bool forward) const;
+    void touch(size_t index, bool loaded);
+    void prefetch(size_t index);
+    void evict(size_t index);
+    static size_t ramSize(const Volume& volume);
+
+    size_t prefetchCount_;
+    size_t byteBudget_;
+    ThreadPool* pool_;
+
+    std::shared_ptr<const VolumeSequence> sequence_;
+    std::optional<size_t> last_;
+    bool forward_ = true;
+
+    struct Entry {
+        std::list<size_t>::iterator pos;
+        bool loaded;  ///< The RAM representation was created by the cache and may be released
+    };
+
+    std::list<size_t> lru_;  ///< Tracked time steps, most recently used first
+    std::unordered_map<size_t, Entry> entries_;
+    std::unordered_map<size_t, std::future<void>> pending_;
+    size_t residentBytes_ = 0;
+    Stats stats_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_VOLUMESEQUENCECACHE_H
@@ -42,8 +42,13 @@
 #include <inviwo/core/properties/boolproperty.h>
 
 #include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace inviwo {
+
+class VolumeMinMaxHierarchy;
 /** \docpage{org.inviwo.SurfaceExtraction, Surface Extraction}
  * ![](org.inviwo.SurfaceExtraction.png?classIdentifier=org.inviwo.SurfaceExtraction)
  *
@@ -65,6 +70,7 @@ public:
     enum class Method {
         MarchingCubes,
         MarchingCubesOpt,
+        MarchingCubesParallel,
         MarchingTetrahedron,
     };
 
@@ -82,9 +88,22 @@ protected:
     void updateColors();
     vec4 getColor(size_t i) const;
 
+    /**
+     * Min/max hierarchy of one input volume for Marching Cubes Parallel. It is built lazily by
+     * the first job that needs it and is replaced whenever the corresponding inport data changes,
+     * so in place edits of the volume are picked up.
+     */
+    struct Hierarchy {
+        std::shared_ptr<const VolumeMinMaxHierarchy> get(const Volume& volume);
+
+        std::mutex mutex;
+        std::shared_ptr<const VolumeMinMaxHierarchy> hierarchy;
+    };
+
     DataInport<Volume, 0, true> volume_;
     DataOutport<std::vector<std::shared_ptr<Mesh>>> outport_;
     std::vector<std::shared_ptr<Mesh>> meshes_;
+    std::vector<std::shared_ptr<Hierarchy>> hierarchies_;
 
     TemplateOptionProperty<Method> method_;
     FloatProperty isoValue_;
@@ -34,6 +34,8 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <modules/base/datastructures/volumesequencecache.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
 
 namespace inviwo {
@@ -50,6 +52,10 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Streaming__ The next time steps in the play direction are loaded in the background, and
+ *     the least recently used ones are released from RAM when above the memory budget. A budget
+ *     of 0 disables the release, only set a budget if nothing else uses the RAM data of the
+ *     sequence, see VolumeSequenceCache.
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -59,6 +65,18 @@ public:
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+    virtual void process() override;
+
+private:
+    CompositeProperty streaming_;
+    IntSizeTProperty prefetchCount_;
+    IntSizeTProperty memoryBudget_;  ///! In MB
+    IntSizeTProperty hits_;
+    IntSizeTProperty misses_;
+    DoubleProperty averageLatency_;  ///! In ms
+
+    VolumeSequenceCache cache_;
 };
 
 }  // namespace inviwo
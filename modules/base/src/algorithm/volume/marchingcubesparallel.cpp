@@ -0,0 +1,399 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/marchingcubesparallel.h>
+#include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/base/algorithm/volume/surfaceextraction.h>
+#include <modules/base/algorithm/volume/volumeminmaxhierarchy.h>
+
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+constexpr uint32_t invalid = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Lookup tables for the marching::Config cube. The case index of a cell is composed from the
+ * iso tests of the four voxels on its left (x) and right (x + 1) faces, and every edge is
+ * identified by its lower end point and its axis.
+ */
+struct CaseTables {
+    struct Edge {
+        size3_t lower;
+        size_t axis;
+    };
+
+    explicit CaseTables(const marching::Config& cube) {
+        left.fill(0);
+        right.fill(0);
+        for (int v = 0; v < 8; ++v) {
+            const auto& corner = cube.vertices[v];
+            const auto faceBit = corner.y + 2 * corner.z;
+            for (size_t face = 0; face < 16; ++face) {
+                if ((face >> faceBit) & 1) (corner.x == 0 ? left : right)[face] |= 1 << v;
+            }
+        }
+        for (size_t e = 0; e < 12; ++e) {
+            const auto& a = cube.vertices[cube.edges[e][0]];
+            const auto& b = cube.vertices[cube.edges[e][1]];
+            edges[e] = Edge{glm::min(a, b), a.x != b.x ? size_t{0} : (a.y != b.y ? 1u : 2u)};
+        }
+    }
+
+    std::array<int, 16> left;
+    std::array<int, 16> right;
+    std::array<Edge, 12> edges;
+};
+
+/**
+ * Output of one chunk of blocks. Vertex ids in indices are local to the arena.
+ */
+struct Arena {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<uint32_t> indices;
+    // Vertices on the faces between blocks, as (global edge key, local vertex id)
+    std::vector<std::pair<size_t, uint32_t>> shared;
+    // Local vertex id to vertex id in the final mesh
+    std::vector<uint32_t> remap;
+};
+
+}  // namespace
+
+namespace util {
+
+std::shared_ptr<Mesh> marchingCubesParallel(std::shared_ptr<const Volume> volume, double iso,
+                                            const vec4& color, bool invert, bool enclose,
+                                            std::function<void(float)> progressCallback,
+                                            std::function<bool(const size3_t&)> maskingCallback) {
+    const VolumeMinMaxHierarchy hierarchy{*volume->getRepresentation<VolumeRAM>()};
+    return marchingCubesParallel(volume, hierarchy, iso, color, invert, enclose,
+                                 std::move(progressCallback), std::move(maskingCallback));
+}
+
+std::shared_ptr<Mesh> marchingCubesParallel(std::shared_ptr<const Volume> volume,
+                                            const VolumeMinMaxHierarchy& hierarchy, double iso,
+                                            const vec4& color, bool invert, bool enclose,
+                                            std::function<void(float)> progressCallback,
+                                            std::function<bool(const size3_t&)> maskingCallback) {
+    if (hierarchy.getVolumeDimensions() != volume->getDimensions()) {
+        throw Exception("The min/max hierarchy does not match the volume dimensions",
+                        IVW_CONTEXT_CUSTOM("util::marchingCubesParallel"));
+    }
+
+    auto indexBuffer = std::make_shared<IndexBuffer>();
+    auto vertexBuffer = std::make_shared<Buffer<vec3>>();
+    auto textureBuffer = std::make_shared<Buffer<vec3>>();
+    auto colorBuffer = std::make_shared<Buffer<vec4>>();
+    auto normalBuffer = std::make_shared<Buffer<vec3>>();
+
+    auto indexRAM = indexBuffer->getEditableRAMRepresentation();
+    auto& indices = indexRAM->getDataContainer();
+    auto& positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& textures = textureBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& colors = colorBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
+
+    if (progressCallback) progressCallback(0.0f);
+
+    const auto mc = [&](auto ram, auto isoTest, auto mapValue) {
+        using T = util::PrecisionValueType<decltype(ram)>;
+        static const marching::Config cube{};
+        static const CaseTables tables{cube};
+
+        const T* src = ram->getDataTyped();
+        const size3_t dim{volume->getDimensions()};
+        const size3_t dim1 = glm::max(dim, size3_t{1}) - size3_t{1};
+        const util::IndexMapper3D im(dim);
+        const util::IndexMapper3D bim(hierarchy.getBlockDimensions());
+
+        const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+        const auto doffs = [&]() {
+            std::array<dvec3, 8> tmp;
+            std::transform(cube.vertices.begin(), cube.vertices.end(), tmp.begin(),
+                           [dr](auto& v) { return dr * dvec3{v}; });
+            return tmp;
+        }();
+
+        // Accumulate the cell positions the same way as marchingCubesOpt to get identical vertices
+        const auto cellPos = [&]() {
+            std::array<std::vector<double>, 3> tmp;
+            for (size_t k = 0; k < 3; ++k) {
+                double p = 0.0;
+                for (size_t i = 0; i < dim1[k]; ++i, p += dr[k]) tmp[k].push_back(p);
+            }
+            return tmp;
+        }();
+
+        const auto interpolate = [src, im, &mapValue, &doffs](const size3_t& ind, const dvec3& pos,
+                                                              marching::Config::EdgeId e) {
+            const auto a = cube.edges[e][0];
+            const auto b = cube.edges[e][1];
+            const auto v0 = mapValue(src[im(ind + cube.vertices[a])]);
+            const auto v1 = mapValue(src[im(ind + cube.vertices[b])]);
+
+            const auto t = v0 / (v0 - v1);
+            const auto r0 = pos + doffs[a];
+            const auto r1 = pos + doffs[b];
+            return r0 + t * (r1 - r0);
+        };
+
+        const float err =
+            static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
+
+        // The iso tests are done in the value type of the volume, the block ranges have to be
+        // compared against the same value to not miss any block.
+        const auto blockIso = util::glm_convert<double>(util::glm_convert<T>(iso));
+        const auto blocks = hierarchy.findBlocksContaining(blockIso);
+
+        // A vertex on a block face can also be created by the neighboring block
+        const auto onBlockFace = [&](const size3_t& lower, size_t axis, const size3_t& begin,
+                                     const size3_t& end) {
+            for (size_t k = 0; k < 3; ++k) {
+                if (k == axis) continue;
+                if ((lower[k] == begin[k] && begin[k] > 0) ||
+                    (lower[k] == end[k] && end[k] < dim1[k])) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        const auto processBlock = [&](size_t blockIndex, Arena& arena,
+                                      std::vector<uint32_t>& edgeCache) {
+            const auto [begin, end] = hierarchy.getCellRange(bim(blockIndex));
+            const util::IndexMapper3D lim(end - begin + size3_t{1});
+            edgeCache.assign(3 * glm::compMul(end - begin + size3_t{1}), invalid);
+
+            std::array<uint32_t, 12> inds{};
+            size3_t ind;
+            for (ind.z = begin.z; ind.z < end.z; ++ind.z) {
+                for (ind.y = begin.y; ind.y < end.y; ++ind.y) {
+                    const std::array<size_t, 4> rows{
+                        im(0, ind.y, ind.z), im(0, ind.y + 1, ind.z), im(0, ind.y, ind.z + 1),
+                        im(0, ind.y + 1, ind.z + 1)};
+                    const auto face = [&](size_t x) {
+                        int res = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            if (isoTest(src[rows[i] + x])) res |= 1 << i;
+                        }
+                        return res;
+                    };
+
+                    int right = face(begin.x);
+                    for (ind.x = begin.x; ind.x < end.x; ++ind.x) {
+                        const int left = right;
+                        right = face(ind.x + 1);
+                        const auto index = tables.left[left] | tables.right[right];
+                        if (index == 0 || index == 255) continue;
+                        if (maskingCallback && !maskingCallback(ind)) continue;
+
+                        const dvec3 pos{cellPos[0][ind.x], cellPos[1][ind.y], cellPos[2][ind.z]};
+                        for (const auto edge : cube.caseEdges[index]) {
+                            const auto lower = ind + tables.edges[edge].lower;
+                            const auto axis = tables.edges[edge].axis;
+                            auto& cached = edgeCache[3 * lim(lower - begin) + axis];
+                            if (cached == invalid) {
+                                cached = static_cast<uint32_t>(arena.positions.size());
+                                arena.positions.emplace_back(interpolate(ind, pos, edge));
+                                arena.normals.emplace_back(0.0f, 0.0f, 0.0f);
+                                if (onBlockFace(lower, axis, begin, end)) {
+                                    arena.shared.emplace_back(3 * im(lower) + axis, cached);
+                                }
+                            }
+                            inds[edge] = cached;
+                        }
+                        for (const auto& tri : cube.caseTriangles[index]) {
+                            const auto& p0 = arena.positions[inds[tri[0]]];
+                            const auto side0 = arena.positions[inds[tri[1]]] - p0;
+                            const auto side1 = arena.positions[inds[tri[2]]] - p0;
+                            auto n = glm::cross(side0, side1);
+                            if (glm::length2(n) < err) {
+                                continue;  // triangle is so small area is 0.
+                            }
+                            n = glm::normalize(n);
+                            for (int v = 0; v < 3; ++v) {
+                                arena.indices.push_back(inds[tri[v]]);
+                                arena.normals[inds[tri[v]]] += n;
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        // Split the active blocks into consecutive chunks, each with its own output arena. The
+        // chunking does not depend on the number of threads, which keeps the output deterministic.
+        const size_t blocksPerChunk = std::max(size_t{1}, blocks.size() / 64);
+        const size_t nChunks = (blocks.size() + blocksPerChunk - 1) / blocksPerChunk;
+        std::vector<Arena> arenas(nChunks);
+
+        std::atomic<size_t> processed{0};
+        std::mutex progressMutex;
+        util::parallelFor(
+            size_t{0}, nChunks,
+            [&](size_t chunk) {
+                std::vector<uint32_t> edgeCache;
+                const auto first = chunk * blocksPerChunk;
+                const auto last = std::min(blocks.size(), first + blocksPerChunk);
+                for (auto i = first; i < last; ++i) {
+                    processBlock(blocks[i], arenas[chunk], edgeCache);
+                    const auto done = ++processed;
+                    if (progressCallback) {
+                        std::unique_lock<std::mutex> lock{progressMutex, std::try_to_lock};
+                        if (lock) {
+                            progressCallback(0.9f * static_cast<float>(done) /
+                                             static_cast<float>(blocks.size()));
+                        }
+                    }
+                }
+            },
+            1);
+
+        // Weld the vertices on the block faces, the first vertex created for an edge is kept
+        struct VertexRef {
+            size_t chunk;
+            uint32_t vertex;
+        };
+        std::unordered_map<size_t, VertexRef> welded;
+        std::vector<std::pair<VertexRef, VertexRef>> duplicates;
+        std::vector<size_t> vertexOffsets(nChunks + 1, 0);
+        std::vector<size_t> indexOffsets(nChunks + 1, 0);
+        for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+            auto& arena = arenas[chunk];
+            arena.remap.assign(arena.positions.size(), 0);
+            size_t unique = arena.positions.size();
+            for (const auto& [key, vertex] : arena.shared) {
+                const auto [it, inserted] = welded.try_emplace(key, VertexRef{chunk, vertex});
+                if (!inserted) {
+                    arena.remap[vertex] = invalid;
+                    duplicates.emplace_back(VertexRef{chunk, vertex}, it->second);
+                    --unique;
+                }
+            }
+            vertexOffsets[chunk + 1] = vertexOffsets[chunk] + unique;
+            indexOffsets[chunk + 1] = indexOffsets[chunk] + arena.indices.size();
+        }
+
+        positions.resize(vertexOffsets.back());
+        normals.resize(vertexOffsets.back());
+        indices.resize(indexOffsets.back());
+
+        util::parallelFor(
+            size_t{0}, nChunks,
+            [&](size_t chunk) {
+                auto& arena = arenas[chunk];
+                auto id = static_cast<uint32_t>(vertexOffsets[chunk]);
+                for (size_t v = 0; v < arena.positions.size(); ++v) {
+                    if (arena.remap[v] == invalid) continue;
+                    arena.remap[v] = id;
+                    positions[id] = arena.positions[v];
+                    normals[id] = arena.normals[v];
+                    ++id;
+                }
+            },
+            1);
+
+        for (const auto& [duplicate, original] : duplicates) {
+            const auto id = arenas[original.chunk].remap[original.vertex];
+            arenas[duplicate.chunk].remap[duplicate.vertex] = id;
+            normals[id] += arenas[duplicate.chunk].normals[duplicate.vertex];
+        }
+
+        util::parallelFor(
+            size_t{0}, nChunks,
+            [&](size_t chunk) {
+                const auto& arena = arenas[chunk];
+                std::transform(arena.indices.begin(), arena.indices.end(),
+                               indices.begin() + indexOffsets[chunk],
+                               [&](uint32_t i) { return arena.remap[i]; });
+            },
+            1);
+
+        if (progressCallback) progressCallback(0.95f);
+
+        if (enclose) {
+            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
+                                    dr.z);
+        }
+    };
+    if (invert) {
+        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+            [&](auto ram) {
+                using ValueType = util::PrecisionValueType<decltype(ram)>;
+                mc(ram,
+                   [tiso = util::glm_convert<ValueType>(iso)](auto&& val) { return val > tiso; },
+                   [iso](auto&& val) { return util::glm_convert<double>(val) - iso; });
+            });
+    } else {
+        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+            [&](auto ram) {
+                using ValueType = util::PrecisionValueType<decltype(ram)>;
+                mc(ram,
+                   [tiso = util::glm_convert<ValueType>(iso)](auto&& val) { return val < tiso; },
+                   [iso](auto&& val) { return -(util::glm_convert<double>(val) - iso); });
+            });
+    }
+
+    ivwAssert(positions.size() == normals.size(), "positions and normals must be equal size");
+
+    std::transform(normals.begin(), normals.end(), normals.begin(),
+                   [](const vec3& n) { return glm::normalize(n); });
+    textures.insert(textures.begin(), positions.begin(), positions.end());
+    colors.reserve(positions.size());
+    std::fill_n(std::back_inserter(colors), positions.size(), color);
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setModelMatrix(volume->getModelMatrix());
+    mesh->setWorldMatrix(volume->getWorldMatrix());
+    mesh->addIndices({DrawType::Triangles, ConnectivityType::None}, indexBuffer);
+    mesh->addBuffer(BufferType::PositionAttrib, vertexBuffer);
+    mesh->addBuffer(BufferType::TexcoordAttrib, textureBuffer);
+    mesh->addBuffer(BufferType::ColorAttrib, colorBuffer);
+    mesh->addBuffer(BufferType::NormalAttrib, normalBuffer);
+
+    if (progressCallback) progressCallback(1.0f);
+
+    return mesh;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
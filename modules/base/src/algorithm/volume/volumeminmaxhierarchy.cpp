@@ -0,0 +1,174 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeminmaxhierarchy.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+size3_t coarserDims(const size3_t& dims) { return (dims + size3_t{1}) / size_t{2}; }
+
+template <typename T>
+double toDouble(T value, double direction) {
+    const auto res = util::glm_convert<double>(value);
+    // 64 bit integers do not fit in a double, widen the range to stay conservative
+    if constexpr (std::is_integral<T>::value && sizeof(T) == 8) {
+        return std::nextafter(res, direction);
+    } else {
+        return res;
+    }
+}
+
+}  // namespace
+
+VolumeMinMaxHierarchy::VolumeMinMaxHierarchy(const VolumeRAM& volume)
+    : volumeDims_{volume.getDimensions()} {
+
+    const size3_t cells{glm::max(volumeDims_, size3_t{1}) - size3_t{1}};
+    Level level0{(cells + size3_t{blockSize - 1}) / blockSize, {}};
+    level0.ranges.resize(glm::compMul(level0.dims));
+
+    volume.dispatch<void, dispatching::filter::Scalars>([&](auto ram) {
+        using T = util::PrecisionValueType<decltype(ram)>;
+        const T* src = ram->getDataTyped();
+        const util::IndexMapper3D im(volumeDims_);
+        const util::IndexMapper3D bim(level0.dims);
+
+        util::parallelFor(size_t{0}, level0.ranges.size(), [&](size_t blockIndex) {
+            const auto block = bim(blockIndex);
+            const auto [begin, end] = getCellRange(block);
+
+            T minVal = src[im(begin)];
+            T maxVal = minVal;
+            bool hasNaN = false;
+            for (size_t z = begin.z; z <= end.z; ++z) {
+                for (size_t y = begin.y; y <= end.y; ++y) {
+                    const auto offset = im(size3_t{0, y, z});
+                    for (size_t x = begin.x; x <= end.x; ++x) {
+                        const auto val = src[offset + x];
+                        if (val < minVal) minVal = val;
+                        if (maxVal < val) maxVal = val;
+                        if constexpr (util::is_floating_point<T>::value) {
+                            hasNaN |= !(val == val);
+                        }
+                    }
+                }
+            }
+            if (hasNaN) {
+                level0.ranges[blockIndex] = dvec2{-std::numeric_limits<double>::infinity(),
+                                                  std::numeric_limits<double>::infinity()};
+            } else {
+                level0.ranges[blockIndex] =
+                    dvec2{toDouble(minVal, std::numeric_limits<double>::lowest()),
+                          toDouble(maxVal, std::numeric_limits<double>::max())};
+            }
+        });
+    });
+    levels_.push_back(std::move(level0));
+
+    while (glm::compMax(levels_.back().dims) > 1) {
+        const auto& fine = levels_.back();
+        Level coarse{coarserDims(fine.dims), {}};
+        coarse.ranges.resize(glm::compMul(coarse.dims),
+                             dvec2{std::numeric_limits<double>::max(),
+                                   std::numeric_limits<double>::lowest()});
+        const util::IndexMapper3D fim(fine.dims);
+        const util::IndexMapper3D cim(coarse.dims);
+        for (size_t i = 0; i < fine.ranges.size(); ++i) {
+            auto& range = coarse.ranges[cim(fim(i) / size_t{2})];
+            range.x = std::min(range.x, fine.ranges[i].x);
+            range.y = std::max(range.y, fine.ranges[i].y);
+        }
+        levels_.push_back(std::move(coarse));
+    }
+}
+
+dvec2 VolumeMinMaxHierarchy::getRange(const size3_t& block, size_t level) const {
+    const auto& l = levels_[level];
+    return l.ranges[util::IndexMapper3D(l.dims)(block)];
+}
+
+std::pair<size3_t, size3_t> VolumeMinMaxHierarchy::getCellRange(const size3_t& block) const {
+    const size3_t cells{glm::max(volumeDims_, size3_t{1}) - size3_t{1}};
+    const size3_t begin{block * blockSize};
+    return {begin, glm::min(begin + size3_t{blockSize}, cells)};
+}
+
+std::vector<size_t> VolumeMinMaxHierarchy::findBlocksContaining(double value) const {
+    if (levels_.front().ranges.empty()) return {};
+
+    const auto contains = [value](const dvec2& range) {
+        return range.x <= value && value <= range.y;
+    };
+
+    // Descend from the coarsest level, only refining blocks that contain the value
+    std::vector<size3_t> blocks;
+    std::vector<size3_t> next;
+    const auto& top = levels_.back();
+    const util::IndexMapper3D tim(top.dims);
+    for (size_t i = 0; i < top.ranges.size(); ++i) {
+        if (contains(top.ranges[i])) blocks.push_back(tim(i));
+    }
+    for (size_t level = levels_.size() - 1; level > 0; --level) {
+        const auto& fine = levels_[level - 1];
+        const util::IndexMapper3D fim(fine.dims);
+        next.clear();
+        for (const auto& block : blocks) {
+            const size3_t begin{block * size_t{2}};
+            const size3_t end{glm::min(begin + size3_t{2}, fine.dims)};
+            for (size_t z = begin.z; z < end.z; ++z) {
+                for (size_t y = begin.y; y < end.y; ++y) {
+                    for (size_t x = begin.x; x < end.x; ++x) {
+                        if (contains(fine.ranges[fim(x, y, z)])) next.emplace_back(x, y, z);
+                    }
+                }
+            }
+        }
+        std::swap(blocks, next);
+    }
+
+    const util::IndexMapper3D bim(levels_.front().dims);
+    std::vector<size_t> result;
+    result.reserve(blocks.size());
+    for (const auto& block : blocks) result.push_back(bim(block));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,199 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/volumesequencecache.h>
+
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/threadpool.h>
+
+namespace inviwo {
+
+std::chrono::nanoseconds VolumeSequenceCache::Stats::averageLatency() const {
+    const auto requests = static_cast<std::chrono::nanoseconds::rep>(hits + misses);
+    return requests == 0 ? std::chrono::nanoseconds{0} : totalLatency / requests;
+}
+
+VolumeSequenceCache::VolumeSequenceCache(size_t prefetchCount, size_t byteBudget,
+                                         ThreadPool* pool)
+    : prefetchCount_{prefetchCount}, byteBudget_{byteBudget}, pool_{pool} {}
+
+void VolumeSequenceCache::setSequence(std::shared_ptr<const VolumeSequence> sequence) {
+    if (sequence == sequence_) return;
+    // Running prefetch tasks keep their volume alive, no need to wait for them
+    pending_.clear();
+    lru_.clear();
+    entries_.clear();
+    residentBytes_ = 0;
+    last_ = std::nullopt;
+    forward_ = true;
+    sequence_ = std::move(sequence);
+}
+
+std::shared_ptr<Volume> VolumeSequenceCache::get(size_t index) {
+    if (!sequence_ || index >= sequence_->size()) {
+        throw RangeException("Time step " + toString(index) + " is outside of the sequence",
+                             IVW_CONTEXT);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto& volume = (*sequence_)[index];
+    bool loaded = true;
+    if (auto it = pending_.find(index); it != pending_.end()) {
+        auto future = std::move(it->second);
+        pending_.erase(it);
+        const bool ready = future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        ++(ready ? stats_.hits : stats_.misses);
+        future.get();
+    } else if (volume->hasRepresentation<VolumeRAM>()) {
+        ++stats_.hits;
+        loaded = false;
+    } else {
+        ++stats_.misses;
+        volume->getRepresentation<VolumeRAM>();
+    }
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    stats_.totalLatency += latency;
+    stats_.maxLatency = std::max(stats_.maxLatency, latency);
+
+    if (last_ && *last_ != index) {
+        // Take the shorter way around the sequence, so looping playback keeps its direction
+        const auto size = sequence_->size();
+        const auto ahead = (index + size - *last_) % size;
+        forward_ = ahead <= size / 2;
+    }
+    last_ = index;
+
+    touch(index, loaded);
+    for (size_t i = 1; i <= prefetchCount_; ++i) {
+        prefetch(step(index, i, forward_));
+    }
+    evict(index);
+
+    return volume;
+}
+
+void VolumeSequenceCache::setPrefetchCount(size_t count) { prefetchCount_ = count; }
+
+void VolumeSequenceCache::setByteBudget(size_t bytes) {
+    byteBudget_ = bytes;
+    if (last_) evict(*last_);
+}
+
+size_t VolumeSequenceCache::step(size_t index, size_t distance, bool forward) const {
+    const auto size = sequence_->size();
+    distance %= size;
+    return forward ? (index + distance) % size : (index + size - distance) % size;
+}
+
+void VolumeSequenceCache::touch(size_t index, bool loaded) {
+    if (auto it = entries_.find(index); it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.pos);
+        it->second.loaded |= loaded;
+    } else {
+        lru_.push_front(index);
+        entries_[index] = Entry{lru_.begin(), loaded};
+        residentBytes_ += ramSize(*(*sequence_)[index]);
+    }
+}
+
+void VolumeSequenceCache::prefetch(size_t index) {
+    if (pending_.count(index) != 0) return;
+    const auto& volume = (*sequence_)[index];
+    // Converting from other representations, like the GL one, can not be done on a pool thread
+    if (volume->hasRepresentation<VolumeRAM>() || !volume->hasRepresentation<VolumeDisk>()) {
+        return;
+    }
+
+    ++stats_.prefetches;
+    auto load = [volume]() { volume->getRepresentation<VolumeRAM>(); };
+    if (pool_) {
+        pending_[index] = pool_->enqueue(std::move(load));
+    } else {
+        std::promise<void> promise;
+        try {
+            load();
+            promise.set_value();
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        pending_[index] = promise.get_future();
+    }
+    // Prefetched steps are the next ones to be used, keep them ahead of older steps
+    touch(index, true);
+}
+
+void VolumeSequenceCache::evict(size_t index) {
+    auto inWindow = [&](size_t i) {
+        if (i == index) return true;
+        for (size_t d = 1; d <= prefetchCount_; ++d) {
+            if (i == step(index, d, forward_)) return true;
+        }
+        return false;
+    };
+
+    // Forget finished prefetches that were skipped, any errors are reported when they are used
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (!inWindow(it->first) &&
+            it->second.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (byteBudget_ == 0) return;
+    for (auto it = lru_.end(); it != lru_.begin() && residentBytes_ > byteBudget_;) {
+        --it;
+        const auto i = *it;
+        const auto& volume = (*sequence_)[i];
+        // Representations we did not create, and volumes used elsewhere, for example by an
+        // outport, might still be in use
+        if (!entries_[i].loaded || inWindow(i) || pending_.count(i) != 0 ||
+            volume.use_count() > 1) {
+            continue;
+        }
+
+        const bool loaded = volume->hasRepresentation<VolumeRAM>();
+        if (loaded && !volume->releaseRepresentation<VolumeRAM, VolumeDisk>()) continue;
+        if (loaded) ++stats_.evictions;
+
+        residentBytes_ -= ramSize(*volume);
+        entries_.erase(i);
+        it = lru_.erase(it);
+    }
+}
+
+size_t VolumeSequenceCache::ramSize(const Volume& volume) {
+    return glm::compMul(volume.getDimensions()) * volume.getDataFormat()->getSize();
+}
+
+}  // namespace inviwo
@@ -33,9 +33,12 @@
 #include <modules/base/algorithm/volume/marchingtetrahedron.h>
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/base/algorithm/volume/marchingcubesparallel.h>
+#include <modules/base/algorithm/volume/volumeminmaxhierarchy.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/zip.h>
 #include <numeric>
@@ -61,7 +64,8 @@ SurfaceExtraction::SurfaceExtraction()
     , method_("method", "Method",
               {{"marchingtetrahedron", "Marching Tetrahedron", Method::MarchingTetrahedron},
                {"marchingcubes", "Marching Cubes", Method::MarchingCubes},
-               {"marchingCubesOpt", "Marching Cubes Optimized", Method::MarchingCubesOpt}},
+               {"marchingCubesOpt", "Marching Cubes Optimized", Method::MarchingCubesOpt},
+               {"marchingCubesParallel", "Marching Cubes Parallel", Method::MarchingCubesParallel}},
               2)
     , isoValue_("iso", "ISO Value", 0.5f, 0.0f, 1.0f, 0.01f)
     , invertIso_("invert", "Invert ISO", false)
@@ -97,11 +101,21 @@ SurfaceExtraction::SurfaceExtraction()
 
 SurfaceExtraction::~SurfaceExtraction() = default;
 
+std::shared_ptr<const VolumeMinMaxHierarchy> SurfaceExtraction::Hierarchy::get(
+    const Volume& volume) {
+    std::scoped_lock lock{mutex};
+    if (!hierarchy) {
+        hierarchy =
+            std::make_shared<VolumeMinMaxHierarchy>(*volume.getRepresentation<VolumeRAM>());
+    }
+    return hierarchy;
+}
+
 void SurfaceExtraction::process() {
 
-    const auto computeSurface = [this](vec4 color, std::shared_ptr<const Volume> vol) {
-        return [vol, color, method = method_.get(), iso = isoValue_.get(),
-                invert = invertIso_.get(),
+    const auto computeSurface = [this](size_t i, vec4 color, std::shared_ptr<const Volume> vol) {
+        return [vol, color, hierarchy = hierarchies_[i], method = method_.get(),
+                iso = isoValue_.get(), invert = invertIso_.get(),
                 enclose = encloseSurface_.get()](pool::Progress progress) -> std::shared_ptr<Mesh> {
             RenderContext::getPtr()->activateLocalRenderContext();
 
@@ -110,6 +124,9 @@ void SurfaceExtraction::process() {
                     return util::marchingcubes(vol, iso, color, invert, enclose, progress);
                 case Method::MarchingCubesOpt:
                     return util::marchingCubesOpt(vol, iso, color, invert, enclose, progress);
+                case Method::MarchingCubesParallel:
+                    return util::marchingCubesParallel(vol, *hierarchy->get(*vol), iso, color,
+                                                       invert, enclose, progress);
                 case Method::MarchingTetrahedron:
                 default:
                     return util::marchingtetrahedron(vol, iso, color, invert, enclose, progress);
@@ -154,10 +171,17 @@ void SurfaceExtraction::process() {
     const bool stateChange = method_.isModified() || isoValue_.isModified() ||
                              invertIso_.isModified() || encloseSurface_.isModified();
 
+    // Drop the hierarchies of all changed volumes, the data might have been modified in place
+    if (size != hierarchies_.size()) hierarchies_.clear();
+    hierarchies_.resize(size);
+    for (auto [i, item] : util::enumerate(volume_.changedAndData())) {
+        if (item.first || !hierarchies_[i]) hierarchies_[i] = std::make_shared<Hierarchy>();
+    }
+
     if (stateChange || size != meshes_.size()) {  // Need to recompute all...
-        std::vector<decltype(computeSurface(vec4{}, std::shared_ptr<const Volume>{}))> jobs;
+        std::vector<decltype(computeSurface(0, vec4{}, std::shared_ptr<const Volume>{}))> jobs;
         for (auto [i, vol] : util::enumerate(volume_)) {
-            jobs.push_back(computeSurface(getColor(i), vol));
+            jobs.push_back(computeSurface(i, getColor(i), vol));
         }
         dispatchMany(jobs, [this](std::vector<std::shared_ptr<Mesh>> result) {
             meshes_ = result;
@@ -172,7 +196,7 @@ void SurfaceExtraction::process() {
             const auto data = item.second;
 
             if (portChanged) {
-                jobs.push_back(computeSurface(getColor(i), data));
+                jobs.push_back(computeSurface(i, getColor(i), data));
                 inds.push_back(i);
             } else if (colors_[i]->isModified()) {
                 jobs.push_back(changeColor(getColor(i), meshes_[i]));
@@ -39,6 +39,8 @@ const ProcessorInfo VolumeDivergenceCPUProcessor::processorInfo_{
     "Volume Operation",                         // Category
     CodeState::Stable,                          // Code state
     Tags::CPU,                                  // Tags
+    true,                                       // Visible
+    true,                                       // Thread safe
 };
 const ProcessorInfo VolumeDivergenceCPUProcessor::getProcessorInfo() const {
     return processorInfo_;
@@ -39,6 +39,8 @@ const ProcessorInfo VolumeGradientCPUProcessor::processorInfo_{
     "Volume Operation",                       // Category
     CodeState::Experimental,                  // Code state
     Tags::CPU,                                // Tags
+    true,                                     // Visible
+    true,                                     // Thread safe
 };
 const ProcessorInfo VolumeGradientCPUProcessor::getProcessorInfo() const { return processorInfo_; }
 
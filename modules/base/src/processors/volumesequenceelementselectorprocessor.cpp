@@ -42,9 +42,53 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() c
     return processorInfo_;
 }
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , streaming_("streaming", "Streaming")
+    , prefetchCount_("prefetchCount", "Prefetch Time Steps", 2, 0, 32)
+    , memoryBudget_("memoryBudget", "Memory Budget (MB)", 0, 0, 1024 * 1024, 64)
+    , hits_("hits", "Cache Hits", 0, 0, std::numeric_limits<size_t>::max(), 1,
+            InvalidationLevel::Valid, PropertySemantics::Text)
+    , misses_("misses", "Cache Misses", 0, 0, std::numeric_limits<size_t>::max(), 1,
+              InvalidationLevel::Valid, PropertySemantics::Text)
+    , averageLatency_("averageLatency", "Average Latency (ms)", 0.0, 0.0,
+                      std::numeric_limits<double>::max(), 0.001, InvalidationLevel::Valid,
+                      PropertySemantics::Text) {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    addProperty(streaming_);
+    streaming_.addProperties(prefetchCount_, memoryBudget_, hits_, misses_, averageLatency_);
+    streaming_.setCollapsed(true);
+    for (auto prop : std::initializer_list<Property*>{&hits_, &misses_, &averageLatency_}) {
+        prop->setReadOnly(true);
+        prop->setSerializationMode(PropertySerializationMode::None);
+    }
+
+    prefetchCount_.onChange([this]() { cache_.setPrefetchCount(prefetchCount_); });
+    memoryBudget_.onChange([this]() { cache_.setByteBudget(memoryBudget_.get() << 20); });
+    cache_.setPrefetchCount(prefetchCount_);
+    cache_.setByteBudget(memoryBudget_.get() << 20);
+}
+
+void VolumeSequenceElementSelectorProcessor::process() {
+    if (!inport_.isReady()) return;
+
+    auto data = inport_.getData();
+    if (!data || data->empty()) {
+        outport_.detachData();
+        return;
+    }
+    cache_.setSequence(data);
+
+    const size_t index =
+        std::min(data->size() - 1, static_cast<size_t>(timeStep_.index_.get() - 1));
+    outport_.setData(cache_.get(index));
+
+    const auto& stats = cache_.getStats();
+    hits_.set(stats.hits);
+    misses_.set(stats.misses);
+    averageLatency_.set(
+        std::chrono::duration<double, std::milli>(stats.averageLatency()).count());
 }
 
 }  // namespace inviwo
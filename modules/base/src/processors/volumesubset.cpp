@@ -40,6 +40,8 @@ const ProcessorInfo VolumeSubset::processorInfo_{
     "Volume Operation",         // Category
     CodeState::Stable,          // Code state
     Tags::CPU,                  // Tags
+    true,                       // Visible
+    true,                       // Thread safe
 };
 const ProcessorInfo VolumeSubset::getProcessorInfo() const { return processorInfo_; }
 
@@ -32,10 +32,13 @@
 #endif
 
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/logcentral.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/base/algorithm/volume/marchingcubesparallel.h>
 
 #include <benchmark/benchmark.h>
 
@@ -130,11 +133,79 @@ static void MiniNew(benchmark::State& state) {
     state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
 }
 
+static void SphereParallel(benchmark::State& state) {
+    auto v = std::shared_ptr<Volume>(
+        util::makeSphericalVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
+static void RippleParallel(benchmark::State& state) {
+    auto v = std::shared_ptr<Volume>(
+        util::makeRippleVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
+// A few small blobs in an otherwise empty volume, like a typical segmentation
+static std::shared_ptr<Volume> makeSparseVolume(size_t size) {
+    const std::array<dvec3, 3> centers{dvec3{0.2, 0.3, 0.5}, dvec3{0.7, 0.6, 0.3},
+                                       dvec3{0.5, 0.8, 0.8}};
+    return util::generateVolume(size3_t{size}, mat3(1.0), [&](const size3_t& ind) {
+        const auto pos = dvec3{ind} / static_cast<double>(size);
+        for (const auto& c : centers) {
+            if (glm::distance(pos, c) < 0.08) return uint8_t{255};
+        }
+        return uint8_t{0};
+    });
+}
+
+static void SparseOpt(benchmark::State& state) {
+    auto v = makeSparseVolume(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesOpt(v, 128.0, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
+static void SparseParallel(benchmark::State& state) {
+    auto v = makeSparseVolume(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesParallel(v, 128.0, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
 BENCHMARK(SphereOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
+BENCHMARK(SphereParallel)->RangeMultiplier(2)->Range(8, 8 << 6);
 
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
 BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
+BENCHMARK(RippleParallel)->RangeMultiplier(2)->Range(8, 8 << 5);
+
+BENCHMARK(SparseOpt)->RangeMultiplier(2)->Range(64, 512);
+BENCHMARK(SparseParallel)->RangeMultiplier(2)->Range(64, 512);
 
 // BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
@@ -147,6 +218,11 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 int main(int argc, char** argv) {
 
     benchmark::Initialize(&argc, argv);
+
+    // The application provides the thread pool used by the parallel algorithms
+    LogCentral::init();
+    InviwoApplication app("Inviwo-Benchmarks-Base");
+
     benchmark::RunSpecifiedBenchmarks();
 
     return 0;
@@ -0,0 +1,156 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/kdtree.h>
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+constexpr size_t numQueries = 1000;
+
+}  // namespace
+
+static void KDTreeBuildOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        K3DTree<size_t, float> tree;
+        for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void KDTreeBuildFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        FlatKDTree<3, float> tree{points};
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void KDTreeKNNOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(numQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            benchmark::DoNotOptimize(tree.findNNearest(q, static_cast<int>(state.range(1))));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+static void KDTreeKNNFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(numQueries, 1);
+    FlatKDTree<3, float> tree{points};
+
+    const auto k = static_cast<size_t>(state.range(1));
+    std::vector<size_t> indices(k);
+    std::vector<float> sqDists(k);
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            benchmark::DoNotOptimize(tree.findNNearest(q, indices, sqDists));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+static void KDTreeKNNFlatBatched(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(numQueries, 1);
+    FlatKDTree<3, float> tree{points};
+
+    const auto k = static_cast<size_t>(state.range(1));
+    std::vector<size_t> indices(k * numQueries);
+    std::vector<float> sqDists(k * numQueries);
+    for (auto _ : state) {
+        tree.findNNearest(queries, k, indices, sqDists);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+static void KDTreeRadiusOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(numQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) benchmark::DoNotOptimize(tree.findCloseTo(q, 0.02f));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+static void KDTreeRadiusFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(numQueries, 1);
+    FlatKDTree<3, float> tree{points};
+
+    std::vector<size_t> indices;
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            benchmark::DoNotOptimize(tree.findWithinRadius(q, 0.02f, indices));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+BENCHMARK(KDTreeBuildOld)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(KDTreeBuildFlat)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(KDTreeKNNOld)->Ranges({{1000, 1000000}, {1, 16}});
+BENCHMARK(KDTreeKNNFlat)->Ranges({{1000, 1000000}, {1, 16}});
+BENCHMARK(KDTreeKNNFlatBatched)->Ranges({{1000, 1000000}, {1, 16}});
+
+BENCHMARK(KDTreeRadiusOld)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(KDTreeRadiusFlat)->RangeMultiplier(10)->Range(1000, 1000000);
+
+#include <warn/pop>
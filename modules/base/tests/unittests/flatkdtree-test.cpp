@@ -0,0 +1,173 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, std::mt19937& gen) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+std::vector<std::pair<float, size_t>> bruteForce(const std::vector<vec3>& points, vec3 pos) {
+    std::vector<std::pair<float, size_t>> res;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto d = points[i] - pos;
+        res.emplace_back(glm::dot(d, d), i);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+}  // namespace
+
+TEST(FlatKDTreeTests, empty) {
+    FlatKDTree<3, float> tree{std::vector<vec3>{}};
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.findNearest(vec3{0.0f}), FlatKDTree<3, float>::npos);
+
+    std::vector<size_t> indices(3);
+    std::vector<float> sqDists(3);
+    EXPECT_EQ(tree.findNNearest(vec3{0.0f}, indices, sqDists), size_t{0});
+    EXPECT_EQ(indices[0], FlatKDTree<3, float>::npos);
+
+    std::vector<size_t> within{1, 2, 3};
+    EXPECT_EQ(tree.findWithinRadius(vec3{0.0f}, 1.0f, within), size_t{0});
+    EXPECT_TRUE(within.empty());
+}
+
+TEST(FlatKDTreeTests, nearestMatchesBruteForce) {
+    std::mt19937 gen(0);
+    const auto points = randomPoints(5000, gen);
+    FlatKDTree<3, float> tree{points};
+    EXPECT_EQ(tree.size(), points.size());
+
+    const size_t k = 10;
+    std::vector<size_t> indices(k);
+    std::vector<float> sqDists(k);
+    for (const auto& query : randomPoints(100, gen)) {
+        const auto expected = bruteForce(points, query);
+        EXPECT_EQ(tree.findNearest(query), expected[0].second);
+        ASSERT_EQ(tree.findNNearest(query, indices, sqDists), k);
+        for (size_t i = 0; i < k; ++i) {
+            EXPECT_EQ(sqDists[i], expected[i].first);
+            const auto d = points[indices[i]] - query;
+            EXPECT_EQ(glm::dot(d, d), sqDists[i]);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, fewerPointsThanRequested) {
+    std::mt19937 gen(1);
+    const auto points = randomPoints(5, gen);
+    FlatKDTree<3, float> tree{points};
+
+    std::vector<size_t> indices(8);
+    std::vector<float> sqDists(8);
+    EXPECT_EQ(tree.findNNearest(vec3{0.5f}, indices, sqDists), size_t{5});
+    EXPECT_EQ(indices[5], FlatKDTree<3, float>::npos);
+    EXPECT_EQ(sqDists[7], std::numeric_limits<float>::infinity());
+}
+
+TEST(FlatKDTreeTests, duplicatePoints) {
+    std::vector<vec3> points(100, vec3{1.0f, 2.0f, 3.0f});
+    points.push_back(vec3{0.0f});
+    FlatKDTree<3, float> tree{points};
+
+    EXPECT_EQ(tree.findNearest(vec3{0.1f}), size_t{100});
+    std::vector<size_t> within;
+    EXPECT_EQ(tree.findWithinRadius(vec3{1.0f, 2.0f, 3.0f}, 0.5f, within), size_t{100});
+}
+
+TEST(FlatKDTreeTests, withinRadiusMatchesBruteForce) {
+    std::mt19937 gen(2);
+    const auto points = randomPoints(5000, gen);
+    FlatKDTree<3, float> tree{points};
+
+    std::vector<size_t> within;
+    for (const auto& query : randomPoints(50, gen)) {
+        const float radius = 0.1f;
+        std::vector<size_t> expected;
+        for (auto& [sqDist, i] : bruteForce(points, query)) {
+            if (sqDist <= radius * radius) expected.push_back(i);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        tree.findWithinRadius(query, radius, within);
+        std::sort(within.begin(), within.end());
+        EXPECT_EQ(within, expected);
+    }
+}
+
+TEST(FlatKDTreeTests, batchedQueries) {
+    std::mt19937 gen(3);
+    const auto points = randomPoints(2000, gen);
+    const auto queries = randomPoints(64, gen);
+    FlatKDTree<3, float> tree{points};
+
+    const size_t k = 4;
+    std::vector<size_t> indices(queries.size() * k);
+    std::vector<float> sqDists(queries.size() * k);
+    tree.findNNearest(queries, k, indices, sqDists);
+
+    std::vector<std::vector<size_t>> within;
+    tree.findWithinRadius(queries, 0.05f, within);
+    ASSERT_EQ(within.size(), queries.size());
+
+    std::vector<size_t> single(k);
+    std::vector<float> singleDists(k);
+    std::vector<size_t> singleWithin;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        tree.findNNearest(queries[i], single, singleDists);
+        for (size_t j = 0; j < k; ++j) {
+            EXPECT_EQ(indices[i * k + j], single[j]);
+            EXPECT_EQ(sqDists[i * k + j], singleDists[j]);
+        }
+        tree.findWithinRadius(queries[i], 0.05f, singleWithin);
+        EXPECT_EQ(within[i], singleWithin);
+    }
+
+    std::vector<size_t> tooSmall(k);
+    EXPECT_THROW(tree.findNNearest(queries, k, tooSmall, sqDists), Exception);
+}
+
+}  // namespace inviwo
@@ -38,6 +38,9 @@
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/base/algorithm/volume/marchingcubesparallel.h>
+#include <modules/base/algorithm/volume/volumeminmaxhierarchy.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
 
 #include <glm/gtx/normal.hpp>
 
@@ -335,4 +338,109 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+namespace {
+
+bool lessThan(const vec3& a, const vec3& b) {
+    return std::lexicographical_compare(glm::value_ptr(a), glm::value_ptr(a) + 3,
+                                        glm::value_ptr(b), glm::value_ptr(b) + 3);
+}
+
+// Triangles as vertex positions, rotated to start at the smallest vertex and sorted, to be able
+// to compare meshes that store the same triangles in different orders
+std::vector<std::array<vec3, 3>> sortedTriangles(Mesh& mesh) {
+    auto& pos = getBufferData<vec3>(mesh, 0);
+    auto& ind = getBufferIndexData(mesh, 0);
+    std::vector<std::array<vec3, 3>> triangles;
+    for (size_t i = 0; i + 2 < ind.size(); i += 3) {
+        std::array<vec3, 3> tri{pos[ind[i]], pos[ind[i + 1]], pos[ind[i + 2]]};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end(), lessThan), tri.end());
+        triangles.push_back(tri);
+    }
+    std::sort(triangles.begin(), triangles.end(), [&](const auto& a, const auto& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), lessThan);
+    });
+    return triangles;
+}
+
+void expectSameSurface(std::shared_ptr<Volume> vol, double iso, bool invert) {
+    auto mesh1 = util::marchingCubesOpt(vol, iso, {1.0f, 0.0f, 0.0f, 1.0f}, invert, false);
+    auto mesh2 = util::marchingCubesParallel(vol, iso, {1.0f, 0.0f, 0.0f, 1.0f}, invert, false);
+
+    auto& pos1 = getBufferData<vec3>(*mesh1, 0);
+    auto& pos2 = getBufferData<vec3>(*mesh2, 0);
+    ASSERT_EQ(pos1.size(), pos2.size());
+    ASSERT_EQ(getBufferIndexData(*mesh1, 0).size(), getBufferIndexData(*mesh2, 0).size());
+
+    EXPECT_TRUE(sortedTriangles(*mesh1) == sortedTriangles(*mesh2));
+
+    // Compare the normals of equal vertices
+    const auto byPosition = [](Mesh& mesh) {
+        auto& pos = getBufferData<vec3>(mesh, 0);
+        auto& normals = getBufferData<vec3>(mesh, 3);
+        std::vector<std::pair<vec3, vec3>> res;
+        for (size_t i = 0; i < pos.size(); ++i) res.emplace_back(pos[i], normals[i]);
+        std::sort(res.begin(), res.end(),
+                  [](const auto& a, const auto& b) { return lessThan(a.first, b.first); });
+        return res;
+    };
+    const auto vertices1 = byPosition(*mesh1);
+    const auto vertices2 = byPosition(*mesh2);
+    for (size_t i = 0; i < vertices1.size(); ++i) {
+        ASSERT_EQ(vertices1[i].first, vertices2[i].first);
+        EXPECT_NEAR(glm::distance(vertices1[i].second, vertices2[i].second), 0.0f, 1.0e-4f);
+    }
+}
+
+}  // namespace
+
+TEST(Marchingcubes, parallelSphere) {
+    auto vol = std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{40}));
+    expectSameSurface(vol, 0.5, false);
+    expectSameSurface(vol, 0.5, true);
+}
+
+TEST(Marchingcubes, parallelRipple) {
+    auto vol = std::shared_ptr<Volume>(util::makeRippleVolume(size3_t{37, 21, 50}));
+    expectSameSurface(vol, 0.5, false);
+    expectSameSurface(vol, 0.3, true);
+}
+
+TEST(Marchingcubes, parallelSparse) {
+    const vec3 center{50.0f, 10.0f, 40.0f};
+    auto vol = std::shared_ptr<Volume>(
+        util::generateVolume(size3_t{70, 60, 50}, mat3(1.0f), [&](const size3_t& ind) {
+            return glm::distance(vec3(ind), center) < 6.0f ? uint8_t{200} : uint8_t{0};
+        }));
+    expectSameSurface(vol, 100.0, false);
+    expectSameSurface(vol, 100.0, true);
+
+    auto mesh = util::marchingCubesParallel(vol, 250.0, {1.0f, 0.0f, 0.0f, 1.0f}, false, false);
+    EXPECT_EQ(getBufferData<vec3>(*mesh, 0).size(), 0);
+}
+
+TEST(Marchingcubes, parallelEditedVolume) {
+    auto vol = std::shared_ptr<Volume>(
+        util::generateVolume(size3_t{40}, mat3(1.0f), [](const size3_t&) { return uint8_t{0}; }));
+    const VolumeMinMaxHierarchy empty{*vol->getRepresentation<VolumeRAM>()};
+    auto mesh = util::marchingCubesParallel(vol, empty, 100.0, vec4{1.0f}, false, false);
+    EXPECT_EQ(getBufferData<vec3>(*mesh, 0).size(), 0);
+
+    // Edit the data in place, a new hierarchy has to see the change
+    auto ram = vol->getEditableRepresentation<VolumeRAM>();
+    for (size_t z = 10; z < 20; ++z) {
+        for (size_t y = 10; y < 20; ++y) {
+            for (size_t x = 10; x < 20; ++x) ram->setFromDouble(size3_t{x, y, z}, 200.0);
+        }
+    }
+    expectSameSurface(vol, 100.0, false);
+
+    const VolumeMinMaxHierarchy edited{*vol->getRepresentation<VolumeRAM>()};
+    mesh = util::marchingCubesParallel(vol, edited, 100.0, vec4{1.0f}, false, false);
+    EXPECT_NE(getBufferData<vec3>(*mesh, 0).size(), 0);
+
+    auto other = std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{20}));
+    EXPECT_THROW(util::marchingCubesParallel(other, edited, 0.5, vec4{1.0f}, false, false),
+                 Exception);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,216 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/volumesequencecache.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <atomic>
+
+namespace inviwo {
+
+namespace {
+
+class CountingLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    explicit CountingLoader(std::atomic<size_t>& loads) : loads_{loads} {}
+    virtual CountingLoader* clone() const override { return new CountingLoader(*this); }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        ++loads_;
+        return std::make_shared<VolumeRAMPrecision<float>>(src.getDimensions());
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {
+        ++loads_;
+    }
+
+private:
+    std::atomic<size_t>& loads_;
+};
+
+// Time steps of 4x4x4 floats, 256 bytes each
+std::shared_ptr<VolumeSequence> makeSequence(size_t size, std::atomic<size_t>& loads) {
+    auto sequence = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < size; ++i) {
+        auto disk = std::make_shared<VolumeDisk>("step" + toString(i), size3_t{4},
+                                                 DataFloat32::get());
+        disk->setLoader(new CountingLoader(loads));
+        sequence->push_back(std::make_shared<Volume>(disk));
+    }
+    return sequence;
+}
+
+constexpr size_t stepSize = 4 * 4 * 4 * sizeof(float);
+
+}  // namespace
+
+TEST(VolumeSequenceCache, prefetch) {
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(8, loads);
+
+    VolumeSequenceCache cache(2, stepSize * 100, nullptr);
+    cache.setSequence(sequence);
+
+    auto volume = cache.get(0);
+    EXPECT_EQ((*sequence)[0], volume);
+    EXPECT_TRUE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[1]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*sequence)[3]->hasRepresentation<VolumeRAM>());
+
+    cache.get(1);
+    cache.get(2);
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(4u, stats.prefetches);
+    EXPECT_EQ(0u, stats.evictions);
+    EXPECT_EQ(5u, loads.load());
+    EXPECT_EQ(5 * stepSize, cache.getResidentBytes());
+
+    cache.resetStats();
+    EXPECT_EQ(0u, cache.getStats().hits);
+    EXPECT_THROW(cache.get(8), RangeException);
+}
+
+TEST(VolumeSequenceCache, direction) {
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(8, loads);
+
+    VolumeSequenceCache cache(2, stepSize * 100, nullptr);
+    cache.setSequence(sequence);
+
+    cache.get(5);
+    cache.get(4);
+    EXPECT_TRUE((*sequence)[3]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*sequence)[1]->hasRepresentation<VolumeRAM>());
+
+    // Going from the last to the first step continues forward
+    auto looping = makeSequence(8, loads);
+    cache.setSequence(looping);
+    cache.get(6);
+    cache.get(7);
+    EXPECT_FALSE((*looping)[2]->hasRepresentation<VolumeRAM>());
+    cache.get(0);
+    EXPECT_TRUE((*looping)[2]->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceCache, budget) {
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(8, loads);
+
+    VolumeSequenceCache cache(1, stepSize * 3, nullptr);
+    cache.setSequence(sequence);
+
+    for (size_t i = 0; i < 8; ++i) {
+        cache.get(i);
+        EXPECT_LE(cache.getResidentBytes(), cache.getByteBudget());
+    }
+
+    // The last two steps and the prefetched first step are left
+    for (size_t i = 1; i < 6; ++i) {
+        EXPECT_FALSE((*sequence)[i]->hasRepresentation<VolumeRAM>()) << "step " << i;
+    }
+    EXPECT_TRUE((*sequence)[6]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[7]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[0]->hasRepresentation<VolumeRAM>());
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(7u, stats.hits);
+    EXPECT_EQ(6u, stats.evictions);
+    EXPECT_EQ(9u, loads.load());
+}
+
+TEST(VolumeSequenceCache, keepsVolumesInUse) {
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(8, loads);
+
+    VolumeSequenceCache cache(1, stepSize * 2, nullptr);
+    cache.setSequence(sequence);
+
+    auto inUse = cache.get(0);
+    cache.get(1);
+    cache.get(2);
+
+    EXPECT_TRUE(inUse->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*sequence)[1]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(3 * stepSize, cache.getResidentBytes());
+}
+
+TEST(VolumeSequenceCache, onlyReleasesOwnRepresentations) {
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(8, loads);
+    // Loaded by someone else before the cache sees it
+    (*sequence)[0]->getRepresentation<VolumeRAM>();
+
+    VolumeSequenceCache unlimited(1, 0, nullptr);
+    unlimited.setSequence(sequence);
+    for (size_t i = 0; i < 8; ++i) unlimited.get(i);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE((*sequence)[i]->hasRepresentation<VolumeRAM>()) << "step " << i;
+    }
+    EXPECT_EQ(0u, unlimited.getStats().evictions);
+
+    auto other = makeSequence(8, loads);
+    (*other)[0]->getRepresentation<VolumeRAM>();
+    VolumeSequenceCache cache(1, stepSize * 3, nullptr);
+    cache.setSequence(other);
+    for (size_t i = 0; i < 7; ++i) cache.get(i);
+    EXPECT_TRUE((*other)[0]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*other)[1]->hasRepresentation<VolumeRAM>());
+}
+
+TEST(VolumeSequenceCache, releaseRepresentation) {
+    Volume inMemory(std::make_shared<VolumeRAMPrecision<float>>(size3_t{4}));
+    EXPECT_FALSE((inMemory.releaseRepresentation<VolumeRAM, VolumeDisk>()));
+    EXPECT_TRUE(inMemory.hasRepresentation<VolumeRAM>());
+
+    std::atomic<size_t> loads{0};
+    auto sequence = makeSequence(1, loads);
+    auto& volume = *sequence->front();
+    volume.getRepresentation<VolumeRAM>();
+    EXPECT_TRUE((volume.releaseRepresentation<VolumeRAM, VolumeDisk>()));
+    EXPECT_FALSE(volume.hasRepresentation<VolumeRAM>());
+
+    // A RAM representation is loaded again from disk
+    volume.getRepresentation<VolumeRAM>();
+    EXPECT_EQ(2u, loads.load());
+}
+
+}  // namespace inviwo
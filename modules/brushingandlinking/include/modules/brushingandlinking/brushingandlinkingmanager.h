@@ -64,23 +64,34 @@ public:
 
     bool isColumnSelected(size_t column) const;
 
+    void setSelected(const BrushingAndLinkingInport* src, const BitSet& indices);
     void setSelected(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
     void clearSelected();
 
+    void setFiltered(const BrushingAndLinkingInport* src, const BitSet& indices);
     void setFiltered(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
     void clearFiltered();
 
+    void setSelectedColumn(const BrushingAndLinkingInport* src, const BitSet& columnIndices);
     void setSelectedColumn(const BrushingAndLinkingInport* src,
                            const std::unordered_set<size_t>& columnIndices);
     void clearColumns();
 
-    const std::unordered_set<size_t>& getSelectedIndices() const;
-    const std::unordered_set<size_t>& getFilteredIndices() const;
-    const std::unordered_set<size_t>& getSelectedColumns() const;
+    const BitSet& getSelection() const;
+    const BitSet& getFiltering() const;
+    const BitSet& getColumnSelection() const;
+
+    /*
+     * Copies of the selected rows, filtered rows and selected columns. Prefer getSelection(),
+     * getFiltering() and getColumnSelection(), which do not copy.
+     */
+    std::unordered_set<size_t> getSelectedIndices() const;
+    std::unordered_set<size_t> getFilteredIndices() const;
+    std::unordered_set<size_t> getSelectedColumns() const;
 
 private:
-    std::unordered_set<size_t> selected_;
-    std::unordered_set<size_t> selectedColumns_;
+    BitSet selected_;
+    BitSet selectedColumns_;
     IndexList filtered_;  // Use IndexList to be able to remove filtered rows on port disconnection
     std::shared_ptr<std::function<void()>> onFilteringChangeCallback_;
 
@@ -91,7 +102,7 @@ private:
 inline bool BrushingAndLinkingManager::isFiltered(size_t idx) const { return filtered_.has(idx); }
 
 inline bool BrushingAndLinkingManager::isSelected(size_t idx) const {
-    return selected_.find(idx) != selected_.end();
+    return selected_.contains(idx);
 }
 
 }  // namespace inviwo
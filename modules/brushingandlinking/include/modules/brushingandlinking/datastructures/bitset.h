@@ -0,0 +1,214 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace inviwo {
+
+namespace detail {
+
+/**
+ * Index of the lowest set bit in \p word, which must not be zero.
+ */
+inline int lowestSetBit(std::uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * \class BitSet
+ * \brief A compressed set of indices, used for row selections and filters.
+ *
+ * The indices are grouped into chunks of 2^16 consecutive values, as in a roaring bitmap. A
+ * chunk with at most 4096 indices stores their lower 16 bits in a sorted array. A fuller chunk
+ * stores them as a bitmap of 1024 64-bit words. A lookup is a binary search for the chunk
+ * followed by a bit test or a binary search within the chunk. Unions and intersections are
+ * computed chunk by chunk, and iteration visits the indices in ascending order.
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API BitSet {
+    struct Chunk;
+
+public:
+    class IVW_MODULE_BRUSHINGANDLINKING_API const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        const_iterator() = default;
+
+        size_t operator*() const { return value_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& rhs) const {
+            return chunk_ == rhs.chunk_ && pos_ == rhs.pos_;
+        }
+        bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+        friend class BitSet;
+        const_iterator(const std::vector<Chunk>* chunks, size_t chunk);
+        void seek();
+
+        const std::vector<Chunk>* chunks_ = nullptr;
+        size_t chunk_ = 0;
+        std::uint32_t pos_ = 0;  // index into the array, or bit position in the bitmap
+        size_t value_ = 0;
+    };
+    using iterator = const_iterator;
+    using value_type = size_t;
+
+    BitSet() = default;
+    BitSet(std::initializer_list<size_t> indices);
+    explicit BitSet(const std::unordered_set<size_t>& indices);
+    template <typename Iter>
+    BitSet(Iter begin, Iter end);
+
+    bool contains(size_t idx) const;
+    size_t size() const;
+    bool empty() const { return chunks_.empty(); }
+
+    void add(size_t idx);
+    /**
+     * Add all indices in the range [begin, end)
+     */
+    void addRange(size_t begin, size_t end);
+    void remove(size_t idx);
+    void clear() { chunks_.clear(); }
+
+    BitSet& operator|=(const BitSet& rhs);
+    BitSet& operator&=(const BitSet& rhs);
+
+    const_iterator begin() const { return const_iterator(&chunks_, 0); }
+    const_iterator end() const { return const_iterator(&chunks_, chunks_.size()); }
+
+    /**
+     * Call \p callback for each index in ascending order. This is faster than using the
+     * iterators.
+     */
+    template <typename Callback>
+    void forEach(Callback callback) const;
+
+    std::unordered_set<size_t> toUnorderedSet() const;
+    std::vector<size_t> toVector() const;
+
+    bool operator==(const BitSet& rhs) const;
+    bool operator!=(const BitSet& rhs) const { return !(*this == rhs); }
+
+private:
+    static constexpr std::uint32_t chunkBits = 16;
+    static constexpr std::uint32_t maxArraySize = 4096;
+    static constexpr std::uint32_t bitmapWords = (1u << chunkBits) / 64;
+
+    /**
+     * A chunk is stored as an array if it holds at most maxArraySize indices, otherwise as a
+     * bitmap. Keeping this invariant makes the representation of a set unique.
+     */
+    struct Chunk {
+        size_t key = 0;  // the upper bits of the indices, idx >> chunkBits
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> array;
+        std::vector<std::uint64_t> bitmap;
+
+        bool isBitmap() const { return !bitmap.empty(); }
+        bool contains(std::uint16_t low) const;
+    };
+
+    std::vector<Chunk>::iterator findOrInsert(size_t key);
+
+    std::vector<Chunk> chunks_;  // sorted by key
+};
+
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator|(BitSet a, const BitSet& b);
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator&(BitSet a, const BitSet& b);
+
+template <typename Iter>
+BitSet::BitSet(Iter begin, Iter end) {
+    std::vector<size_t> indices(begin, end);
+    std::sort(indices.begin(), indices.end());
+    // adding in ascending order appends to the chunks
+    for (auto idx : indices) add(idx);
+}
+
+inline bool BitSet::Chunk::contains(std::uint16_t low) const {
+    if (isBitmap()) return (bitmap[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+inline bool BitSet::contains(size_t idx) const {
+    const size_t key = idx >> chunkBits;
+    const auto low = static_cast<std::uint16_t>(idx & 0xFFFF);
+    // selections of rows usually have a chunk for every key, then the chunk is at position key
+    if (key < chunks_.size() && chunks_[key].key == key) return chunks_[key].contains(low);
+    const auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+                                     [](const Chunk& c, size_t k) { return c.key < k; });
+    return it != chunks_.end() && it->key == key && it->contains(low);
+}
+
+template <typename Callback>
+void BitSet::forEach(Callback callback) const {
+    for (const auto& chunk : chunks_) {
+        const size_t base = chunk.key << chunkBits;
+        if (chunk.isBitmap()) {
+            for (size_t i = 0; i < bitmapWords; ++i) {
+                for (auto word = chunk.bitmap[i]; word != 0; word &= word - 1) {
+                    callback(base + i * 64 + detail::lowestSetBit(word));
+                }
+            }
+        } else {
+            for (auto low : chunk.array) callback(base + low);
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -57,20 +57,30 @@ void BrushingAndLinkingManager::remove(const BrushingAndLinkingInport* src) {
 }
 
 bool BrushingAndLinkingManager::isColumnSelected(size_t idx) const {
-    return selectedColumns_.find(idx) != selectedColumns_.end();
+    return selectedColumns_.contains(idx);
 }
 
 void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport*,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const BitSet& indices) {
     selected_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport* src,
+                                            const std::unordered_set<size_t>& indices) {
+    setSelected(src, BitSet(indices));
+}
+
 void BrushingAndLinkingManager::clearSelected() {
     selected_.clear();
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
+                                            const BitSet& indices) {
+    filtered_.set(src, indices);
+}
+
 void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
                                             const std::unordered_set<size_t>& indices) {
     filtered_.set(src, indices);
@@ -79,26 +89,37 @@ void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
 void BrushingAndLinkingManager::clearFiltered() { filtered_.clear(); }
 
 void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport*,
-                                                  const std::unordered_set<size_t>& indices) {
+                                                  const BitSet& indices) {
     selectedColumns_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport* src,
+                                                  const std::unordered_set<size_t>& indices) {
+    setSelectedColumn(src, BitSet(indices));
+}
+
 void BrushingAndLinkingManager::clearColumns() {
-    selected_.clear();
+    selectedColumns_.clear();
     owner_->invalidate(invalidationLevel_);
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedIndices() const {
-    return selected_;
+const BitSet& BrushingAndLinkingManager::getSelection() const { return selected_; }
+
+const BitSet& BrushingAndLinkingManager::getFiltering() const { return filtered_.getIndices(); }
+
+const BitSet& BrushingAndLinkingManager::getColumnSelection() const { return selectedColumns_; }
+
+std::unordered_set<size_t> BrushingAndLinkingManager::getSelectedIndices() const {
+    return selected_.toUnorderedSet();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getFilteredIndices() const {
-    return filtered_.getIndices();
+std::unordered_set<size_t> BrushingAndLinkingManager::getFilteredIndices() const {
+    return filtered_.getIndices().toUnorderedSet();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedColumns() const {
-    return selectedColumns_;
+std::unordered_set<size_t> BrushingAndLinkingManager::getSelectedColumns() const {
+    return selectedColumns_.toUnorderedSet();
 }
 
 }  // namespace inviwo
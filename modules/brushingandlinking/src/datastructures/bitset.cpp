@@ -0,0 +1,338 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+int popcount(std::uint64_t word) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+}  // namespace
+
+BitSet::const_iterator::const_iterator(const std::vector<Chunk>* chunks, size_t chunk)
+    : chunks_{chunks}, chunk_{chunk} {
+    seek();
+}
+
+BitSet::const_iterator& BitSet::const_iterator::operator++() {
+    ++pos_;
+    seek();
+    return *this;
+}
+
+BitSet::const_iterator BitSet::const_iterator::operator++(int) {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+// Move forward to the first index at or after the current position
+void BitSet::const_iterator::seek() {
+    for (; chunk_ < chunks_->size(); ++chunk_, pos_ = 0) {
+        const auto& chunk = (*chunks_)[chunk_];
+        const size_t base = chunk.key << chunkBits;
+        if (chunk.isBitmap()) {
+            for (auto word = pos_ / 64; word < bitmapWords; ++word) {
+                auto bits = chunk.bitmap[word];
+                if (word == pos_ / 64) bits &= ~std::uint64_t{0} << (pos_ % 64);
+                if (bits != 0) {
+                    pos_ = word * 64 + detail::lowestSetBit(bits);
+                    value_ = base + pos_;
+                    return;
+                }
+            }
+        } else if (pos_ < chunk.array.size()) {
+            value_ = base + chunk.array[pos_];
+            return;
+        }
+    }
+    pos_ = 0;
+}
+
+namespace {
+
+using Array = std::vector<std::uint16_t>;
+using Bitmap = std::vector<std::uint64_t>;
+
+std::uint32_t count(const Bitmap& bitmap) {
+    return std::accumulate(bitmap.begin(), bitmap.end(), std::uint32_t{0},
+                           [](std::uint32_t sum, std::uint64_t w) { return sum + popcount(w); });
+}
+
+Bitmap toBitmap(const Array& array, std::uint32_t words) {
+    Bitmap bitmap(words, 0);
+    for (auto low : array) bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+    return bitmap;
+}
+
+Array toArray(const Bitmap& bitmap, std::uint32_t cardinality) {
+    Array array;
+    array.reserve(cardinality);
+    for (size_t i = 0; i < bitmap.size(); ++i) {
+        for (auto word = bitmap[i]; word != 0; word &= word - 1) {
+            array.push_back(static_cast<std::uint16_t>(i * 64 + detail::lowestSetBit(word)));
+        }
+    }
+    return array;
+}
+
+}  // namespace
+
+BitSet::BitSet(std::initializer_list<size_t> indices) : BitSet(indices.begin(), indices.end()) {}
+
+BitSet::BitSet(const std::unordered_set<size_t>& indices)
+    : BitSet(indices.begin(), indices.end()) {}
+
+size_t BitSet::size() const {
+    return std::accumulate(chunks_.begin(), chunks_.end(), size_t{0},
+                           [](size_t sum, const Chunk& c) { return sum + c.cardinality; });
+}
+
+std::vector<BitSet::Chunk>::iterator BitSet::findOrInsert(size_t key) {
+    if (!chunks_.empty() && chunks_.back().key == key) return std::prev(chunks_.end());
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+                               [](const Chunk& c, size_t k) { return c.key < k; });
+    if (it == chunks_.end() || it->key != key) {
+        it = chunks_.insert(it, Chunk{});
+        it->key = key;
+    }
+    return it;
+}
+
+void BitSet::add(size_t idx) {
+    auto& chunk = *findOrInsert(idx >> chunkBits);
+    const auto low = static_cast<std::uint16_t>(idx & 0xFFFF);
+    if (chunk.isBitmap()) {
+        auto& word = chunk.bitmap[low >> 6];
+        const auto bit = std::uint64_t{1} << (low & 63);
+        if ((word & bit) == 0) {
+            word |= bit;
+            ++chunk.cardinality;
+        }
+        return;
+    }
+    // appending in ascending order is the common case
+    if (chunk.array.empty() || chunk.array.back() < low) {
+        chunk.array.push_back(low);
+    } else {
+        auto it = std::lower_bound(chunk.array.begin(), chunk.array.end(), low);
+        if (*it == low) return;
+        chunk.array.insert(it, low);
+    }
+    if (++chunk.cardinality > maxArraySize) {
+        chunk.bitmap = toBitmap(chunk.array, bitmapWords);
+        chunk.array = Array{};
+    }
+}
+
+void BitSet::addRange(size_t begin, size_t end) {
+    while (begin < end) {
+        auto& chunk = *findOrInsert(begin >> chunkBits);
+        const size_t base = chunk.key << chunkBits;
+        const auto first = static_cast<std::uint32_t>(begin - base);
+        const auto last =
+            static_cast<std::uint32_t>(std::min(end - base, size_t{1} << chunkBits));
+
+        if (!chunk.isBitmap() && chunk.cardinality + (last - first) <= maxArraySize) {
+            Array range(last - first);
+            std::iota(range.begin(), range.end(), static_cast<std::uint16_t>(first));
+            Array merged;
+            merged.reserve(chunk.array.size() + range.size());
+            std::set_union(chunk.array.begin(), chunk.array.end(), range.begin(), range.end(),
+                           std::back_inserter(merged));
+            chunk.array = std::move(merged);
+            chunk.cardinality = static_cast<std::uint32_t>(chunk.array.size());
+        } else {
+            if (!chunk.isBitmap()) {
+                chunk.bitmap = toBitmap(chunk.array, bitmapWords);
+                chunk.array = Array{};
+            }
+            for (auto i = first; i < last;) {
+                const auto offset = i % 64;
+                const auto n = std::min(64 - offset, last - i);
+                const auto mask = n == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << n) - 1);
+                chunk.bitmap[i / 64] |= mask << offset;
+                i += n;
+            }
+            chunk.cardinality = count(chunk.bitmap);
+            if (chunk.cardinality <= maxArraySize) {
+                chunk.array = toArray(chunk.bitmap, chunk.cardinality);
+                chunk.bitmap = Bitmap{};
+            }
+        }
+        begin = base + last;
+    }
+}
+
+void BitSet::remove(size_t idx) {
+    const size_t key = idx >> chunkBits;
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+                               [](const Chunk& c, size_t k) { return c.key < k; });
+    if (it == chunks_.end() || it->key != key) return;
+
+    const auto low = static_cast<std::uint16_t>(idx & 0xFFFF);
+    if (it->isBitmap()) {
+        auto& word = it->bitmap[low >> 6];
+        const auto bit = std::uint64_t{1} << (low & 63);
+        if ((word & bit) == 0) return;
+        word &= ~bit;
+        if (--it->cardinality <= maxArraySize) {
+            it->array = toArray(it->bitmap, it->cardinality);
+            it->bitmap = Bitmap{};
+        }
+    } else {
+        auto pos = std::lower_bound(it->array.begin(), it->array.end(), low);
+        if (pos == it->array.end() || *pos != low) return;
+        it->array.erase(pos);
+        if (--it->cardinality == 0) chunks_.erase(it);
+    }
+}
+
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+    std::vector<Chunk> result;
+    result.reserve(chunks_.size() + rhs.chunks_.size());
+
+    auto a = chunks_.begin();
+    auto b = rhs.chunks_.begin();
+    while (a != chunks_.end() || b != rhs.chunks_.end()) {
+        if (b == rhs.chunks_.end() || (a != chunks_.end() && a->key < b->key)) {
+            result.push_back(std::move(*a++));
+        } else if (a == chunks_.end() || b->key < a->key) {
+            result.push_back(*b++);
+        } else {
+            Chunk chunk{};
+            chunk.key = a->key;
+            if (!a->isBitmap() && !b->isBitmap()) {
+                chunk.array.reserve(a->array.size() + b->array.size());
+                std::set_union(a->array.begin(), a->array.end(), b->array.begin(),
+                               b->array.end(), std::back_inserter(chunk.array));
+                chunk.cardinality = static_cast<std::uint32_t>(chunk.array.size());
+                if (chunk.cardinality > maxArraySize) {
+                    chunk.bitmap = toBitmap(chunk.array, bitmapWords);
+                    chunk.array = Array{};
+                }
+            } else {
+                chunk.bitmap =
+                    a->isBitmap() ? std::move(a->bitmap) : toBitmap(a->array, bitmapWords);
+                if (b->isBitmap()) {
+                    for (size_t i = 0; i < bitmapWords; ++i) chunk.bitmap[i] |= b->bitmap[i];
+                } else {
+                    for (auto low : b->array) {
+                        chunk.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+                    }
+                }
+                chunk.cardinality = count(chunk.bitmap);
+            }
+            result.push_back(std::move(chunk));
+            ++a;
+            ++b;
+        }
+    }
+    chunks_ = std::move(result);
+    return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+    std::vector<Chunk> result;
+
+    auto a = chunks_.begin();
+    auto b = rhs.chunks_.begin();
+    while (a != chunks_.end() && b != rhs.chunks_.end()) {
+        if (a->key < b->key) {
+            ++a;
+        } else if (b->key < a->key) {
+            ++b;
+        } else {
+            Chunk chunk{};
+            chunk.key = a->key;
+            if (a->isBitmap() && b->isBitmap()) {
+                chunk.bitmap = std::move(a->bitmap);
+                for (size_t i = 0; i < bitmapWords; ++i) chunk.bitmap[i] &= b->bitmap[i];
+                chunk.cardinality = count(chunk.bitmap);
+                if (chunk.cardinality <= maxArraySize) {
+                    chunk.array = toArray(chunk.bitmap, chunk.cardinality);
+                    chunk.bitmap = Bitmap{};
+                }
+            } else if (a->isBitmap() || b->isBitmap()) {
+                const auto& bitmap = a->isBitmap() ? *a : *b;
+                const auto& array = a->isBitmap() ? b->array : a->array;
+                std::copy_if(array.begin(), array.end(), std::back_inserter(chunk.array),
+                             [&](std::uint16_t low) { return bitmap.contains(low); });
+                chunk.cardinality = static_cast<std::uint32_t>(chunk.array.size());
+            } else {
+                std::set_intersection(a->array.begin(), a->array.end(), b->array.begin(),
+                                      b->array.end(), std::back_inserter(chunk.array));
+                chunk.cardinality = static_cast<std::uint32_t>(chunk.array.size());
+            }
+            if (chunk.cardinality > 0) result.push_back(std::move(chunk));
+            ++a;
+            ++b;
+        }
+    }
+    chunks_ = std::move(result);
+    return *this;
+}
+
+bool BitSet::operator==(const BitSet& rhs) const {
+    return std::equal(chunks_.begin(), chunks_.end(), rhs.chunks_.begin(), rhs.chunks_.end(),
+                      [](const Chunk& a, const Chunk& b) {
+                          return a.key == b.key && a.cardinality == b.cardinality &&
+                                 a.array == b.array && a.bitmap == b.bitmap;
+                      });
+}
+
+std::unordered_set<size_t> BitSet::toUnorderedSet() const {
+    std::unordered_set<size_t> set;
+    set.reserve(size());
+    forEach([&](size_t idx) { set.insert(idx); });
+    return set;
+}
+
+std::vector<size_t> BitSet::toVector() const {
+    std::vector<size_t> vec;
+    vec.reserve(size());
+    forEach([&](size_t idx) { vec.push_back(idx); });
+    return vec;
+}
+
+BitSet operator|(BitSet a, const BitSet& b) { return a |= b; }
+
+BitSet operator&(BitSet a, const BitSet& b) { return a &= b; }
+
+}  // namespace inviwo
@@ -37,7 +37,7 @@
 namespace inviwo {
 
 BrushingAndLinkingEvent::BrushingAndLinkingEvent(const BrushingAndLinkingInport* src,
-                                                 const std::unordered_set<size_t>& indices)
+                                                 const BitSet& indices)
     : source_(src), indices_(indices) {}
 
 BrushingAndLinkingEvent* BrushingAndLinkingEvent::clone() const {
@@ -48,7 +48,7 @@ const inviwo::BrushingAndLinkingInport* BrushingAndLinkingEvent::getSource() con
     return source_;
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingEvent::getIndices() const { return indices_; }
+const BitSet& BrushingAndLinkingEvent::getIndices() const { return indices_; }
 
 uint64_t BrushingAndLinkingEvent::hash() const { return chash(); }
 
@@ -59,12 +59,10 @@ void BrushingAndLinkingEvent::print(std::ostream& os) const {
 void BrushingAndLinkingEvent::printEvent(const std::string& eventType, std::ostream& os) const {
     using namespace std::string_literals;
 
-    std::vector<size_t> indices(indices_.begin(), indices_.end());
-    std::sort(indices.begin(), indices.end());
     const std::string indicesStr = [&]() -> std::string {
-        if (indices.empty()) return "none"s;
-        std::string str = joinString(indices.begin(),
-                                     indices.begin() + std::min<size_t>(indices.size(), 10), ", ");
+        if (indices_.empty()) return "none"s;
+        const auto first = std::next(indices_.begin(), std::min<size_t>(indices_.size(), 10));
+        std::string str = joinString(indices_.begin(), first, ", ");
         if (indices_.size() > 10) {
             str.append("...");
         }
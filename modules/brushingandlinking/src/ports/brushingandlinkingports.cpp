@@ -41,17 +41,21 @@ BrushingAndLinkingInport::BrushingAndLinkingInport(std::string identifier)
     });
 }
 
-void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
-    if (filterCache_.size() == 0 && indices.size() == 0) return;
+void BrushingAndLinkingInport::sendFilterEvent(const BitSet &indices) {
+    if (filterCache_.empty() && indices.empty()) return;
     filterCache_ = indices;
     FilteringEvent event(this, filterCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
+    sendFilterEvent(BitSet(indices));
+}
+
+void BrushingAndLinkingInport::sendSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedIndices().empty();
+        noRemoteSelections = getData()->getSelection().empty();
     }
     if (selectionCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
@@ -61,10 +65,14 @@ void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+    sendSelectionEvent(BitSet(indices));
+}
+
+void BrushingAndLinkingInport::sendColumnSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedColumns().empty();
+        noRemoteSelections = getData()->getColumnSelection().empty();
     }
     if (selectionColumnCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
@@ -74,38 +82,54 @@ void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set
     propagateEvent(&event, nullptr);
 }
 
+void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+    sendColumnSelectionEvent(BitSet(indices));
+}
+
 bool BrushingAndLinkingInport::isColumnSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isColumnSelected(idx);
     } else {
-        return selectionColumnCache_.find(idx) != selectionColumnCache_.end();
+        return selectionColumnCache_.contains(idx);
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedIndices() const {
+const BitSet &BrushingAndLinkingInport::getSelection() const {
     if (isConnected()) {
-        return getData()->getSelectedIndices();
+        return getData()->getSelection();
     } else {
         return selectionCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getFilteredIndices() const {
+const BitSet &BrushingAndLinkingInport::getFiltering() const {
     if (isConnected()) {
-        return getData()->getFilteredIndices();
+        return getData()->getFiltering();
     } else {
         return filterCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedColumns() const {
+const BitSet &BrushingAndLinkingInport::getColumnSelection() const {
     if (isConnected()) {
-        return getData()->getSelectedColumns();
+        return getData()->getColumnSelection();
     } else {
         return selectionColumnCache_;
     }
 }
 
+std::unordered_set<size_t> BrushingAndLinkingInport::getSelectedIndices() const {
+    return getSelection().toUnorderedSet();
+}
+
+std::unordered_set<size_t> BrushingAndLinkingInport::getFilteredIndices() const {
+    return getFiltering().toUnorderedSet();
+}
+
+std::unordered_set<size_t> BrushingAndLinkingInport::getSelectedColumns() const {
+    return getColumnSelection().toUnorderedSet();
+}
+
 std::string BrushingAndLinkingInport::getClassIdentifier() const {
     return PortTraits<BrushingAndLinkingInport>::classIdentifier();
 }
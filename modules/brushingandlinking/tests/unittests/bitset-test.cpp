@@ -0,0 +1,122 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <random>
+#include <set>
+
+namespace inviwo {
+
+TEST(BitSet, addRemoveContains) {
+    BitSet set;
+    EXPECT_TRUE(set.empty());
+    set.add(5);
+    set.add(70000);
+    set.add(5);
+    EXPECT_EQ(2, set.size());
+    EXPECT_TRUE(set.contains(5));
+    EXPECT_TRUE(set.contains(70000));
+    EXPECT_FALSE(set.contains(6));
+    EXPECT_FALSE(set.contains(1000000));
+
+    set.remove(5);
+    set.remove(6);
+    EXPECT_EQ(1, set.size());
+    EXPECT_FALSE(set.contains(5));
+    set.remove(70000);
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(BitSet, addRange) {
+    BitSet set;
+    set.addRange(10, 20);
+    set.addRange(65530, 200000);
+    EXPECT_EQ(10 + 200000 - 65530, set.size());
+    EXPECT_FALSE(set.contains(9));
+    EXPECT_TRUE(set.contains(10));
+    EXPECT_TRUE(set.contains(19));
+    EXPECT_FALSE(set.contains(20));
+    EXPECT_TRUE(set.contains(65536));
+    EXPECT_TRUE(set.contains(199999));
+    EXPECT_FALSE(set.contains(200000));
+
+    BitSet same;
+    for (size_t i = 10; i < 20; ++i) same.add(i);
+    for (size_t i = 65530; i < 200000; ++i) same.add(i);
+    EXPECT_EQ(same, set);
+}
+
+TEST(BitSet, iteration) {
+    const std::vector<size_t> indices{0, 3, 64, 65535, 65536, 1000000};
+    BitSet set(indices.rbegin(), indices.rend());
+    EXPECT_EQ(indices, std::vector<size_t>(set.begin(), set.end()));
+    EXPECT_EQ(indices, set.toVector());
+
+    std::unordered_set<size_t> unordered(indices.begin(), indices.end());
+    EXPECT_EQ(unordered, set.toUnorderedSet());
+    EXPECT_EQ(set, BitSet(unordered));
+}
+
+TEST(BitSet, setOperations) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dist(0, 300000);
+
+    // dense enough to create both array and bitmap chunks
+    BitSet a, b;
+    std::set<size_t> refA, refB;
+    for (int i = 0; i < 50000; ++i) {
+        const auto ia = dist(gen) / (i % 2 ? 1 : 8);
+        const auto ib = dist(gen);
+        a.add(ia);
+        refA.insert(ia);
+        b.add(ib);
+        refB.insert(ib);
+    }
+
+    std::set<size_t> refUnion = refA;
+    refUnion.insert(refB.begin(), refB.end());
+    std::vector<size_t> refIntersection;
+    std::set_intersection(refA.begin(), refA.end(), refB.begin(), refB.end(),
+                          std::back_inserter(refIntersection));
+
+    const auto setUnion = a | b;
+    const auto setIntersection = a & b;
+    EXPECT_EQ(refUnion.size(), setUnion.size());
+    EXPECT_EQ(std::vector<size_t>(refUnion.begin(), refUnion.end()), setUnion.toVector());
+    EXPECT_EQ(refIntersection.size(), setIntersection.size());
+    EXPECT_EQ(refIntersection, setIntersection.toVector());
+}
+
+}  // namespace inviwo
@@ -180,6 +180,15 @@ protected:
 class IVW_MODULE_DATAFRAME_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
 public:
     CategoricalColumn(const std::string &header);
+    /**
+     * \brief create a column from existing category indices and their categorical values
+     *
+     * @param header      column header
+     * @param buffer      indices into \p categories
+     * @param categories  unique categorical values
+     */
+    CategoricalColumn(const std::string &header, std::shared_ptr<Buffer<std::uint32_t>> buffer,
+                      std::vector<std::string> categories);
     CategoricalColumn(const CategoricalColumn &rhs) = default;
     CategoricalColumn(CategoricalColumn &&rhs) = default;
 
@@ -0,0 +1,174 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMEQUERY_H
+#define IVW_DATAFRAMEQUERY_H
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Columnar query operations on DataFrames. The operations work directly on the typed buffers of
+ * the columns, and on the codes of categorical columns, instead of going through the virtual
+ * Column interface row by row. Rows are processed in morsels of `morselSize` rows, which are
+ * distributed over the thread pool of the application. All results are deterministic, i.e. they
+ * do not depend on the number of threads.
+ *
+ * Only scalar columns are supported, the operations throw a DataTypeMismatch for columns with
+ * vector types and an Exception for missing columns. The index column is never copied, the
+ * resulting DataFrames get a new one.
+ */
+namespace dataframeutil {
+
+/**
+ * Number of rows processed by one task
+ */
+constexpr size_t morselSize = size_t{1} << 14;
+
+/**
+ * Indices of rows in a DataFrame
+ */
+using Selection = std::vector<std::uint32_t>;
+
+enum class CompareOp { Less, LessEqual, Equal, NotEqual, GreaterEqual, Greater };
+
+/**
+ * Compares the values of a column against a constant. Numerical columns are compared against
+ * `value`. Categorical columns are compared against `category`, using the string ordering of
+ * the categories. NaN values never pass a predicate.
+ */
+struct IVW_MODULE_DATAFRAME_API Predicate {
+    std::string column;
+    CompareOp op = CompareOp::Equal;
+    double value = 0.0;
+    std::string category;
+};
+
+/**
+ * Select the rows of \p dataframe that pass all of \p predicates
+ * @return the selected rows in ascending order
+ */
+IVW_MODULE_DATAFRAME_API Selection filter(const DataFrame& dataframe,
+                                          const std::vector<Predicate>& predicates);
+
+/**
+ * Select the rows of \p selection that pass all of \p predicates, keeping their order
+ */
+IVW_MODULE_DATAFRAME_API Selection filter(const DataFrame& dataframe,
+                                          const std::vector<Predicate>& predicates,
+                                          const Selection& selection);
+
+struct IVW_MODULE_DATAFRAME_API SortKey {
+    std::string column;
+    bool ascending = true;
+};
+
+/**
+ * Stable sort of all rows of \p dataframe by \p keys. The first key is the primary one.
+ * Categorical columns are sorted by their strings and NaN values are put last.
+ * @return the rows in sorted order
+ */
+IVW_MODULE_DATAFRAME_API Selection sortRows(const DataFrame& dataframe,
+                                            const std::vector<SortKey>& keys);
+
+/**
+ * Stable sort of the rows in \p selection by \p keys.
+ */
+IVW_MODULE_DATAFRAME_API Selection sortRows(const DataFrame& dataframe,
+                                            const std::vector<SortKey>& keys,
+                                            Selection selection);
+
+/**
+ * Create a new DataFrame with the rows of \p selection in the order of the selection.
+ * Categorical columns keep their categories.
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> selectRows(const DataFrame& dataframe,
+                                                               const Selection& selection);
+
+enum class AggregateOp { Count, Sum, Mean, Min, Max };
+
+/**
+ * An aggregate of a column. NaN values are ignored, Count counts the values that are not NaN.
+ * Count without a column counts all rows. The result column is named "op(column)", i.e.
+ * "mean(x)", or "count" for the row count, unless `name` is given.
+ */
+struct IVW_MODULE_DATAFRAME_API Aggregate {
+    std::string column;
+    AggregateOp op = AggregateOp::Count;
+    std::string name;
+};
+
+/**
+ * Group the rows of \p dataframe by the values in the \p keys columns and compute \p aggregates
+ * for each group. The result has one row per group, in order of the first row of each group.
+ * The key columns keep their type, Count columns are std::uint32_t and all other aggregates are
+ * double.
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> groupBy(
+    const DataFrame& dataframe, const std::vector<std::string>& keys,
+    const std::vector<Aggregate>& aggregates);
+
+/**
+ * Matching rows of an inner join, `left[i]` matches `right[i]`.
+ */
+struct IVW_MODULE_DATAFRAME_API JoinResult {
+    Selection left;
+    Selection right;
+};
+
+/**
+ * Hash join of \p left and \p right on the \p keys columns, which have to exist in both.
+ * Categorical keys are matched by their strings, numerical keys by value.
+ * @return all pairs of matching rows, ordered by the left row and then the right row
+ */
+IVW_MODULE_DATAFRAME_API JoinResult joinRows(const DataFrame& left, const DataFrame& right,
+                                             const std::vector<std::string>& keys);
+
+/**
+ * Inner join of \p left and \p right on the \p keys columns. The result has the columns of
+ * \p left followed by the non-key columns of \p right. Right columns whose name exists in
+ * \p left get the suffix "_right".
+ * \see joinRows
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> innerJoin(const DataFrame& left,
+                                                              const DataFrame& right,
+                                                              const std::vector<std::string>& keys);
+
+}  // namespace dataframeutil
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMEQUERY_H
@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+namespace inviwo {
+
+/**
+ * Constants of the binary DataFrame format (.ivdf). A file holds a header, a column directory,
+ * and one block of raw data per column. All values are stored in native byte order.
+ *
+ *     char[8]  magic "IVWDFBIN"
+ *     uint32   version
+ *     uint32   byte order mark, 0x01020304
+ *     uint64   number of columns, excluding the index column
+ *     uint64   number of rows
+ *     for each column:
+ *         uint32  kind, see ColumnKind
+ *         uint32  DataFormatId of the data block
+ *         string  header
+ *         uint64  offset of the data block from the start of the file
+ *         uint64  size of the data block in bytes
+ *         for categorical columns:
+ *             uint64  number of categories
+ *             string  each category
+ *     data blocks, each aligned to `alignment` bytes
+ *
+ * A string is stored as a uint64 length followed by its characters.
+ */
+namespace binarydataframe {
+constexpr std::array<char, 8> magic{'I', 'V', 'W', 'D', 'F', 'B', 'I', 'N'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+constexpr std::uint64_t alignment = 64;
+
+enum class ColumnKind : std::uint32_t { Plain = 0, Categorical = 1 };
+}  // namespace binarydataframe
+
+/**
+ * \class BinaryDataFrameWriter
+ * \ingroup dataio
+ * Writes a DataFrame into the binary columnar format described in binarydataframe. The index
+ * column is not stored, it is recreated when reading the file. Only scalar columns are supported.
+ * \see BinaryDataFrameReader
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameWriter : public DataWriterType<DataFrame> {
+public:
+    BinaryDataFrameWriter();
+    BinaryDataFrameWriter(const BinaryDataFrameWriter&) = default;
+    BinaryDataFrameWriter& operator=(const BinaryDataFrameWriter&) = default;
+    virtual BinaryDataFrameWriter* clone() const override;
+    virtual ~BinaryDataFrameWriter() = default;
+
+    /**
+     * @throws DataWriterException if the file exists and overwrite is not set, or if the DataFrame
+     * contains a column that is not scalar
+     */
+    virtual void writeData(const DataFrame* data, const std::string filePath) const override;
+    virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
+        const DataFrame* data, const std::string& fileExtension) const override;
+
+private:
+    void writeData(const DataFrame* data, std::ostream& os) const;
+};
+
+}  // namespace inviwo
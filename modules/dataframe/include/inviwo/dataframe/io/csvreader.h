@@ -58,6 +58,10 @@ public:
  *
  * \brief A reader for comma separated value (CSV) files with customizable delimiters.
  * The default delimiter is ',' and headers are included
+ *
+ * The column types are derived from the first 50 rows. All rows are then located, split into
+ * fields, and converted in parallel using the thread pool of the InviwoApplication. Files are
+ * memory mapped and parsed in place.
  */
 class IVW_MODULE_DATAFRAME_API CSVReader : public DataReaderType<DataFrame> {
 public:
@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMEGROUPBY_H
+#define IVW_DATAFRAMEGROUPBY_H
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+#include <inviwo/dataframe/properties/dataframeproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameGroupBy, DataFrame Group By}
+ * ![](org.inviwo.DataFrameGroupBy.png?classIdentifier=org.inviwo.DataFrameGroupBy)
+ * Groups the rows of a DataFrame by the values of a key column and aggregates all other
+ * numerical columns per group. The result has one row per group, with the key, the number of
+ * rows in the group, and one aggregate per column.
+ *
+ * ### Inports
+ *   * __inport__   DataFrame to group
+ *
+ * ### Outports
+ *   * __outport__  DataFrame with one row per group
+ *
+ * ### Properties
+ *   * __Key Column__  column to group by
+ *   * __Aggregate__   aggregate used for the numerical columns
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameGroupBy : public Processor {
+public:
+    DataFrameGroupBy();
+    virtual ~DataFrameGroupBy() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<DataFrame> inport_;
+    DataOutport<DataFrame> outport_;
+
+    DataFrameColumnProperty key_;
+    TemplateOptionProperty<dataframeutil::AggregateOp> op_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMEGROUPBY_H
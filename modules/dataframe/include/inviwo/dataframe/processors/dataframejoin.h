@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMEJOIN_H
+#define IVW_DATAFRAMEJOIN_H
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/properties/dataframeproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameJoin, DataFrame Join}
+ * ![](org.inviwo.DataFrameJoin.png?classIdentifier=org.inviwo.DataFrameJoin)
+ * Inner join of two DataFrames on a key column that exists in both. Categorical keys are
+ * matched by their strings, numerical keys by value.
+ *
+ * ### Inports
+ *   * __left__    first DataFrame
+ *   * __right__   second DataFrame
+ *
+ * ### Outports
+ *   * __outport__  DataFrame with the columns of both DataFrames for each matching pair of rows.
+ *                  Columns of the right DataFrame that exist in the left one get the suffix
+ *                  "_right".
+ *
+ * ### Properties
+ *   * __Key Column__  column of the left DataFrame to join on
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameJoin : public Processor {
+public:
+    DataFrameJoin();
+    virtual ~DataFrameJoin() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<DataFrame> left_;
+    DataInport<DataFrame> right_;
+    DataOutport<DataFrame> outport_;
+
+    DataFrameColumnProperty key_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMEJOIN_H
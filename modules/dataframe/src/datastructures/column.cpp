@@ -34,6 +34,11 @@ namespace inviwo {
 CategoricalColumn::CategoricalColumn(const std::string &header)
     : TemplateColumn<std::uint32_t>(header) {}
 
+CategoricalColumn::CategoricalColumn(const std::string &header,
+                                     std::shared_ptr<Buffer<std::uint32_t>> buffer,
+                                     std::vector<std::string> categories)
+    : TemplateColumn<std::uint32_t>(header, buffer), lookUpTable_(std::move(categories)) {}
+
 CategoricalColumn *CategoricalColumn::clone() const { return new CategoricalColumn(*this); }
 
 std::string CategoricalColumn::getAsString(size_t idx) const {
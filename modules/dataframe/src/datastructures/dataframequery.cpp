@@ -0,0 +1,726 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/hashcombine.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/taskgroup.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace dataframeutil {
+
+namespace {
+
+constexpr std::uint32_t noRow = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint64_t noMatch = std::numeric_limits<std::uint64_t>::max();
+
+using Key = std::vector<std::uint64_t>;
+
+struct KeyHash {
+    size_t operator()(const Key& key) const noexcept {
+        size_t seed = key.size();
+        for (auto v : key) util::hash_combine(seed, v);
+        return seed;
+    }
+};
+
+const Column& getScalarColumn(const DataFrame& dataframe, const std::string& name,
+                              const ExceptionContext& context) {
+    auto column = dataframe.getColumn(name);
+    if (!column) {
+        throw Exception("Column \"" + name + "\" not found", context);
+    }
+    if (column->getBuffer()->getDataFormat()->getComponents() != 1) {
+        throw DataTypeMismatch("Column \"" + name + "\" is not scalar", context);
+    }
+    return *column;
+}
+
+bool isFloat(const Column& column) {
+    return column.getBuffer()->getDataFormat()->getNumericType() == NumericType::Float;
+}
+
+const std::vector<std::uint32_t>& getCodes(const CategoricalColumn& column) {
+    return column.getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+}
+
+/**
+ * Calls \p f with the data container of the scalar column \p column
+ */
+template <typename R, typename F>
+R dispatchScalar(const Column& column, F&& f) {
+    return column.getBuffer()
+        ->getRepresentation<BufferRAM>()
+        ->dispatch<R, dispatching::filter::Scalars>(
+            [&](auto typed) -> R { return f(typed->getDataContainer()); });
+}
+
+size_t numberOfMorsels(size_t rows) { return (rows + morselSize - 1) / morselSize; }
+
+/**
+ * Calls \p f(morsel, begin, end) for each morsel of \p rows rows in parallel
+ */
+template <typename F>
+void forEachMorsel(size_t rows, F&& f) {
+    util::parallelFor(
+        size_t{0}, numberOfMorsels(rows),
+        [&](size_t morsel) {
+            const auto begin = morsel * morselSize;
+            f(morsel, begin, std::min(rows, begin + morselSize));
+        },
+        1);
+}
+
+Selection concatenate(std::vector<Selection>& parts) {
+    if (parts.size() == 1) return std::move(parts.front());
+    size_t size = 0;
+    for (const auto& part : parts) size += part.size();
+    Selection result;
+    result.reserve(size);
+    for (const auto& part : parts) result.insert(result.end(), part.begin(), part.end());
+    return result;
+}
+
+template <typename T>
+bool isNaN(const T& v) {
+    return !(v == v);
+}
+
+template <typename F>
+decltype(auto) withComparison(CompareOp op, F&& f) {
+    switch (op) {
+        case CompareOp::Less:
+            return f(std::less<>{});
+        case CompareOp::LessEqual:
+            return f(std::less_equal<>{});
+        case CompareOp::NotEqual:
+            return f(std::not_equal_to<>{});
+        case CompareOp::GreaterEqual:
+            return f(std::greater_equal<>{});
+        case CompareOp::Greater:
+            return f(std::greater<>{});
+        case CompareOp::Equal:
+        default:
+            return f(std::equal_to<>{});
+    }
+}
+
+template <typename T>
+std::vector<T> gather(const std::vector<T>& data, const Selection& rows) {
+    std::vector<T> result(rows.size());
+    forEachMorsel(rows.size(), [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result[i] = data[rows[i]];
+    });
+    return result;
+}
+
+void gatherColumn(const Column& column, const Selection& rows, const std::string& header,
+                  DataFrame& dst) {
+    if (auto categorical = dynamic_cast<const CategoricalColumn*>(&column)) {
+        dst.addColumn(std::make_shared<CategoricalColumn>(
+            header, util::makeBuffer(gather(getCodes(*categorical), rows)),
+            categorical->getCategories()));
+    } else {
+        dispatchScalar<void>(column,
+                             [&](const auto& data) { dst.addColumn(header, gather(data, rows)); });
+    }
+}
+
+bool isIndexColumn(const DataFrame& dataframe, const std::shared_ptr<const Column>& column) {
+    return column == dataframe.getIndexColumn();
+}
+
+// Filter
+
+struct CompiledPredicate {
+    const Column* column;
+    const CategoricalColumn* categorical;
+    CompareOp op;
+    double value;
+    std::vector<char> passCategory;
+};
+
+std::vector<CompiledPredicate> compile(const DataFrame& dataframe,
+                                       const std::vector<Predicate>& predicates) {
+    const auto context = IVW_CONTEXT_CUSTOM("dataframeutil::filter");
+    std::vector<CompiledPredicate> compiled;
+    for (const auto& predicate : predicates) {
+        const auto& column = getScalarColumn(dataframe, predicate.column, context);
+        auto& item = compiled.emplace_back(CompiledPredicate{
+            &column, dynamic_cast<const CategoricalColumn*>(&column), predicate.op,
+            predicate.value, {}});
+        if (item.categorical) {
+            for (const auto& category : item.categorical->getCategories()) {
+                item.passCategory.push_back(withComparison(predicate.op, [&](auto cmp) {
+                    return cmp(category, predicate.category);
+                }));
+            }
+        }
+    }
+    return compiled;
+}
+
+/**
+ * Keeps the \p count rows in \p rows that pass, compacting them in place without branches
+ * @return the number of rows that passed
+ */
+template <typename T, typename Pass>
+size_t refine(const std::vector<T>& data, std::uint32_t* rows, size_t count, Pass pass) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const auto row = rows[i];
+        rows[n] = row;
+        n += pass(data[row]) ? 1 : 0;
+    }
+    return n;
+}
+
+size_t apply(const CompiledPredicate& predicate, std::uint32_t* rows, size_t count) {
+    if (predicate.categorical) {
+        const auto& pass = predicate.passCategory;
+        return refine(getCodes(*predicate.categorical), rows, count,
+                      [&](std::uint32_t code) { return code < pass.size() && pass[code]; });
+    }
+    return dispatchScalar<size_t>(*predicate.column, [&](const auto& data) {
+        return withComparison(predicate.op, [&](auto cmp) {
+            const auto value = predicate.value;
+            return refine(data, rows, count, [&](auto v) {
+                const auto d = static_cast<double>(v);
+                return !isNaN(d) && cmp(d, value);
+            });
+        });
+    });
+}
+
+template <typename Fill>
+Selection filterRows(const DataFrame& dataframe, const std::vector<Predicate>& predicates,
+                     size_t size, Fill fill) {
+    IVW_TRACE_SCOPE("DataFrame", "Filter");
+    const auto compiled = compile(dataframe, predicates);
+
+    std::vector<Selection> parts(numberOfMorsels(size));
+    forEachMorsel(size, [&](size_t morsel, size_t begin, size_t end) {
+        auto& rows = parts[morsel];
+        rows.resize(end - begin);
+        fill(rows, begin);
+        auto count = rows.size();
+        for (const auto& predicate : compiled) {
+            count = apply(predicate, rows.data(), count);
+        }
+        rows.resize(count);
+    });
+    return concatenate(parts);
+}
+
+// Sort
+
+template <typename Less>
+void parallelStableSort(Selection& rows, Less less) {
+    const auto size = rows.size();
+    if (numberOfMorsels(size) <= 1) {
+        std::stable_sort(rows.begin(), rows.end(), less);
+        return;
+    }
+    forEachMorsel(size, [&](size_t, size_t begin, size_t end) {
+        std::stable_sort(rows.begin() + begin, rows.begin() + end, less);
+    });
+
+    Selection buffer(size);
+    for (size_t width = morselSize; width < size; width *= 2) {
+        const auto pairs = (size + 2 * width - 1) / (2 * width);
+        util::parallelFor(
+            size_t{0}, pairs,
+            [&](size_t pair) {
+                const auto begin = rows.begin() + pair * 2 * width;
+                const auto middle = rows.begin() + std::min(size, pair * 2 * width + width);
+                const auto end = rows.begin() + std::min(size, pair * 2 * width + 2 * width);
+                std::merge(begin, middle, middle, end, buffer.begin() + pair * 2 * width, less);
+            },
+            1);
+        std::swap(rows, buffer);
+    }
+}
+
+struct NaNLast {
+    bool ascending;
+    template <typename T>
+    bool operator()(const T& a, const T& b) const {
+        if (isNaN(b)) return !isNaN(a);
+        return ascending ? a < b : b < a;
+    }
+};
+
+void sortByKey(const DataFrame& dataframe, const SortKey& key, Selection& rows) {
+    const auto& column =
+        getScalarColumn(dataframe, key.column, IVW_CONTEXT_CUSTOM("dataframeutil::sortRows"));
+
+    if (auto categorical = dynamic_cast<const CategoricalColumn*>(&column)) {
+        const auto& categories = categorical->getCategories();
+        std::vector<std::uint32_t> order(categories.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(),
+                  [&](auto a, auto b) { return categories[a] < categories[b]; });
+        std::vector<std::uint32_t> rank(categories.size() + 1, noRow);
+        for (std::uint32_t i = 0; i < order.size(); ++i) rank[order[i]] = i;
+
+        const auto& codes = getCodes(*categorical);
+        const auto rankOf = [&](std::uint32_t row) {
+            return rank[std::min<size_t>(codes[row], categories.size())];
+        };
+        if (key.ascending) {
+            parallelStableSort(rows, [&](auto a, auto b) { return rankOf(a) < rankOf(b); });
+        } else {
+            parallelStableSort(rows, [&](auto a, auto b) { return rankOf(b) < rankOf(a); });
+        }
+        return;
+    }
+
+    dispatchScalar<void>(column, [&](const auto& data) {
+        const NaNLast less{key.ascending};
+        parallelStableSort(rows, [&](auto a, auto b) { return less(data[a], data[b]); });
+    });
+}
+
+// Group by and join
+
+struct KeyColumn {
+    const Column* column;
+    const CategoricalColumn* categorical;
+    bool asDouble;
+    std::vector<std::uint64_t> codeMap;  // Maps categorical codes to key values if not empty
+};
+
+std::uint64_t doubleKey(double v) {
+    if (v == 0.0) v = 0.0;  // Treat -0 as 0
+    if (isNaN(v)) v = std::numeric_limits<double>::quiet_NaN();
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Encodes rows [begin, end) of \p key into `keys[(row - begin) * stride]`. Rows with NaN values
+ * or categories without a match are marked as not valid.
+ */
+void encodeKeys(const KeyColumn& key, size_t begin, size_t end, size_t stride,
+                std::uint64_t* keys, char* valid) {
+    if (key.categorical) {
+        const auto& codes = getCodes(*key.categorical);
+        for (size_t i = begin; i < end; ++i) {
+            auto& k = keys[(i - begin) * stride];
+            k = codes[i];
+            if (!key.codeMap.empty()) {
+                k = k < key.codeMap.size() ? key.codeMap[k] : noMatch;
+                if (k == noMatch) valid[i - begin] = 0;
+            }
+        }
+        return;
+    }
+
+    dispatchScalar<void>(*key.column, [&](const auto& data) {
+        using T = typename std::decay_t<decltype(data)>::value_type;
+        for (size_t i = begin; i < end; ++i) {
+            auto& k = keys[(i - begin) * stride];
+            if constexpr (std::is_integral_v<T>) {
+                if (!key.asDouble) {
+                    k = static_cast<std::uint64_t>(static_cast<std::int64_t>(data[i]));
+                    continue;
+                }
+            }
+            const auto d = static_cast<double>(data[i]);
+            k = doubleKey(d);
+            if (isNaN(d)) valid[i - begin] = 0;
+        }
+    });
+}
+
+/**
+ * Encodes the keys of rows [begin, end) into a row major matrix
+ */
+void encodeRows(const std::vector<KeyColumn>& keyColumns, size_t begin, size_t end,
+                std::vector<std::uint64_t>& keys, std::vector<char>& valid) {
+    const auto stride = keyColumns.size();
+    keys.resize((end - begin) * stride);
+    valid.assign(end - begin, 1);
+    for (size_t c = 0; c < stride; ++c) {
+        encodeKeys(keyColumns[c], begin, end, stride, keys.data() + c, valid.data());
+    }
+}
+
+struct Partial {
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    std::uint32_t count = 0;
+
+    void add(double v) {
+        if (isNaN(v)) return;
+        sum += v;
+        min = std::min(min, v);
+        max = std::max(max, v);
+        ++count;
+    }
+    void merge(const Partial& other) {
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        count += other.count;
+    }
+    double get(AggregateOp op) const {
+        if (count == 0 && op != AggregateOp::Sum) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        switch (op) {
+            case AggregateOp::Mean:
+                return sum / count;
+            case AggregateOp::Min:
+                return min;
+            case AggregateOp::Max:
+                return max;
+            case AggregateOp::Sum:
+            case AggregateOp::Count:
+            default:
+                return sum;
+        }
+    }
+};
+
+struct GroupTable {
+    std::unordered_map<Key, std::uint32_t, KeyHash> index;
+    std::vector<Key> keys;
+    Selection firstRows;
+    std::vector<Partial> partials;
+};
+
+std::string aggregateName(const Aggregate& aggregate) {
+    if (!aggregate.name.empty()) return aggregate.name;
+    switch (aggregate.op) {
+        case AggregateOp::Sum:
+            return "sum(" + aggregate.column + ")";
+        case AggregateOp::Mean:
+            return "mean(" + aggregate.column + ")";
+        case AggregateOp::Min:
+            return "min(" + aggregate.column + ")";
+        case AggregateOp::Max:
+            return "max(" + aggregate.column + ")";
+        case AggregateOp::Count:
+        default:
+            return aggregate.column.empty() ? "count" : "count(" + aggregate.column + ")";
+    }
+}
+
+}  // namespace
+
+Selection filter(const DataFrame& dataframe, const std::vector<Predicate>& predicates) {
+    return filterRows(dataframe, predicates, dataframe.getNumberOfRows(),
+                      [](Selection& rows, size_t begin) {
+                          std::iota(rows.begin(), rows.end(), static_cast<std::uint32_t>(begin));
+                      });
+}
+
+Selection filter(const DataFrame& dataframe, const std::vector<Predicate>& predicates,
+                 const Selection& selection) {
+    return filterRows(dataframe, predicates, selection.size(),
+                      [&](Selection& rows, size_t begin) {
+                          std::copy_n(selection.begin() + begin, rows.size(), rows.begin());
+                      });
+}
+
+Selection sortRows(const DataFrame& dataframe, const std::vector<SortKey>& keys) {
+    Selection rows(dataframe.getNumberOfRows());
+    std::iota(rows.begin(), rows.end(), 0u);
+    return sortRows(dataframe, keys, std::move(rows));
+}
+
+Selection sortRows(const DataFrame& dataframe, const std::vector<SortKey>& keys,
+                   Selection selection) {
+    IVW_TRACE_SCOPE("DataFrame", "Sort");
+    // Stable sorts from the least to the most significant key
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+        sortByKey(dataframe, *it, selection);
+    }
+    return selection;
+}
+
+std::shared_ptr<DataFrame> selectRows(const DataFrame& dataframe, const Selection& selection) {
+    IVW_TRACE_SCOPE("DataFrame", "Select rows");
+    const auto context = IVW_CONTEXT_CUSTOM("dataframeutil::selectRows");
+    auto result = std::make_shared<DataFrame>(static_cast<std::uint32_t>(selection.size()));
+    for (const auto& column : dataframe) {
+        if (isIndexColumn(dataframe, column)) continue;
+        gatherColumn(getScalarColumn(dataframe, column->getHeader(), context), selection,
+                     column->getHeader(), *result);
+    }
+    return result;
+}
+
+std::shared_ptr<DataFrame> groupBy(const DataFrame& dataframe,
+                                   const std::vector<std::string>& keys,
+                                   const std::vector<Aggregate>& aggregates) {
+    IVW_TRACE_SCOPE("DataFrame", "Group by");
+    const auto context = IVW_CONTEXT_CUSTOM("dataframeutil::groupBy");
+
+    std::vector<KeyColumn> keyColumns;
+    for (const auto& name : keys) {
+        const auto& column = getScalarColumn(dataframe, name, context);
+        keyColumns.push_back(
+            {&column, dynamic_cast<const CategoricalColumn*>(&column), isFloat(column), {}});
+    }
+    std::vector<const Column*> aggregateColumns;
+    for (const auto& aggregate : aggregates) {
+        if (aggregate.op == AggregateOp::Count && aggregate.column.empty()) {
+            aggregateColumns.push_back(nullptr);
+            continue;
+        }
+        const auto& column = getScalarColumn(dataframe, aggregate.column, context);
+        if (aggregate.op != AggregateOp::Count && dynamic_cast<const CategoricalColumn*>(&column)) {
+            throw DataTypeMismatch(
+                "Categorical column \"" + aggregate.column + "\" can only be counted", context);
+        }
+        aggregateColumns.push_back(&column);
+    }
+
+    const auto rows = dataframe.getNumberOfRows();
+    const auto nKeys = keyColumns.size();
+    const auto nAggregates = aggregates.size();
+
+    // Aggregate each morsel into a local table
+    std::vector<GroupTable> tables(numberOfMorsels(rows));
+    forEachMorsel(rows, [&](size_t morsel, size_t begin, size_t end) {
+        auto& table = tables[morsel];
+        std::vector<std::uint64_t> encoded;
+        std::vector<char> valid;
+        encodeRows(keyColumns, begin, end, encoded, valid);
+
+        std::vector<std::uint32_t> groupOfRow(end - begin);
+        Key key(nKeys);
+        for (size_t i = 0; i < end - begin; ++i) {
+            std::copy_n(encoded.begin() + i * nKeys, nKeys, key.begin());
+            const auto [it, inserted] =
+                table.index.try_emplace(key, static_cast<std::uint32_t>(table.keys.size()));
+            if (inserted) {
+                table.keys.push_back(key);
+                table.firstRows.push_back(static_cast<std::uint32_t>(begin + i));
+            }
+            groupOfRow[i] = it->second;
+        }
+
+        table.partials.resize(table.keys.size() * nAggregates);
+        for (size_t a = 0; a < nAggregates; ++a) {
+            const auto column = aggregateColumns[a];
+            if (!column || dynamic_cast<const CategoricalColumn*>(column)) {
+                for (size_t i = 0; i < end - begin; ++i) {
+                    table.partials[groupOfRow[i] * nAggregates + a].add(0.0);
+                }
+                continue;
+            }
+            dispatchScalar<void>(*column, [&](const auto& data) {
+                for (size_t i = 0; i < end - begin; ++i) {
+                    table.partials[groupOfRow[i] * nAggregates + a].add(
+                        static_cast<double>(data[begin + i]));
+                }
+            });
+        }
+    });
+
+    // Merge the tables in order, which keeps the groups in order of their first row
+    std::unordered_map<Key, std::uint32_t, KeyHash> index;
+    Selection firstRows;
+    std::vector<Partial> totals;
+    for (auto& table : tables) {
+        for (size_t g = 0; g < table.keys.size(); ++g) {
+            const auto [it, inserted] = index.try_emplace(
+                std::move(table.keys[g]), static_cast<std::uint32_t>(firstRows.size()));
+            if (inserted) {
+                firstRows.push_back(table.firstRows[g]);
+                totals.resize(totals.size() + nAggregates);
+            }
+            for (size_t a = 0; a < nAggregates; ++a) {
+                totals[it->second * nAggregates + a].merge(table.partials[g * nAggregates + a]);
+            }
+        }
+    }
+
+    const auto groups = firstRows.size();
+    auto result = std::make_shared<DataFrame>(static_cast<std::uint32_t>(groups));
+    for (const auto& key : keyColumns) {
+        gatherColumn(*key.column, firstRows, key.column->getHeader(), *result);
+    }
+    for (size_t a = 0; a < nAggregates; ++a) {
+        const auto op = aggregates[a].op;
+        if (op == AggregateOp::Count) {
+            std::vector<std::uint32_t> counts(groups);
+            for (size_t g = 0; g < groups; ++g) counts[g] = totals[g * nAggregates + a].count;
+            result->addColumn(aggregateName(aggregates[a]), std::move(counts));
+        } else {
+            std::vector<double> values(groups);
+            for (size_t g = 0; g < groups; ++g) values[g] = totals[g * nAggregates + a].get(op);
+            result->addColumn(aggregateName(aggregates[a]), std::move(values));
+        }
+    }
+    return result;
+}
+
+JoinResult joinRows(const DataFrame& left, const DataFrame& right,
+                    const std::vector<std::string>& keys) {
+    IVW_TRACE_SCOPE("DataFrame", "Join");
+    const auto context = IVW_CONTEXT_CUSTOM("dataframeutil::joinRows");
+    if (keys.empty()) {
+        throw Exception("No join keys given", context);
+    }
+
+    std::vector<KeyColumn> leftKeys;
+    std::vector<KeyColumn> rightKeys;
+    for (const auto& name : keys) {
+        const auto& leftColumn = getScalarColumn(left, name, context);
+        const auto& rightColumn = getScalarColumn(right, name, context);
+        const auto leftCategorical = dynamic_cast<const CategoricalColumn*>(&leftColumn);
+        const auto rightCategorical = dynamic_cast<const CategoricalColumn*>(&rightColumn);
+        if (!leftCategorical != !rightCategorical) {
+            throw DataTypeMismatch(
+                "Key \"" + name + "\" has to be categorical in both or neither DataFrame",
+                context);
+        }
+        const bool asDouble = isFloat(leftColumn) || isFloat(rightColumn);
+        leftKeys.push_back({&leftColumn, leftCategorical, asDouble, {}});
+        rightKeys.push_back({&rightColumn, rightCategorical, asDouble, {}});
+
+        if (leftCategorical) {
+            // Match categories by their strings, using the codes of the left column as keys
+            std::unordered_map<std::string, std::uint64_t> codes;
+            const auto& leftCategories = leftCategorical->getCategories();
+            for (size_t i = 0; i < leftCategories.size(); ++i) {
+                codes.try_emplace(leftCategories[i], i);
+            }
+            auto& codeMap = rightKeys.back().codeMap;
+            for (const auto& category : rightCategorical->getCategories()) {
+                const auto it = codes.find(category);
+                codeMap.push_back(it != codes.end() ? it->second : noMatch);
+            }
+            // Make sure that an empty map is not mistaken for the identity
+            codeMap.push_back(noMatch);
+        }
+    }
+
+    // Build a hash table over the right rows, chaining rows with equal keys in ascending order
+    const auto nKeys = keys.size();
+    const auto rightRows = right.getNumberOfRows();
+    std::vector<std::uint64_t> rightEncoded(rightRows * nKeys);
+    std::vector<char> rightValid(rightRows);
+    forEachMorsel(rightRows, [&](size_t, size_t begin, size_t end) {
+        std::fill(rightValid.begin() + begin, rightValid.begin() + end, 1);
+        for (size_t c = 0; c < nKeys; ++c) {
+            encodeKeys(rightKeys[c], begin, end, nKeys, rightEncoded.data() + begin * nKeys + c,
+                       rightValid.data() + begin);
+        }
+    });
+
+    std::unordered_map<Key, std::uint32_t, KeyHash> heads;
+    heads.reserve(rightRows);
+    std::vector<std::uint32_t> next(rightRows, noRow);
+    Key key(nKeys);
+    for (size_t row = rightRows; row-- > 0;) {
+        if (!rightValid[row]) continue;
+        std::copy_n(rightEncoded.begin() + row * nKeys, nKeys, key.begin());
+        const auto [it, inserted] = heads.try_emplace(key, static_cast<std::uint32_t>(row));
+        if (!inserted) {
+            next[row] = it->second;
+            it->second = static_cast<std::uint32_t>(row);
+        }
+    }
+
+    // Probe with the left rows
+    const auto leftRows = left.getNumberOfRows();
+    std::vector<JoinResult> parts(numberOfMorsels(leftRows));
+    forEachMorsel(leftRows, [&](size_t morsel, size_t begin, size_t end) {
+        auto& part = parts[morsel];
+        std::vector<std::uint64_t> encoded;
+        std::vector<char> valid;
+        encodeRows(leftKeys, begin, end, encoded, valid);
+
+        Key probe(nKeys);
+        for (size_t i = 0; i < end - begin; ++i) {
+            if (!valid[i]) continue;
+            std::copy_n(encoded.begin() + i * nKeys, nKeys, probe.begin());
+            const auto it = heads.find(probe);
+            if (it == heads.end()) continue;
+            for (auto row = it->second; row != noRow; row = next[row]) {
+                part.left.push_back(static_cast<std::uint32_t>(begin + i));
+                part.right.push_back(row);
+            }
+        }
+    });
+
+    std::vector<Selection> leftParts;
+    std::vector<Selection> rightParts;
+    for (auto& part : parts) {
+        leftParts.push_back(std::move(part.left));
+        rightParts.push_back(std::move(part.right));
+    }
+    return {concatenate(leftParts), concatenate(rightParts)};
+}
+
+std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
+                                     const std::vector<std::string>& keys) {
+    const auto rows = joinRows(left, right, keys);
+
+    IVW_TRACE_SCOPE("DataFrame", "Select rows");
+    const auto context = IVW_CONTEXT_CUSTOM("dataframeutil::innerJoin");
+    auto result = std::make_shared<DataFrame>(static_cast<std::uint32_t>(rows.left.size()));
+    for (const auto& column : left) {
+        if (isIndexColumn(left, column)) continue;
+        gatherColumn(getScalarColumn(left, column->getHeader(), context), rows.left,
+                     column->getHeader(), *result);
+    }
+    for (const auto& column : right) {
+        const auto& header = column->getHeader();
+        if (isIndexColumn(right, column) || util::contains(keys, header)) continue;
+        gatherColumn(getScalarColumn(right, header, context), rows.right,
+                     left.getColumn(header) ? header + "_right" : header, *result);
+    }
+    return result;
+}
+
+}  // namespace dataframeutil
+
+}  // namespace inviwo
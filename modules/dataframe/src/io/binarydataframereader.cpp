@@ -0,0 +1,200 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/memorymappedfile.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+T read(std::istream& is) {
+    T value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+std::string readString(std::istream& is, std::uint64_t fileSize) {
+    const auto size = read<std::uint64_t>(is);
+    if (!is || size > fileSize) {
+        throw DataReaderException("Invalid binary DataFrame file, bad string length",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    std::string str(static_cast<size_t>(size), '\0');
+    is.read(&str[0], static_cast<std::streamsize>(size));
+    return str;
+}
+
+/**
+ * Copies the data block of a column from a memory mapping of the file into a BufferRAM.
+ */
+class ColumnBlockLoader : public DiskRepresentationLoader<BufferRepresentation> {
+public:
+    ColumnBlockLoader(const std::string& fileName, std::uint64_t offset)
+        : fileName_{fileName}, offset_{offset} {}
+    virtual ColumnBlockLoader* clone() const override { return new ColumnBlockLoader(*this); }
+    virtual ~ColumnBlockLoader() = default;
+
+    virtual std::shared_ptr<BufferRepresentation> createRepresentation(
+        const BufferRepresentation& src) const override {
+        auto ram = createBufferRAM(src.getSize(), src.getDataFormat(), src.getBufferUsage(),
+                                   src.getBufferTarget());
+        copyInto(*ram);
+        return ram;
+    }
+
+    virtual void updateRepresentation(std::shared_ptr<BufferRepresentation> dest,
+                                      const BufferRepresentation& src) const override {
+        auto ram = std::static_pointer_cast<BufferRAM>(dest);
+        if (ram->getSize() != src.getSize()) ram->setSize(src.getSize());
+        copyInto(*ram);
+    }
+
+private:
+    void copyInto(BufferRAM& ram) const {
+        const auto size = ram.getSize() * ram.getSizeOfElement();
+        if (size == 0) return;
+        util::MemoryMappedFile file(fileName_, static_cast<size_t>(offset_), size);
+        std::memcpy(ram.getData(), file.data(), size);
+    }
+
+    std::string fileName_;
+    std::uint64_t offset_;
+};
+
+struct ColumnDispatcher {
+    template <typename Result, typename Format>
+    Result operator()(const std::string& header, std::shared_ptr<BufferDisk> disk) {
+        using T = typename Format::type;
+        auto buffer = std::make_shared<Buffer<T>>(disk->getSize());
+        buffer->addRepresentation(disk);
+        return std::make_shared<TemplateColumn<T>>(header, buffer);
+    }
+};
+
+}  // namespace
+
+BinaryDataFrameReader::BinaryDataFrameReader() : DataReaderType<DataFrame>() {
+    addExtension(FileExtension("ivdf", "Inviwo Binary DataFrame"));
+}
+
+BinaryDataFrameReader* BinaryDataFrameReader::clone() const {
+    return new BinaryDataFrameReader(*this);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(const std::string& fileName) {
+    using namespace binarydataframe;
+
+    auto in = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        throw FileException("BinaryDataFrameReader: Could not open file \"" + fileName + "\".",
+                            IVW_CONTEXT);
+    }
+    in.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    std::array<char, 8> fileMagic{};
+    in.read(fileMagic.data(), fileMagic.size());
+    if (!in || fileMagic != magic) {
+        throw DataReaderException("Not a binary DataFrame file: " + fileName, IVW_CONTEXT);
+    }
+    const auto fileVersion = read<std::uint32_t>(in);
+    if (fileVersion != version) {
+        throw DataReaderException("Unsupported binary DataFrame version " +
+                                      std::to_string(fileVersion) + " in " + fileName,
+                                  IVW_CONTEXT);
+    }
+    if (read<std::uint32_t>(in) != byteOrderMark) {
+        throw DataReaderException("Binary DataFrame file has wrong byte order: " + fileName,
+                                  IVW_CONTEXT);
+    }
+    const auto columnCount = read<std::uint64_t>(in);
+    const auto rows = read<std::uint64_t>(in);
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    for (std::uint64_t i = 0; i < columnCount; ++i) {
+        const auto kind = static_cast<ColumnKind>(read<std::uint32_t>(in));
+        const auto formatId = read<std::uint32_t>(in);
+        const auto header = readString(in, fileSize);
+        const auto offset = read<std::uint64_t>(in);
+        const auto size = read<std::uint64_t>(in);
+        std::vector<std::string> categories;
+        if (kind == ColumnKind::Categorical) {
+            const auto categoryCount = read<std::uint64_t>(in);
+            for (std::uint64_t c = 0; c < categoryCount && in; ++c) {
+                categories.push_back(readString(in, fileSize));
+            }
+        }
+        if (!in) {
+            throw DataReaderException("Unexpected end of file in column directory: " + fileName,
+                                      IVW_CONTEXT);
+        }
+
+        const auto format =
+            formatId < static_cast<std::uint32_t>(DataFormatId::NumberOfFormats)
+                ? DataFormatBase::get(static_cast<DataFormatId>(formatId))
+                : nullptr;
+        if (!format || format->getComponents() != 1 || size != rows * format->getSize() ||
+            offset > fileSize || size > fileSize - offset ||
+            (kind == ColumnKind::Categorical && format->getId() != DataFormatId::UInt32)) {
+            throw DataReaderException("Invalid column '" + header + "' in " + fileName,
+                                      IVW_CONTEXT);
+        }
+
+        auto disk = std::make_shared<BufferDisk>(fileName, static_cast<size_t>(rows), format);
+        disk->setLoader(new ColumnBlockLoader(fileName, offset));
+        if (kind == ColumnKind::Categorical) {
+            auto buffer = std::make_shared<Buffer<std::uint32_t>>(static_cast<size_t>(rows));
+            buffer->addRepresentation(disk);
+            dataFrame->addColumn(
+                std::make_shared<CategoricalColumn>(header, buffer, std::move(categories)));
+        } else {
+            dataFrame->addColumn(
+                dispatching::dispatch<std::shared_ptr<Column>, dispatching::filter::Scalars>(
+                    format->getId(), ColumnDispatcher{}, header, disk));
+        }
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace inviwo
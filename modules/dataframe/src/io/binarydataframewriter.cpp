@@ -0,0 +1,154 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+void write(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& os, const std::string& str) {
+    write(os, static_cast<std::uint64_t>(str.size()));
+    os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+}  // namespace
+
+BinaryDataFrameWriter::BinaryDataFrameWriter() : DataWriterType<DataFrame>() {
+    addExtension(FileExtension("ivdf", "Inviwo Binary DataFrame"));
+}
+
+BinaryDataFrameWriter* BinaryDataFrameWriter::clone() const {
+    return new BinaryDataFrameWriter(*this);
+}
+
+void BinaryDataFrameWriter::writeData(const DataFrame* data, const std::string filePath) const {
+    if (filesystem::fileExists(filePath) && !getOverwrite()) {
+        throw DataWriterException("File already exists: " + filePath, IVW_CONTEXT);
+    }
+    auto f = filesystem::ofstream(filePath, std::ios_base::out | std::ios_base::binary);
+    writeData(data, f);
+}
+
+std::unique_ptr<std::vector<unsigned char>> BinaryDataFrameWriter::writeDataToBuffer(
+    const DataFrame* data, const std::string& /*fileExtension*/) const {
+    std::stringstream ss(std::ios_base::out | std::ios_base::binary);
+    writeData(data, ss);
+    auto stringdata = ss.str();
+    return std::make_unique<std::vector<unsigned char>>(stringdata.begin(), stringdata.end());
+}
+
+void BinaryDataFrameWriter::writeData(const DataFrame* data, std::ostream& os) const {
+    using namespace binarydataframe;
+
+    const auto rows = static_cast<std::uint64_t>(data->getNumberOfRows());
+    // skip the index column, it is recreated by the reader
+    const std::vector<std::shared_ptr<const Column>> columns(std::next(data->begin()),
+                                                             data->end());
+
+    // The directory is written first with zero offsets, which are filled in once the size of the
+    // directory is known
+    std::ostringstream dir(std::ios_base::out | std::ios_base::binary);
+    dir.write(magic.data(), magic.size());
+    write(dir, version);
+    write(dir, byteOrderMark);
+    write(dir, static_cast<std::uint64_t>(columns.size()));
+    write(dir, rows);
+
+    std::vector<std::streamoff> offsetPositions;
+    std::vector<const BufferRAM*> blocks;
+    for (const auto& column : columns) {
+        const auto buffer = column->getBuffer()->getRepresentation<BufferRAM>();
+        const auto format = buffer->getDataFormat();
+        if (format->getComponents() != 1) {
+            throw DataWriterException("Column '" + column->getHeader() + "' of type " +
+                                          format->getString() + " is not scalar",
+                                      IVW_CONTEXT);
+        }
+        if (buffer->getSize() != rows) {
+            throw DataWriterException("Column '" + column->getHeader() + "' has " +
+                                          std::to_string(buffer->getSize()) + " rows, expected " +
+                                          std::to_string(rows),
+                                      IVW_CONTEXT);
+        }
+        const auto categorical = dynamic_cast<const CategoricalColumn*>(column.get());
+
+        write(dir, categorical ? ColumnKind::Categorical : ColumnKind::Plain);
+        write(dir, static_cast<std::uint32_t>(format->getId()));
+        write(dir, column->getHeader());
+        offsetPositions.push_back(dir.tellp());
+        write(dir, std::uint64_t{0});
+        write(dir, static_cast<std::uint64_t>(rows * format->getSize()));
+        if (categorical) {
+            const auto& categories = categorical->getCategories();
+            write(dir, static_cast<std::uint64_t>(categories.size()));
+            for (const auto& category : categories) {
+                write(dir, category);
+            }
+        }
+        blocks.push_back(buffer);
+    }
+
+    auto directory = dir.str();
+    std::vector<std::uint64_t> offsets;
+    std::uint64_t pos = directory.size();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        pos = (pos + alignment - 1) / alignment * alignment;
+        offsets.push_back(pos);
+        std::memcpy(&directory[static_cast<size_t>(offsetPositions[i])], &pos, sizeof(pos));
+        pos += rows * blocks[i]->getSizeOfElement();
+    }
+
+    os.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+    const std::array<char, alignment> padding{};
+    pos = directory.size();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const auto size = rows * blocks[i]->getSizeOfElement();
+        os.write(padding.data(), static_cast<std::streamsize>(offsets[i] - pos));
+        os.write(static_cast<const char*>(blocks[i]->getData()),
+                 static_cast<std::streamsize>(size));
+        pos = offsets[i] + size;
+    }
+}
+
+}  // namespace inviwo
@@ -32,86 +32,50 @@
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/memorymappedfile.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/taskgroup.h>
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <exception>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
 
 namespace inviwo {
 
-CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
-    : DataReaderException("CSVReader: " + message, context) {}
-
-CSVReader::CSVReader() : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true) {
-    addExtension(FileExtension("csv", "Comma Separated Values"));
-}
-
-CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
-
-void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
-
-void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader; }
-
-std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
-    auto file = filesystem::ifstream(fileName);
-
-    if (!file.is_open()) {
-        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
-                            IVW_CONTEXT);
-    }
-    file.seekg(0, std::ios::end);
-    std::streampos len = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    if (len == std::streampos(0)) {
-        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
-    }
-
-    return readData(file);
-}
+namespace {
 
-std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
-    // Skip BOM if it exists. Added by for example Excel when saving csv files.
-    filesystem::skipByteOrderMark(stream);
-
-    if (stream.bad() || stream.fail()) {
-        throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
-    }
-
-    // create a string stream from input stream for buffering
-    std::stringstream in;
-    in << stream.rdbuf();
-    if (in.fail()) {
-        throw CSVDataReaderException("No data", IVW_CONTEXT);
-    }
+constexpr size_t noColumnLimit = std::numeric_limits<size_t>::max();
 
-    // current line
-    size_t lineNumber = 1u;
+/**
+ * Splits CSV data into fields and rows. Works on a range of characters but behaves like a stream,
+ * i.e. the end-of-file flag is only set once a read past the end has been attempted.
+ */
+class CSVTokenizer {
+public:
+    CSVTokenizer(const char* begin, const char* end, std::string_view delimiters,
+                 size_t lineNumber)
+        : pos_{begin}, end_{end}, delimiters_{delimiters}, lineNumber_{lineNumber} {}
 
-    // extract exactly one field from the current stream position, the bool return value indicates
+    // extract exactly one field from the current position, the bool return value indicates
     // whether a line break was detected following the field
-    auto extractField = [&in, &lineNumber, delims = delimiters_]() -> std::pair<std::string, bool> {
+    std::pair<std::string, bool> extractField() {
         std::string value;
         size_t quoteCount = 0;
         size_t quoteBeginLine = 0;
         char prev = 0;
 
-        auto isLineBreak = [](const char ch, std::istream& stream) {
-            if (ch == '\r') {
-                // consume potential LF (\n) following CR (\r)
-                if (stream.peek() == '\n') {
-                    stream.get();
-                }
-                return true;
-            } else {
-                return (ch == '\n');
-            }
-        };
-
         char ch;
-        while (in.get(ch) && in.good()) {
-            bool linebreak = isLineBreak(ch, in);
+        while (get(ch)) {
+            bool linebreak = isLineBreak(ch);
             if (linebreak) {
-                ++lineNumber;  // increase line counter
+                ++lineNumber_;  // increase line counter
                 // ensure that ch is equal to '\n'
                 ch = '\n';
                 // consume line break, if inside quotes
@@ -122,9 +86,9 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
                 }
             }
             if (ch == '"') {  // found a quote
-                if (quoteCount == 0) quoteBeginLine = lineNumber;
+                if (quoteCount == 0) quoteBeginLine = lineNumber_;
                 ++quoteCount;
-            } else if (util::contains(delims, ch) || linebreak) {
+            } else if (delimiters_.find(ch) != std::string_view::npos || linebreak) {
                 // found a delimiter/newline, ensure that it isn't enclosed by quotes,
                 // i.e. a quote count of 0 or an even count of quotes if the previous
                 // character was a quote
@@ -135,20 +99,18 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
             prev = ch;
             value += ch;
         }
-        if (((quoteCount & 1) != 0) && in.eof()) {
+        if (((quoteCount & 1) != 0) && eof_) {
             throw CSVDataReaderException("Unmatched quotes (starting in line " +
                                          std::to_string(quoteBeginLine) + ")");
         }
         return {value, false};
-    };
+    }
 
-    // extract one row from the current stream position, the bool return value indicates whether
+    // extract one row from the current position, the bool return value indicates whether
     // the end-of-file was detected
-    auto extractRow = [&in, extractField,
-                       &lineNumber](size_t maxColCount = std::numeric_limits<size_t>::max())
-        -> std::pair<std::vector<std::string>, bool> {
+    std::pair<std::vector<std::string>, bool> extractRow(size_t maxColCount = noColumnLimit) {
         auto val = extractField();
-        if (in.eof() && val.first.empty()) {
+        if (eof_ && val.first.empty()) {
             // reached end of file, no more data
             return {{}, true};
         } else if (val.first.empty() && val.second) {
@@ -156,30 +118,283 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
             return {{}, false};
         }
         std::vector<std::string> values;
-        values.push_back(val.first);
-        while (!val.second && !in.eof()) {
+        values.push_back(std::move(val.first));
+        while (!val.second && !eof_) {
             val = extractField();
             values.push_back(trim(val.first));
         }
         // ignore last field _if_ it is empty and would be inserted in the maxColCount+1 column
         if (values.back().empty() && (values.size() - 1 == maxColCount)) {
             values.resize(values.size() - 1);
-        } else if ((values.size() != maxColCount) &&
-                   (maxColCount != std::numeric_limits<size_t>::max())) {
+        } else if ((values.size() != maxColCount) && (maxColCount != noColumnLimit)) {
             // mismatch in the number of columns
             throw CSVDataReaderException("Column counts do not match (line " +
-                                         std::to_string(lineNumber) + ": " +
+                                         std::to_string(lineNumber_) + ": " +
                                          std::to_string(values.size()) + " fields; DataFrame has " +
                                          std::to_string(maxColCount) + " columns)");
         }
         return {values, false};
+    }
+
+    const char* position() const { return pos_; }
+    size_t lineNumber() const { return lineNumber_; }
+
+    void seek(const char* pos, size_t lineNumber) {
+        pos_ = pos;
+        lineNumber_ = lineNumber;
+        eof_ = false;
+    }
+
+private:
+    bool get(char& ch) {
+        if (pos_ == end_) {
+            eof_ = true;
+            return false;
+        }
+        ch = *pos_++;
+        return true;
+    }
+
+    bool isLineBreak(char ch) {
+        if (ch == '\r') {
+            // consume potential LF (\n) following CR (\r)
+            if (pos_ == end_) {
+                eof_ = true;
+            } else if (*pos_ == '\n') {
+                ++pos_;
+            }
+            return true;
+        } else {
+            return (ch == '\n');
+        }
+    }
+
+    const char* pos_;
+    const char* end_;
+    std::string_view delimiters_;
+    size_t lineNumber_;
+    bool eof_ = false;
+};
+
+bool isEmptyRow(const std::vector<std::string>& row) {
+    return std::all_of(row.begin(), row.end(), [](const auto& a) { return a.empty(); });
+}
+
+struct RowStart {
+    const char* pos;
+    size_t lineNumber;
+};
+
+/**
+ * Find the start of all rows in [begin, end), i.e. the positions following line breaks that are
+ * not enclosed in quotes. The data is split into chunks which are scanned in parallel. A first
+ * pass counts the quotes and line breaks of each chunk, which gives the quote state and the line
+ * number at the start of every chunk. A second pass then collects the row starts.
+ */
+std::vector<RowStart> findRowStarts(const char* begin, const char* end, size_t lineNumber) {
+    constexpr size_t chunkSize = size_t{1} << 20;
+    const auto size = static_cast<size_t>(end - begin);
+    const auto chunkBegin = [&](size_t chunk) { return begin + std::min(chunk * chunkSize, size); };
+    // CR LF is a single line break
+    const auto isLineBreak = [begin](const char* it) {
+        return *it == '\r' || (*it == '\n' && (it == begin || *(it - 1) != '\r'));
+    };
+
+    struct Chunk {
+        size_t quotes = 0;
+        size_t lineBreaks = 0;
+        bool quoted = false;
+        size_t lineNumber = 0;
+        std::vector<RowStart> rows;
+    };
+    std::vector<Chunk> chunks(std::max(size_t{1}, (size + chunkSize - 1) / chunkSize));
+    const auto firstLineNumber = lineNumber;
+
+    util::parallelFor(size_t{0}, chunks.size(), [&](size_t i) {
+        auto& chunk = chunks[i];
+        for (auto it = chunkBegin(i); it != chunkBegin(i + 1); ++it) {
+            if (*it == '"') {
+                ++chunk.quotes;
+            } else if (isLineBreak(it)) {
+                ++chunk.lineBreaks;
+            }
+        }
+    });
+
+    bool quoted = false;
+    for (auto& chunk : chunks) {
+        chunk.quoted = quoted;
+        chunk.lineNumber = lineNumber;
+        quoted ^= (chunk.quotes & 1) != 0;
+        lineNumber += chunk.lineBreaks;
+    }
+
+    util::parallelFor(size_t{0}, chunks.size(), [&](size_t i) {
+        auto& chunk = chunks[i];
+        for (auto it = chunkBegin(i); it != chunkBegin(i + 1); ++it) {
+            if (*it == '"') {
+                chunk.quoted = !chunk.quoted;
+            } else if (isLineBreak(it)) {
+                ++chunk.lineNumber;
+                if (!chunk.quoted) {
+                    const bool crlf = *it == '\r' && it + 1 != end && *(it + 1) == '\n';
+                    chunk.rows.push_back({it + (crlf ? 2 : 1), chunk.lineNumber});
+                }
+            }
+        }
+    });
+
+    std::vector<RowStart> rows{{begin, firstLineNumber}};
+    for (auto& chunk : chunks) {
+        rows.insert(rows.end(), chunk.rows.begin(), chunk.rows.end());
+    }
+    return rows;
+}
+
+/**
+ * Convert a string to float with the same result as TemplateColumn<float>::add, i.e. NaN for
+ * values that cannot be converted. Uses std::from_chars where available, which is much faster than
+ * going through a stream.
+ */
+float toFloat(const std::string& str) {
+    if (str.empty()) return std::numeric_limits<float>::quiet_NaN();
+#if defined(__cpp_lib_to_chars)
+    {
+        float result;
+        const auto last = str.data() + str.size();
+        const auto [ptr, ec] = std::from_chars(str.data(), last, result);
+        // from_chars accepts "inf" and "nan" which the stream does not, use the stream for those
+        if (ec == std::errc{} && ptr == last && std::isfinite(result)) return result;
+    }
+#endif
+    float result;
+    std::istringstream stream(str);
+    stream >> result;
+    return stream.fail() ? std::numeric_limits<float>::quiet_NaN() : result;
+}
+
+/**
+ * Add the rows in [begin, end) to the DataFrame. The rows are located, split into fields, and
+ * converted in parallel, one window of rows at a time to limit the memory used for the fields.
+ * The float columns are written directly into their buffers, categorical columns are filled in
+ * row order to keep the order of the categories. A row that does not end where expected can only
+ * be caused by a malformed quote, in which case the remaining rows are read sequentially to get
+ * exactly the same result, or error, as the sequential tokenizer.
+ */
+void addRows(DataFrame& dataFrame, const char* begin, const char* end, size_t lineNumber,
+             std::string_view delimiters, size_t colCount) {
+    constexpr size_t windowSize = size_t{1} << 16;
+    constexpr size_t rowsPerTask = 512;
+
+    struct FloatColumn {
+        size_t field;
+        std::vector<float>* data;
+    };
+    struct OtherColumn {
+        size_t field;
+        std::shared_ptr<Column> column;
     };
+    std::vector<FloatColumn> floatColumns;
+    std::vector<OtherColumn> otherColumns;
+    for (size_t i = 0; i < colCount; ++i) {
+        auto column = dataFrame.getColumn(i + 1);
+        if (auto floatColumn = std::dynamic_pointer_cast<TemplateColumn<float>>(column)) {
+            floatColumns.push_back(
+                {i, &floatColumn->getTypedBuffer()->getEditableRAMRepresentation()
+                         ->getDataContainer()});
+        } else {
+            otherColumns.push_back({i, column});
+        }
+    }
+
+    const auto rowStarts = findRowStarts(begin, end, lineNumber);
+
+    std::vector<std::vector<std::string>> rows(std::min(windowSize, rowStarts.size()));
+    std::vector<std::exception_ptr> errors(rows.size());
+    std::vector<size_t> nonEmptyRows;
+    for (size_t first = 0; first < rowStarts.size(); first += windowSize) {
+        const auto count = std::min(windowSize, rowStarts.size() - first);
+        std::atomic<bool> misaligned{false};
+        util::parallelFor(
+            size_t{0}, count,
+            [&](size_t i) {
+                const auto row = first + i;
+                const auto rowEnd = row + 1 < rowStarts.size() ? rowStarts[row + 1].pos : end;
+                try {
+                    CSVTokenizer tokenizer{rowStarts[row].pos, end, delimiters,
+                                           rowStarts[row].lineNumber};
+                    rows[i] = tokenizer.extractRow(colCount).first;
+                    errors[i] = nullptr;
+                    if (tokenizer.position() != rowEnd) misaligned = true;
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            },
+            rowsPerTask);
+
+        if (misaligned) {
+            CSVTokenizer tokenizer{rowStarts[first].pos, end, delimiters,
+                                   rowStarts[first].lineNumber};
+            auto row = tokenizer.extractRow(colCount);
+            while (!row.second) {
+                if (!isEmptyRow(row.first)) {
+                    // May throw DataTypeMismatch, but do not catch it here since it indicates
+                    // that the DataFrame is in an invalid state
+                    dataFrame.addRow(row.first);
+                }
+                row = tokenizer.extractRow(colCount);
+            }
+            return;
+        }
+        const auto error = std::find_if(errors.begin(), errors.begin() + count,
+                                        [](const auto& e) { return e != nullptr; });
+        if (error != errors.begin() + count) {
+            std::rethrow_exception(*error);
+        }
+
+        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
+        nonEmptyRows.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (!isEmptyRow(rows[i])) nonEmptyRows.push_back(i);
+        }
+        const auto rowOffset = dataFrame.getColumn(1)->getSize();
+        for (auto& column : floatColumns) {
+            column.data->resize(rowOffset + nonEmptyRows.size());
+        }
+        util::parallelFor(
+            size_t{0}, nonEmptyRows.size(),
+            [&](size_t i) {
+                const auto& row = rows[nonEmptyRows[i]];
+                for (auto& column : floatColumns) {
+                    (*column.data)[rowOffset + i] = toFloat(row[column.field]);
+                }
+            },
+            rowsPerTask);
+        util::parallelFor(
+            size_t{0}, otherColumns.size(),
+            [&](size_t c) {
+                auto& column = otherColumns[c];
+                for (auto i : nonEmptyRows) {
+                    column.column->add(rows[i][column.field]);
+                }
+            },
+            1);
+    }
+}
+
+std::shared_ptr<DataFrame> parseCSV(std::string_view data, std::string_view delimiters,
+                                    bool firstRowHeader) {
+    if (data.empty()) {
+        throw CSVDataReaderException("No data", IVW_CONTEXT_CUSTOM("CSVReader"));
+    }
+    const char* const end = data.data() + data.size();
+    CSVTokenizer tokenizer{data.data(), end, delimiters, 1u};
 
     std::vector<std::string> headers;
-    size_t maxColCount = std::numeric_limits<size_t>::max();
-    if (firstRowHeader_) {
+    size_t maxColCount = noColumnLimit;
+    if (firstRowHeader) {
         // read headers
-        auto row = extractRow();
+        auto row = tokenizer.extractRow();
         if (row.second || row.first.empty()) {
             throw CSVDataReaderException("Empty file, column headers not found");
         }
@@ -189,16 +404,16 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
 
     std::vector<std::vector<std::string>> exampleRows;
     std::vector<size_t> exampleLineNumbers;  // line numbers matching the example rows
-    std::streampos streamPos = in.tellg();
+    const char* const dataBegin = tokenizer.position();
+    const size_t dataLineNumber = tokenizer.lineNumber();
     for (auto exampleRow = 0u; exampleRow < 50u; ++exampleRow) {
-        size_t currentLine = lineNumber;
-        auto row = extractRow(maxColCount);
+        size_t currentLine = tokenizer.lineNumber();
+        auto row = tokenizer.extractRow(maxColCount);
         if (row.second) {
             // reached end-of-file
             if (exampleRow == 0) {
                 throw CSVDataReaderException("Empty file, no data");
             }
-            in.clear();  // clear eof-bit
             break;
         } else if (!row.first.empty()) {  // ignore empty lines
             exampleRows.emplace_back(row.first);
@@ -206,9 +421,11 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
         }
     }
 
-    // Rewind to start position
-    in.seekg(streamPos, std::ios::beg);
-    if (!firstRowHeader_) {
+    if (exampleRows.empty()) {
+        // only empty lines
+        throw CSVDataReaderException("Empty file, no data");
+    }
+    if (!firstRowHeader) {
         // assign default column headers
         for (size_t i = 0; i < exampleRows.front().size(); ++i) {
             headers.push_back(std::string("Column ") + std::to_string(i + 1));
@@ -229,23 +446,69 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
     }
 
     auto dataFrame = createDataFrame(exampleRows, headers);
-
-    size_t rowIndex = firstRowHeader_ ? 1 : 0;
-    auto row = extractRow(maxColCount);
-    while (!row.second) {
-        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
-        auto emptyIt = std::find_if(std::begin(row.first), std::end(row.first),
-                                    [](const auto& a) { return !a.empty(); });
-        if (emptyIt != row.first.end()) {
-            // May throw DataTypeMismatch, but do not catch it here since it indicates
-            // that the DataFrame is in an invalid state
-            dataFrame->addRow(row.first);
-        }
-        row = extractRow(maxColCount);
-        ++rowIndex;
-    }
+    addRows(*dataFrame, dataBegin, end, dataLineNumber, delimiters, maxColCount);
     dataFrame->updateIndexBuffer();
     return dataFrame;
 }
 
+}  // namespace
+
+CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
+    : DataReaderException("CSVReader: " + message, context) {}
+
+CSVReader::CSVReader() : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true) {
+    addExtension(FileExtension("csv", "Comma Separated Values"));
+}
+
+CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
+
+void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
+
+void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader; }
+
+std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
+    auto file = filesystem::ifstream(fileName);
+
+    if (!file.is_open()) {
+        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
+                            IVW_CONTEXT);
+    }
+    file.seekg(0, std::ios::end);
+    std::streampos len = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    if (len == std::streampos(0)) {
+        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
+    }
+
+    // Parse straight from a mapping of the file, use the stream if the file cannot be mapped
+    std::unique_ptr<util::MemoryMappedFile> mapping;
+    try {
+        mapping = std::make_unique<util::MemoryMappedFile>(fileName, 0, static_cast<size_t>(len));
+    } catch (const FileException&) {
+        return readData(file);
+    }
+    file.close();
+
+    std::string_view data{static_cast<const char*>(mapping->data()), mapping->size()};
+    // Skip BOM if it exists. Added by for example Excel when saving csv files.
+    if (data.substr(0, 3) == "\xef\xbb\xbf") {
+        data.remove_prefix(3);
+    }
+    return parseCSV(data, delimiters_, firstRowHeader_);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
+    // Skip BOM if it exists. Added by for example Excel when saving csv files.
+    filesystem::skipByteOrderMark(stream);
+
+    if (stream.bad() || stream.fail()) {
+        throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
+    }
+
+    const std::string data{std::istreambuf_iterator<char>{stream},
+                           std::istreambuf_iterator<char>{}};
+    return parseCSV(data, delimiters_, firstRowHeader_);
+}
+
 }  // namespace inviwo
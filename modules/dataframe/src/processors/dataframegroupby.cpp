@@ -0,0 +1,82 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframegroupby.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameGroupBy::processorInfo_{
+    "org.inviwo.DataFrameGroupBy",  // Class identifier
+    "DataFrame Group By",           // Display name
+    "DataFrame",                    // Category
+    CodeState::Experimental,        // Code state
+    "CPU, DataFrame, Query"         // Tags
+};
+const ProcessorInfo DataFrameGroupBy::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameGroupBy::DataFrameGroupBy()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , key_("key", "Key Column", inport_, false, 1)
+    , op_("op", "Aggregate",
+          {{"sum", "Sum", dataframeutil::AggregateOp::Sum},
+           {"mean", "Mean", dataframeutil::AggregateOp::Mean},
+           {"min", "Min", dataframeutil::AggregateOp::Min},
+           {"max", "Max", dataframeutil::AggregateOp::Max}},
+          1) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(key_, op_);
+}
+
+void DataFrameGroupBy::process() {
+    auto dataframe = inport_.getData();
+    auto key = key_.getColumn();
+    if (!key) {
+        outport_.setData(dataframe);
+        return;
+    }
+
+    std::vector<dataframeutil::Aggregate> aggregates{{"", dataframeutil::AggregateOp::Count, ""}};
+    for (const auto& column : *dataframe) {
+        if (column == dataframe->getIndexColumn() || column == key ||
+            dynamic_cast<const CategoricalColumn*>(column.get()) ||
+            column->getBuffer()->getDataFormat()->getComponents() != 1) {
+            continue;
+        }
+        aggregates.push_back({column->getHeader(), op_.get(), ""});
+    }
+
+    outport_.setData(dataframeutil::groupBy(*dataframe, {key->getHeader()}, aggregates));
+}
+
+}  // namespace inviwo
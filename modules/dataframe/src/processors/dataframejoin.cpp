@@ -0,0 +1,69 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframejoin.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameJoin::processorInfo_{
+    "org.inviwo.DataFrameJoin",  // Class identifier
+    "DataFrame Join",            // Display name
+    "DataFrame",                 // Category
+    CodeState::Experimental,     // Code state
+    "CPU, DataFrame, Query"      // Tags
+};
+const ProcessorInfo DataFrameJoin::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameJoin::DataFrameJoin()
+    : Processor()
+    , left_("left")
+    , right_("right")
+    , outport_("outport")
+    , key_("key", "Key Column", left_, false, 1) {
+
+    addPort(left_);
+    addPort(right_);
+    addPort(outport_);
+    addProperty(key_);
+}
+
+void DataFrameJoin::process() {
+    auto key = key_.getColumn();
+    if (!key) {
+        outport_.setData(left_.getData());
+        return;
+    }
+
+    outport_.setData(
+        dataframeutil::innerJoin(*left_.getData(), *right_.getData(), {key->getHeader()}));
+}
+
+}  // namespace inviwo
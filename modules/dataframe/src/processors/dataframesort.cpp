@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframesort.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameSort::processorInfo_{
+    "org.inviwo.DataFrameSort",  // Class identifier
+    "DataFrame Sort",            // Display name
+    "DataFrame",                 // Category
+    CodeState::Experimental,     // Code state
+    "CPU, DataFrame, Query"      // Tags
+};
+const ProcessorInfo DataFrameSort::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameSort::DataFrameSort()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , column_("column", "Column", inport_, false, 1)
+    , ascending_("ascending", "Ascending", true)
+    , secondaryColumn_("secondaryColumn", "Secondary Column", inport_, true, 0)
+    , secondaryAscending_("secondaryAscending", "Secondary Ascending", true) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(column_, ascending_, secondaryColumn_, secondaryAscending_);
+}
+
+void DataFrameSort::process() {
+    auto dataframe = inport_.getData();
+
+    std::vector<dataframeutil::SortKey> keys;
+    if (auto column = column_.getColumn()) {
+        keys.push_back({column->getHeader(), ascending_.get()});
+    }
+    if (auto column = secondaryColumn_.getColumn()) {
+        keys.push_back({column->getHeader(), secondaryAscending_.get()});
+    }
+    if (keys.empty()) {
+        outport_.setData(dataframe);
+        return;
+    }
+
+    outport_.setData(
+        dataframeutil::selectRows(*dataframe, dataframeutil::sortRows(*dataframe, keys)));
+}
+
+}  // namespace inviwo
@@ -41,6 +41,8 @@ const ProcessorInfo VolumeToDataFrame::processorInfo_{
     "Data Creation",                 // Category
     CodeState::Stable,               // Code state
     "CPU, DataFrame, Volume",        // Tags
+    true,                            // Visible
+    true,                            // Thread safe
 };
 const ProcessorInfo VolumeToDataFrame::getProcessorInfo() const { return processorInfo_; }
 
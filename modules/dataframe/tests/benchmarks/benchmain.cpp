@@ -0,0 +1,252 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/datastructures/representationutil.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+#include <inviwo/dataframe/io/csvreader.h>
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <numeric>
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+constexpr size_t numberOfColumns = 16;
+
+std::shared_ptr<DataFrame> createDataFrame(size_t rows) {
+    std::mt19937 gen(rows);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    auto dataframe = std::make_shared<DataFrame>();
+    for (size_t col = 0; col < numberOfColumns; ++col) {
+        std::vector<float> data(rows);
+        for (auto& v : data) v = dist(gen);
+        dataframe->addColumn("col" + std::to_string(col), std::move(data));
+    }
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+void writeCSV(const DataFrame& dataframe, const std::string& fileName) {
+    auto file = filesystem::ofstream(fileName);
+    for (size_t col = 1; col < dataframe.getNumberOfColumns(); ++col) {
+        file << (col > 1 ? "," : "") << dataframe.getHeader(col);
+    }
+    for (size_t row = 0; row < dataframe.getNumberOfRows(); ++row) {
+        file << '\n';
+        for (size_t col = 1; col < dataframe.getNumberOfColumns(); ++col) {
+            file << (col > 1 ? "," : "") << dataframe.getColumn(col)->getAsString(row);
+        }
+    }
+}
+
+void writeBinary(const DataFrame& dataframe, const std::string& fileName) {
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(&dataframe, fileName);
+}
+
+}  // namespace
+
+static void LoadCSV(benchmark::State& state) {
+    util::TempFileHandle file("", ".csv");
+    writeCSV(*createDataFrame(static_cast<size_t>(state.range(0))), file.getFileName());
+
+    CSVReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(file.getFileName());
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void LoadBinaryLazy(benchmark::State& state) {
+    util::TempFileHandle file("", ".ivdf");
+    writeBinary(*createDataFrame(static_cast<size_t>(state.range(0))), file.getFileName());
+
+    BinaryDataFrameReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(file.getFileName());
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void LoadBinaryOneColumn(benchmark::State& state) {
+    util::TempFileHandle file("", ".ivdf");
+    writeBinary(*createDataFrame(static_cast<size_t>(state.range(0))), file.getFileName());
+
+    BinaryDataFrameReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(file.getFileName());
+        auto ram = dataframe->getColumn(1)->getBuffer()->getRepresentation<BufferRAM>();
+        benchmark::DoNotOptimize(ram);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void LoadBinaryAll(benchmark::State& state) {
+    util::TempFileHandle file("", ".ivdf");
+    writeBinary(*createDataFrame(static_cast<size_t>(state.range(0))), file.getFileName());
+
+    BinaryDataFrameReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(file.getFileName());
+        for (auto col : *dataframe) {
+            auto ram = col->getBuffer()->getRepresentation<BufferRAM>();
+            benchmark::DoNotOptimize(ram);
+        }
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+BENCHMARK(LoadCSV)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadBinaryLazy)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadBinaryOneColumn)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadBinaryAll)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void FilterRowByRow(benchmark::State& state) {
+    const auto dataframe = createDataFrame(static_cast<size_t>(state.range(0)));
+    const auto column = dataframe->getColumn("col0");
+
+    for (auto _ : state) {
+        dataframeutil::Selection rows;
+        for (size_t row = 0; row < column->getSize(); ++row) {
+            if (column->getAsDouble(row) > 0.0) rows.push_back(static_cast<std::uint32_t>(row));
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void Filter(benchmark::State& state) {
+    const auto dataframe = createDataFrame(static_cast<size_t>(state.range(0)));
+    const std::vector<dataframeutil::Predicate> predicates{
+        {"col0", dataframeutil::CompareOp::Greater, 0.0, ""}};
+
+    for (auto _ : state) {
+        auto rows = dataframeutil::filter(*dataframe, predicates);
+        benchmark::DoNotOptimize(rows);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void Sort(benchmark::State& state) {
+    const auto dataframe = createDataFrame(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto rows = dataframeutil::sortRows(*dataframe, {{"col0", true}});
+        benchmark::DoNotOptimize(rows);
+    }
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+static void GroupBy(benchmark::State& state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    auto dataframe = createDataFrame(rows);
+    std::vector<int> keys(rows);
+    for (size_t i = 0; i < rows; ++i) keys[i] = static_cast<int>(i % 100);
+    dataframe->addColumn("key", std::move(keys));
+
+    const std::vector<dataframeutil::Aggregate> aggregates{
+        {"col0", dataframeutil::AggregateOp::Mean, ""},
+        {"col1", dataframeutil::AggregateOp::Max, ""}};
+    for (auto _ : state) {
+        auto result = dataframeutil::groupBy(*dataframe, {"key"}, aggregates);
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["Rows"] = static_cast<double>(rows);
+}
+
+static void Join(benchmark::State& state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    auto left = createDataFrame(rows);
+    std::vector<int> keys(rows);
+    for (size_t i = 0; i < rows; ++i) keys[i] = static_cast<int>((i * 7919) % rows);
+    left->addColumn("key", std::move(keys));
+
+    DataFrame right;
+    std::vector<int> rightKeys(rows);
+    std::iota(rightKeys.begin(), rightKeys.end(), 0);
+    right.addColumn("key", std::move(rightKeys));
+    right.updateIndexBuffer();
+
+    for (auto _ : state) {
+        auto result = dataframeutil::joinRows(*left, right, {"key"});
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["Rows"] = static_cast<double>(rows);
+}
+
+BENCHMARK(FilterRowByRow)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Filter)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Sort)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GroupBy)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Join)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    RepresentationFactoryManager rfm;
+    util::registerCoreRepresentations(rfm);
+
+    benchmark::Initialize(&argc, argv);
+
+    // The application provides the thread pool used by the parallel algorithms
+    LogCentral::init();
+    InviwoApplication app("Inviwo-Benchmarks-DataFrame");
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
@@ -0,0 +1,154 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createTestDataFrame() {
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn("float", std::vector<float>{1.5f, -2.0f, 3.25f, 0.0f});
+    dataframe->addColumn("int", std::vector<int>{1, 2, -3, 4});
+    auto cat = dataframe->addCategoricalColumn("category");
+    for (auto str : {"blue", "red", "blue", "yellow"}) {
+        cat->add(str);
+    }
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+void writeTestFile(const DataFrame& dataframe, const std::string& fileName) {
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(&dataframe, fileName);
+}
+
+}  // namespace
+
+TEST(BinaryDataFrame, roundTrip) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    const auto src = createTestDataFrame();
+    writeTestFile(*src, tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+
+    ASSERT_EQ(src->getNumberOfColumns(), dataframe->getNumberOfColumns());
+    ASSERT_EQ(src->getNumberOfRows(), dataframe->getNumberOfRows());
+    for (size_t col = 0; col < src->getNumberOfColumns(); ++col) {
+        auto expected = src->getColumn(col);
+        auto result = dataframe->getColumn(col);
+        EXPECT_EQ(expected->getHeader(), result->getHeader());
+        EXPECT_EQ(expected->getBuffer()->getDataFormat(), result->getBuffer()->getDataFormat());
+        for (size_t row = 0; row < src->getNumberOfRows(); ++row) {
+            EXPECT_EQ(expected->getAsString(row), result->getAsString(row))
+                << "column '" << expected->getHeader() << "', row " << row;
+        }
+    }
+    auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(dataframe->getColumn(3));
+    ASSERT_TRUE(categorical) << "categorical column was not restored";
+    EXPECT_EQ((std::vector<std::string>{"blue", "red", "yellow"}), categorical->getCategories());
+}
+
+TEST(BinaryDataFrame, lazyColumns) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    writeTestFile(*createTestDataFrame(), tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+
+    auto floatBuffer = dataframe->getColumn(1)->getBuffer();
+    auto intBuffer = dataframe->getColumn(2)->getBuffer();
+    EXPECT_FALSE(floatBuffer->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(intBuffer->hasRepresentation<BufferRAM>());
+    EXPECT_EQ(4, floatBuffer->getSize());
+
+    EXPECT_DOUBLE_EQ(-2.0, dataframe->getColumn(1)->getAsDouble(1));
+    EXPECT_TRUE(floatBuffer->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(intBuffer->hasRepresentation<BufferRAM>());
+}
+
+TEST(BinaryDataFrame, emptyDataFrame) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    auto src = std::make_shared<DataFrame>();
+    src->addColumn("empty", std::vector<double>{});
+    src->updateIndexBuffer();
+    writeTestFile(*src, tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(2, dataframe->getNumberOfColumns());
+    EXPECT_EQ(0, dataframe->getNumberOfRows());
+    EXPECT_EQ(0, dataframe->getColumn(1)->getBuffer()->getRepresentation<BufferRAM>()->getSize());
+}
+
+TEST(BinaryDataFrame, invalidFile) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    {
+        auto file = filesystem::ofstream(tmpFile.getFileName());
+        file << "1,2,3\n4,5,6\n";
+    }
+    BinaryDataFrameReader reader;
+    EXPECT_THROW(reader.readData(tmpFile.getFileName()), DataReaderException);
+}
+
+TEST(BinaryDataFrame, truncatedFile) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    writeTestFile(*createTestDataFrame(), tmpFile.getFileName());
+    std::string content;
+    {
+        auto in = filesystem::ifstream(tmpFile.getFileName(), std::ios::in | std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        // cut off the end of the last data block
+        auto out = filesystem::ofstream(tmpFile.getFileName(), std::ios::out | std::ios::binary);
+        out.write(content.data(), content.size() - 8);
+    }
+    BinaryDataFrameReader reader;
+    EXPECT_THROW(reader.readData(tmpFile.getFileName()), DataReaderException);
+}
+
+}  // namespace inviwo
@@ -35,6 +35,8 @@
 #include <inviwo/core/io/tempfilehandle.h>
 #include <inviwo/dataframe/io/csvreader.h>
 
+#include <cmath>
+#include <cstdio>
 #include <sstream>
 
 namespace inviwo {
@@ -465,4 +467,83 @@ TEST(CSVlinebreaks, mixed) {
     ASSERT_EQ(4, dataframe->getNumberOfRows()) << "row count does not match";
 }
 
+TEST(CSVfile, matchesStream) {
+    // enough rows to span several chunks, including quoted line breaks, CR LF, and empty lines
+    std::ostringstream oss;
+    oss << "Number,Name,Value\r\n";
+    for (int i = 0; i < 5000; ++i) {
+        oss << i << ",";
+        if (i % 7 == 0) {
+            oss << "\"multi\nline, " << i % 3 << "\"";
+        } else {
+            oss << "name " << i % 5;
+        }
+        oss << "," << i * 0.25 << (i % 2 ? "\r\n" : "\n");
+        if (i % 100 == 0) oss << "\n";
+    }
+    const auto data = oss.str();
+
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(data.data(), 1, data.size(), tmpFile.getHandle());
+    std::fflush(tmpFile.getHandle());
+
+    CSVReader reader;
+    std::istringstream ss(data);
+    auto streamDataframe = reader.readData(ss);
+    auto fileDataframe = reader.readData(tmpFile.getFileName());
+
+    ASSERT_EQ(4, fileDataframe->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(5000, fileDataframe->getNumberOfRows()) << "row count does not match";
+    ASSERT_EQ(streamDataframe->getNumberOfRows(), fileDataframe->getNumberOfRows());
+    for (size_t col = 1; col < 4; ++col) {
+        for (size_t row = 0; row < 5000; ++row) {
+            ASSERT_EQ(streamDataframe->getColumn(col)->getAsString(row),
+                      fileDataframe->getColumn(col)->getAsString(row))
+                << "column " << col << ", row " << row;
+        }
+    }
+    EXPECT_EQ(4999.0, fileDataframe->getColumn(1)->getAsDouble(4999));
+    EXPECT_EQ("\"multi\nline, 1\"", fileDataframe->getColumn(2)->get(7, true)->toString());
+    EXPECT_EQ(0.25 * 4999, fileDataframe->getColumn(3)->getAsDouble(4999));
+}
+
+TEST(CSVfile, malformedQuoteAfterExampleRows) {
+    std::ostringstream oss;
+    oss << "A,B\n";
+    for (int i = 0; i < 100; ++i) {
+        oss << i << "," << i << "\n";
+    }
+    // the closing quote is not followed by a delimiter, the field continues to the end of the file
+    oss << "\"a\"b,1\n1,2\n";
+    const auto data = oss.str();
+
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(data.data(), 1, data.size(), tmpFile.getHandle());
+    std::fflush(tmpFile.getHandle());
+
+    CSVReader reader;
+    std::istringstream ss(data);
+    EXPECT_THROW(reader.readData(ss), CSVDataReaderException);
+    EXPECT_THROW(reader.readData(tmpFile.getFileName()), CSVDataReaderException);
+}
+
+TEST(CSVdata, floatConversion) {
+    std::istringstream ss("A,B\n 1.5,2e3\n-0.25,inf\n3,7\n4,abc\n5,5x");
+
+    CSVReader reader;
+    auto dataframe = reader.readData(ss);
+    ASSERT_EQ(5, dataframe->getNumberOfRows()) << "row count does not match";
+
+    auto a = dataframe->getColumn(1);
+    EXPECT_EQ(1.5, a->getAsDouble(0)) << "leading white space";
+    EXPECT_EQ(-0.25, a->getAsDouble(1));
+    EXPECT_EQ(3.0, a->getAsDouble(2));
+    auto b = dataframe->getColumn(2);
+    EXPECT_EQ(2000.0, b->getAsDouble(0));
+    EXPECT_TRUE(std::isnan(b->getAsDouble(1))) << "inf is not a valid value";
+    EXPECT_EQ(7.0, b->getAsDouble(2));
+    EXPECT_TRUE(std::isnan(b->getAsDouble(3)));
+    EXPECT_EQ(5.0, b->getAsDouble(4)) << "trailing characters are ignored";
+}
+
 }  // namespace inviwo
@@ -0,0 +1,237 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createTestDataFrame() {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn("float", std::vector<float>{1.5f, -2.0f, nan, 0.0f, 4.0f, 1.5f});
+    dataframe->addColumn("int", std::vector<int>{1, 2, 3, 2, 1, 2});
+    auto cat = dataframe->addCategoricalColumn("category");
+    for (auto str : {"red", "blue", "red", "yellow", "blue", "red"}) {
+        cat->add(str);
+    }
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+template <typename T>
+const std::vector<T>& getData(const DataFrame& dataframe, const std::string& name) {
+    auto column = std::dynamic_pointer_cast<const TemplateColumn<T>>(dataframe.getColumn(name));
+    EXPECT_TRUE(column) << "Missing column " << name;
+    return column->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+}
+
+}  // namespace
+
+TEST(DataFrameQuery, filterNumerical) {
+    const auto dataframe = createTestDataFrame();
+    using dataframeutil::CompareOp;
+
+    EXPECT_EQ(dataframeutil::Selection({0, 4, 5}),
+              dataframeutil::filter(*dataframe, {{"float", CompareOp::Greater, 1.0, ""}}));
+    // NaN never passes, not even NotEqual
+    EXPECT_EQ(dataframeutil::Selection({1, 3, 4}),
+              dataframeutil::filter(*dataframe, {{"float", CompareOp::NotEqual, 1.5, ""}}));
+    EXPECT_EQ(dataframeutil::Selection({1, 3, 5}),
+              dataframeutil::filter(*dataframe, {{"int", CompareOp::Equal, 2.0, ""},
+                                                 {"float", CompareOp::LessEqual, 1.5, ""}}));
+    EXPECT_EQ(dataframeutil::Selection({5, 1}),
+              dataframeutil::filter(*dataframe, {{"int", CompareOp::Equal, 2.0, ""}},
+                                    {5, 4, 2, 1, 0}));
+}
+
+TEST(DataFrameQuery, filterCategorical) {
+    const auto dataframe = createTestDataFrame();
+    using dataframeutil::CompareOp;
+
+    EXPECT_EQ(dataframeutil::Selection({0, 2, 5}),
+              dataframeutil::filter(*dataframe, {{"category", CompareOp::Equal, 0.0, "red"}}));
+    EXPECT_EQ(dataframeutil::Selection({1, 4}),
+              dataframeutil::filter(*dataframe, {{"category", CompareOp::Less, 0.0, "red"}}));
+    EXPECT_TRUE(
+        dataframeutil::filter(*dataframe, {{"category", CompareOp::Equal, 0.0, "green"}}).empty());
+}
+
+TEST(DataFrameQuery, filterErrors) {
+    const auto dataframe = createTestDataFrame();
+    using dataframeutil::CompareOp;
+
+    EXPECT_THROW(dataframeutil::filter(*dataframe, {{"missing", CompareOp::Equal, 0.0, ""}}),
+                 Exception);
+
+    DataFrame vectors;
+    vectors.addColumn("vec", std::vector<vec2>{vec2{1.0f}, vec2{2.0f}});
+    EXPECT_THROW(dataframeutil::filter(vectors, {{"vec", CompareOp::Equal, 0.0, ""}}),
+                 DataTypeMismatch);
+}
+
+TEST(DataFrameQuery, sort) {
+    const auto dataframe = createTestDataFrame();
+
+    EXPECT_EQ(dataframeutil::Selection({1, 3, 0, 5, 4, 2}),
+              dataframeutil::sortRows(*dataframe, {{"float", true}}));
+    EXPECT_EQ(dataframeutil::Selection({4, 0, 5, 3, 1, 2}),
+              dataframeutil::sortRows(*dataframe, {{"float", false}}));
+    // Stable, and categorical columns are sorted by their strings
+    EXPECT_EQ(dataframeutil::Selection({1, 4, 0, 2, 5, 3}),
+              dataframeutil::sortRows(*dataframe, {{"category", true}}));
+    EXPECT_EQ(dataframeutil::Selection({2, 5, 3, 1, 4, 0}),
+              dataframeutil::sortRows(*dataframe, {{"int", false}, {"float", false}}));
+}
+
+TEST(DataFrameQuery, sortManyMorsels) {
+    const size_t size = 3 * dataframeutil::morselSize + 17;
+    std::vector<int> values(size);
+    for (size_t i = 0; i < size; ++i) values[i] = static_cast<int>((i * 7919) % 101);
+
+    DataFrame dataframe;
+    dataframe.addColumn("value", values);
+    dataframe.updateIndexBuffer();
+
+    const auto rows = dataframeutil::sortRows(dataframe, {{"value", true}});
+    dataframeutil::Selection expected(size);
+    std::iota(expected.begin(), expected.end(), 0u);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](auto a, auto b) { return values[a] < values[b]; });
+    EXPECT_EQ(expected, rows);
+}
+
+TEST(DataFrameQuery, selectRows) {
+    const auto dataframe = createTestDataFrame();
+    const auto result = dataframeutil::selectRows(*dataframe, {5, 1});
+
+    ASSERT_EQ(dataframe->getNumberOfColumns(), result->getNumberOfColumns());
+    ASSERT_EQ(2, result->getNumberOfRows());
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 1}), getData<std::uint32_t>(*result, "index"));
+    EXPECT_EQ(std::vector<int>({2, 2}), getData<int>(*result, "int"));
+    EXPECT_EQ("red", result->getColumn("category")->getAsString(0));
+    EXPECT_EQ("blue", result->getColumn("category")->getAsString(1));
+}
+
+TEST(DataFrameQuery, groupBy) {
+    const auto dataframe = createTestDataFrame();
+    using dataframeutil::AggregateOp;
+
+    const auto result = dataframeutil::groupBy(
+        *dataframe, {"category"},
+        {{"", AggregateOp::Count, ""},
+         {"float", AggregateOp::Count, ""},
+         {"float", AggregateOp::Mean, ""},
+         {"int", AggregateOp::Max, "largest"}});
+
+    ASSERT_EQ(3, result->getNumberOfRows());
+    const auto category = result->getColumn("category");
+    EXPECT_EQ("red", category->getAsString(0));
+    EXPECT_EQ("blue", category->getAsString(1));
+    EXPECT_EQ("yellow", category->getAsString(2));
+    EXPECT_EQ(std::vector<std::uint32_t>({3, 2, 1}), getData<std::uint32_t>(*result, "count"));
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 2, 1}),
+              getData<std::uint32_t>(*result, "count(float)"));
+    EXPECT_EQ(std::vector<double>({1.5, 1.0, 0.0}), getData<double>(*result, "mean(float)"));
+    EXPECT_EQ(std::vector<double>({3.0, 2.0, 2.0}), getData<double>(*result, "largest"));
+}
+
+TEST(DataFrameQuery, groupByManyMorsels) {
+    const size_t size = 2 * dataframeutil::morselSize + 5;
+    std::vector<int> keys(size);
+    std::vector<double> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        keys[i] = static_cast<int>(3 - i % 4);
+        values[i] = static_cast<double>(i);
+    }
+    DataFrame dataframe;
+    dataframe.addColumn("key", keys);
+    dataframe.addColumn("value", values);
+    dataframe.updateIndexBuffer();
+
+    const auto result =
+        dataframeutil::groupBy(dataframe, {"key"},
+                               {{"value", dataframeutil::AggregateOp::Sum, ""},
+                                {"value", dataframeutil::AggregateOp::Min, ""}});
+
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 0}), getData<int>(*result, "key"));
+    std::vector<double> sums(4, 0.0);
+    for (size_t i = 0; i < size; ++i) sums[i % 4] += values[i];
+    EXPECT_EQ(sums, getData<double>(*result, "sum(value)"));
+    EXPECT_EQ(std::vector<double>({0.0, 1.0, 2.0, 3.0}), getData<double>(*result, "min(value)"));
+}
+
+TEST(DataFrameQuery, join) {
+    const auto left = createTestDataFrame();
+
+    DataFrame right;
+    right.addColumn("int", std::vector<double>{2.0, 5.0, 1.0, 2.0});
+    right.addColumn("float", std::vector<float>{10.0f, 20.0f, 30.0f, 40.0f});
+    right.updateIndexBuffer();
+
+    const auto rows = dataframeutil::joinRows(*left, right, {"int"});
+    EXPECT_EQ(dataframeutil::Selection({0, 1, 1, 3, 3, 4, 5, 5}), rows.left);
+    EXPECT_EQ(dataframeutil::Selection({2, 0, 3, 0, 3, 2, 0, 3}), rows.right);
+
+    const auto result = dataframeutil::innerJoin(*left, right, {"int"});
+    ASSERT_EQ(rows.left.size(), result->getNumberOfRows());
+    ASSERT_EQ(5, result->getNumberOfColumns());
+    EXPECT_EQ(std::vector<float>({30.0f, 10.0f, 40.0f, 10.0f, 40.0f, 30.0f, 10.0f, 40.0f}),
+              getData<float>(*result, "float_right"));
+}
+
+TEST(DataFrameQuery, joinCategorical) {
+    const auto left = createTestDataFrame();
+
+    DataFrame right;
+    auto cat = right.addCategoricalColumn("category");
+    for (auto str : {"yellow", "green", "red"}) {
+        cat->add(str);
+    }
+    right.addColumn("value", std::vector<int>{1, 2, 3});
+    right.updateIndexBuffer();
+
+    const auto rows = dataframeutil::joinRows(*left, right, {"category"});
+    EXPECT_EQ(dataframeutil::Selection({0, 2, 3, 5}), rows.left);
+    EXPECT_EQ(dataframeutil::Selection({2, 2, 0, 2}), rows.right);
+}
+
+}  // namespace inviwo
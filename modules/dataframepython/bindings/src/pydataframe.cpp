@@ -38,6 +38,7 @@
 
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/dataframequery.h>
 #include <inviwo/dataframe/datastructures/datapoint.h>
 
 #include <inviwo/core/util/defaultvalues.h>
@@ -204,6 +205,106 @@ void exposeDataFrame(pybind11::module& m) {
             colHeaders      Name of each column. If none are given, "Column 1", "Column 2", ... is used
         )delim");
 
+    py::enum_<dataframeutil::CompareOp>(m, "CompareOp")
+        .value("Less", dataframeutil::CompareOp::Less)
+        .value("LessEqual", dataframeutil::CompareOp::LessEqual)
+        .value("Equal", dataframeutil::CompareOp::Equal)
+        .value("NotEqual", dataframeutil::CompareOp::NotEqual)
+        .value("GreaterEqual", dataframeutil::CompareOp::GreaterEqual)
+        .value("Greater", dataframeutil::CompareOp::Greater);
+
+    py::class_<dataframeutil::Predicate>(m, "Predicate")
+        .def(py::init([](std::string column, dataframeutil::CompareOp op, double value,
+                         std::string category) {
+                 return dataframeutil::Predicate{std::move(column), op, value,
+                                                 std::move(category)};
+             }),
+             py::arg("column"), py::arg("op") = dataframeutil::CompareOp::Equal,
+             py::arg("value") = 0.0, py::arg("category") = "")
+        .def_readwrite("column", &dataframeutil::Predicate::column)
+        .def_readwrite("op", &dataframeutil::Predicate::op)
+        .def_readwrite("value", &dataframeutil::Predicate::value)
+        .def_readwrite("category", &dataframeutil::Predicate::category);
+
+    py::class_<dataframeutil::SortKey>(m, "SortKey")
+        .def(py::init([](std::string column, bool ascending) {
+                 return dataframeutil::SortKey{std::move(column), ascending};
+             }),
+             py::arg("column"), py::arg("ascending") = true)
+        .def_readwrite("column", &dataframeutil::SortKey::column)
+        .def_readwrite("ascending", &dataframeutil::SortKey::ascending);
+
+    py::enum_<dataframeutil::AggregateOp>(m, "AggregateOp")
+        .value("Count", dataframeutil::AggregateOp::Count)
+        .value("Sum", dataframeutil::AggregateOp::Sum)
+        .value("Mean", dataframeutil::AggregateOp::Mean)
+        .value("Min", dataframeutil::AggregateOp::Min)
+        .value("Max", dataframeutil::AggregateOp::Max);
+
+    py::class_<dataframeutil::Aggregate>(m, "Aggregate")
+        .def(py::init([](std::string column, dataframeutil::AggregateOp op, std::string name) {
+                 return dataframeutil::Aggregate{std::move(column), op, std::move(name)};
+             }),
+             py::arg("column"), py::arg("op") = dataframeutil::AggregateOp::Count,
+             py::arg("name") = "")
+        .def_readwrite("column", &dataframeutil::Aggregate::column)
+        .def_readwrite("op", &dataframeutil::Aggregate::op)
+        .def_readwrite("name", &dataframeutil::Aggregate::name);
+
+    py::class_<dataframeutil::JoinResult>(m, "JoinResult")
+        .def_readonly("left", &dataframeutil::JoinResult::left)
+        .def_readonly("right", &dataframeutil::JoinResult::right);
+
+    m.def("filter",
+          py::overload_cast<const DataFrame&, const std::vector<dataframeutil::Predicate>&>(
+              &dataframeutil::filter),
+          py::arg("dataframe"), py::arg("predicates"),
+          R"delim(
+            Select the rows of a DataFrame that pass all predicates.
+
+            Parameters
+            ----------
+            dataframe       DataFrame to filter
+            predicates      List of Predicate, NaN values never pass
+        )delim");
+    m.def("filter",
+          py::overload_cast<const DataFrame&, const std::vector<dataframeutil::Predicate>&,
+                            const dataframeutil::Selection&>(&dataframeutil::filter),
+          py::arg("dataframe"), py::arg("predicates"), py::arg("selection"));
+    m.def("sortRows",
+          py::overload_cast<const DataFrame&, const std::vector<dataframeutil::SortKey>&>(
+              &dataframeutil::sortRows),
+          py::arg("dataframe"), py::arg("keys"),
+          R"delim(
+            Stable sort of the rows of a DataFrame, the first key is the primary one.
+
+            Parameters
+            ----------
+            dataframe       DataFrame to sort
+            keys            List of SortKey
+        )delim");
+    m.def("sortRows",
+          py::overload_cast<const DataFrame&, const std::vector<dataframeutil::SortKey>&,
+                            dataframeutil::Selection>(&dataframeutil::sortRows),
+          py::arg("dataframe"), py::arg("keys"), py::arg("selection"));
+    m.def("selectRows", &dataframeutil::selectRows, py::arg("dataframe"), py::arg("selection"),
+          "Create a new DataFrame with the selected rows");
+    m.def("groupBy", &dataframeutil::groupBy, py::arg("dataframe"), py::arg("keys"),
+          py::arg("aggregates"),
+          R"delim(
+            Group the rows of a DataFrame by the key columns and aggregate each group.
+
+            Parameters
+            ----------
+            dataframe       DataFrame to group
+            keys            Names of the key columns
+            aggregates      List of Aggregate, one result column each
+        )delim");
+    m.def("joinRows", &dataframeutil::joinRows, py::arg("left"), py::arg("right"),
+          py::arg("keys"), "Matching rows of an inner join on the key columns");
+    m.def("innerJoin", &dataframeutil::innerJoin, py::arg("left"), py::arg("right"),
+          py::arg("keys"), "Inner join of two DataFrames on the key columns");
+
     exposeStandardDataPorts<DataFrame>(m, "DataFrame");
 }
 
@@ -85,6 +85,19 @@ public:
         dataFunction_(destVec, index);
     }
 
+    /**
+     * \brief Range access, constant
+     * @param dest Position to write to, expect write of (end - start) * NumComponents many T
+     * @param start First linear point index
+     * @param end One past the last linear point index
+     */
+    void fillRaw(T* dest, ind start, ind end) const override {
+        Vec* destVec = reinterpret_cast<Vec*>(dest);
+        for (ind index = start; index < end; ++index) {
+            dataFunction_(destVec[index - start], index);
+        }
+    }
+
 protected:
     virtual CachedGetter<AnalyticChannel>* newIterator() override {
         return new CachedGetter<AnalyticChannel>(this);
@@ -156,6 +156,16 @@ protected:
         memcpy(dest, &buffer_[index * N], sizeof(T) * N);
     }
 
+    /**
+     * \brief Range access, constant
+     * @param dest Position to write to, expect write of (end - start) * NumComponents many T
+     * @param start First linear point index
+     * @param end One past the last linear point index
+     */
+    virtual void fillRaw(T* dest, ind start, ind end) const override {
+        if (end > start) memcpy(dest, &buffer_[start * N], sizeof(T) * N * (end - start));
+    }
+
     /**
      * \brief Vector containing the buffer data
      * Resizeable only by DataSet. Handle with care:
@@ -47,6 +47,16 @@ public:
 
 protected:
     virtual void fillRaw(T* dest, ind index) const = 0;
+    /**
+     * \brief Range access, write elements [start, end) to dest
+     * Calls fillRaw per element, override if the data can be copied in bulk.
+     * @param dest Position to write to, expect write of (end - start) * NumComponents many T
+     */
+    virtual void fillRaw(T* dest, ind start, ind end) const {
+        for (ind index = start; index < end; ++index) {
+            fillRaw(dest + (index - start) * N, index);
+        }
+    }
     virtual ChannelGetter<T, N>* newIterator() = 0;
 };
 
@@ -101,6 +111,20 @@ public:
         this->fillRaw(reinterpret_cast<T*>(&dest), index);
     }
 
+    /**
+     * \brief Range access, copy data of the elements [start, end)
+     * Thread safe. A single virtual call for the whole range.
+     * @param dest Position to write to, expect VecNT[end - start]
+     * @param start First linear point index
+     * @param end One past the last linear point index
+     */
+    template <typename VecNT>
+    void fill(VecNT* dest, ind start, ind end) const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        this->fillRaw(reinterpret_cast<T*>(dest), start, end);
+    }
+
     template <typename VecNT>
     void operator()(VecNT& dest, ind index) const {
         fill(dest, index);
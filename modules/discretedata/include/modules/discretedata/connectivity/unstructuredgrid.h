@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/discretedata/connectivity/connectivity.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <tcb/span.hpp>
+
+namespace inviwo {
+namespace discretedata {
+
+/**
+ * \brief An unstructured mesh of tetrahedra, hexahedra, wedges and pyramids in 3D, or triangles
+ * and quads in 2D, in any mix.
+ *
+ * All relations between grid primitives are stored in compressed sparse row (CSR) arrays: one
+ * array of offsets and one array of the connected indices. The cell to vertex relation is given,
+ * all other relations are derived from it when they are first requested, in parallel on the
+ * application thread pool. Edges and faces are numbered by their smallest vertex, local vertex
+ * orders follow the VTK conventions of the respective cell type.
+ *
+ * Use the span returning getConnections overload and fillRaw on the channels to traverse large
+ * meshes without allocations or virtual calls per element.
+ */
+class IVW_MODULE_DISCRETEDATA_API UnstructuredGrid : public Connectivity {
+public:
+    /**
+     * \brief Create a mesh from cells given in CSR form
+     * @param gridDimension Dimension of the cells, Face or Volume
+     * @param numVertices Number of vertices
+     * @param cellOffsets Offsets into cellVertices, expect size numCells + 1
+     * @param cellVertices Vertex indices of all cells, in VTK order
+     * @param cellTypes Type of each cell, all of dimension gridDimension
+     * Throws an Exception if the arrays are inconsistent or a cell type is not supported.
+     */
+    UnstructuredGrid(GridPrimitive gridDimension, ind numVertices, std::vector<ind> cellOffsets,
+                     std::vector<ind> cellVertices, std::vector<CellType> cellTypes);
+    virtual ~UnstructuredGrid() = default;
+
+    virtual ind getNumElements(GridPrimitive elementType) const override;
+
+    /**
+     * \brief Get the map from one element to another
+     * Copies the result of the span returning overload.
+     */
+    virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
+                                GridPrimitive to, bool isPosition = false) const override;
+
+    /**
+     * \brief Get the map from one element to another without allocating
+     * Elements of the same dimension are connected if they share an element of one dimension
+     * lower, vertices if they share an edge. The relation is built on first use.
+     * @param index Index of element in dimension 'from'
+     * @param from Dimension the index lives in
+     * @param to Dimension the result lives in
+     * @return All connected indices in dimension 'to', valid as long as the grid
+     */
+    util::span<const ind> getConnections(ind index, GridPrimitive from, GridPrimitive to) const;
+
+    virtual CellType getCellType(GridPrimitive dim, ind index) const override;
+
+    /**
+     * \brief Build all relations between the grid primitives up front
+     */
+    void buildAllConnections() const;
+
+    //! Relation between two grid primitives in compressed sparse row form
+    struct Relation {
+        //! Connections of element i are indices[offsets[i]] to indices[offsets[i + 1]]
+        std::vector<ind> offsets;
+        std::vector<ind> indices;
+
+        ind size() const { return static_cast<ind>(offsets.size()) - 1; }
+        util::span<const ind> operator[](ind index) const {
+            return {indices.data() + offsets[index],
+                    static_cast<size_t>(offsets[index + 1] - offsets[index])};
+        }
+    };
+
+    /**
+     * \brief The CSR arrays of a relation, built on first use
+     */
+    const Relation& getRelation(GridPrimitive from, GridPrimitive to) const;
+
+    static constexpr size_t maxDimension = 3;
+
+private:
+    void buildSubElements(ind dim) const;
+    void buildRelation(ind from, ind to) const;
+
+    std::vector<CellType> cellTypes_;
+
+    mutable std::array<std::array<Relation, maxDimension + 1>, maxDimension + 1> relations_;
+    // Relations are built lazily under buildMutex_, recursively since a relation is built from
+    // other relations, and published through the flags.
+    mutable std::recursive_mutex buildMutex_;
+    mutable std::array<std::array<std::atomic<bool>, maxDimension + 1>, maxDimension + 1> built_{};
+    mutable std::array<std::atomic<bool>, maxDimension + 1> subElementsBuilt_{};
+};
+
+}  // namespace discretedata
+}  // namespace inviwo
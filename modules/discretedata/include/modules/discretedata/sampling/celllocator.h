@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/discretedata/discretedatamoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/spatialdata.h>
+
+#include <modules/discretedata/channels/channel.h>
+#include <modules/discretedata/connectivity/connectivity.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <tcb/span.hpp>
+
+namespace inviwo {
+namespace discretedata {
+
+/**
+ * \brief Finds the cell of a volume grid that contains a point
+ *
+ * The cells are sorted into a uniform grid of bins over the bounding box of the vertex positions,
+ * about one cell per bin. A query tests the cells of a single bin, first against their bounding
+ * box and then exactly, which also gives the interpolation weights of the cell vertices:
+ * barycentric coordinates for tetrahedra and pyramids (split into two tetrahedra), and the
+ * parametric coordinates of the trilinear and wedge interpolation for hexahedra and wedges.
+ *
+ * The cells, vertex positions, and bins are copied and built in parallel on construction, the
+ * locator does not refer to the grid or the positions afterwards. Queries are thread safe.
+ * The cells of a StructuredGrid are reordered from its corner order to the VTK hexahedron order.
+ *
+ * The locator is also the SpatialEntity of the DataSetSampler, its data space is the bounding box
+ * of the vertex positions.
+ */
+class IVW_MODULE_DISCRETEDATA_API CellLocator : public SpatialEntity<3> {
+public:
+    //! Maximal number of vertices of a cell
+    static constexpr size_t maxVertices = 8;
+
+    struct Location {
+        //! Index of the containing cell, -1 if the point is outside of all cells
+        ind cell = -1;
+        ind numVertices = 0;
+        std::array<ind, maxVertices> vertices{};
+        std::array<double, maxVertices> weights{};
+
+        bool found() const { return cell >= 0; }
+
+        //! Interpolate per vertex values with the weights
+        template <typename V>
+        V interpolate(const V* values) const {
+            V res{0};
+            for (ind i = 0; i < numVertices; ++i) res += weights[i] * values[vertices[i]];
+            return res;
+        }
+    };
+
+    /**
+     * \brief Build the locator
+     * @param grid Volume grid of tetrahedra, hexahedra, wedges, or pyramids
+     * @param positions Vertex positions with 3 components
+     * Throws an Exception if the grid is not a volume grid or the positions do not match.
+     */
+    CellLocator(const Connectivity& grid, const Channel& positions);
+    CellLocator(const CellLocator&) = default;
+    CellLocator& operator=(const CellLocator&) = default;
+    virtual CellLocator* clone() const override;
+    virtual ~CellLocator() = default;
+
+    /**
+     * \brief Find the cell containing a position, given in the space of the vertex positions
+     */
+    Location locate(const dvec3& pos) const;
+
+    /**
+     * \brief Locate all positions in parallel, result has to have the same size as positions
+     */
+    void locate(util::span<const dvec3> positions, util::span<Location> result) const;
+
+    //! Lower corner of the bounding box of the vertex positions
+    const dvec3& getMin() const { return min_; }
+    //! Upper corner of the bounding box of the vertex positions
+    const dvec3& getMax() const { return max_; }
+    const size3_t& getNumBins() const { return numBins_; }
+    ind getNumCells() const { return static_cast<ind>(shapes_.size()); }
+    ind getNumVertices() const { return static_cast<ind>(positions_.size()); }
+
+private:
+    //! Supported cell types, vertices are stored in VTK order
+    enum class Shape : std::uint8_t { Tetra, Hexahedron, Wedge, Pyramid };
+
+    bool locateInCell(ind cell, const dvec3& pos, Location& location) const;
+
+    std::vector<dvec3> positions_;
+    std::vector<ind> cellOffsets_;
+    std::vector<ind> cellVertices_;
+    std::vector<Shape> shapes_;
+    std::vector<dvec3> cellMin_;
+    std::vector<dvec3> cellMax_;
+
+    dvec3 min_;
+    dvec3 max_;
+    size3_t numBins_;
+    dvec3 binSize_;
+    std::vector<ind> binOffsets_;
+    std::vector<ind> binCells_;
+};
+
+}  // namespace discretedata
+}  // namespace inviwo
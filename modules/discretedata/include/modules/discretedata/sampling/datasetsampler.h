@@ -0,0 +1,137 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/discretedata/discretedatamoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <modules/discretedata/channels/channel.h>
+#include <modules/discretedata/sampling/celllocator.h>
+#include <modules/discretedata/util.h>
+
+#include <memory>
+#include <vector>
+
+#include <tcb/span.hpp>
+
+namespace inviwo {
+namespace discretedata {
+
+/**
+ * \brief Interpolates per vertex data of a volume grid at arbitrary positions
+ *
+ * The cell containing a position is found with a CellLocator, the values of its vertices are then
+ * interpolated with the barycentric or parametric weights. Positions outside of all cells sample to
+ * zero and are not within bounds. Like other SpatialSamplers, the data space is the unit cube,
+ * mapped to the bounding box of the grid by the model matrix of the locator. This lets the
+ * IntegralLineTracer trace directly on unstructured grids.
+ *
+ * The values are copied to doubles on construction, the locator is shared.
+ */
+template <unsigned int DataDims>
+class DataSetSampler : public SpatialSampler<3, DataDims, double> {
+public:
+    using Value = Vector<DataDims, double>;
+    using Space = typename SpatialSampler<3, DataDims, double>::Space;
+
+    /**
+     * @param locator Cell locator of the grid
+     * @param vertexData Values with DataDims components, one per vertex
+     * @param space Space of the positions passed to sample
+     * Throws an Exception if the data does not match the grid.
+     */
+    DataSetSampler(std::shared_ptr<const CellLocator> locator, const Channel& vertexData,
+                   Space space = Space::Data);
+    virtual ~DataSetSampler() = default;
+
+    using SpatialSampler<3, DataDims, double>::sample;
+
+    /**
+     * Sample all positions, given in data space, in parallel. The result has to have the same size
+     * as positions.
+     */
+    void sample(util::span<const dvec3> positions, util::span<Value> result) const;
+
+    const CellLocator& getLocator() const { return *locator_; }
+
+protected:
+    virtual Value sampleDataSpace(const dvec3& pos) const override;
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
+
+private:
+    dvec3 toModel(const dvec3& pos) const {
+        return locator_->getMin() + pos * (locator_->getMax() - locator_->getMin());
+    }
+
+    std::shared_ptr<const CellLocator> locator_;
+    std::vector<Value> values_;
+};
+
+template <unsigned int DataDims>
+DataSetSampler<DataDims>::DataSetSampler(std::shared_ptr<const CellLocator> locator,
+                                         const Channel& vertexData, Space space)
+    : SpatialSampler<3, DataDims, double>(*locator, space)
+    , locator_{std::move(locator)}
+    , values_{dd_util::channelToDouble<DataDims>(vertexData)} {
+    if (static_cast<ind>(values_.size()) != locator_->getNumVertices()) {
+        throw Exception("Vertex data needs " + toString(DataDims) + " components per vertex",
+                        IVW_CONTEXT_CUSTOM("DataSetSampler"));
+    }
+}
+
+template <unsigned int DataDims>
+auto DataSetSampler<DataDims>::sampleDataSpace(const dvec3& pos) const -> Value {
+    const auto location = locator_->locate(toModel(pos));
+    if (!location.found()) return Value{0.0};
+    return location.interpolate(values_.data());
+}
+
+template <unsigned int DataDims>
+bool DataSetSampler<DataDims>::withinBoundsDataSpace(const dvec3& pos) const {
+    return locator_->locate(toModel(pos)).found();
+}
+
+template <unsigned int DataDims>
+void DataSetSampler<DataDims>::sample(util::span<const dvec3> positions,
+                                      util::span<Value> result) const {
+    if (positions.size() != result.size()) {
+        throw Exception("Positions and result have to have the same size",
+                        IVW_CONTEXT_CUSTOM("DataSetSampler"));
+    }
+    util::parallelFor(size_t{0}, positions.size(), [&](size_t i) {
+        const auto location = locator_->locate(toModel(positions[i]));
+        result[i] = location.found() ? location.interpolate(values_.data()) : Value{0.0};
+    });
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
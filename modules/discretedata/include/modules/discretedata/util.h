@@ -31,6 +31,14 @@
 
 #include <modules/discretedata/connectivity/connectivity.h>
 #include <modules/discretedata/connectivity/cell.h>
+#include <modules/discretedata/channels/datachannel.h>
+
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace inviwo {
 namespace discretedata {
@@ -108,6 +116,43 @@ inline GridPrimitive cellTypeToGridPrimitive(CellType type) {
     };
 }
 
+namespace detail {
+template <unsigned int N>
+struct ChannelToDouble {
+    template <typename Result, typename Format>
+    std::vector<Vector<N, double>> operator()(const Channel& channel) {
+        using T = typename Format::type;
+        const auto* typed = dynamic_cast<const DataChannel<T, N>*>(&channel);
+        if (!typed) return {};
+
+        constexpr ind chunkSize = 1 << 14;
+        const ind size = channel.size();
+        std::vector<Vector<N, double>> result(static_cast<size_t>(size));
+        util::parallelFor(ind{0}, (size + chunkSize - 1) / chunkSize, [&](ind chunk) {
+            std::vector<Vector<N, T>> values(chunkSize);
+            const ind start = chunk * chunkSize;
+            const ind end = std::min(size, start + chunkSize);
+            typed->fill(values.data(), start, end);
+            std::transform(values.begin(), values.begin() + (end - start),
+                           result.begin() + start,
+                           [](const auto& v) { return static_cast<Vector<N, double>>(v); });
+        });
+        return result;
+    }
+};
+}  // namespace detail
+
+/** \brief Copy all values of a channel with N components into a vector of doubles
+ *  Uses the range fill of the channel, one virtual call per chunk of values.
+ *  @return The values, or an empty vector if the channel does not have N components
+ */
+template <unsigned int N>
+std::vector<Vector<N, double>> channelToDouble(const Channel& channel) {
+    if (channel.getNumComponents() != static_cast<ind>(N)) return {};
+    return dispatching::dispatch<std::vector<Vector<N, double>>, dispatching::filter::Scalars>(
+        channel.getDataFormatId(), detail::ChannelToDouble<N>{}, channel);
+}
+
 }  // namespace dd_util
 }  // namespace discretedata
 }  // namespace inviwo
@@ -0,0 +1,432 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/discretedata/connectivity/unstructuredgrid.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <tuple>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+using LocalElements = std::vector<std::vector<ind>>;
+
+/**
+ * Run \p build once and publish the result through \p built. Unlike std::call_once the build
+ * does not run inside the once machinery, the lock is an ordinary mutex that only threads asking
+ * for the same grid wait on. The parallel loops of a build never query the grid themselves.
+ */
+template <typename Build>
+void buildOnce(std::atomic<bool>& built, std::recursive_mutex& mutex, Build&& build) {
+    if (built.load(std::memory_order_acquire)) return;
+    std::scoped_lock lock{mutex};
+    if (built.load(std::memory_order_relaxed)) return;
+    build();
+    built.store(true, std::memory_order_release);
+}
+
+//! Local vertex indices of the edges and faces of a cell type, in VTK order
+struct CellTopology {
+    ind dimension;
+    ind numVertices;
+    LocalElements edges;
+    LocalElements faces;
+
+    const LocalElements& subElements(ind dim) const { return dim == 1 ? edges : faces; }
+};
+
+const CellTopology* getTopology(CellType type) {
+    static const CellTopology triangle{2, 3, {{0, 1}, {1, 2}, {2, 0}}, {}};
+    static const CellTopology quad{2, 4, {{0, 1}, {1, 2}, {2, 3}, {3, 0}}, {}};
+    static const CellTopology tetra{
+        3,
+        4,
+        {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}},
+        {{0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}}};
+    static const CellTopology hexahedron{
+        3,
+        8,
+        {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6},
+         {3, 7}},
+        {{0, 4, 7, 3}, {1, 2, 6, 5}, {0, 1, 5, 4}, {3, 7, 6, 2}, {0, 3, 2, 1}, {4, 5, 6, 7}}};
+    static const CellTopology wedge{
+        3,
+        6,
+        {{0, 1}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}, {0, 3}, {1, 4}, {2, 5}},
+        {{0, 1, 2}, {3, 5, 4}, {0, 3, 4, 1}, {1, 4, 5, 2}, {2, 5, 3, 0}}};
+    static const CellTopology pyramid{
+        3,
+        5,
+        {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 4}, {2, 4}, {3, 4}},
+        {{0, 3, 2, 1}, {0, 1, 4}, {1, 2, 4}, {2, 3, 4}, {3, 0, 4}}};
+
+    switch (type) {
+        case CellType::Triangle:
+            return &triangle;
+        case CellType::Quad:
+            return &quad;
+        case CellType::Tetra:
+            return &tetra;
+        case CellType::Hexahedron:
+            return &hexahedron;
+        case CellType::Wedge:
+            return &wedge;
+        case CellType::Pyramid:
+            return &pyramid;
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Exclusive prefix sum of counts, returns offsets of size counts.size() + 1.
+ */
+template <typename Counts>
+std::vector<ind> toOffsets(const Counts& counts) {
+    std::vector<ind> offsets(counts.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        offsets[i + 1] = offsets[i] + static_cast<ind>(counts[i]);
+    }
+    return offsets;
+}
+
+/**
+ * Invert a relation from n elements to numTargets elements. The connections of each target are
+ * sorted in ascending order.
+ */
+UnstructuredGrid::Relation transpose(const UnstructuredGrid::Relation& rel, ind numTargets) {
+    std::vector<std::atomic<ind>> counts(static_cast<size_t>(numTargets));
+    util::parallelFor(ind{0}, numTargets,
+                      [&](ind t) { counts[t].store(0, std::memory_order_relaxed); });
+    util::parallelFor(ind{0}, static_cast<ind>(rel.indices.size()), [&](ind i) {
+        counts[rel.indices[i]].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    UnstructuredGrid::Relation res;
+    res.offsets.resize(static_cast<size_t>(numTargets) + 1);
+    res.offsets[0] = 0;
+    for (ind t = 0; t < numTargets; ++t) {
+        res.offsets[t + 1] = res.offsets[t] + counts[t].load(std::memory_order_relaxed);
+        counts[t].store(0, std::memory_order_relaxed);
+    }
+
+    res.indices.resize(rel.indices.size());
+    util::parallelFor(ind{0}, rel.size(), [&](ind e) {
+        for (auto t : rel[e]) {
+            res.indices[res.offsets[t] + counts[t].fetch_add(1, std::memory_order_relaxed)] = e;
+        }
+    });
+    util::parallelFor(ind{0}, numTargets, [&](ind t) {
+        std::sort(res.indices.begin() + res.offsets[t], res.indices.begin() + res.offsets[t + 1]);
+    });
+    return res;
+}
+
+//! A sub element of a cell, identified by its sorted vertices
+struct Occurrence {
+    std::array<ind, 4> key;
+    ind cell;
+    ind local;
+
+    bool operator<(const Occurrence& other) const {
+        return std::tie(key, cell, local) < std::tie(other.key, other.cell, other.local);
+    }
+};
+
+}  // namespace
+
+UnstructuredGrid::UnstructuredGrid(GridPrimitive gridDimension, ind numVertices,
+                                   std::vector<ind> cellOffsets, std::vector<ind> cellVertices,
+                                   std::vector<CellType> cellTypes)
+    : Connectivity(gridDimension), cellTypes_(std::move(cellTypes)) {
+    const auto dim = static_cast<ind>(gridDimension);
+    if (dim < 2 || dim > static_cast<ind>(maxDimension)) {
+        throw Exception("UnstructuredGrid supports only Face and Volume grids",
+                        IVW_CONTEXT_CUSTOM("UnstructuredGrid"));
+    }
+    const auto numCells = static_cast<ind>(cellTypes_.size());
+    if (static_cast<ind>(cellOffsets.size()) != numCells + 1 || cellOffsets.front() != 0 ||
+        cellOffsets.back() != static_cast<ind>(cellVertices.size())) {
+        throw Exception("Cell offsets do not match the number of cells and vertex indices",
+                        IVW_CONTEXT_CUSTOM("UnstructuredGrid"));
+    }
+
+    std::atomic<bool> valid{true};
+    util::parallelFor(ind{0}, numCells, [&](ind cell) {
+        const auto* topology = getTopology(cellTypes_[cell]);
+        if (!topology || topology->dimension != dim ||
+            topology->numVertices != cellOffsets[cell + 1] - cellOffsets[cell]) {
+            valid = false;
+            return;
+        }
+        for (ind i = cellOffsets[cell]; i < cellOffsets[cell + 1]; ++i) {
+            if (cellVertices[i] < 0 || cellVertices[i] >= numVertices) valid = false;
+        }
+    });
+    if (!valid) {
+        throw Exception("Unsupported cell type, or cell with invalid vertices",
+                        IVW_CONTEXT_CUSTOM("UnstructuredGrid"));
+    }
+
+    relations_[dim][0].offsets = std::move(cellOffsets);
+    relations_[dim][0].indices = std::move(cellVertices);
+    numGridPrimitives_[0] = numVertices;
+    numGridPrimitives_[dim] = numCells;
+}
+
+ind UnstructuredGrid::getNumElements(GridPrimitive elementType) const {
+    const auto dim = static_cast<ind>(elementType);
+    if (dim > 0 && dim < static_cast<ind>(gridDimension_)) {
+        buildOnce(subElementsBuilt_[dim], buildMutex_, [&]() { buildSubElements(dim); });
+    }
+    return Connectivity::getNumElements(elementType);
+}
+
+void UnstructuredGrid::getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
+                                      GridPrimitive to, bool) const {
+    const auto connections = getConnections(index, from, to);
+    result.assign(connections.begin(), connections.end());
+}
+
+util::span<const ind> UnstructuredGrid::getConnections(ind index, GridPrimitive from,
+                                                       GridPrimitive to) const {
+    return getRelation(from, to)[index];
+}
+
+const UnstructuredGrid::Relation& UnstructuredGrid::getRelation(GridPrimitive from,
+                                                                GridPrimitive to) const {
+    const auto f = static_cast<ind>(from);
+    const auto t = static_cast<ind>(to);
+    const auto dim = static_cast<ind>(gridDimension_);
+    if (f < 0 || t < 0 || f > dim || t > dim) {
+        throw Exception("Grid primitive out of range", IVW_CONTEXT_CUSTOM("UnstructuredGrid"));
+    }
+    buildOnce(built_[f][t], buildMutex_, [&]() { buildRelation(f, t); });
+    return relations_[f][t];
+}
+
+void UnstructuredGrid::buildAllConnections() const {
+    const auto dim = static_cast<ind>(gridDimension_);
+    for (ind from = 0; from <= dim; ++from) {
+        for (ind to = 0; to <= dim; ++to) {
+            getRelation(static_cast<GridPrimitive>(from), static_cast<GridPrimitive>(to));
+        }
+    }
+}
+
+CellType UnstructuredGrid::getCellType(GridPrimitive dim, ind index) const {
+    if (dim == gridDimension_) return cellTypes_[index];
+    switch (dim) {
+        case GridPrimitive::Vertex:
+            return CellType::Vertex;
+        case GridPrimitive::Edge:
+            return CellType::Line;
+        case GridPrimitive::Face:
+            return getConnections(index, GridPrimitive::Face, GridPrimitive::Vertex).size() == 3
+                       ? CellType::Triangle
+                       : CellType::Quad;
+        default:
+            return CellType::EmptyCell;
+    }
+}
+
+void UnstructuredGrid::buildRelation(ind from, ind to) const {
+    const auto dim = static_cast<ind>(gridDimension_);
+    const auto primitive = [](ind d) { return static_cast<GridPrimitive>(d); };
+
+    if (from == dim && to == 0) {
+        // Given in the constructor.
+    } else if ((from == dim && to > 0 && to < dim) || (to == 0 && from > 0 && from < dim)) {
+        const auto sub = from == dim ? to : from;
+        buildOnce(subElementsBuilt_[sub], buildMutex_, [&]() { buildSubElements(sub); });
+    } else if (from < to) {
+        relations_[from][to] =
+            transpose(getRelation(primitive(to), primitive(from)), getNumElements(primitive(from)));
+    } else if (from == to) {
+        // Connected through a shared element one dimension lower, vertices through edges.
+        const auto via = from == 0 ? 1 : from - 1;
+        const auto& down = getRelation(primitive(from), primitive(via));
+        const auto& up = getRelation(primitive(via), primitive(from));
+        const auto num = getNumElements(primitive(from));
+
+        auto& res = relations_[from][to];
+        std::vector<ind> counts(static_cast<size_t>(num));
+        const auto collect = [&](ind e, auto&& func) {
+            for (auto v : down[e]) {
+                for (auto n : up[v]) {
+                    if (n != e) func(n);
+                }
+            }
+        };
+        util::parallelFor(ind{0}, num, [&](ind e) {
+            ind count = 0;
+            collect(e, [&](ind) { ++count; });
+            counts[e] = count;
+        });
+        res.offsets = toOffsets(counts);
+        res.indices.resize(static_cast<size_t>(res.offsets.back()));
+        util::parallelFor(ind{0}, num, [&](ind e) {
+            auto pos = res.offsets[e];
+            collect(e, [&](ind n) { res.indices[pos++] = n; });
+        });
+    } else {
+        // Face to edge in a volume grid: consecutive vertices of the face polygon.
+        const auto& faceVertices = getRelation(primitive(from), GridPrimitive::Vertex);
+        const auto& edgeVertices = getRelation(GridPrimitive::Edge, GridPrimitive::Vertex);
+        const auto& vertexEdges = getRelation(GridPrimitive::Vertex, GridPrimitive::Edge);
+
+        auto& res = relations_[from][to];
+        res.offsets = faceVertices.offsets;
+        res.indices.resize(faceVertices.indices.size());
+        util::parallelFor(ind{0}, faceVertices.size(), [&](ind face) {
+            const auto verts = faceVertices[face];
+            const auto n = verts.size();
+            for (size_t i = 0; i < n; ++i) {
+                const auto a = std::min(verts[i], verts[(i + 1) % n]);
+                const auto b = std::max(verts[i], verts[(i + 1) % n]);
+                // Edges are numbered by their smallest vertex.
+                for (auto edge : vertexEdges[a]) {
+                    const auto ev = edgeVertices[edge];
+                    if (std::min(ev[0], ev[1]) == a && std::max(ev[0], ev[1]) == b) {
+                        res.indices[res.offsets[face] + i] = edge;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+}
+
+void UnstructuredGrid::buildSubElements(ind sub) const {
+    const auto dim = static_cast<ind>(gridDimension_);
+    const auto& cellVertices = relations_[dim][0];
+    const auto& vertexCells = getRelation(GridPrimitive::Vertex, gridDimension_);
+    const auto numCells = cellVertices.size();
+    const auto numVertices = numGridPrimitives_[0];
+
+    // Slots of the cell to sub element relation.
+    auto& cellSubs = relations_[dim][sub];
+    {
+        std::vector<ind> counts(static_cast<size_t>(numCells));
+        util::parallelFor(ind{0}, numCells, [&](ind cell) {
+            counts[cell] =
+                static_cast<ind>(getTopology(cellTypes_[cell])->subElements(sub).size());
+        });
+        cellSubs.offsets = toOffsets(counts);
+        cellSubs.indices.resize(static_cast<size_t>(cellSubs.offsets.back()));
+    }
+
+    // Each sub element is owned by its smallest vertex. Gather the sub elements of the cells around
+    // a vertex that it owns, sorted such that duplicates are adjacent.
+    const auto gather = [&](ind vertex, std::vector<Occurrence>& occurrences) {
+        occurrences.clear();
+        for (auto cell : vertexCells[vertex]) {
+            const auto verts = cellVertices[cell];
+            const auto& locals = getTopology(cellTypes_[cell])->subElements(sub);
+            for (size_t local = 0; local < locals.size(); ++local) {
+                Occurrence occ{{}, cell, static_cast<ind>(local)};
+                occ.key.fill(std::numeric_limits<ind>::max());
+                for (size_t i = 0; i < locals[local].size(); ++i) {
+                    occ.key[i] = verts[locals[local][i]];
+                }
+                std::sort(occ.key.begin(), occ.key.end());
+                if (occ.key[0] == vertex) occurrences.push_back(occ);
+            }
+        }
+        std::sort(occurrences.begin(), occurrences.end());
+    };
+    const auto numSubVertices = [&](const Occurrence& occ) {
+        return static_cast<ind>(
+            getTopology(cellTypes_[occ.cell])->subElements(sub)[occ.local].size());
+    };
+
+    // Count the unique sub elements per vertex and their number of vertices.
+    std::vector<ind> subCounts(static_cast<size_t>(numVertices));
+    std::vector<ind> vertexCounts(static_cast<size_t>(numVertices));
+    util::parallelFor(ind{0}, numVertices, [&](ind first, ind last) {
+        std::vector<Occurrence> occurrences;
+        for (ind vertex = first; vertex < last; ++vertex) {
+            gather(vertex, occurrences);
+            ind subs = 0;
+            ind verts = 0;
+            for (size_t i = 0; i < occurrences.size(); ++i) {
+                if (i == 0 || occurrences[i].key != occurrences[i - 1].key) {
+                    ++subs;
+                    verts += numSubVertices(occurrences[i]);
+                }
+            }
+            subCounts[vertex] = subs;
+            vertexCounts[vertex] = verts;
+        }
+    });
+    const auto subOffsets = toOffsets(subCounts);
+    const auto subVertexOffsets = toOffsets(vertexCounts);
+    const auto numSubs = subOffsets.back();
+
+    // Number the sub elements, keep the vertex order of their first occurrence.
+    auto& subVertices = relations_[sub][0];
+    subVertices.offsets.resize(static_cast<size_t>(numSubs) + 1);
+    subVertices.offsets.back() = subVertexOffsets.back();
+    subVertices.indices.resize(static_cast<size_t>(subVertexOffsets.back()));
+    util::parallelFor(ind{0}, numVertices, [&](ind first, ind last) {
+        std::vector<Occurrence> occurrences;
+        for (ind vertex = first; vertex < last; ++vertex) {
+            gather(vertex, occurrences);
+            ind id = subOffsets[vertex] - 1;
+            ind pos = subVertexOffsets[vertex];
+            for (size_t i = 0; i < occurrences.size(); ++i) {
+                const auto& occ = occurrences[i];
+                if (i == 0 || occ.key != occurrences[i - 1].key) {
+                    ++id;
+                    subVertices.offsets[id] = pos;
+                    const auto verts = cellVertices[occ.cell];
+                    for (auto local :
+                         getTopology(cellTypes_[occ.cell])->subElements(sub)[occ.local]) {
+                        subVertices.indices[pos++] = verts[local];
+                    }
+                }
+                cellSubs.indices[cellSubs.offsets[occ.cell] + occ.local] = id;
+            }
+        }
+    });
+
+    numGridPrimitives_[sub] = numSubs;
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
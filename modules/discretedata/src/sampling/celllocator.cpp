@@ -0,0 +1,390 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/discretedata/sampling/celllocator.h>
+
+#include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/unstructuredgrid.h>
+#include <modules/discretedata/util.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+constexpr double epsilon = 1e-6;
+constexpr int maxNewtonIterations = 16;
+
+//! Corner order of StructuredGrid cells (bit d set: upper side in dimension d) to VTK hexahedron
+constexpr std::array<ind, 8> voxelToHexahedron = {0, 1, 3, 2, 4, 5, 7, 6};
+
+bool inUnitInterval(double v) { return v >= -epsilon && v <= 1.0 + epsilon; }
+
+/**
+ * Barycentric coordinates of pos in the tetrahedron (a, b, c, d), false if degenerate or outside
+ */
+bool tetraWeights(const dvec3& a, const dvec3& b, const dvec3& c, const dvec3& d, const dvec3& pos,
+                  dvec4& weights) {
+    const dmat3 m{b - a, c - a, d - a};
+    const double det = glm::determinant(m);
+    if (std::abs(det) < std::numeric_limits<double>::min()) return false;
+    const dvec3 l = glm::inverse(m) * (pos - a);
+    weights = dvec4{1.0 - l.x - l.y - l.z, l.x, l.y, l.z};
+    return glm::all(glm::greaterThanEqual(weights, dvec4{-epsilon}));
+}
+
+/**
+ * Invert an isoparametric map by Newton iteration, starting at param. ShapeFunctions fills the
+ * weights and their derivatives with respect to the parametric coordinates at a parametric
+ * position. Returns the parametric coordinates of pos and the weights there, std::nullopt if the
+ * map is degenerate.
+ */
+template <size_t N, typename ShapeFunctions>
+std::optional<dvec3> invertMap(const std::array<dvec3, N>& corners, const dvec3& pos, dvec3 param,
+                               ShapeFunctions shapeFunctions, std::array<double, N>& weights) {
+    std::array<dvec3, N> derivatives;
+    for (int iteration = 0; iteration < maxNewtonIterations; ++iteration) {
+        shapeFunctions(param, weights, derivatives);
+        dvec3 x{0.0};
+        dmat3 jacobian{0.0};
+        for (size_t i = 0; i < N; ++i) {
+            x += weights[i] * corners[i];
+            jacobian += glm::outerProduct(corners[i], derivatives[i]);
+        }
+        if (std::abs(glm::determinant(jacobian)) < std::numeric_limits<double>::min()) {
+            return std::nullopt;
+        }
+        const dvec3 step = glm::inverse(jacobian) * (x - pos);
+        param -= step;
+        if (glm::compMax(glm::abs(step)) < epsilon * 1e-3) break;
+    }
+    shapeFunctions(param, weights, derivatives);
+    return param;
+}
+
+void hexahedronShape(const dvec3& p, std::array<double, 8>& w, std::array<dvec3, 8>& dw) {
+    // VTK order: counter clockwise bottom quad, then the top quad
+    static constexpr std::array<int, 8> cx = {0, 1, 1, 0, 0, 1, 1, 0};
+    static constexpr std::array<int, 8> cy = {0, 0, 1, 1, 0, 0, 1, 1};
+    for (size_t i = 0; i < 8; ++i) {
+        const dvec3 f{cx[i] ? p.x : 1.0 - p.x, cy[i] ? p.y : 1.0 - p.y, i < 4 ? 1.0 - p.z : p.z};
+        const dvec3 s{cx[i] ? 1.0 : -1.0, cy[i] ? 1.0 : -1.0, i < 4 ? -1.0 : 1.0};
+        w[i] = f.x * f.y * f.z;
+        dw[i] = dvec3{s.x * f.y * f.z, f.x * s.y * f.z, f.x * f.y * s.z};
+    }
+}
+
+void wedgeShape(const dvec3& p, std::array<double, 6>& w, std::array<dvec3, 6>& dw) {
+    const std::array<double, 3> l = {1.0 - p.x - p.y, p.x, p.y};
+    static const std::array<dvec2, 3> dl = {dvec2{-1.0, -1.0}, dvec2{1.0, 0.0},
+                                             dvec2{0.0, 1.0}};
+    for (size_t i = 0; i < 3; ++i) {
+        w[i] = l[i] * (1.0 - p.z);
+        w[i + 3] = l[i] * p.z;
+        dw[i] = dvec3{dl[i] * (1.0 - p.z), -l[i]};
+        dw[i + 3] = dvec3{dl[i] * p.z, l[i]};
+    }
+}
+
+}  // namespace
+
+CellLocator::CellLocator(const Connectivity& grid, const Channel& positions)
+    : SpatialEntity<3>(), min_{0.0}, max_{0.0}, numBins_{1}, binSize_{1.0} {
+    if (grid.getDimension() != GridPrimitive::Volume) {
+        throw Exception("CellLocator requires a grid of volume cells",
+                        IVW_CONTEXT_CUSTOM("CellLocator"));
+    }
+    const ind numVertices = grid.getNumElements(GridPrimitive::Vertex);
+    positions_ = dd_util::channelToDouble<3>(positions);
+    if (static_cast<ind>(positions_.size()) != numVertices || positions.size() != numVertices) {
+        throw Exception("CellLocator requires one position with 3 components per vertex",
+                        IVW_CONTEXT_CUSTOM("CellLocator"));
+    }
+
+    // Flatten the cell to vertex relation
+    const ind numCells = grid.getNumElements(GridPrimitive::Volume);
+    if (auto unstructured = dynamic_cast<const UnstructuredGrid*>(&grid)) {
+        const auto& rel = unstructured->getRelation(GridPrimitive::Volume, GridPrimitive::Vertex);
+        cellOffsets_ = rel.offsets;
+        cellVertices_ = rel.indices;
+    } else {
+        std::vector<ind> counts(static_cast<size_t>(numCells));
+        util::parallelFor(ind{0}, numCells, [&](ind first, ind last) {
+            std::vector<ind> verts;
+            for (ind cell = first; cell < last; ++cell) {
+                verts.clear();
+                grid.getConnections(verts, cell, GridPrimitive::Volume, GridPrimitive::Vertex);
+                counts[cell] = static_cast<ind>(verts.size());
+            }
+        });
+        cellOffsets_.resize(static_cast<size_t>(numCells) + 1);
+        cellOffsets_[0] = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            cellOffsets_[cell + 1] = cellOffsets_[cell] + counts[cell];
+        }
+        cellVertices_.resize(static_cast<size_t>(cellOffsets_.back()));
+
+        const bool structured = dynamic_cast<const StructuredGrid*>(&grid) != nullptr;
+        util::parallelFor(ind{0}, numCells, [&](ind first, ind last) {
+            std::vector<ind> verts;
+            for (ind cell = first; cell < last; ++cell) {
+                verts.clear();
+                grid.getConnections(verts, cell, GridPrimitive::Volume, GridPrimitive::Vertex);
+                auto* dest = cellVertices_.data() + cellOffsets_[cell];
+                if (structured && verts.size() == 8) {
+                    for (size_t i = 0; i < 8; ++i) dest[i] = verts[voxelToHexahedron[i]];
+                } else {
+                    std::copy(verts.begin(), verts.end(), dest);
+                }
+            }
+        });
+    }
+
+    // Cell shapes and bounding boxes
+    shapes_.resize(static_cast<size_t>(numCells));
+    cellMin_.resize(static_cast<size_t>(numCells));
+    cellMax_.resize(static_cast<size_t>(numCells));
+    std::atomic<bool> invalid{false};
+    util::parallelFor(ind{0}, numCells, [&](ind cell) {
+        const ind size = cellOffsets_[cell + 1] - cellOffsets_[cell];
+        switch (grid.getCellType(GridPrimitive::Volume, cell)) {
+            case CellType::Tetra:
+                shapes_[cell] = Shape::Tetra;
+                invalid = invalid || size != 4;
+                break;
+            case CellType::Hexahedron:
+                shapes_[cell] = Shape::Hexahedron;
+                invalid = invalid || size != 8;
+                break;
+            case CellType::Wedge:
+                shapes_[cell] = Shape::Wedge;
+                invalid = invalid || size != 6;
+                break;
+            case CellType::Pyramid:
+                shapes_[cell] = Shape::Pyramid;
+                invalid = invalid || size != 5;
+                break;
+            default:
+                invalid = true;
+                return;
+        }
+        dvec3 cmin{std::numeric_limits<double>::max()};
+        dvec3 cmax{std::numeric_limits<double>::lowest()};
+        for (ind i = cellOffsets_[cell]; i < cellOffsets_[cell + 1]; ++i) {
+            const auto v = cellVertices_[i];
+            if (v < 0 || v >= numVertices) {
+                invalid = true;
+                return;
+            }
+            cmin = glm::min(cmin, positions_[v]);
+            cmax = glm::max(cmax, positions_[v]);
+        }
+        cellMin_[cell] = cmin;
+        cellMax_[cell] = cmax;
+    });
+    if (invalid) {
+        throw Exception(
+            "CellLocator supports tetrahedra, hexahedra, wedges, and pyramids with valid vertices",
+            IVW_CONTEXT_CUSTOM("CellLocator"));
+    }
+    if (numCells == 0) return;
+
+    min_ = dvec3{std::numeric_limits<double>::max()};
+    max_ = dvec3{std::numeric_limits<double>::lowest()};
+    for (ind cell = 0; cell < numCells; ++cell) {
+        min_ = glm::min(min_, cellMin_[cell]);
+        max_ = glm::max(max_, cellMax_[cell]);
+    }
+
+    // About one cell per bin, bins are roughly cubes
+    const dvec3 extent = glm::max(max_ - min_, dvec3{std::numeric_limits<double>::min()});
+    const double binLength = std::cbrt(extent.x * extent.y * extent.z / numCells);
+    const double maxBinsPerDim = std::cbrt(static_cast<double>(numCells)) * 4.0 + 1.0;
+    for (int d = 0; d < 3; ++d) {
+        numBins_[d] = static_cast<size_t>(
+            std::clamp(std::ceil(extent[d] / binLength), 1.0, maxBinsPerDim));
+    }
+    binSize_ = extent / dvec3{numBins_};
+
+    const auto binRange = [&](ind cell) {
+        const auto toBin = [&](const dvec3& p) {
+            const size3_t bin{glm::max((p - min_) / binSize_, dvec3{0.0})};
+            return glm::min(bin, numBins_ - size3_t{1});
+        };
+        return std::make_pair(toBin(cellMin_[cell]), toBin(cellMax_[cell]));
+    };
+    const auto binIndex = [&](size_t x, size_t y, size_t z) {
+        return static_cast<ind>(x + numBins_.x * (y + numBins_.y * z));
+    };
+    const auto forEachBin = [&](ind cell, auto callback) {
+        const auto [bmin, bmax] = binRange(cell);
+        for (size_t z = bmin.z; z <= bmax.z; ++z) {
+            for (size_t y = bmin.y; y <= bmax.y; ++y) {
+                for (size_t x = bmin.x; x <= bmax.x; ++x) callback(binIndex(x, y, z));
+            }
+        }
+    };
+
+    const ind numBins = static_cast<ind>(numBins_.x * numBins_.y * numBins_.z);
+    std::vector<std::atomic<ind>> counts(static_cast<size_t>(numBins));
+    util::parallelFor(ind{0}, numBins,
+                      [&](ind b) { counts[b].store(0, std::memory_order_relaxed); });
+    util::parallelFor(ind{0}, numCells, [&](ind cell) {
+        forEachBin(cell, [&](ind b) { counts[b].fetch_add(1, std::memory_order_relaxed); });
+    });
+
+    binOffsets_.resize(static_cast<size_t>(numBins) + 1);
+    binOffsets_[0] = 0;
+    for (ind b = 0; b < numBins; ++b) {
+        binOffsets_[b + 1] = binOffsets_[b] + counts[b].load(std::memory_order_relaxed);
+        counts[b].store(0, std::memory_order_relaxed);
+    }
+    binCells_.resize(static_cast<size_t>(binOffsets_.back()));
+    util::parallelFor(ind{0}, numCells, [&](ind cell) {
+        forEachBin(cell, [&](ind b) {
+            binCells_[binOffsets_[b] + counts[b].fetch_add(1, std::memory_order_relaxed)] = cell;
+        });
+    });
+    // Sort for a deterministic result where cells touch
+    util::parallelFor(ind{0}, numBins, [&](ind b) {
+        std::sort(binCells_.begin() + binOffsets_[b], binCells_.begin() + binOffsets_[b + 1]);
+    });
+
+    setBasis(mat3{glm::diagonal3x3(vec3{extent})});
+    setOffset(vec3{min_});
+}
+
+CellLocator* CellLocator::clone() const { return new CellLocator(*this); }
+
+CellLocator::Location CellLocator::locate(const dvec3& pos) const {
+    Location location;
+    if (binOffsets_.empty() || glm::any(glm::lessThan(pos, min_)) ||
+        glm::any(glm::greaterThan(pos, max_))) {
+        return location;
+    }
+
+    const size3_t bin = glm::min(size3_t{(pos - min_) / binSize_}, numBins_ - size3_t{1});
+    const ind b = static_cast<ind>(bin.x + numBins_.x * (bin.y + numBins_.y * bin.z));
+    for (ind i = binOffsets_[b]; i < binOffsets_[b + 1]; ++i) {
+        const ind cell = binCells_[i];
+        if (glm::any(glm::lessThan(pos, cellMin_[cell] - epsilon)) ||
+            glm::any(glm::greaterThan(pos, cellMax_[cell] + epsilon))) {
+            continue;
+        }
+        if (locateInCell(cell, pos, location)) return location;
+    }
+    return Location{};
+}
+
+void CellLocator::locate(util::span<const dvec3> positions, util::span<Location> result) const {
+    if (positions.size() != result.size()) {
+        throw Exception("Positions and result have to have the same size",
+                        IVW_CONTEXT_CUSTOM("CellLocator"));
+    }
+    util::parallelFor(size_t{0}, positions.size(),
+                      [&](size_t i) { result[i] = locate(positions[i]); });
+}
+
+bool CellLocator::locateInCell(ind cell, const dvec3& pos, Location& location) const {
+    const ind* verts = cellVertices_.data() + cellOffsets_[cell];
+    const auto corners = [&](auto& dest) {
+        for (size_t i = 0; i < dest.size(); ++i) dest[i] = positions_[verts[i]];
+    };
+    const auto setLocation = [&](std::initializer_list<ind> localVertices, const auto& weights) {
+        location.cell = cell;
+        location.numVertices = static_cast<ind>(localVertices.size());
+        int i = 0;
+        for (auto local : localVertices) {
+            location.vertices[i] = verts[local];
+            location.weights[i] = weights[i];
+            ++i;
+        }
+        return true;
+    };
+
+    switch (shapes_[cell]) {
+        case Shape::Tetra: {
+            dvec4 w;
+            if (tetraWeights(positions_[verts[0]], positions_[verts[1]], positions_[verts[2]],
+                             positions_[verts[3]], pos, w)) {
+                return setLocation({0, 1, 2, 3}, w);
+            }
+            return false;
+        }
+        case Shape::Pyramid: {
+            // Split along the base diagonal 0-2
+            const auto& apex = positions_[verts[4]];
+            dvec4 w;
+            if (tetraWeights(positions_[verts[0]], positions_[verts[1]], positions_[verts[2]],
+                             apex, pos, w)) {
+                return setLocation({0, 1, 2, 4}, w);
+            }
+            if (tetraWeights(positions_[verts[0]], positions_[verts[2]], positions_[verts[3]],
+                             apex, pos, w)) {
+                return setLocation({0, 2, 3, 4}, w);
+            }
+            return false;
+        }
+        case Shape::Hexahedron: {
+            std::array<dvec3, 8> c;
+            corners(c);
+            std::array<double, 8> w;
+            const auto p = invertMap(c, pos, dvec3{0.5}, hexahedronShape, w);
+            if (p && inUnitInterval(p->x) && inUnitInterval(p->y) && inUnitInterval(p->z)) {
+                return setLocation({0, 1, 2, 3, 4, 5, 6, 7}, w);
+            }
+            return false;
+        }
+        case Shape::Wedge: {
+            std::array<dvec3, 6> c;
+            corners(c);
+            std::array<double, 6> w;
+            const auto p = invertMap(c, pos, dvec3{1.0 / 3.0, 1.0 / 3.0, 0.5}, wedgeShape, w);
+            if (p && inUnitInterval(p->x) && inUnitInterval(p->y) && inUnitInterval(p->z) &&
+                p->x + p->y <= 1.0 + epsilon) {
+                return setLocation({0, 1, 2, 3, 4, 5}, w);
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
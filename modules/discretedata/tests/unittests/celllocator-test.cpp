@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/discretedata/channels/bufferchannel.h>
+#include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/unstructuredgrid.h>
+#include <modules/discretedata/sampling/celllocator.h>
+#include <modules/discretedata/sampling/datasetsampler.h>
+#include <inviwo/core/util/exception.h>
+
+#include <numeric>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+double linear(const dvec3& p) { return 1.0 + p.x + 2.0 * p.y + 3.0 * p.z; }
+
+//! A unit cube hexahedron with a pyramid on top, apex at (0.5, 0.5, 1.5)
+std::shared_ptr<UnstructuredGrid> hexWithPyramid() {
+    return std::make_shared<UnstructuredGrid>(
+        GridPrimitive::Volume, 9, std::vector<ind>{0, 8, 13},
+        std::vector<ind>{0, 1, 2, 3, 4, 5, 6, 7, 4, 5, 6, 7, 8},
+        std::vector<CellType>{CellType::Hexahedron, CellType::Pyramid});
+}
+
+std::vector<dvec3> hexWithPyramidPositions() {
+    return {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},      {0, 0, 1},
+            {1, 0, 1}, {1, 1, 1}, {0, 1, 1}, {0.5, 0.5, 1.5}};
+}
+
+template <typename T, ind N, typename Vec>
+std::shared_ptr<BufferChannel<T, N>> makeChannel(const std::vector<Vec>& values,
+                                                   const std::string& name) {
+    std::vector<T> raw;
+    for (const auto& v : values) {
+        for (ind c = 0; c < N; ++c) raw.push_back(static_cast<T>(v[static_cast<int>(c)]));
+    }
+    return std::make_shared<BufferChannel<T, N>>(raw, name, GridPrimitive::Vertex);
+}
+
+}  // namespace
+
+TEST(CellLocator, LocateUnstructured) {
+    const auto positions = hexWithPyramidPositions();
+    CellLocator locator(*hexWithPyramid(), *makeChannel<float, 3>(positions, "Position"));
+
+    EXPECT_EQ(dvec3(0.0), locator.getMin());
+    EXPECT_EQ(dvec3(1.0, 1.0, 1.5), locator.getMax());
+
+    for (const auto& [pos, cell] : std::vector<std::pair<dvec3, ind>>{
+             {{0.25, 0.5, 0.75}, 0}, {{0.9, 0.1, 0.1}, 0}, {{0.5, 0.5, 1.25}, 1},
+             {{0.4, 0.6, 1.1}, 1},   {{0.1, 0.1, 1.4}, -1}, {{2.0, 0.5, 0.5}, -1}}) {
+        const auto location = locator.locate(pos);
+        EXPECT_EQ(cell, location.cell) << pos;
+        if (!location.found()) continue;
+
+        double sum = 0.0;
+        for (ind i = 0; i < location.numVertices; ++i) sum += location.weights[i];
+        EXPECT_NEAR(1.0, sum, 1e-9);
+        const auto interpolated = location.interpolate(positions.data());
+        EXPECT_NEAR(0.0, glm::distance(pos, interpolated), 1e-9) << pos;
+    }
+}
+
+TEST(CellLocator, LocateStructuredBatched) {
+    const std::vector<ind> size = {4, 3, 2};
+    StructuredGrid grid(GridPrimitive::Volume, size);
+
+    // Sheared grid with spacing 0.5
+    std::vector<dvec3> positions;
+    for (ind z = 0; z <= size[2]; ++z) {
+        for (ind y = 0; y <= size[1]; ++y) {
+            for (ind x = 0; x <= size[0]; ++x) {
+                positions.emplace_back(0.5 * x + 0.25 * z, 0.5 * y, 0.5 * z);
+            }
+        }
+    }
+    CellLocator locator(grid, *makeChannel<double, 3>(positions, "Position"));
+
+    std::vector<dvec3> queries;
+    for (ind z = 0; z < size[2]; ++z) {
+        for (ind y = 0; y < size[1]; ++y) {
+            for (ind x = 0; x < size[0]; ++x) {
+                queries.emplace_back(0.5 * x + 0.25 * z + 0.3, 0.5 * y + 0.2, 0.5 * z + 0.1);
+            }
+        }
+    }
+    std::vector<CellLocator::Location> result(queries.size());
+    locator.locate(queries, result);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(static_cast<ind>(i), result[i].cell);
+        EXPECT_EQ(8, result[i].numVertices);
+        EXPECT_NEAR(0.0, glm::distance(queries[i], result[i].interpolate(positions.data())),
+                    1e-9);
+    }
+}
+
+TEST(CellLocator, InvalidInput) {
+    const auto positions = hexWithPyramidPositions();
+    auto grid = hexWithPyramid();
+    EXPECT_THROW(CellLocator(*grid, *makeChannel<float, 2>(positions, "Position")), Exception);
+
+    std::vector<dvec3> tooFew(positions.begin(), positions.end() - 1);
+    EXPECT_THROW(CellLocator(*grid, *makeChannel<float, 3>(tooFew, "Position")), Exception);
+
+    StructuredGrid plane(GridPrimitive::Face, {2, 2});
+    EXPECT_THROW(CellLocator(plane, *makeChannel<float, 3>(positions, "Position")), Exception);
+}
+
+TEST(DataSetSampler, LinearField) {
+    const auto positions = hexWithPyramidPositions();
+    auto locator = std::make_shared<const CellLocator>(
+        *hexWithPyramid(), *makeChannel<float, 3>(positions, "Position"));
+
+    std::vector<dvec1> values;
+    for (const auto& p : positions) values.emplace_back(linear(p));
+    DataSetSampler<1> sampler(locator, *makeChannel<double, 1>(values, "Values"));
+
+    // Data space is the unit cube over the bounding box
+    const dvec3 extent{1.0, 1.0, 1.5};
+    std::vector<dvec3> queries{{0.1, 0.2, 0.3}, {0.5, 0.5, 0.9}, {0.7, 0.3, 0.5}, {0.9, 0.9, 0.95}};
+    std::vector<dvec1> result(queries.size());
+    sampler.sample(queries, result);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto inside = queries[i] != dvec3{0.9, 0.9, 0.95};
+        EXPECT_EQ(inside, sampler.withinBounds(queries[i]));
+        const double expected = inside ? linear(queries[i] * extent) : 0.0;
+        EXPECT_NEAR(expected, sampler.sample(queries[i]).x, 1e-9);
+        EXPECT_NEAR(expected, result[i].x, 1e-9);
+    }
+
+    EXPECT_THROW(DataSetSampler<3>(locator, *makeChannel<double, 1>(values, "Values")),
+                 Exception);
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
@@ -148,5 +148,34 @@ TEST(CreatingCopyingIndexing, DataChannels) {
     }
 }
 
+TEST(CreatingCopyingIndexing, RangeFill) {
+    const ind numElements = 10;
+    auto base = [](glm::vec3& dest, ind idx) {
+        dest[0] = 1.0f;
+        dest[1] = static_cast<float>(idx);
+        dest[2] = static_cast<float>(idx * idx);
+    };
+    std::vector<float> data;
+    for (ind idx = 0; idx < numElements; ++idx) {
+        data.push_back(1.0f);
+        data.push_back(static_cast<float>(idx));
+        data.push_back(static_cast<float>(idx * idx));
+    }
+    BufferFloat buffer(data.data(), numElements, "MonomialBuffer");
+    AnalyticChannel<float, 3, glm::vec3> analytic(base, numElements, "MonomialAnalytical");
+
+    std::vector<glm::vec3> fromBuffer(4);
+    std::vector<glm::vec3> fromAnalytic(4);
+    buffer.fill(fromBuffer.data(), 3, 7);
+    analytic.fill(fromAnalytic.data(), 3, 7);
+
+    for (ind i = 0; i < 4; ++i) {
+        glm::vec3 expected;
+        base(expected, i + 3);
+        EXPECT_EQ(expected, fromBuffer[i]);
+        EXPECT_EQ(expected, fromAnalytic[i]);
+    }
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
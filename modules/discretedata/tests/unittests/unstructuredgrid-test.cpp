@@ -0,0 +1,158 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/discretedata/connectivity/unstructuredgrid.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+/**
+ * A unit cube hexahedron with a pyramid on top
+ *     8
+ *   7---6
+ *  4---5|
+ *  |3--|2
+ *  0---1
+ */
+std::shared_ptr<UnstructuredGrid> hexWithPyramid() {
+    return std::make_shared<UnstructuredGrid>(
+        GridPrimitive::Volume, 9, std::vector<ind>{0, 8, 13},
+        std::vector<ind>{0, 1, 2, 3, 4, 5, 6, 7, 4, 5, 6, 7, 8},
+        std::vector<CellType>{CellType::Hexahedron, CellType::Pyramid});
+}
+
+std::vector<ind> sorted(util::span<const ind> span) {
+    std::vector<ind> res(span.begin(), span.end());
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+}  // namespace
+
+TEST(UnstructuredGrid, NumElements) {
+    auto grid = hexWithPyramid();
+    EXPECT_EQ(9, grid->getNumElements(GridPrimitive::Vertex));
+    EXPECT_EQ(16, grid->getNumElements(GridPrimitive::Edge));
+    EXPECT_EQ(10, grid->getNumElements(GridPrimitive::Face));
+    EXPECT_EQ(2, grid->getNumElements(GridPrimitive::Volume));
+
+    EXPECT_EQ(CellType::Hexahedron, grid->getCellType(GridPrimitive::Volume, 0));
+    EXPECT_EQ(CellType::Pyramid, grid->getCellType(GridPrimitive::Volume, 1));
+    ind triangles = 0;
+    for (ind face = 0; face < 10; ++face) {
+        if (grid->getCellType(GridPrimitive::Face, face) == CellType::Triangle) ++triangles;
+    }
+    EXPECT_EQ(4, triangles);
+}
+
+TEST(UnstructuredGrid, Connections) {
+    auto grid = hexWithPyramid();
+
+    EXPECT_EQ((std::vector<ind>{4, 5, 6, 7}),
+              sorted(grid->getConnections(8, GridPrimitive::Vertex, GridPrimitive::Vertex)));
+    EXPECT_EQ((std::vector<ind>{1, 3, 4}),
+              sorted(grid->getConnections(0, GridPrimitive::Vertex, GridPrimitive::Vertex)));
+    EXPECT_EQ((std::vector<ind>{0, 1}),
+              sorted(grid->getConnections(4, GridPrimitive::Vertex, GridPrimitive::Volume)));
+    EXPECT_EQ((std::vector<ind>{1}),
+              sorted(grid->getConnections(0, GridPrimitive::Volume, GridPrimitive::Volume)));
+    EXPECT_EQ(12, grid->getConnections(0, GridPrimitive::Volume, GridPrimitive::Edge).size());
+    EXPECT_EQ(5, grid->getConnections(1, GridPrimitive::Volume, GridPrimitive::Face).size());
+
+    // The shared face is the only one with two cells.
+    const auto hexFaces = grid->getConnections(0, GridPrimitive::Volume, GridPrimitive::Face);
+    const auto pyrFaces = grid->getConnections(1, GridPrimitive::Volume, GridPrimitive::Face);
+    for (auto face : hexFaces) {
+        const auto cells = grid->getConnections(face, GridPrimitive::Face, GridPrimitive::Volume);
+        const bool shared = std::find(pyrFaces.begin(), pyrFaces.end(), face) != pyrFaces.end();
+        EXPECT_EQ(shared ? 2u : 1u, cells.size());
+        if (shared) {
+            EXPECT_EQ((std::vector<ind>{4, 5, 6, 7}),
+                      sorted(grid->getConnections(face, GridPrimitive::Face,
+                                                  GridPrimitive::Vertex)));
+        }
+    }
+}
+
+TEST(UnstructuredGrid, Bidirectional) {
+    auto grid = hexWithPyramid();
+    grid->buildAllConnections();
+
+    for (ind from = 0; from <= 3; ++from) {
+        for (ind to = 0; to <= 3; ++to) {
+            const auto fromDim = static_cast<GridPrimitive>(from);
+            const auto toDim = static_cast<GridPrimitive>(to);
+            for (ind index = 0; index < grid->getNumElements(fromDim); ++index) {
+                for (auto other : grid->getConnections(index, fromDim, toDim)) {
+                    const auto back = grid->getConnections(other, toDim, fromDim);
+                    EXPECT_NE(back.end(), std::find(back.begin(), back.end(), index))
+                        << "from " << from << " to " << to << " index " << index;
+                }
+            }
+        }
+    }
+
+    // Edges of a face connect consecutive face vertices.
+    for (ind face = 0; face < grid->getNumElements(GridPrimitive::Face); ++face) {
+        const auto verts = grid->getConnections(face, GridPrimitive::Face, GridPrimitive::Vertex);
+        const auto edges = grid->getConnections(face, GridPrimitive::Face, GridPrimitive::Edge);
+        ASSERT_EQ(verts.size(), edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) {
+            std::vector<ind> expected{verts[i], verts[(i + 1) % verts.size()]};
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(expected, sorted(grid->getConnections(edges[i], GridPrimitive::Edge,
+                                                            GridPrimitive::Vertex)));
+        }
+    }
+}
+
+TEST(UnstructuredGrid, InvalidCells) {
+    EXPECT_THROW(UnstructuredGrid(GridPrimitive::Volume, 4, {0, 3}, {0, 1, 2},
+                                  {CellType::Tetra}),
+                 Exception);
+    EXPECT_THROW(UnstructuredGrid(GridPrimitive::Volume, 3, {0, 4}, {0, 1, 2, 3},
+                                  {CellType::Tetra}),
+                 Exception);
+    EXPECT_THROW(UnstructuredGrid(GridPrimitive::Volume, 3, {0, 3}, {0, 1, 2},
+                                  {CellType::Triangle}),
+                 Exception);
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
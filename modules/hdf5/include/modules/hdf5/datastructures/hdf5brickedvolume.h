@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_HDF5BRICKEDVOLUME_H
+#define IVW_HDF5BRICKEDVOLUME_H
+
+#include <modules/hdf5/hdf5moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/datastructures/hdf5path.h>
+
+#include <H5Cpp.h>
+
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+namespace hdf5 {
+
+/**
+ * \brief On-demand access to a hyperslab of an HDF5 dataset, divided into bricks
+ *
+ * The selected hyperslab, which may have at most three dimensions with more than one element, is
+ * divided into bricks. A brick is read from the file the first time it is requested and kept in a
+ * least recently used cache of decoded bricks, limited to `cacheSize` bytes. The minimum and
+ * maximum value of a brick is computed when it is read and kept after it has been evicted.
+ * Use readRegion to assemble a part of the volume from the bricks it overlaps, moving the region
+ * around only reads the bricks that are not cached yet.
+ *
+ * If the dataset is chunked and no brick size is given, the bricks are aligned to the chunks of
+ * the dataset, taking the stride of the selection into account, such that a brick never decodes
+ * a chunk that is shared with another brick as long as the selection starts on a chunk boundary.
+ *
+ * All functions are thread safe. Calls into the HDF5 library are serialized since the library
+ * itself is not reentrant, the conversion, min/max computation and copying of bricks runs
+ * concurrently.
+ */
+class IVW_MODULE_HDF5_API BrickedVolume {
+public:
+    /// Bricks of at least this many voxels along each axis are used for chunked datasets
+    static constexpr size_t minBrickSize = 32;
+    /// Brick size used for datasets that are not chunked
+    static constexpr size_t defaultBrickSize = 64;
+
+    /**
+     * @param filename   the HDF5 file
+     * @param path       absolute path of the dataset within the file
+     * @param selection  the hyperslab, one selection per dimension of the dataset, column major
+     * @param format     format to convert the data to, the format of the dataset if nullptr
+     * @param brickSize  voxels along each axis of a brick, derived from the chunks if zero
+     * @param cacheSize  maximum number of bytes kept in the brick cache
+     * @throws Exception if the selection does not match the dataset
+     */
+    BrickedVolume(const std::string& filename, const Path& path,
+                  std::vector<Handle::Selection> selection, const DataFormatBase* format = nullptr,
+                  size3_t brickSize = size3_t{0}, size_t cacheSize = size_t{512} << 20);
+    BrickedVolume(const BrickedVolume&) = delete;
+    BrickedVolume& operator=(const BrickedVolume&) = delete;
+    ~BrickedVolume();
+
+    const std::string& getFileName() const;
+    const Path& getPath() const;
+    const DataFormatBase* getDataFormat() const;
+
+    /// Dimensions of the volume, i.e. of the selected hyperslab
+    size3_t getDimensions() const;
+    size3_t getBrickSize() const;
+    /// Number of bricks along each axis
+    size3_t getBrickCounts() const;
+    /// The voxels covered by \p brick, as [begin, end)
+    std::pair<size3_t, size3_t> getBrickRegion(const size3_t& brick) const;
+
+    /**
+     * Get \p brick, reading it from the file unless it is cached.
+     */
+    std::shared_ptr<const VolumeRAM> getBrick(const size3_t& brick) const;
+
+    /**
+     * Get all the \p bricks, reading the ones that are not cached. The bricks are read
+     * concurrently on the thread pool if \p parallel is true.
+     */
+    std::vector<std::shared_ptr<const VolumeRAM>> getBricks(const std::vector<size3_t>& bricks,
+                                                            bool parallel = true) const;
+
+    /**
+     * The minimum and maximum value per channel of \p brick, if it has been read.
+     */
+    std::optional<std::pair<dvec4, dvec4>> getBrickMinMax(const size3_t& brick) const;
+
+    /**
+     * The minimum and maximum value per channel of all bricks read so far. The result covers the
+     * whole volume once every brick has been read, see readAll.
+     */
+    std::pair<dvec4, dvec4> getMinMax() const;
+    /// True if all bricks have been read at least once
+    bool isMinMaxComplete() const;
+
+    /**
+     * Read the whole volume with a single read straight into the result, bypassing the brick
+     * cache. The min/max of all bricks is computed afterwards, concurrently on the thread pool if
+     * \p parallel is true, see getMinMax.
+     */
+    std::shared_ptr<VolumeRAM> readAll(bool parallel = true) const;
+
+    /**
+     * Read the region [\p begin, \p end) of the volume from the bricks it overlaps. The bricks are
+     * taken from the cache, or read and added to it. The bricks are copied concurrently on the
+     * thread pool if \p parallel is true.
+     * @return the region and its minimum and maximum value per channel
+     * @throws Exception if the region is empty or outside of the volume
+     */
+    std::pair<std::shared_ptr<VolumeRAM>, std::pair<dvec4, dvec4>> readRegion(
+        const size3_t& begin, const size3_t& end, bool parallel = true) const;
+
+    size_t getCacheSize() const;
+    /// Set the maximum number of bytes kept in the brick cache, evicting bricks if needed
+    void setCacheSize(size_t cacheSize);
+    /// Number of bytes of the bricks currently in the cache
+    size_t getCachedBytes() const;
+    /// True if \p brick is in the cache
+    bool isCached(const size3_t& brick) const;
+    void clearCache();
+
+    /// Number of bricks read from the file so far, bricks taken from the cache are not counted
+    size_t getBricksRead() const;
+
+private:
+    struct CacheEntry {
+        std::shared_ptr<const VolumeRAM> brick;
+        std::list<size_t>::iterator lru;
+    };
+
+    size_t brickIndex(const size3_t& brick) const;
+    /// Read the voxels [begin, begin + extent) of the volume into the contiguous \p dst
+    void read(void* dst, const H5::DataType& type, const size3_t& begin,
+              const size3_t& extent) const;
+    std::shared_ptr<VolumeRAM> readBrick(size_t index) const;
+    std::shared_ptr<const VolumeRAM> findCached(size_t index) const;
+    void insertCached(size_t index, std::shared_ptr<const VolumeRAM> brick) const;
+    void evict() const;
+
+    std::string filename_;
+    Path path_;
+    const DataFormatBase* format_;
+
+    H5::H5File file_;
+    H5::DataSet dataset_;
+
+    // Row major hyperslab of the dataset
+    std::vector<hsize_t> start_;
+    std::vector<hsize_t> stride_;
+    // Dataset dimension of the x, y, and z axis of the volume, -1 for axes of size 1
+    std::array<int, 3> axes_;
+
+    size3_t dimensions_;
+    size3_t brickSize_;
+    size3_t brickCounts_;
+
+    mutable std::mutex mutex_;
+    size_t cacheSize_;
+    mutable size_t cachedBytes_ = 0;
+    mutable size_t bricksRead_ = 0;
+    mutable std::list<size_t> lru_;
+    mutable std::unordered_map<size_t, CacheEntry> cache_;
+    mutable std::vector<std::optional<std::pair<dvec4, dvec4>>> brickMinMax_;
+};
+
+}  // namespace hdf5
+
+}  // namespace inviwo
+
+#endif  // IVW_HDF5BRICKEDVOLUME_H
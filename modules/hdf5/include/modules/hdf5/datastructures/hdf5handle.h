@@ -53,6 +53,8 @@ namespace inviwo {
 
 namespace hdf5 {
 
+class BrickedVolume;
+
 class IVW_MODULE_HDF5_API Handle {
 public:
     struct Selection {
@@ -78,9 +80,24 @@ public:
 
     Handle* getHandleForPath(const std::string& path) const;
 
+    /**
+     * Read the selected hyperslab of the dataset at \p path into a volume. The hyperslab is read
+     * in bricks, in parallel if \p parallel is true, and the data range is computed while reading.
+     * @see BrickedVolume
+     */
     std::shared_ptr<Volume> getVolumeAtPathAsType(const Path& path,
                                                   std::vector<Selection> selection,
-                                                  const DataFormatBase* type) const;
+                                                  const DataFormatBase* type,
+                                                  bool parallel = true) const;
+
+    /**
+     * Get on-demand, bricked access to the selected hyperslab of the dataset at \p path. Nothing
+     * is read until a brick is requested.
+     * @see BrickedVolume
+     */
+    std::shared_ptr<BrickedVolume> getBrickedVolumeAtPath(
+        const Path& path, std::vector<Selection> selection, const DataFormatBase* type,
+        size3_t brickSize = size3_t{0}, size_t cacheSize = size_t{512} << 20) const;
 
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
@@ -36,6 +36,7 @@
 #include <modules/hdf5/ports/hdf5port.h>
 #include <modules/hdf5/datastructures/hdf5metadata.h>
 #include <modules/hdf5/hdf5utils.h>
+#include <modules/hdf5/datastructures/hdf5brickedvolume.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/minmaxproperty.h>
@@ -80,6 +81,12 @@ namespace hdf5 {
  *   * __Stride__ ...
  *   * __Source__ ...
  *   * __Convert to type__ ...
+ *   * __Load on demand__ Read the selection in bricks aligned to the chunks of the dataset and
+ *     keep them in a cache, moving the selection only reads the bricks that are not cached yet.
+ *     The data range is computed from the selected voxels. The selection is still copied into a
+ *     single volume in RAM, hence it has to fit in memory.
+ *   * __Brick cache (MB)__ Size of the cache of decoded bricks when loading on demand
+ *   * __Parallel read__ Read the bricks concurrently on the thread pool
  *   * __Volume__ ...
  *
  */
@@ -131,6 +138,9 @@ private:
     };
 
     void makeVolume();
+    /// Read the selection through the cached bricked volume, see Load on demand
+    std::shared_ptr<Volume> readRegion(const Handle& handle, const Path& path,
+                                       const DataFormatBase* format);
     void onDataChange();
 
     void onSelectionChange();
@@ -144,6 +154,9 @@ private:
     Inport inport_;
     VolumeOutport outport_;
     std::shared_ptr<Volume> volume_;
+    std::shared_ptr<BrickedVolume> bricked_;
+    std::vector<Handle::Selection> brickedExtent_;
+    const DataFormatBase* brickedFormat_ = nullptr;
 
     OptionPropertyString volumeSelection_;
 
@@ -166,6 +179,9 @@ private:
     StringProperty valueUnit_;
 
     OptionPropertyInt datatype_;
+    BoolProperty loadOnDemand_;
+    IntSizeTProperty brickCacheSize_;
+    BoolProperty parallelRead_;
 
     DimSelections selection_;
 
@@ -0,0 +1,416 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5brickedvolume.h>
+#include <modules/hdf5/hdf5types.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+namespace {
+
+// The HDF5 library is not reentrant, serialize all calls made by bricked volumes
+std::mutex& libraryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::pair<dvec4, dvec4> emptyMinMax() {
+    return {dvec4{DataFloat64::max()}, dvec4{DataFloat64::lowest()}};
+}
+
+void merge(std::pair<dvec4, dvec4>& res, const std::pair<dvec4, dvec4>& minmax) {
+    res.first = glm::min(res.first, minmax.first);
+    res.second = glm::max(res.second, minmax.second);
+}
+
+// Min/max of the voxels [begin, end) of a volume with dimensions dims
+template <typename T>
+std::pair<dvec4, dvec4> regionMinMax(const T* data, const size3_t& dims, const size3_t& begin,
+                                     const size3_t& end) {
+    const ::inviwo::util::IndexMapper3D mapper{dims};
+    auto res = emptyMinMax();
+    for (size_t z = begin.z; z < end.z; ++z) {
+        for (size_t y = begin.y; y < end.y; ++y) {
+            merge(res, ::inviwo::util::dataMinMax(data + mapper(begin.x, y, z), end.x - begin.x));
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+BrickedVolume::BrickedVolume(const std::string& filename, const Path& path,
+                             std::vector<Handle::Selection> selection,
+                             const DataFormatBase* format, size3_t brickSize, size_t cacheSize)
+    : filename_{filename}
+    , path_{path}
+    , format_{format}
+    , axes_{{-1, -1, -1}}
+    , dimensions_{1}
+    , cacheSize_{cacheSize} {
+
+    std::vector<hsize_t> chunk;
+    {
+        std::scoped_lock lock{libraryMutex()};
+        file_ = H5::H5File(filename_, H5F_ACC_RDONLY);
+        dataset_ = file_.openDataSet(path_);
+
+        const size_t rank = dataset_.getSpace().getSimpleExtentNdims();
+        if (selection.size() != rank) {
+            throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
+        }
+        const auto plist = dataset_.getCreatePlist();
+        if (plist.getLayout() == H5D_CHUNKED) {
+            chunk.resize(rank);
+            plist.getChunk(static_cast<int>(rank), chunk.data());
+        }
+        if (!format_) format_ = util::getDataFormatFromDataSet(dataset_);
+    }
+    if (!format_) throw Exception("Unsupported data format of " + path_.toString(), IVW_CONTEXT);
+
+    // HDF is row major, Inviwo column major. Reverse the selection to match the dataset.
+    std::reverse(selection.begin(), selection.end());
+
+    std::vector<int> volumeAxes;
+    for (const auto& sel : selection) {
+        const auto count = static_cast<hsize_t>((sel.end - sel.start) / sel.stride);
+        if (count == 0) throw Exception("Invalid selection, empty range", IVW_CONTEXT);
+        if (count > 1) {
+            if (volumeAxes.size() > 2) {
+                throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
+            }
+            volumeAxes.push_back(static_cast<int>(start_.size()));
+        }
+        start_.push_back(sel.start);
+        stride_.push_back(sel.stride);
+    }
+
+    // The last varying dimension of the dataset is the fastest changing, i.e. x
+    for (size_t i = 0; i < volumeAxes.size(); ++i) {
+        const auto axis = volumeAxes[i];
+        axes_[2 - i] = axis;
+        dimensions_[2 - i] = (selection[axis].end - selection[axis].start) / selection[axis].stride;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (brickSize[i] == 0) {
+            if (axes_[i] >= 0 && !chunk.empty()) {
+                // Round up to a whole number of chunks of the strided selection
+                const auto chunkSize = chunk[axes_[i]];
+                const auto stride = stride_[axes_[i]];
+                const auto perChunk =
+                    std::max(size_t{1}, static_cast<size_t>((chunkSize + stride - 1) / stride));
+                brickSize[i] = perChunk * ((minBrickSize + perChunk - 1) / perChunk);
+            } else {
+                brickSize[i] = defaultBrickSize;
+            }
+        }
+        brickSize_[i] = std::clamp(brickSize[i], size_t{1}, dimensions_[i]);
+    }
+    brickCounts_ = (dimensions_ + brickSize_ - size3_t{1}) / brickSize_;
+    brickMinMax_.resize(glm::compMul(brickCounts_));
+}
+
+BrickedVolume::~BrickedVolume() {
+    std::scoped_lock lock{libraryMutex()};
+    dataset_.close();
+    file_.close();
+}
+
+const std::string& BrickedVolume::getFileName() const { return filename_; }
+
+const Path& BrickedVolume::getPath() const { return path_; }
+
+const DataFormatBase* BrickedVolume::getDataFormat() const { return format_; }
+
+size3_t BrickedVolume::getDimensions() const { return dimensions_; }
+
+size3_t BrickedVolume::getBrickSize() const { return brickSize_; }
+
+size3_t BrickedVolume::getBrickCounts() const { return brickCounts_; }
+
+std::pair<size3_t, size3_t> BrickedVolume::getBrickRegion(const size3_t& brick) const {
+    const size3_t begin{brick * brickSize_};
+    return {begin, glm::min(begin + brickSize_, dimensions_)};
+}
+
+size_t BrickedVolume::brickIndex(const size3_t& brick) const {
+    if (glm::any(glm::greaterThanEqual(brick, brickCounts_))) {
+        throw Exception("Brick index out of range", IVW_CONTEXT);
+    }
+    return ::inviwo::util::IndexMapper3D(brickCounts_)(brick);
+}
+
+std::shared_ptr<const VolumeRAM> BrickedVolume::getBrick(const size3_t& brick) const {
+    const auto index = brickIndex(brick);
+    if (auto cached = findCached(index)) return cached;
+
+    std::shared_ptr<const VolumeRAM> res = readBrick(index);
+    insertCached(index, res);
+    return res;
+}
+
+std::vector<std::shared_ptr<const VolumeRAM>> BrickedVolume::getBricks(
+    const std::vector<size3_t>& bricks, bool parallel) const {
+
+    std::vector<std::shared_ptr<const VolumeRAM>> res(bricks.size());
+    const auto get = [&](size_t i) { res[i] = getBrick(bricks[i]); };
+    if (parallel) {
+        ::inviwo::util::parallelFor(size_t{0}, bricks.size(), get, 1);
+    } else {
+        for (size_t i = 0; i < bricks.size(); ++i) get(i);
+    }
+    return res;
+}
+
+std::optional<std::pair<dvec4, dvec4>> BrickedVolume::getBrickMinMax(const size3_t& brick) const {
+    const auto index = brickIndex(brick);
+    std::scoped_lock lock{mutex_};
+    return brickMinMax_[index];
+}
+
+std::pair<dvec4, dvec4> BrickedVolume::getMinMax() const {
+    auto res = emptyMinMax();
+    std::scoped_lock lock{mutex_};
+    for (const auto& minmax : brickMinMax_) {
+        if (minmax) merge(res, *minmax);
+    }
+    return res;
+}
+
+bool BrickedVolume::isMinMaxComplete() const {
+    std::scoped_lock lock{mutex_};
+    return std::all_of(brickMinMax_.begin(), brickMinMax_.end(),
+                       [](const auto& minmax) { return minmax.has_value(); });
+}
+
+void BrickedVolume::read(void* dst, const H5::DataType& type, const size3_t& begin,
+                         const size3_t& extent) const {
+    std::vector<hsize_t> start(start_);
+    std::vector<hsize_t> count(start_.size(), 1);
+    for (size_t i = 0; i < 3; ++i) {
+        if (axes_[i] < 0) continue;
+        start[axes_[i]] += begin[i] * stride_[axes_[i]];
+        count[axes_[i]] = extent[i];
+    }
+    const std::array<hsize_t, 3> memoryDimensions{extent.z, extent.y, extent.x};
+
+    std::scoped_lock lock{libraryMutex()};
+    try {
+        H5::DataSpace dataSpace = dataset_.getSpace();
+        dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride_.data(),
+                                  nullptr);
+        H5::DataSpace memorySpace(3, memoryDimensions.data());
+        dataset_.read(dst, type, memorySpace, dataSpace);
+    } catch (const H5::Exception& e) {
+        throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+    }
+}
+
+std::shared_ptr<VolumeRAM> BrickedVolume::readBrick(size_t index) const {
+    const auto [begin, end] = getBrickRegion(::inviwo::util::IndexMapper3D(brickCounts_)(index));
+    const size3_t extent{end - begin};
+
+    auto volumeram =
+        createVolumeRAM(extent, format_, ::inviwo::util::DataInitialization::Uninitialized);
+
+    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
+        [&](auto vrprecision) {
+            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+            ValueType* data = vrprecision->getDataTyped();
+            read(data, TypeMap<ValueType>::getType(), begin, extent);
+            return ::inviwo::util::dataMinMax(data, glm::compMul(extent));
+        });
+
+    std::scoped_lock lock{mutex_};
+    brickMinMax_[index] = minmax;
+    ++bricksRead_;
+    return volumeram;
+}
+
+std::shared_ptr<VolumeRAM> BrickedVolume::readAll(bool parallel) const {
+    auto volumeram =
+        createVolumeRAM(dimensions_, format_, ::inviwo::util::DataInitialization::Uninitialized);
+
+    volumeram->dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+        using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+        const ValueType* data = vrprecision->getDataTyped();
+        read(vrprecision->getDataTyped(), TypeMap<ValueType>::getType(), size3_t{0}, dimensions_);
+
+        const auto brickMinMax = [&](size_t index) {
+            const auto [begin, end] =
+                getBrickRegion(::inviwo::util::IndexMapper3D(brickCounts_)(index));
+            const auto minmax = regionMinMax(data, dimensions_, begin, end);
+            std::scoped_lock lock{mutex_};
+            brickMinMax_[index] = minmax;
+        };
+        const auto count = glm::compMul(brickCounts_);
+        if (parallel) {
+            ::inviwo::util::parallelFor(size_t{0}, count, brickMinMax, 1);
+        } else {
+            for (size_t i = 0; i < count; ++i) brickMinMax(i);
+        }
+    });
+    return volumeram;
+}
+
+std::pair<std::shared_ptr<VolumeRAM>, std::pair<dvec4, dvec4>> BrickedVolume::readRegion(
+    const size3_t& begin, const size3_t& end, bool parallel) const {
+    if (glm::any(glm::greaterThanEqual(begin, end)) ||
+        glm::any(glm::greaterThan(end, dimensions_))) {
+        throw Exception("Region outside of the volume", IVW_CONTEXT);
+    }
+
+    const size3_t extent{end - begin};
+    const size3_t firstBrick{begin / brickSize_};
+    const size3_t brickCounts{(end - size3_t{1}) / brickSize_ + size3_t{1} - firstBrick};
+    const ::inviwo::util::IndexMapper3D brickMapper{brickCounts};
+
+    auto volumeram =
+        createVolumeRAM(extent, format_, ::inviwo::util::DataInitialization::Uninitialized);
+
+    std::mutex mutex;
+    auto res = emptyMinMax();
+    volumeram->dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+        using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+        ValueType* dst = vrprecision->getDataTyped();
+        const ::inviwo::util::IndexMapper3D dstMapper{extent};
+
+        const auto copyBrick = [&](size_t i) {
+            const auto brickPos = firstBrick + brickMapper(i);
+            const auto brick = getBrick(brickPos);
+            const auto [brickBegin, brickEnd] = getBrickRegion(brickPos);
+            const auto src = static_cast<const ValueType*>(brick->getData());
+            const ::inviwo::util::IndexMapper3D srcMapper{brickEnd - brickBegin};
+
+            // The part of the brick within the region
+            const size3_t from{glm::max(begin, brickBegin)};
+            const size3_t to{glm::min(end, brickEnd)};
+            for (size_t z = from.z; z < to.z; ++z) {
+                for (size_t y = from.y; y < to.y; ++y) {
+                    const auto row =
+                        src + srcMapper(from.x - brickBegin.x, y - brickBegin.y, z - brickBegin.z);
+                    std::copy(row, row + (to.x - from.x),
+                              dst + dstMapper(from.x - begin.x, y - begin.y, z - begin.z));
+                }
+            }
+
+            // The min/max of a brick is known once it has been read
+            const bool whole = from == brickBegin && to == brickEnd;
+            const auto minmax = whole ? *getBrickMinMax(brickPos)
+                                      : regionMinMax(src, brickEnd - brickBegin,
+                                                     from - brickBegin, to - brickBegin);
+            std::scoped_lock lock{mutex};
+            merge(res, minmax);
+        };
+
+        const auto count = glm::compMul(brickCounts);
+        if (parallel) {
+            ::inviwo::util::parallelFor(size_t{0}, count, copyBrick, 1);
+        } else {
+            for (size_t i = 0; i < count; ++i) copyBrick(i);
+        }
+    });
+    return {volumeram, res};
+}
+
+std::shared_ptr<const VolumeRAM> BrickedVolume::findCached(size_t index) const {
+    std::scoped_lock lock{mutex_};
+    auto it = cache_.find(index);
+    if (it == cache_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.brick;
+}
+
+void BrickedVolume::insertCached(size_t index, std::shared_ptr<const VolumeRAM> brick) const {
+    std::scoped_lock lock{mutex_};
+    // Another thread might have read the same brick in the mean time
+    if (cache_.count(index) != 0) return;
+    cachedBytes_ += glm::compMul(brick->getDimensions()) * format_->getSize();
+    lru_.push_front(index);
+    cache_.emplace(index, CacheEntry{std::move(brick), lru_.begin()});
+    evict();
+}
+
+void BrickedVolume::evict() const {
+    while (cachedBytes_ > cacheSize_ && !lru_.empty()) {
+        auto it = cache_.find(lru_.back());
+        cachedBytes_ -= glm::compMul(it->second.brick->getDimensions()) * format_->getSize();
+        cache_.erase(it);
+        lru_.pop_back();
+    }
+}
+
+size_t BrickedVolume::getCacheSize() const {
+    std::scoped_lock lock{mutex_};
+    return cacheSize_;
+}
+
+void BrickedVolume::setCacheSize(size_t cacheSize) {
+    std::scoped_lock lock{mutex_};
+    cacheSize_ = cacheSize;
+    evict();
+}
+
+size_t BrickedVolume::getCachedBytes() const {
+    std::scoped_lock lock{mutex_};
+    return cachedBytes_;
+}
+
+bool BrickedVolume::isCached(const size3_t& brick) const {
+    const auto index = brickIndex(brick);
+    std::scoped_lock lock{mutex_};
+    return cache_.count(index) != 0;
+}
+
+void BrickedVolume::clearCache() {
+    std::scoped_lock lock{mutex_};
+    cache_.clear();
+    lru_.clear();
+    cachedBytes_ = 0;
+}
+
+size_t BrickedVolume::getBricksRead() const {
+    std::scoped_lock lock{mutex_};
+    return bricksRead_;
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -28,13 +28,10 @@
  *********************************************************************************/
 
 #include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/datastructures/hdf5brickedvolume.h>
 #include <inviwo/core/util/stdextensions.h>
-#include <inviwo/core/util/formatdispatching.h>
-#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
-#include <modules/base/algorithm/dataminmax.h>
-
 #include <algorithm>
 
 namespace inviwo {
@@ -124,95 +121,20 @@ double Handle::getMax(const DataFormatBase* type) const {
 
 std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
-                                                      const DataFormatBase* type) const {
-
-    auto dataset = data_.openDataSet(path);
-    ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
-
-    const H5::DataSpace dataSpace = dataset.getSpace();
-    const size_t rank = dataSpace.getSimpleExtentNdims();
-    if (selection.size() != rank) {
-        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
-    }
-
-    std::vector<hsize_t> dataDimensions(rank);
-    dataSpace.getSimpleExtentDims(dataDimensions.data());
-    const hsize_t dataSize = dataSpace.getSelectNpoints();
-
-    std::vector<hsize_t> start(rank);
-    std::vector<hsize_t> count(rank);
-    std::vector<hsize_t> stride(rank);
-
-    /*
-     * Column major, i.e. the FIRST listed dimension is the fasted changing
-     * Inviwo, OpenGL, matlab, Fortran
-     *
-     * Row major, i.e. the LAST listed dimension is the fasted changing
-     * HDF, C/C++, Mathematica, Python
-     *
-     * Solution reverse all the dimension lists.
-     * Row major version of the selection to match the hdf row major dataDimensions.
-     */
-    std::reverse(selection.begin(), selection.end());
-
-    size3_t volumeDimensions(1);
-    int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
-
-    for (size_t i = 0; i < rank; ++i) {
-        start[i] = selection[i].start;
-        count[i] =
-            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
-        stride[i] = selection[i].stride;
-
-        if (count[i] > 1) {
-            if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
-            volumeDimensions[resRank] = count[i];
-            resRank++;
-        }
-    }
-
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
-
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
-
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
+                                                      const DataFormatBase* type,
+                                                      bool parallel) const {
 
-    LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
+    // A single read of the whole selection, nothing is cached
+    BrickedVolume bricked(filename_, path, std::move(selection), type, size3_t{0}, 0);
+    auto volumeram = bricked.readAll(parallel);
+    const auto minmax = bricked.getMinMax();
 
-    const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
+    LogInfo("Read HDF volume type: " << bricked.getDataFormat()->getString() << " dims "
+                                     << bricked.getDimensions() << " bricks "
+                                     << bricked.getBrickCounts() << " data range: " << minmax.first
+                                     << ", " << minmax.second << " file: " << filename_);
 
-    // Reverse back the Column major
-    std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
-    auto volumeram = createVolumeRAM(volumeDimensions, format);
-
-    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
-        [&](auto vrprecision) {
-            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
-
-            ValueType* data = vrprecision->getDataTyped();
-
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
-            }
-
-            auto res = ::inviwo::util::dataMinMax(data, selectionSize);
-
-            LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
-                                             << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
-
-            return res;
-        });
-
-    auto volume = std::make_shared<Volume>(volumeDimensions, format);
+    auto volume = std::make_shared<Volume>(bricked.getDimensions(), bricked.getDataFormat());
     volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
     volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
     volume->dataMap_.valueRange = volume->dataMap_.dataRange;
@@ -222,6 +144,15 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
     return volume;
 }
 
+std::shared_ptr<BrickedVolume> Handle::getBrickedVolumeAtPath(const Path& path,
+                                                              std::vector<Selection> selection,
+                                                              const DataFormatBase* type,
+                                                              size3_t brickSize,
+                                                              size_t cacheSize) const {
+    return std::make_shared<BrickedVolume>(filename_, path, std::move(selection), type, brickSize,
+                                           cacheSize);
+}
+
 const uvec3 Handle::colorCode = uvec3(101, 101, 188);
 
 const std::string Handle::classIdentifier = "org.inviwo.hdf5.handle";
@@ -32,6 +32,7 @@
 #include <modules/hdf5/datastructures/hdf5path.h>
 #include <inviwo/core/io/datareader.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <limits>
@@ -88,6 +89,9 @@ HDF5ToVolume::HDF5ToVolume()
                  {"uchar", "Unsigned Char", 2},
                  {"ushort", "Unsigned Short", 3}},
                 0)
+    , loadOnDemand_("loadOnDemand", "Load on demand", false)
+    , brickCacheSize_("brickCacheSize", "Brick cache (MB)", 512, 0, 65536)
+    , parallelRead_("parallelRead", "Parallel read", true)
     , selection_("selection", "Selection", 6)
     , dirty_(false) {
 
@@ -118,6 +122,11 @@ HDF5ToVolume::HDF5ToVolume()
     addProperty(information_);
 
     outputGroup_.addProperty(datatype_);
+    outputGroup_.addProperty(loadOnDemand_);
+    outputGroup_.addProperty(brickCacheSize_);
+    outputGroup_.addProperty(parallelRead_);
+    loadOnDemand_.onChange([this]() { brickCacheSize_.setVisible(loadOnDemand_); });
+    brickCacheSize_.setVisible(loadOnDemand_);
     outputGroup_.addProperty(overrideRange_);
 
     outputGroup_.addProperty(outDataRange_);
@@ -282,6 +291,7 @@ void HDF5ToVolume::onDataChange() {
         basisSelection_.clearOptions();
         volumeSelection_.clearOptions();
     }
+    bricked_.reset();
 }
 
 std::string HDF5ToVolume::getDescription(const MetaData& meta) {
@@ -344,9 +354,14 @@ void HDF5ToVolume::makeVolume() {
                     break;
             }
 
-            volume_ = std::shared_ptr<Volume>(
-                data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
-                                            selection_.getSelection(), format));
+            const auto path = Path(data->getGroup().getObjName()) + volumeMeta.path_;
+            if (loadOnDemand_) {
+                volume_ = readRegion(*data, path, format);
+            } else {
+                bricked_.reset();
+                volume_ = data->getVolumeAtPathAsType(path, selection_.getSelection(), format,
+                                                      parallelRead_);
+            }
 
             dataRange_.set(volume_->dataMap_.dataRange);
 
@@ -360,6 +375,65 @@ void HDF5ToVolume::makeVolume() {
     }
 }
 
+std::shared_ptr<Volume> HDF5ToVolume::readRegion(const Handle& handle, const Path& path,
+                                                 const DataFormatBase* format) {
+    const auto selection = selection_.getSelection();
+    const auto maxSelection = selection_.getMaxSelection();
+
+    // The bricked volume covers the whole extent of the varying dimensions, with the strides of the
+    // selection, such that moving the selection around reuses the cached bricks.
+    std::vector<Handle::Selection> extent;
+    std::vector<std::pair<size_t, size_t>> region;
+    for (size_t i = 0; i < selection.size(); ++i) {
+        const auto& sel = selection[i];
+        const auto count = (sel.end - sel.start) / sel.stride;
+        if (count > 1) {
+            const auto first = sel.start % sel.stride;
+            extent.emplace_back(first, maxSelection[i].end, sel.stride);
+            region.emplace_back((sel.start - first) / sel.stride, count);
+        } else {
+            extent.push_back(sel);
+        }
+    }
+    if (region.size() > 3) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
+
+    const auto equal = [](const std::vector<Handle::Selection>& a,
+                          const std::vector<Handle::Selection>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                          [](const auto& s1, const auto& s2) {
+                              return s1.start == s2.start && s1.end == s2.end &&
+                                     s1.stride == s2.stride;
+                          });
+    };
+    if (!bricked_ || bricked_->getPath().toString() != path.toString() ||
+        brickedFormat_ != format || !equal(brickedExtent_, extent)) {
+        bricked_.reset();
+        bricked_ = handle.getBrickedVolumeAtPath(path, extent, format, size3_t{0},
+                                                 brickCacheSize_.get() << 20);
+        brickedExtent_ = extent;
+        brickedFormat_ = format;
+    } else {
+        bricked_->setCacheSize(brickCacheSize_.get() << 20);
+    }
+
+    // The first varying dimension of the column major selection is the x axis of the volume, the
+    // bricked volume puts the varying dimensions last.
+    size3_t begin{0};
+    size3_t end{1};
+    for (size_t i = 0; i < region.size(); ++i) {
+        const auto axis = 3 - region.size() + i;
+        begin[axis] = region[i].first;
+        end[axis] = region[i].first + region[i].second;
+    }
+
+    const auto [volumeram, minmax] = bricked_->readRegion(begin, end, parallelRead_);
+    auto volume = std::make_shared<Volume>(volumeram);
+    volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
+    volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
+    volume->dataMap_.valueRange = volume->dataMap_.dataRange;
+    return volume;
+}
+
 HDF5ToVolume::DimSelection::DimSelection(std::string identifier, std::string displayName,
                                          InvalidationLevel level)
     : CompositeProperty(identifier, displayName, level, PropertySemantics::Default)
@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/hdf5/datastructures/hdf5brickedvolume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <H5Cpp.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+const size3_t dims{28, 24, 20};
+
+std::int32_t value(const size3_t& pos) {
+    return static_cast<std::int32_t>(pos.x + 100 * pos.y + 10000 * pos.z);
+}
+
+/**
+ * Writes a dataset "data" with the dimensions dims and the voxel values given by value to a
+ * temporary file, which is removed again at the end of the test.
+ */
+class BrickedVolumeTest : public ::testing::Test {
+protected:
+    BrickedVolumeTest()
+        : filename_{(std::filesystem::temp_directory_path() / "inviwo-hdf5-bricked-volume.h5")
+                        .string()} {
+        std::vector<std::int32_t> values(glm::compMul(dims));
+        const util::IndexMapper3D mapper{dims};
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) values[mapper(x, y, z)] = value({x, y, z});
+            }
+        }
+
+        // HDF5 is row major
+        const std::array<hsize_t, 3> fileDims{dims.z, dims.y, dims.x};
+        H5::H5File file(filename_, H5F_ACC_TRUNC);
+        H5::DataSpace space(3, fileDims.data());
+        auto dataset = file.createDataSet("data", H5::PredType::NATIVE_INT32, space);
+        dataset.write(values.data(), H5::PredType::NATIVE_INT32);
+    }
+    virtual ~BrickedVolumeTest() { std::filesystem::remove(filename_); }
+
+    std::unique_ptr<hdf5::BrickedVolume> create(size_t cacheSize = size_t{64} << 20) const {
+        // One selection per dimension, column major
+        std::vector<hdf5::Handle::Selection> selection{{0, dims.x, 1}, {0, dims.y, 1},
+                                                       {0, dims.z, 1}};
+        return std::make_unique<hdf5::BrickedVolume>(filename_, hdf5::Path("/data"),
+                                                     std::move(selection), nullptr, size3_t{8},
+                                                     cacheSize);
+    }
+
+    std::string filename_;
+};
+
+constexpr size_t brickBytes = 8 * 8 * 8 * sizeof(std::int32_t);
+
+}  // namespace
+
+TEST_F(BrickedVolumeTest, ReadRegionMatchesReadAll) {
+    const auto volume = create();
+    ASSERT_EQ(dims, volume->getDimensions());
+    ASSERT_EQ(size3_t(4, 3, 3), volume->getBrickCounts());
+
+    const auto all = volume->readAll();
+    const auto allData = static_cast<const std::int32_t*>(all->getData());
+    const util::IndexMapper3D allMapper{dims};
+
+    const size3_t begin{3, 5, 2};
+    const size3_t end{21, 17, 19};
+    const auto [region, minmax] = volume->readRegion(begin, end);
+    ASSERT_EQ(end - begin, region->getDimensions());
+    const auto regionData = static_cast<const std::int32_t*>(region->getData());
+    const util::IndexMapper3D regionMapper{end - begin};
+
+    for (size_t z = begin.z; z < end.z; ++z) {
+        for (size_t y = begin.y; y < end.y; ++y) {
+            for (size_t x = begin.x; x < end.x; ++x) {
+                ASSERT_EQ(allData[allMapper(x, y, z)],
+                          regionData[regionMapper(x - begin.x, y - begin.y, z - begin.z)])
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+    EXPECT_EQ(static_cast<double>(value(begin)), minmax.first.x);
+    EXPECT_EQ(static_cast<double>(value(end - size3_t{1})), minmax.second.x);
+}
+
+TEST_F(BrickedVolumeTest, BrickMinMax) {
+    const auto volume = create();
+    const size3_t brick{3, 2, 1};
+    EXPECT_FALSE(volume->getBrickMinMax(brick));
+
+    volume->getBrick(brick);
+    const auto [begin, end] = volume->getBrickRegion(brick);
+    const auto minmax = volume->getBrickMinMax(brick);
+    ASSERT_TRUE(minmax);
+    EXPECT_EQ(static_cast<double>(value(begin)), minmax->first.x);
+    EXPECT_EQ(static_cast<double>(value(end - size3_t{1})), minmax->second.x);
+    EXPECT_FALSE(volume->isMinMaxComplete());
+
+    // readAll computes the min/max of all bricks
+    volume->readAll();
+    EXPECT_TRUE(volume->isMinMaxComplete());
+    const auto counts = volume->getBrickCounts();
+    for (size_t z = 0; z < counts.z; ++z) {
+        for (size_t y = 0; y < counts.y; ++y) {
+            for (size_t x = 0; x < counts.x; ++x) {
+                const auto region = volume->getBrickRegion({x, y, z});
+                const auto brickMinMax = volume->getBrickMinMax({x, y, z});
+                ASSERT_TRUE(brickMinMax);
+                EXPECT_EQ(static_cast<double>(value(region.first)), brickMinMax->first.x);
+                EXPECT_EQ(static_cast<double>(value(region.second - size3_t{1})),
+                          brickMinMax->second.x);
+            }
+        }
+    }
+    EXPECT_EQ(static_cast<double>(value(size3_t{0})), volume->getMinMax().first.x);
+    EXPECT_EQ(static_cast<double>(value(dims - size3_t{1})), volume->getMinMax().second.x);
+}
+
+TEST_F(BrickedVolumeTest, LeastRecentlyUsedEviction) {
+    const auto volume = create(3 * brickBytes);
+
+    const size3_t a{0, 0, 0};
+    const size3_t b{1, 0, 0};
+    const size3_t c{2, 0, 0};
+    const size3_t d{0, 1, 0};
+    volume->getBrick(a);
+    volume->getBrick(b);
+    volume->getBrick(c);
+    EXPECT_EQ(3 * brickBytes, volume->getCachedBytes());
+
+    // Touch a, such that b is the least recently used brick
+    volume->getBrick(a);
+    EXPECT_EQ(size_t{3}, volume->getBricksRead());
+
+    volume->getBrick(d);
+    EXPECT_EQ(size_t{4}, volume->getBricksRead());
+    EXPECT_LE(volume->getCachedBytes(), volume->getCacheSize());
+    EXPECT_TRUE(volume->isCached(a));
+    EXPECT_FALSE(volume->isCached(b));
+    EXPECT_TRUE(volume->isCached(c));
+    EXPECT_TRUE(volume->isCached(d));
+
+    volume->setCacheSize(brickBytes);
+    EXPECT_EQ(brickBytes, volume->getCachedBytes());
+    EXPECT_TRUE(volume->isCached(d));
+}
+
+TEST_F(BrickedVolumeTest, MovedRegionReadsOnlyUncachedBricks) {
+    const auto volume = create();
+
+    // 2 x 2 x 2 bricks
+    volume->readRegion(size3_t{0}, size3_t{16});
+    EXPECT_EQ(size_t{8}, volume->getBricksRead());
+
+    // Moved one brick along x, half of the bricks are already cached
+    volume->readRegion(size3_t{8, 0, 0}, size3_t{24, 16, 16});
+    EXPECT_EQ(size_t{12}, volume->getBricksRead());
+
+    // Within the cached bricks
+    volume->readRegion(size3_t{4, 2, 3}, size3_t{20, 10, 12});
+    EXPECT_EQ(size_t{12}, volume->getBricksRead());
+}
+
+}  // namespace inviwo
@@ -54,8 +54,9 @@ void LayerRAM2GLConverter::update(std::shared_ptr<const LayerRAM> layerSrc,
 std::shared_ptr<LayerRAM> LayerGL2RAMConverter::createFrom(
     std::shared_ptr<const LayerGL> layerGL) const {
     auto layerRAM = createLayerRAM(layerGL->getDimensions(), layerGL->getLayerType(),
-                                   layerGL->getDataFormat(), layerGL->getSwizzleMask(),
-                                   layerGL->getInterpolation(), layerGL->getWrapping());
+                                   layerGL->getDataFormat(), util::DataInitialization::Uninitialized,
+                                   layerGL->getSwizzleMask(), layerGL->getInterpolation(),
+                                   layerGL->getWrapping());
 
     if (layerRAM) {
         layerGL->getTexture()->download(layerRAM->getData());
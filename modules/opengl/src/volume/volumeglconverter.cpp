@@ -53,7 +53,8 @@ void VolumeRAM2GLConverter::update(std::shared_ptr<const VolumeRAM> volumeSrc,
 
 std::shared_ptr<VolumeRAM> VolumeGL2RAMConverter::createFrom(
     std::shared_ptr<const VolumeGL> volumeGL) const {
-    auto volume = createVolumeRAM(volumeGL->getDimensions(), volumeGL->getDataFormat(), nullptr,
+    auto volume = createVolumeRAM(volumeGL->getDimensions(), volumeGL->getDataFormat(),
+                                  util::DataInitialization::Uninitialized,
                                   volumeGL->getSwizzleMask(), volumeGL->getInterpolation(),
                                   volumeGL->getWrapping());
 
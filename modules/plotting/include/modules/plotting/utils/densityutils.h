@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DENSITYUTILS_H
+#define IVW_DENSITYUTILS_H
+
+#include <modules/plotting/plottingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+namespace plot {
+
+/**
+ * A 2D image of row counts, created by aggregating the rows of a plot instead of drawing each of
+ * them. The count of pixel (x, y) is at `counts[y * dims.x + x]`, y = 0 is the bottom row.
+ */
+struct IVW_MODULE_PLOTTING_API DensityImage {
+    size2_t dims{0};
+    std::vector<float> counts;
+    float max = 0.0f;
+};
+
+/**
+ * \brief Bins the points (x[i], y[i]) into an image covering \p rangeX times \p rangeY.
+ * Points outside of the ranges, NaN values, and rows where \p filtered is true are skipped, an
+ * empty \p filtered is ignored. The rows are binned in parallel on the thread pool.
+ *
+ * @param x       scalar buffer with the x coordinates
+ * @param y       scalar buffer with the y coordinates
+ * @param rangeX  data range mapped to the image width
+ * @param rangeY  data range mapped to the image height
+ * @param dims    size of the image, usually the size of the plot area in pixels
+ * @param filtered  rows to skip
+ */
+IVW_MODULE_PLOTTING_API DensityImage scatterDensity(const BufferBase& x, const BufferBase& y,
+                                                    dvec2 rangeX, dvec2 rangeY, size2_t dims,
+                                                    const std::vector<bool>& filtered = {});
+
+/**
+ * \brief Bins only the points of \p rows
+ * Element i of \p filtered refers to `rows[i]`, i.e. the mask is applied to the positions in
+ * \p rows and not to the rows of \p x and \p y. An empty \p filtered is ignored.
+ * @see scatterDensity
+ */
+IVW_MODULE_PLOTTING_API DensityImage scatterDensity(const BufferBase& x, const BufferBase& y,
+                                                    dvec2 rangeX, dvec2 rangeY, size2_t dims,
+                                                    const std::vector<std::uint32_t>& rows,
+                                                    const std::vector<bool>& filtered = {});
+
+/**
+ * \brief Counts the rows per pair of bins on two neighboring axes of a parallel coordinate plot.
+ * \p a and \p b are the normalized positions, in [0 1], of each row on the two axes. The count of
+ * rows in bin i of \p a and bin j of \p b is at `j * bins + i`. NaN values and rows where
+ * \p filtered is true are skipped.
+ */
+IVW_MODULE_PLOTTING_API std::vector<std::uint32_t> axisPairHistogram(
+    const std::vector<float>& a, const std::vector<float>& b, size_t bins,
+    const std::vector<bool>& filtered = {});
+
+/**
+ * \brief Density image of a parallel coordinate plot.
+ * The rows are counted per pair of bins of neighboring axes, see axisPairHistogram, and each
+ * non-empty pair of bins is then drawn as a line weighted by its count. The cost is thereby
+ * linear in the number of rows, but the drawing only depends on \p bins and \p dims.
+ *
+ * @param axes  normalized positions, in [0 1], of all rows on each axis, in drawing order
+ * @param axisPositions  horizontal position of each axis in [0 1]
+ * @param dims  size of the image, usually the size of the plot area in pixels
+ * @param bins  number of bins per axis
+ * @param filtered  rows to skip
+ */
+IVW_MODULE_PLOTTING_API DensityImage pcpDensity(const std::vector<std::vector<float>>& axes,
+                                                const std::vector<float>& axisPositions,
+                                                size2_t dims, size_t bins,
+                                                const std::vector<bool>& filtered = {});
+
+}  // namespace plot
+
+}  // namespace inviwo
+
+#endif  // IVW_DENSITYUTILS_H
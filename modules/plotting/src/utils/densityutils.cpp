@@ -0,0 +1,263 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plotting/utils/densityutils.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace inviwo {
+
+namespace plot {
+
+namespace {
+
+constexpr size_t chunkSize = 4096;
+
+/**
+ * Each task bins its rows into an image of its own, which are summed up afterwards. Too many
+ * tasks waste time on clearing and summing those images.
+ */
+size_t numberOfTasks(size_t rows) {
+    constexpr size_t minRowsPerTask = size_t{1} << 16;
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::clamp(rows / minRowsPerTask, size_t{1}, threads);
+}
+
+struct AllRows {
+    size_t size() const { return rows; }
+    std::uint32_t operator[](size_t i) const { return static_cast<std::uint32_t>(i); }
+    size_t rows;
+};
+
+/**
+ * Bin of the values of \p rows [begin, end) in \p buffer, or -1 for values outside of \p range
+ */
+template <typename Rows>
+void toBins(const BufferBase& buffer, const Rows& rows, size_t begin, size_t end, dvec2 range,
+            size_t bins, std::vector<std::int32_t>& result) {
+    buffer.getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        [&](auto ram) {
+            const auto& data = ram->getDataContainer();
+            const double scale = static_cast<double>(bins) / (range.y - range.x);
+            const auto last = static_cast<std::int32_t>(bins) - 1;
+            for (size_t i = begin; i < end; ++i) {
+                const auto v = (static_cast<double>(data[rows[i]]) - range.x) * scale;
+                // NaN fails both comparisons
+                result[i - begin] = (v >= 0.0 && v <= static_cast<double>(bins))
+                                        ? std::min(static_cast<std::int32_t>(v), last)
+                                        : -1;
+            }
+        });
+}
+
+/**
+ * Sums the images of the tasks into a float image
+ */
+void reduce(const std::vector<std::vector<std::uint32_t>>& partial, std::vector<float>& result) {
+    util::parallelFor(
+        size_t{0}, result.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::uint32_t sum = 0;
+                for (const auto& counts : partial) sum += counts[i];
+                result[i] = static_cast<float>(sum);
+            }
+        },
+        size_t{1} << 16);
+}
+
+template <typename Rows>
+DensityImage binPoints(const BufferBase& x, const BufferBase& y, dvec2 rangeX, dvec2 rangeY,
+                       size2_t dims, const Rows& rows, const std::vector<bool>& filtered) {
+    DensityImage result{dims, std::vector<float>(dims.x * dims.y, 0.0f), 0.0f};
+    if (result.counts.empty() || rangeX.x == rangeX.y || rangeY.x == rangeY.y) return result;
+
+    const auto size = rows.size();
+    const auto tasks = numberOfTasks(size);
+    std::vector<std::vector<std::uint32_t>> partial(tasks);
+    util::parallelFor(
+        size_t{0}, tasks,
+        [&](size_t task) {
+            auto& counts = partial[task];
+            counts.assign(result.counts.size(), 0);
+            std::vector<std::int32_t> binsX(chunkSize);
+            std::vector<std::int32_t> binsY(chunkSize);
+
+            const auto begin = size * task / tasks;
+            const auto end = size * (task + 1) / tasks;
+            for (auto first = begin; first < end; first += chunkSize) {
+                const auto last = std::min(end, first + chunkSize);
+                toBins(x, rows, first, last, rangeX, dims.x, binsX);
+                toBins(y, rows, first, last, rangeY, dims.y, binsY);
+                for (size_t i = 0; i < last - first; ++i) {
+                    if (binsX[i] < 0 || binsY[i] < 0) continue;
+                    if (!filtered.empty() && filtered[first + i]) continue;
+                    ++counts[binsY[i] * dims.x + binsX[i]];
+                }
+            }
+        },
+        1);
+
+    reduce(partial, result.counts);
+    result.max = *std::max_element(result.counts.begin(), result.counts.end());
+    return result;
+}
+
+std::int32_t toBin(float v, size_t bins) {
+    // NaN fails both comparisons
+    if (!(v >= 0.0f && v <= 1.0f)) return -1;
+    return std::min(static_cast<std::int32_t>(v * bins), static_cast<std::int32_t>(bins) - 1);
+}
+
+}  // namespace
+
+DensityImage scatterDensity(const BufferBase& x, const BufferBase& y, dvec2 rangeX, dvec2 rangeY,
+                            size2_t dims, const std::vector<bool>& filtered) {
+    return binPoints(x, y, rangeX, rangeY, dims, AllRows{std::min(x.getSize(), y.getSize())},
+                     filtered);
+}
+
+DensityImage scatterDensity(const BufferBase& x, const BufferBase& y, dvec2 rangeX, dvec2 rangeY,
+                            size2_t dims, const std::vector<std::uint32_t>& rows,
+                            const std::vector<bool>& filtered) {
+    return binPoints(x, y, rangeX, rangeY, dims, rows, filtered);
+}
+
+std::vector<std::uint32_t> axisPairHistogram(const std::vector<float>& a,
+                                             const std::vector<float>& b, size_t bins,
+                                             const std::vector<bool>& filtered) {
+    const auto size = std::min(a.size(), b.size());
+    const auto tasks = numberOfTasks(size);
+    std::vector<std::vector<std::uint32_t>> partial(tasks);
+    util::parallelFor(
+        size_t{0}, tasks,
+        [&](size_t task) {
+            auto& counts = partial[task];
+            counts.assign(bins * bins, 0);
+            const auto end = size * (task + 1) / tasks;
+            for (auto i = size * task / tasks; i < end; ++i) {
+                if (!filtered.empty() && filtered[i]) continue;
+                const auto binA = toBin(a[i], bins);
+                const auto binB = toBin(b[i], bins);
+                if (binA < 0 || binB < 0) continue;
+                ++counts[binB * bins + binA];
+            }
+        },
+        1);
+
+    if (tasks == 1) return std::move(partial.front());
+    std::vector<std::uint32_t> result(bins * bins, 0);
+    for (const auto& counts : partial) {
+        std::transform(counts.begin(), counts.end(), result.begin(), result.begin(),
+                       std::plus<>{});
+    }
+    return result;
+}
+
+DensityImage pcpDensity(const std::vector<std::vector<float>>& axes,
+                        const std::vector<float>& axisPositions, size2_t dims, size_t bins,
+                        const std::vector<bool>& filtered) {
+    DensityImage result{dims, std::vector<float>(dims.x * dims.y, 0.0f), 0.0f};
+    if (result.counts.empty() || axes.size() < 2 || bins == 0) return result;
+
+    // A line between the centers of a pair of bins, in pixels
+    struct Segment {
+        float yA;
+        float yB;
+        float count;
+    };
+    struct Pair {
+        std::int64_t xA;
+        std::int64_t xB;
+        std::vector<Segment> segments;
+    };
+
+    const auto height = static_cast<float>(dims.y - 1);
+    const auto width = static_cast<float>(dims.x - 1);
+    std::vector<Pair> pairs;
+    for (size_t i = 0; i + 1 < axes.size(); ++i) {
+        const auto histogram = axisPairHistogram(axes[i], axes[i + 1], bins, filtered);
+        Pair pair{std::lround(axisPositions[i] * width), std::lround(axisPositions[i + 1] * width),
+                  {}};
+        if (pair.xA == pair.xB) continue;
+        if (pair.xA > pair.xB) std::swap(pair.xA, pair.xB);
+
+        const auto binToPixel = [&](size_t bin) { return (bin + 0.5f) / bins * height; };
+        for (size_t b = 0; b < bins; ++b) {
+            for (size_t a = 0; a < bins; ++a) {
+                if (const auto count = histogram[b * bins + a]) {
+                    pair.segments.push_back(
+                        {binToPixel(a), binToPixel(b), static_cast<float>(count)});
+                }
+            }
+        }
+        if (axisPositions[i] > axisPositions[i + 1]) {
+            for (auto& segment : pair.segments) std::swap(segment.yA, segment.yB);
+        }
+        pairs.push_back(std::move(pair));
+    }
+
+    // Each column is drawn by one task, a pair of axes owns the columns [xA, xB), and the last
+    // pair also the column xB.
+    util::parallelFor(
+        std::int64_t{0}, static_cast<std::int64_t>(dims.x),
+        [&](std::int64_t x) {
+            for (const auto& pair : pairs) {
+                if (x < pair.xA || x > pair.xB || (x == pair.xB && &pair != &pairs.back())) {
+                    continue;
+                }
+                const auto length = static_cast<float>(pair.xB - pair.xA);
+                const auto t0 = (x - pair.xA) / length;
+                const auto t1 = std::min(1.0f, (x + 1 - pair.xA) / length);
+                for (const auto& segment : pair.segments) {
+                    const auto y0 = segment.yA + t0 * (segment.yB - segment.yA);
+                    const auto y1 = segment.yA + t1 * (segment.yB - segment.yA);
+                    const auto lo = static_cast<size_t>(std::lround(std::min(y0, y1)));
+                    const auto hi = static_cast<size_t>(std::lround(std::max(y0, y1)));
+                    for (auto y = lo; y <= hi; ++y) {
+                        result.counts[y * dims.x + x] += segment.count;
+                    }
+                }
+            }
+        },
+        16);
+
+    result.max = *std::max_element(result.counts.begin(), result.counts.end());
+    return result;
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plotting/utils/densityutils.h>
+
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+TEST(DensityUtilsTest, scatter) {
+    Buffer<float> X;
+    Buffer<double> Y;
+    X.getEditableRAMRepresentation()->getDataContainer() = {0.1f, 0.1f, 0.9f, 1.0f, 2.0f, 0.5f};
+    Y.getEditableRAMRepresentation()->getDataContainer() = {
+        0.1, 0.2, 0.9, 1.0, 0.5, std::numeric_limits<double>::quiet_NaN()};
+
+    const auto density = plot::scatterDensity(X, Y, dvec2(0.0, 1.0), dvec2(0.0, 1.0), size2_t(2));
+    ASSERT_EQ(size2_t(2), density.dims);
+    // The point at x = 2 is outside of the range and the NaN is skipped
+    EXPECT_EQ(std::vector<float>({2.0f, 0.0f, 0.0f, 2.0f}), density.counts);
+    EXPECT_EQ(2.0f, density.max);
+
+    const std::vector<bool> mask{true, false, false, true, false, false};
+    const auto filtered =
+        plot::scatterDensity(X, Y, dvec2(0.0, 1.0), dvec2(0.0, 1.0), size2_t(2), mask);
+    EXPECT_EQ(std::vector<float>({1.0f, 0.0f, 0.0f, 1.0f}), filtered.counts);
+
+    const auto rows = plot::scatterDensity(X, Y, dvec2(0.0, 1.0), dvec2(0.0, 1.0), size2_t(2),
+                                           std::vector<std::uint32_t>{2, 3, 4});
+    EXPECT_EQ(std::vector<float>({0.0f, 0.0f, 0.0f, 2.0f}), rows.counts);
+
+    // The mask refers to the positions in rows, not to the rows themselves
+    const auto filteredRows =
+        plot::scatterDensity(X, Y, dvec2(0.0, 1.0), dvec2(0.0, 1.0), size2_t(2),
+                             std::vector<std::uint32_t>{3, 2, 0}, {true, false, false});
+    EXPECT_EQ(std::vector<float>({1.0f, 0.0f, 0.0f, 1.0f}), filteredRows.counts);
+}
+
+TEST(DensityUtilsTest, scatterManyRows) {
+    const size_t size = 300000;
+    Buffer<int> X;
+    Buffer<int> Y;
+    auto& x = X.getEditableRAMRepresentation()->getDataContainer();
+    auto& y = Y.getEditableRAMRepresentation()->getDataContainer();
+    for (size_t i = 0; i < size; ++i) {
+        x.push_back(static_cast<int>(i % 4));
+        y.push_back(static_cast<int>(i % 3));
+    }
+
+    const auto density =
+        plot::scatterDensity(X, Y, dvec2(0.0, 4.0), dvec2(0.0, 3.0), size2_t(4, 3));
+    EXPECT_EQ(static_cast<float>(size),
+              std::accumulate(density.counts.begin(), density.counts.end(), 0.0f));
+    EXPECT_EQ(static_cast<float>(size / 12), density.max);
+}
+
+TEST(DensityUtilsTest, axisPairHistogram) {
+    const std::vector<float> a{0.0f, 0.4f, 1.0f, 0.9f, 0.5f};
+    const std::vector<float> b{1.0f, 0.6f, 0.0f, 0.1f, std::numeric_limits<float>::quiet_NaN()};
+
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 2, 2, 0}), plot::axisPairHistogram(a, b, 2));
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 1, 2, 0}),
+              plot::axisPairHistogram(a, b, 2, {false, false, true, false, false}));
+}
+
+TEST(DensityUtilsTest, pcp) {
+    // All rows go from the bottom of the first axis to the top of the second
+    const std::vector<std::vector<float>> axes{{0.0f, 0.1f, 0.05f}, {1.0f, 0.95f, 0.9f}};
+    const auto density = plot::pcpDensity(axes, {0.0f, 1.0f}, size2_t(5, 5), 4);
+
+    ASSERT_EQ(25u, density.counts.size());
+    EXPECT_EQ(3.0f, density.max);
+    // The lines start in the lower half of the first column, end in the upper half of the last
+    // one, and cover every column in between
+    EXPECT_EQ(3.0f, density.counts[1 * 5 + 0]);
+    EXPECT_EQ(3.0f, density.counts[4 * 5 + 4]);
+    for (size_t x = 0; x < 5; ++x) {
+        float sum = 0.0f;
+        for (size_t y = 0; y < 5; ++y) sum += density.counts[y * 5 + x];
+        EXPECT_LE(3.0f, sum) << "column " << x;
+    }
+
+    const auto none = plot::pcpDensity(axes, {0.0f, 1.0f}, size2_t(5, 5), 4, {true, true, true});
+    EXPECT_EQ(0.0f, none.max);
+}
+
+}  // namespace inviwo
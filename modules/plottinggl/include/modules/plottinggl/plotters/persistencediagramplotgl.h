@@ -43,6 +43,7 @@
 #include <modules/opengl/texture/textureutils.h>
 #include <modules/opengl/shader/shader.h>
 #include <modules/base/algorithm/dataminmax.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
 
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <modules/plotting/properties/marginproperty.h>
@@ -66,7 +67,7 @@ class IVW_MODULE_PLOTTINGGL_API PersistenceDiagramPlotGL {
 public:
     using ToolTipFunc = void(PickingEvent*, size_t);
     using ToolTipCallbackHandle = std::shared_ptr<std::function<ToolTipFunc>>;
-    using SelectionFunc = void(const std::unordered_set<size_t>&);
+    using SelectionFunc = void(const BitSet&);
     using SelectionCallbackHandle = std::shared_ptr<std::function<SelectionFunc>>;
 
     class Properties : public CompositeProperty {
@@ -142,7 +143,7 @@ public:
 
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
-    void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    void setSelectedIndices(const BitSet& indices);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -175,7 +176,7 @@ protected:
     std::array<AxisRenderer, 2> axisRenderers_;
 
     PickingMapper picking_;
-    std::unordered_set<size_t> selectedIndices_;
+    BitSet selectedIndices_;
     std::set<uint32_t> hoveredIndices_;
 
     Processor* processor_;
@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/transferfunction.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/interaction/pickingmapper.h>
+#include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/transferfunctionproperty.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/dispatcher.h>
@@ -40,6 +41,7 @@
 #include <modules/base/algorithm/dataminmax.h>
 #include <modules/base/properties/stipplingproperty.h>
 #include <modules/basegl/properties/linesettingsproperty.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
 
 #include <modules/opengl/texture/textureutils.h>
 #include <modules/opengl/shader/shader.h>
@@ -52,10 +54,10 @@
 #include <modules/plotting/properties/axisstyleproperty.h>
 
 #include <modules/plottinggl/rendering/boxselectionrenderer.h>
+#include <modules/plottinggl/rendering/densityrenderer.h>
 #include <modules/plottinggl/utils/axisrenderer.h>
 
 #include <optional>
-#include <unordered_set>
 
 namespace inviwo {
 
@@ -101,6 +103,11 @@ public:
 
         BoolProperty hovering_;
 
+        TemplateOptionProperty<DensityMode> densityMode_;
+        IntSizeTProperty densityThreshold_;  ///! Row count above which Automatic draws densities
+        TransferFunctionProperty densityTf_;
+        BoolProperty densityLogScale_;
+
         AxisStyleProperty axisStyle_;
         AxisProperty xAxis_;
         AxisProperty yAxis_;
@@ -109,12 +116,16 @@ public:
         auto props() {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, densityMode_,
+                            densityThreshold_, densityTf_, densityLogScale_, axisStyle_, xAxis_,
+                            yAxis_);
         }
         auto props() const {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, densityMode_,
+                            densityThreshold_, densityTf_, densityLogScale_, axisStyle_, xAxis_,
+                            yAxis_);
         }
     };
 
@@ -144,7 +155,13 @@ public:
     void setRadiusData(std::shared_ptr<const BufferBase> buffer);
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
-    void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    void setSelectedIndices(const BitSet& indices);
+    /**
+     * Replaces the filtered rows, e.g. with the filtering of a brushing and linking port. Prefer
+     * this over passing an index buffer to plot since the rows are then only re-indexed, and the
+     * density re-binned, when the filtering has changed.
+     */
+    void setFilteredIndices(const BitSet& indices);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -159,6 +176,12 @@ public:
 
 protected:
     void plot(const size2_t& dims, IndexBuffer* indices, bool useAxisRanges);
+    /*
+     * Draws the number of rows per pixel of the plot area instead of each row, the density is
+     * only recomputed when the data, the filtering, the ranges or the plot area changes.
+     */
+    void plotDensity(const size2_t& dims, const vec4& margins, IndexBuffer* indices,
+                     bool useAxisRanges);
     void renderAxis(const size2_t& dims);
 
     void objectPicked(PickingEvent* p);
@@ -199,6 +222,14 @@ protected:
     std::unique_ptr<IndexBuffer> indices_;
     std::unique_ptr<BufferObjectArray> boa_;
 
+    DensityRenderer densityRenderer_;
+    bool densityDirty_ = true;
+    // Rows of the index buffer the density was last computed for, if any
+    std::optional<std::vector<uint32_t>> densityRows_;
+    size2_t densityDims_{0};
+    dvec2 densityRangeX_{0.0};
+    dvec2 densityRangeY_{0.0};
+
     Processor* processor_;
 
     Dispatcher<ToolTipFunc> tooltipCallback_;
@@ -55,6 +55,7 @@
 #include <inviwo/dataframe/properties/dataframecolormapproperty.h>
 #include <modules/plotting/properties/marginproperty.h>
 
+#include <modules/plottinggl/rendering/densityrenderer.h>
 #include <modules/plottinggl/utils/axisrenderer.h>
 
 namespace inviwo {
@@ -71,6 +72,10 @@ class PickingEvent;
  * ### Outports
  *   * __outport__   rendered image of the parallel coordinate plot
  *
+ * ### Properties
+ *   * __Density__  With many rows, the regular lines can be replaced by the number of lines
+ *                  passing through each pixel. Selected lines are still drawn on top.
+ *
  */
 namespace plot {
 
@@ -117,6 +122,12 @@ public:
     FloatVec3Property filterColor_;
     FloatProperty filterAlpha_;
     FloatProperty filterIntensity_;
+    CompositeProperty density_;
+    TemplateOptionProperty<DensityMode> densityMode_;
+    IntSizeTProperty densityThreshold_;  ///! Row count above which Automatic draws densities
+    IntSizeTProperty densityBins_;       ///! Number of bins per axis
+    TransferFunctionProperty densityTf_;
+    BoolProperty densityLogScale_;
 
     FontProperty captionSettings_;
     TemplateOptionProperty<LabelPosition> captionPosition_;
@@ -169,6 +180,8 @@ private:
     void drawAxis(size2_t size);
     void drawHandles(size2_t size);
     void drawLines(size2_t size);
+    void drawDensity(size2_t size);
+    bool densityEnabled() const;
 
     void updateBrushing();
 
@@ -217,6 +230,11 @@ private:
     };
     Lines lines_;
 
+    DensityRenderer densityRenderer_;
+    bool densityDirty_ = true;
+    size2_t densityDims_{0};
+    BitSet densityFiltering_;  ///! Filtering the density was last computed for
+
     std::pair<vec2, vec2> marginsInternal_;  // Margins with/without considering labels
     int hoveredLine_ = -1;
     int hoveredAxis_ = -1;
@@ -73,6 +73,7 @@ private:
     ImageOutport outport_;
 
     ScatterPlotGL scatterPlot_;
+    BitSet filtering_;  ///! Filtering of the brushing port last passed to scatterPlot_
 
     DataFrameColumnProperty xAxis_;
     DataFrameColumnProperty yAxis_;
@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/plottinggl/plottingglmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/properties/transferfunctionproperty.h>
+#include <modules/opengl/shader/shader.h>
+#include <modules/opengl/texture/texture2d.h>
+#include <modules/plotting/utils/densityutils.h>
+
+namespace inviwo {
+
+namespace plot {
+
+/**
+ * When to draw the aggregated density of a plot instead of each of its rows
+ */
+enum class DensityMode { Off, On, Automatic };
+
+/**
+ * Whether a plot of \p rows rows is drawn as a density, Automatic switches to the density once
+ * there are more than \p threshold rows.
+ */
+inline bool useDensity(DensityMode mode, size_t rows, size_t threshold) {
+    return mode == DensityMode::On || (mode == DensityMode::Automatic && rows > threshold);
+}
+
+/**
+ * \brief Renders a DensityImage by mapping the counts through a transfer function.
+ * Pixels without any rows are left untouched.
+ * @see scatterDensity, pcpDensity
+ */
+class IVW_MODULE_PLOTTINGGL_API DensityRenderer {
+public:
+    DensityRenderer();
+    virtual ~DensityRenderer() = default;
+
+    /**
+     * \brief Upload \p density to the GPU, the texture is only reallocated when the dimensions
+     * change.
+     */
+    void setDensity(const DensityImage& density);
+
+    /**
+     * \brief Draw the density into the rectangle at \p start of size \p size, relative to the
+     * current viewport. The counts are normalized by the maximum count, optionally on a log scale,
+     * before the transfer function lookup.
+     */
+    void render(const ivec2& start, const ivec2& size, const TransferFunctionProperty& tf,
+                bool logScale);
+
+    Shader& getShader() { return shader_; }
+
+private:
+    Shader shader_;
+    Texture2D texture_;
+    float max_ = 0.0f;
+};
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -47,6 +47,8 @@
 #include <inviwo/core/util/zip.h>
 #include <modules/opengl/buffer/bufferobjectarray.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 namespace plot {
@@ -75,6 +77,16 @@ ScatterPlotGL::Properties::Properties(std::string identifier, std::string displa
     , borderWidth_("borderWidth", "Border Width", 2, 0, 20)
     , borderColor_("borderColor", "Border Color", vec4(0, 0, 0, 1))
     , hovering_("hovering", "Enable Hovering", true)
+    , densityMode_("densityMode", "Density Mode",
+                   {{"off", "Off", DensityMode::Off},
+                    {"on", "On", DensityMode::On},
+                    {"automatic", "Automatic", DensityMode::Automatic}},
+                   2)
+    , densityThreshold_("densityThreshold", "Density Threshold", 1000000, 0, 100000000, 1000)
+    , densityTf_("densityTransferFunction", "Density Transfer Function",
+                 TransferFunction({{0.0, vec4(0.8f, 0.88f, 0.96f, 1.0f)},
+                                   {1.0, vec4(0.03f, 0.19f, 0.42f, 1.0f)}}))
+    , densityLogScale_("densityLogScale", "Logarithmic Density", true)
 
     , axisStyle_("axisStyle", "Global Axis Style")
     , xAxis_("xAxis", "X Axis")
@@ -94,6 +106,7 @@ ScatterPlotGL::Properties::Properties(std::string identifier, std::string displa
     minRadius_.setVisible(false);
 
     tf_.setCurrentStateAsDefault();
+    densityTf_.setCurrentStateAsDefault();
 }
 
 ScatterPlotGL::Properties::Properties(const ScatterPlotGL::Properties& rhs)
@@ -111,6 +124,10 @@ ScatterPlotGL::Properties::Properties(const ScatterPlotGL::Properties& rhs)
     , borderWidth_(rhs.borderWidth_)
     , borderColor_(rhs.borderColor_)
     , hovering_(rhs.hovering_)
+    , densityMode_(rhs.densityMode_)
+    , densityThreshold_(rhs.densityThreshold_)
+    , densityTf_(rhs.densityTf_)
+    , densityLogScale_(rhs.densityLogScale_)
     , axisStyle_(rhs.axisStyle_)
     , xAxis_(rhs.xAxis_)
     , yAxis_(rhs.yAxis_) {
@@ -162,6 +179,8 @@ ScatterPlotGL::ScatterPlotGL(Processor* processor)
     , selectionRectRenderer_(properties_.boxSelectionSettings_) {
     if (processor_) {
         shader_.onReload([this]() { processor_->invalidate(InvalidationLevel::InvalidOutput); });
+        densityRenderer_.getShader().onReload(
+            [this]() { processor_->invalidate(InvalidationLevel::InvalidOutput); });
     }
     properties_.hovering_.onChange([this]() {
         if (!properties_.hovering_.get()) {
@@ -195,6 +214,7 @@ ScatterPlotGL::ScatterPlotGL(Processor* processor)
                 }
             }
             filteringDirty_ = true;
+            densityDirty_ = true;
             // May filter selected points
             selectedIndicesGLDirty_ = true;
             filteringChangedCallback_.invoke(filtered_);
@@ -237,6 +257,13 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
     // adjust all margins by axis margin
     vec4 margins = properties_.margins_.getAsVec4() + properties_.axisMargin_.get();
 
+    // with many rows, draw the density of the rows and only the selected and hovered points
+    const auto rows = indexBuffer ? indexBuffer->getSize() : xAxis_->getSize();
+    const bool density = useDensity(properties_.densityMode_, rows, properties_.densityThreshold_);
+    if (density) {
+        plotDensity(dims, margins, indexBuffer, useAxisRanges);
+    }
+
     shader_.activate();
 
     vec2 pixelSize = vec2(1) / vec2(dims);
@@ -319,76 +346,79 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
     } else {
         shader_.setUniform("has_radius", 0);
     }
-    // Will be called if no indexBuffer is specified.
-    // (assuming brushing & linking filters, so internal filters should not be applied)
-    auto setupInternalFiltering = [this, xbuf]() {
-        if (!filteringDirty_) return;
+    if (!density) {
+        // Will be called if no indexBuffer is specified. The indices are only rebuilt when the
+        // filtering changes, either in the plot or through setFilteredIndices.
+        auto setupInternalFiltering = [this, xbuf]() {
+            if (!filteringDirty_) return;
 
-        std::vector<uint32_t> selectedIndices;
+            std::vector<uint32_t> selectedIndices;
 
-        // no indices given, draw all non-filtered data points
-        size_t nFiltered = std::count(filtered_.begin(), filtered_.end(), true);
-        // std::reduce<size_t>(filtered_.begin(), filtered_.end(), size_t(0), [);
-        auto nNotFiltered = xbuf->getSize() - nFiltered;
+            // no indices given, draw all non-filtered data points
+            size_t nFiltered = std::count(filtered_.begin(), filtered_.end(), true);
+            // std::reduce<size_t>(filtered_.begin(), filtered_.end(), size_t(0), [);
+            auto nNotFiltered = xbuf->getSize() - nFiltered;
 
-        if (!indices_) indices_ = std::make_unique<IndexBuffer>(nNotFiltered);
-        auto& inds = indices_->getEditableRAMRepresentation()->getDataContainer();
-        inds.clear();
-        inds.reserve(nNotFiltered);
+            if (!indices_) indices_ = std::make_unique<IndexBuffer>(nNotFiltered);
+            auto& inds = indices_->getEditableRAMRepresentation()->getDataContainer();
+            inds.clear();
+            inds.reserve(nNotFiltered);
 
-        if (indexColumn_) {
-            auto& indexCol =
-                indexColumn_->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-            for (auto [ind, filtered] : util::enumerate(filtered_)) {
-                if (!filtered) {
-                    inds.push_back(indexCol[ind]);
+            if (indexColumn_) {
+                auto& indexCol =
+                    indexColumn_->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+                for (auto [ind, filtered] : util::enumerate(filtered_)) {
+                    if (!filtered) {
+                        inds.push_back(indexCol[ind]);
+                    }
                 }
+            } else {
+                auto indicesSeq = util::make_sequence<unsigned int>(
+                    0, static_cast<unsigned int>(xbuf->getSize()), 1);
+                std::copy_if(indicesSeq.begin(), indicesSeq.end(), std::back_inserter(inds),
+                             [this](auto val) { return !filtered_[val]; });
             }
-        } else {
-            auto indicesSeq =
-                util::make_sequence<unsigned int>(0, static_cast<unsigned int>(xbuf->getSize()), 1);
-            std::copy_if(indicesSeq.begin(), indicesSeq.end(), std::back_inserter(inds),
-                         [this](auto val) { return !filtered_[val]; });
-        }
-        filteringDirty_ = false;
-    };
-    IndexBuffer* indices;
-    if (radius_) {
-
-        if (indexBuffer) {
-            // copy selected indices
-            indices_ = std::unique_ptr<IndexBuffer>(indexBuffer->clone());
-        } else {
-            setupInternalFiltering();
-        }
-        indices = indices_.get();
+            filteringDirty_ = false;
+        };
+        IndexBuffer* indices;
+        if (radius_) {
+
+            if (indexBuffer) {
+                // copy selected indices
+                indices_ = std::unique_ptr<IndexBuffer>(indexBuffer->clone());
+            } else {
+                setupInternalFiltering();
+            }
+            indices = indices_.get();
 
-        // sort according to radii, larger first
-        auto& inds = indices->getEditableRAMRepresentation()->getDataContainer();
+            // sort according to radii, larger first
+            auto& inds = indices->getEditableRAMRepresentation()->getDataContainer();
 
-        radius_->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
-            [&inds](auto bufferpr) {
-                auto& radii = bufferpr->getDataContainer();
-                std::sort(inds.begin(), inds.end(), [&radii](const uint32_t& a, const uint32_t& b) {
-                    return radii[a] > radii[b];
+            radius_->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+                [&inds](auto bufferpr) {
+                    auto& radii = bufferpr->getDataContainer();
+                    std::sort(inds.begin(), inds.end(),
+                              [&radii](const uint32_t& a, const uint32_t& b) {
+                                  return radii[a] > radii[b];
+                              });
                 });
-            });
-    } else {
-        if (indexBuffer) {
-            // copy selected indices
-            indices = indexBuffer;
         } else {
-            setupInternalFiltering();
-            indices = indices_.get();
+            if (indexBuffer) {
+                // copy selected indices
+                indices = indexBuffer;
+            } else {
+                setupInternalFiltering();
+                indices = indices_.get();
+            }
         }
-    }
 
-    boa_->bind();
-    auto indicesGL = indices->getRepresentation<BufferGL>();
-    indicesGL->bind();
-    glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()), indicesGL->getFormatType(),
-                   nullptr);
-    indicesGL->getBufferObject()->unbind();
+        boa_->bind();
+        auto indicesGL = indices->getRepresentation<BufferGL>();
+        indicesGL->bind();
+        glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()),
+                       indicesGL->getFormatType(), nullptr);
+        indicesGL->getBufferObject()->unbind();
+    }
     // draw selected and hovered points on top
 
     if (selectedIndicesGLDirty_ || nSelectedButNotFiltered_ > 0) {
@@ -453,6 +483,50 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
     renderAxis(dims);
 }  // namespace plot
 
+void ScatterPlotGL::plotDensity(const size2_t& dims, const vec4& margins, IndexBuffer* indexBuffer,
+                                bool useAxisRanges) {
+    // margins are top, right, bottom, left
+    const ivec2 start(static_cast<int>(margins.w), static_cast<int>(margins.z));
+    const ivec2 size = ivec2(dims) - ivec2(static_cast<int>(margins.w + margins.y),
+                                           static_cast<int>(margins.z + margins.x));
+    if (size.x <= 0 || size.y <= 0) return;
+
+    const dvec2 rangeX = useAxisRanges ? properties_.xAxis_.range_.get() : dvec2(minmaxX_);
+    const dvec2 rangeY = useAxisRanges ? properties_.yAxis_.range_.get() : dvec2(minmaxY_);
+
+    // An index buffer given by the caller is only binned again if its rows have changed
+    const auto* rows =
+        indexBuffer ? &indexBuffer->getRAMRepresentation()->getDataContainer() : nullptr;
+    const bool rowsChanged = rows ? !densityRows_ || *densityRows_ != *rows : bool(densityRows_);
+
+    if (rowsChanged || densityDirty_ || densityDims_ != size2_t(size) ||
+        densityRangeX_ != rangeX || densityRangeY_ != rangeY) {
+        DensityImage density;
+        if (rows) {
+            density = scatterDensity(*xAxis_, *yAxis_, rangeX, rangeY, size2_t(size), *rows);
+            densityRows_ = *rows;
+        } else if (indexColumn_) {
+            const auto& indexCol =
+                indexColumn_->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+            density = scatterDensity(*xAxis_, *yAxis_, rangeX, rangeY, size2_t(size), indexCol,
+                                     filtered_);
+            densityRows_.reset();
+        } else {
+            density = scatterDensity(*xAxis_, *yAxis_, rangeX, rangeY, size2_t(size), filtered_);
+            densityRows_.reset();
+        }
+        densityRenderer_.setDensity(density);
+
+        densityDirty_ = false;
+        densityDims_ = size2_t(size);
+        densityRangeX_ = rangeX;
+        densityRangeY_ = rangeY;
+    }
+
+    densityRenderer_.render(start, size, properties_.densityTf_,
+                            properties_.densityLogScale_.get());
+}
+
 void ScatterPlotGL::setXAxisLabel(const std::string& label) {
     properties_.xAxis_.setCaption(label);
 }
@@ -480,6 +554,7 @@ void ScatterPlotGL::setXAxisData(std::shared_ptr<const BufferBase> buffer) {
 
         properties_.xAxis_.setRange(minmaxX_);
     }
+    densityDirty_ = true;
     boxSelectionHandler_.setXAxisData(buffer);
 }
 
@@ -492,6 +567,7 @@ void ScatterPlotGL::setYAxisData(std::shared_ptr<const BufferBase> buffer) {
 
         properties_.yAxis_.setRange(minmaxY_);
     }
+    densityDirty_ = true;
     boxSelectionHandler_.setYAxisData(buffer);
 }
 
@@ -532,12 +608,24 @@ void ScatterPlotGL::setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t
     }
 }
 
-void ScatterPlotGL::setSelectedIndices(const std::unordered_set<size_t>& indices) {
+void ScatterPlotGL::setSelectedIndices(const BitSet& indices) {
     ensureSelectAndFilterSizes();
-    selected_.resize(xAxis_->getSize(), false);
-    for (auto i : indices) {
-        selected_[i] = true;
-    }
+    std::fill(selected_.begin(), selected_.end(), false);
+    indices.forEach([&](size_t i) {
+        if (i < selected_.size()) selected_[i] = true;
+    });
+    selectedIndicesGLDirty_ = true;
+}
+
+void ScatterPlotGL::setFilteredIndices(const BitSet& indices) {
+    ensureSelectAndFilterSizes();
+    std::fill(filtered_.begin(), filtered_.end(), false);
+    indices.forEach([&](size_t i) {
+        if (i < filtered_.size()) filtered_[i] = true;
+    });
+    filteringDirty_ = true;
+    densityDirty_ = true;
+    // May filter selected points
     selectedIndicesGLDirty_ = true;
 }
 
@@ -647,6 +735,7 @@ void ScatterPlotGL::ensureSelectAndFilterSizes() {
         filtered_.resize(xAxis_->getSize(), false);
         selectedIndicesGLDirty_ = true;
         filteringDirty_ = true;
+        densityDirty_ = true;
     }
 }
 
@@ -54,6 +54,9 @@
 #include <inviwo/dataframe/datastructures/dataframeutil.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/zip.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <limits>
 
 namespace inviwo {
 
@@ -101,6 +104,18 @@ ParallelCoordinates::ParallelCoordinates()
                    vec4(0.01f), InvalidationLevel::InvalidOutput, PropertySemantics::Color)
     , filterAlpha_("filterAlpha", "Filter Alpha", 0.75f)
     , filterIntensity_("filterIntensity", "Filter Mixing", 0.7f, 0.01f, 1.0f, 0.001f)
+    , density_("density", "Density")
+    , densityMode_("densityMode", "Mode",
+                   {{"off", "Off", DensityMode::Off},
+                    {"on", "On", DensityMode::On},
+                    {"automatic", "Automatic", DensityMode::Automatic}},
+                   2)
+    , densityThreshold_("densityThreshold", "Threshold", 100000, 0, 100000000, 1000)
+    , densityBins_("densityBins", "Bins", 256, 2, 1024)
+    , densityTf_("densityTransferFunction", "Transfer Function",
+                 TransferFunction({{0.0, vec4(0.8f, 0.88f, 0.96f, 1.0f)},
+                                   {1.0, vec4(0.03f, 0.19f, 0.42f, 1.0f)}}))
+    , densityLogScale_("densityLogScale", "Logarithmic", true)
 
     , captionSettings_("captions", "Caption Settings", "Montserrat-Regular", 24, 0.0f,
                        vec2{0.0f, -1.0f})
@@ -163,8 +178,11 @@ ParallelCoordinates::ParallelCoordinates()
     selectedLine_.setCollapsed(true);
 
     addProperty(lineSettings_);
+    density_.addProperties(densityMode_, densityThreshold_, densityBins_, densityTf_,
+                           densityLogScale_);
+    density_.setCollapsed(true);
     lineSettings_.addProperties(blendMode_, falllofPower_, lineWidth_, selectedLine_, showFiltered_,
-                                filterColor_, filterAlpha_, filterIntensity_);
+                                filterColor_, filterAlpha_, filterIntensity_, density_);
     lineSettings_.setCollapsed(true);
 
     addProperty(captionSettings_);
@@ -218,6 +236,8 @@ ParallelCoordinates::ParallelCoordinates()
         lineShader_.onReload([&]() { this->invalidate(InvalidationLevel::InvalidOutput); });
         lineShader_.build();
     }
+    densityRenderer_.getShader().onReload(
+        [&]() { this->invalidate(InvalidationLevel::InvalidOutput); });
 
     dataFrame_.onChange([&]() { createOrUpdateProperties(); });
 
@@ -317,6 +337,7 @@ void ParallelCoordinates::process() {
     utilgl::activateAndClearTarget(outport_, ImageType::ColorPicking);
     utilgl::GlBoolState depthTest(GL_DEPTH_TEST, false);
 
+    if (densityEnabled()) drawDensity(dims);
     drawLines(dims);
     drawAxis(dims);
     drawHandles(dims);
@@ -378,6 +399,7 @@ void ParallelCoordinates::createOrUpdateProperties() {
         prop->invertRange.onChange([this, i, s = slider.get(), prop]() {
             s->setFlipped(prop->invertRange);
             lines_.axisFlipped[i] = static_cast<int>(prop->invertRange);
+            densityDirty_ = true;
         });
         // initialize corresponding flipped flag for the line shader
         lines_.axisFlipped[i] = static_cast<int>(prop->invertRange);
@@ -467,6 +489,8 @@ void ParallelCoordinates::buildAxisPositions() {
     for (auto&& item : util::enumerate(enabledAxes_)) {
         lines_.axisPositions[item.second()] = item.first() / float(numberOfEnabledAxis - 1);
     }
+    // The density image is drawn at the axis positions
+    densityDirty_ = true;
 }
 
 void ParallelCoordinates::partitionLines() {
@@ -598,7 +622,9 @@ void ParallelCoordinates::drawLines(size2_t size) {
                                              selectedLineColorOverride_.isChecked() ? 1.0f : 0.0f};
         std::array<float, 3> mixAlpha = {1.0, 0.0f, 0.0f};
 
-        for (size_t i = showFiltered_ ? 0 : 1; i < lines_.offsets.size() - 1; ++i) {
+        // the density replaces the filtered and regular lines
+        const size_t first = densityEnabled() ? 2 : (showFiltered_ ? 0 : 1);
+        for (size_t i = first; i < lines_.offsets.size() - 1; ++i) {
             auto begin = lines_.offsets[i];
             auto end = lines_.offsets[i + 1];
             if (end == begin) continue;
@@ -626,6 +652,56 @@ void ParallelCoordinates::drawLines(size2_t size) {
     lineShader_.deactivate();
 }
 
+bool ParallelCoordinates::densityEnabled() const {
+    return useDensity(densityMode_, lines_.starts.size(), densityThreshold_);
+}
+
+void ParallelCoordinates::drawDensity(size2_t size) {
+    const ivec2 start{marginsInternal_.first};
+    const ivec2 extent = ivec2{size} - ivec2{marginsInternal_.first + marginsInternal_.second};
+    if (extent.x <= 0 || extent.y <= 0 || enabledAxes_.size() < 2) return;
+
+    // Only the filtering affects the density, selections are drawn as lines on top of it
+    const auto& filtering = brushingAndLinking_.getFiltering();
+    if (densityDirty_ || densityBins_.isModified() || densityDims_ != size2_t{extent} ||
+        densityFiltering_ != filtering) {
+        const auto numberOfAxis = axes_.size();
+        const auto numberOfLines = dataFrame_.getData()->getNumberOfRows();
+        const auto& values = lines_.mesh.getTypedDataContainer<buffertraits::PositionsBuffer1D>();
+        const auto iCol = dataFrame_.getData()->getIndexColumn();
+        const auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+
+        // normalized values of the enabled axes, in the order they are drawn. Filtered rows are
+        // set to NaN, which pcpDensity skips.
+        std::vector<std::vector<float>> axes(enabledAxes_.size(),
+                                             std::vector<float>(numberOfLines));
+        std::vector<float> axisPositions;
+        for (auto id : enabledAxes_) axisPositions.push_back(lines_.axisPositions[id]);
+        util::parallelFor(
+            size_t{0}, numberOfLines,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const bool filtered = filtering.contains(indexCol[i]);
+                    for (size_t a = 0; a < axes.size(); ++a) {
+                        const auto id = enabledAxes_[a];
+                        const auto v = values[i * numberOfAxis + id];
+                        axes[a][i] = filtered ? std::numeric_limits<float>::quiet_NaN()
+                                           : (lines_.axisFlipped[id] != 0 ? 1.0f - v : v);
+                    }
+                }
+            },
+            size_t{1} << 14);
+
+        densityRenderer_.setDensity(
+            pcpDensity(axes, axisPositions, size2_t{extent}, densityBins_.get()));
+        densityFiltering_ = filtering;
+        densityDirty_ = false;
+        densityDims_ = size2_t{extent};
+    }
+
+    densityRenderer_.render(start, extent, densityTf_, densityLogScale_.get());
+}
+
 void ParallelCoordinates::linePicked(PickingEvent* p) {
     if (auto df = dataFrame_.getData()) {
         // Show tooltip about current line
@@ -650,11 +726,11 @@ void ParallelCoordinates::linePicked(PickingEvent* p) {
 
         auto id = p->getPickedId();
 
-        auto selection = brushingAndLinking_.getSelectedIndices();
+        auto selection = brushingAndLinking_.getSelection();
         if (brushingAndLinking_.isSelected(indexCol[id])) {
-            selection.erase(indexCol[id]);
+            selection.remove(indexCol[id]);
         } else {
-            selection.insert(indexCol[id]);
+            selection.add(indexCol[id]);
         }
         brushingAndLinking_.sendSelectionEvent(selection);
 
@@ -759,6 +835,7 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
                         glm::clamp(float(p->getPosition().x * p->getCanvasSize().x - rect.first.x) /
                                        (rect.second.x - rect.first.x),
                                    0.0f, 1.0f);
+                    densityDirty_ = true;
                     invalidate(InvalidationLevel::InvalidOutput);
                 }
             }
@@ -796,9 +873,9 @@ void ParallelCoordinates::updateBrushing() {
         }
     }
 
-    std::unordered_set<size_t> brushedID;
+    BitSet brushedID;
     for (size_t i = 0; i < nRows; ++i) {
-        if (brushed[i]) brushedID.insert(indexCol[i]);
+        if (brushed[i]) brushedID.add(indexCol[i]);
     }
     brushingAndLinking_.sendFilterEvent(brushedID);
 }
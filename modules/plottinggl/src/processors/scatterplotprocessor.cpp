@@ -78,11 +78,11 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     selectionChangedCallBack_ =
         scatterPlot_.addSelectionChangedCallback([this](const std::vector<bool>& selected) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> selectedIndices;
+                BitSet selectedIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < selected.size(); ++i) {
-                    if (selected[i]) selectedIndices.insert(indexCol[i]);
+                    if (selected[i]) selectedIndices.add(indexCol[i]);
                 }
                 brushingPort_.sendSelectionEvent(selectedIndices);
             } else {
@@ -92,11 +92,11 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     filteringChangedCallBack_ =
         scatterPlot_.addFilteringChangedCallback([this](const std::vector<bool>& filtered) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> filteredIndices;
+                BitSet filteredIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < filtered.size(); ++i) {
-                    if (filtered[i]) filteredIndices.insert(indexCol[i]);
+                    if (filtered[i]) filteredIndices.add(indexCol[i]);
                 }
                 brushingPort_.sendFilterEvent(filteredIndices);
             } else {
@@ -135,41 +135,25 @@ ScatterPlotProcessor::ScatterPlotProcessor()
 
 void ScatterPlotProcessor::process() {
     utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    auto dataframe = dataFramePort_.getData();
 
     if (brushingPort_.isConnected()) {
         if (brushingPort_.isChanged()) {
-            scatterPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
+            scatterPlot_.setSelectedIndices(brushingPort_.getSelection());
         }
-
-        auto dfSize = dataframe->getNumberOfRows();
-
-        auto iCol = dataframe->getIndexColumn();
-        auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-
-        auto brushedIndicies = brushingPort_.getFilteredIndices();
-        IndexBuffer indicies;
-        auto& vec = indicies.getEditableRAMRepresentation()->getDataContainer();
-        vec.reserve(dfSize - brushedIndicies.size());
-
-        auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
-        std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
-                     [&](const auto& id) { return !brushingPort_.isFiltered(indexCol[id]); });
-
-        if (backgroundPort_.hasData()) {
-            scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), &indicies,
-                              true);
-        } else {
-            scatterPlot_.plot(*outport_.getEditableData(), &indicies, true);
+        // Only refilter when the filtering changed, and not on every selection or hover
+        if (dataFramePort_.isChanged() || brushingPort_.getFiltering() != filtering_) {
+            filtering_ = brushingPort_.getFiltering();
+            scatterPlot_.setFilteredIndices(filtering_);
         }
+    } else if (!filtering_.empty()) {
+        filtering_ = BitSet{};
+        scatterPlot_.setFilteredIndices(filtering_);
+    }
 
+    if (backgroundPort_.hasData()) {
+        scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), nullptr, true);
     } else {
-        if (backgroundPort_.hasData()) {
-            scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), nullptr,
-                              true);
-        } else {
-            scatterPlot_.plot(*outport_.getEditableData(), nullptr, true);
-        }
+        scatterPlot_.plot(*outport_.getEditableData(), nullptr, true);
     }
 }
 
@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plottinggl/rendering/densityrenderer.h>
+#include <modules/opengl/openglutils.h>
+#include <modules/opengl/texture/textureunit.h>
+#include <modules/opengl/texture/textureutils.h>
+
+namespace inviwo {
+
+namespace plot {
+
+DensityRenderer::DensityRenderer()
+    : shader_("img_identity.vert", "density.frag")
+    , texture_(size2_t(1), GL_RED, GL_R32F, GL_FLOAT, GL_NEAREST) {
+    texture_.initialize(nullptr);
+}
+
+void DensityRenderer::setDensity(const DensityImage& density) {
+    max_ = density.max;
+    if (density.counts.empty()) return;
+    texture_.resize(density.dims);
+    texture_.upload(density.counts.data());
+}
+
+void DensityRenderer::render(const ivec2& start, const ivec2& size,
+                             const TransferFunctionProperty& tf, bool logScale) {
+    if (max_ <= 0.0f || size.x <= 0 || size.y <= 0) return;
+
+    utilgl::Viewport current;
+    current.get();
+    utilgl::ViewportState viewport(current.x() + start.x, current.y() + start.y, size.x, size.y);
+    utilgl::GlBoolState depthTest(GL_DEPTH_TEST, false);
+    utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    TextureUnitContainer units;
+    utilgl::Activate<Shader> activate(&shader_);
+    utilgl::bindAndSetUniforms(shader_, units, texture_, "density");
+    TextureUnit tfUnit;
+    utilgl::bindTexture(tf, tfUnit);
+    shader_.setUniform("transferFunction", tfUnit);
+    units.push_back(std::move(tfUnit));
+    shader_.setUniform("maxCount", max_);
+    shader_.setUniform("logScale", logScale ? 1 : 0);
+
+    utilgl::singleDrawImagePlaneRect();
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -68,7 +68,7 @@ struct BufferRAMHelper {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Data>>(
                          data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                     pyutil::copyData(data, ram->getData());
                      return new Buffer<T, BufferTarget::Data>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -82,7 +82,7 @@ struct BufferRAMHelper {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Index>>(
                          data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                     pyutil::copyData(data, ram->getData());
                      return new Buffer<T, BufferTarget::Index>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -149,7 +149,7 @@ void exposeBuffer(pybind11::module &m) {
                           auto rep = buffer->getEditableRepresentation<BufferRAM>();
                           pyutil::checkDataFormat<1>(rep->getDataFormat(), rep->getSize(), data);
 
-                          memcpy(rep->getData(), data.data(0), data.nbytes());
+                          pyutil::copyData(data, rep->getData());
                       })
         .def("__repr__", [](const BufferBase &self) {
             return fmt::format("<Buffer: target = {} usage = {} format = {} size = {}>",
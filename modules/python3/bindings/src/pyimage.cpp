@@ -169,7 +169,7 @@ void exposeImage(py::module& m) {
                 auto rep = layer->getEditableRepresentation<LayerRAM>();
                 pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                pyutil::copyData(data, rep->getData());
             })
         .def("__repr__", [](const Layer& self) {
             return fmt::format(
@@ -151,16 +151,17 @@ void exposeProcessors(pybind11::module &m) {
         .def_readonly_static("PY", &Tags::PY);
 
     py::class_<ProcessorInfo>(m, "ProcessorInfo")
-        .def(py::init<std::string, std::string, std::string, CodeState, Tags, bool>(),
+        .def(py::init<std::string, std::string, std::string, CodeState, Tags, bool, bool>(),
              py::arg("classIdentifier"), py::arg("displayName"), py::arg("category") = "Python",
              py::arg("codeState") = CodeState::Stable, py::arg("tags") = Tags::PY,
-             py::arg("visible") = true)
+             py::arg("visible") = true, py::arg("threadSafe") = false)
         .def_readonly("classIdentifier", &ProcessorInfo::classIdentifier)
         .def_readonly("displayName", &ProcessorInfo::displayName)
         .def_readonly("category", &ProcessorInfo::category)
         .def_readonly("codeState", &ProcessorInfo::codeState)
         .def_readonly("tags", &ProcessorInfo::tags)
-        .def_readonly("visible", &ProcessorInfo::visible);
+        .def_readonly("visible", &ProcessorInfo::visible)
+        .def_readonly("threadSafe", &ProcessorInfo::threadSafe);
 
     py::class_<ProcessorFactoryObject, ProcessorFactoryObjectTrampoline>(m,
                                                                          "ProcessorFactoryObject")
@@ -91,7 +91,7 @@ void exposeVolume(pybind11::module &m) {
                 auto rep = volume->getEditableRepresentation<VolumeRAM>();
                 pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                pyutil::copyData(data, rep->getData());
             })
         .def("__repr__", [](const Volume &volume) {
             std::ostringstream oss;
@@ -43,6 +43,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/datastructures/image/imagetypes.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/stringconversion.h>
 
@@ -50,14 +51,46 @@ namespace inviwo {
 
 class BufferBase;
 class Layer;
+class LayerRAM;
 class Volume;
+class VolumeRAM;
 
 namespace pyutil {
 
 IVW_MODULE_PYTHON3_API pybind11::dtype toNumPyFormat(const DataFormatBase *df);
 IVW_MODULE_PYTHON3_API const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr);
+/**
+ * Copy the data of \p arr into \p dest. The GIL is released during the copy to let other Python
+ * threads progress.
+ */
+IVW_MODULE_PYTHON3_API void copyData(const pybind11::array &arr, void *dest);
+
 IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr);
+
+/**
+ * Create a LayerRAM that refers to the data of a NumPy array without copying it. The array is kept
+ * alive for as long as the representation uses its data. Any non-const access to the data of the
+ * representation makes a copy first (copy-on-write), hence the array is never modified by Inviwo.
+ * Modifications of the array from Python on the other hand are visible in the representation.
+ * Arrays that are not contiguous are copied into a C-contiguous array first.
+ */
+IVW_MODULE_PYTHON3_API std::shared_ptr<LayerRAM> createLayerRAM(
+    pybind11::array &arr, LayerType layerType = LayerType::Color);
+/**
+ * Create a Layer wrapping the data of a NumPy array.
+ * @see createLayerRAM
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr);
+
+/**
+ * Create a VolumeRAM that refers to the data of a NumPy array without copying it.
+ * @see createLayerRAM
+ */
+IVW_MODULE_PYTHON3_API std::shared_ptr<VolumeRAM> createVolumeRAM(pybind11::array &arr);
+/**
+ * Create a Volume wrapping the data of a NumPy array.
+ * @see createLayerRAM
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr);
 
 template <int Dim>
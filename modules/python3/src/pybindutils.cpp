@@ -29,6 +29,7 @@
 
 #include <modules/python3/pybindutils.h>
 
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/formatdispatching.h>
@@ -48,6 +49,9 @@
 
 #include <inviwo/core/util/stdextensions.h>
 
+#include <cstdint>
+#include <cstring>
+
 namespace inviwo {
 
 namespace pyutil {
@@ -90,41 +94,100 @@ const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr) {
     return format;
 }
 
+namespace {
+
+/**
+ * Returns the array itself if its data can be used as is by a representation, i.e. if it is
+ * C-contiguous and aligned for the element type. Otherwise a C-contiguous copy is returned, also
+ * for F-contiguous arrays, such that the representation always sees the same memory layout for
+ * the same logical array.
+ */
+template <typename T>
+pybind11::array contiguous(pybind11::array &arr) {
+    namespace py = pybind11;
+    const bool isContiguous = (arr.flags() & py::array::c_style) != 0;
+    const bool isAligned = reinterpret_cast<std::uintptr_t>(arr.data()) % alignof(T) == 0;
+    if (isContiguous && isAligned) return arr;
+    return py::array::ensure(arr, py::array::c_style | py::detail::npy_api::NPY_ARRAY_ALIGNED_);
+}
+
+void releaseArray(pybind11::array *arr) {
+    if (Py_IsInitialized()) {
+        pybind11::gil_scoped_acquire gil;
+        delete arr;
+    } else {
+        // The interpreter is already gone, the array can not be released anymore.
+        arr->release();
+        delete arr;
+    }
+}
+
+/**
+ * Keeps a NumPy array alive for as long as a representation refers to its data. The last
+ * reference might be dropped on any thread, for example by a pool job. Acquiring the GIL there
+ * would stall the worker while the main thread holds it, so unless the current thread already
+ * holds the GIL the release is posted to the main thread.
+ */
+std::shared_ptr<void> keepAlive(pybind11::array arr) {
+    return std::shared_ptr<void>(new pybind11::array(std::move(arr)), [](void *ptr) {
+        auto arr = static_cast<pybind11::array *>(ptr);
+        if (Py_IsInitialized() && !PyGILState_Check() && InviwoApplication::isInitialized()) {
+            dispatchFrontAndForget([arr]() { releaseArray(arr); });
+        } else {
+            releaseArray(arr);
+        }
+    });
+}
+
+}  // namespace
+
+void copyData(const pybind11::array &arr, void *dest) {
+    const auto src = arr.data();
+    const auto bytes = static_cast<size_t>(arr.nbytes());
+    pybind11::gil_scoped_release release;
+    std::memcpy(dest, src, bytes);
+}
+
 struct BufferFromArrayDispatcher {
     using type = std::unique_ptr<BufferBase>;
 
     template <typename Result, typename T>
     std::unique_ptr<BufferBase> operator()(pybind11::array &arr) {
         using Type = typename T::type;
-        auto buf = std::make_unique<Buffer<Type>>(arr.shape(0));
-        memcpy(buf->getEditableRAMRepresentation()->getData(), arr.data(0), arr.nbytes());
+        // BufferRAMPrecision stores its data in a std::vector which can not adopt external memory
+        auto src = contiguous<Type>(arr);
+        auto buf = std::make_unique<Buffer<Type>>(src.shape(0));
+        copyData(src, buf->getEditableRAMRepresentation()->getData());
         return buf;
     }
 };
 
 struct LayerFromArrayDispatcher {
-    using type = std::unique_ptr<Layer>;
+    using type = std::shared_ptr<LayerRAM>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Layer> operator()(pybind11::array &arr) {
+    std::shared_ptr<LayerRAM> operator()(pybind11::array &arr, LayerType layerType) {
         using Type = typename T::type;
-        size2_t dims(arr.shape(0), arr.shape(1));
-        auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(dims);
-        memcpy(layerRAM->getData(), arr.data(0), arr.nbytes());
-        return std::make_unique<Layer>(layerRAM);
+        auto src = contiguous<Type>(arr);
+        size2_t dims(src.shape(0), src.shape(1));
+        // the representation only reads the data, any modification makes a copy
+        auto data = const_cast<Type *>(static_cast<const Type *>(src.data()));
+        return std::make_shared<LayerRAMPrecision<Type>>(data, keepAlive(std::move(src)), dims,
+                                                         layerType);
     }
 };
 
 struct VolumeFromArrayDispatcher {
-    using type = std::unique_ptr<Volume>;
+    using type = std::shared_ptr<VolumeRAM>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Volume> operator()(pybind11::array &arr) {
+    std::shared_ptr<VolumeRAM> operator()(pybind11::array &arr) {
         using Type = typename T::type;
-        size3_t dims(arr.shape(0), arr.shape(1), arr.shape(2));
-        auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(dims);
-        memcpy(volumeRAM->getData(), arr.data(0), arr.nbytes());
-        return std::make_unique<Volume>(volumeRAM);
+        auto src = contiguous<Type>(arr);
+        size3_t dims(src.shape(0), src.shape(1), src.shape(2));
+        // the representation only reads the data, any modification makes a copy
+        auto data = const_cast<Type *>(static_cast<const Type *>(src.data()));
+        return std::make_shared<VolumeRAMPrecision<Type>>(data, keepAlive(std::move(src)), dims);
     }
 };
 
@@ -137,23 +200,31 @@ std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr) {
         df->getId(), dispatcher, arr);
 }
 
-std::unique_ptr<Layer> createLayer(pybind11::array &arr) {
+std::shared_ptr<LayerRAM> createLayerRAM(pybind11::array &arr, LayerType layerType) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 2 || ndim == 3, "Ndims must be either 2 or 3");
     auto df = pyutil::getDataFormat(ndim == 2 ? 1 : arr.shape(2), arr);
     LayerFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(df->getId(),
-                                                                                   dispatcher, arr);
+    return dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
+        df->getId(), dispatcher, arr, layerType);
 }
 
-std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
+std::unique_ptr<Layer> createLayer(pybind11::array &arr) {
+    return std::make_unique<Layer>(createLayerRAM(arr));
+}
+
+std::shared_ptr<VolumeRAM> createVolumeRAM(pybind11::array &arr) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 3 || ndim == 4, "Ndims must be either 3 or 4");
     auto df = pyutil::getDataFormat(ndim == 3 ? 1 : arr.shape(3), arr);
     VolumeFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Volume>, dispatching::filter::All>(
+    return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
         df->getId(), dispatcher, arr);
 }
 
+std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
+    return std::make_unique<Volume>(createVolumeRAM(arr));
+}
+
 }  // namespace pyutil
 }  // namespace inviwo
@@ -96,6 +96,97 @@ TEST(Python3Scripts, SimpleBufferTest) {
     EXPECT_TRUE(status);
 }
 
+TEST(Python3Numpy, VolumeSharesArrayData) {
+    PythonScript s;
+    s.setSource("import numpy as np\na = np.arange(64, dtype=np.float32).reshape((4, 4, 4))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+        EXPECT_EQ(size3_t(4, 4, 4), volume->getDimensions());
+
+        // reading uses the data of the array
+        auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_EQ(arr.data(), ram->getData());
+
+        // writing makes a copy and leaves the array untouched
+        auto editable = volume->getEditableRepresentation<VolumeRAM>();
+        editable->setFromDouble(size3_t(0, 0, 0), 100.0);
+        EXPECT_NE(arr.data(), editable->getData());
+        EXPECT_EQ(100.0, editable->getAsDouble(size3_t(0, 0, 0)));
+        EXPECT_EQ(1.0, editable->getAsDouble(size3_t(1, 0, 0)));
+        EXPECT_EQ(0.0f, *static_cast<const float *>(arr.data()));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(Python3Numpy, LayerSharesArrayData) {
+    PythonScript s;
+    s.setSource("import numpy as np\na = np.arange(16, dtype=np.uint8).reshape((4, 4))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto layer = pyutil::createLayer(arr);
+        EXPECT_EQ(size2_t(4, 4), layer->getDimensions());
+
+        auto ram = layer->getRepresentation<LayerRAM>();
+        EXPECT_EQ(arr.data(), ram->getData());
+
+        auto editable = layer->getEditableRepresentation<LayerRAM>();
+        editable->setFromDouble(size2_t(0, 0), 100.0);
+        EXPECT_NE(arr.data(), editable->getData());
+        EXPECT_EQ(100.0, editable->getAsDouble(size2_t(0, 0)));
+        EXPECT_EQ(1.0, editable->getAsDouble(size2_t(1, 0)));
+        EXPECT_EQ(0, *static_cast<const unsigned char *>(arr.data()));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(Python3Numpy, NonContiguousArrayIsCopied) {
+    PythonScript s;
+    s.setSource("import numpy as np\na = np.arange(128, dtype=np.int32).reshape((8, 4, 4))[::2]\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+        EXPECT_EQ(size3_t(4, 4, 4), volume->getDimensions());
+
+        auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_NE(arr.data(), ram->getData());
+        // C-contiguous copy, the last index is the fastest
+        EXPECT_EQ(0.0, ram->getAsDouble(size3_t(0, 0, 0)));
+        EXPECT_EQ(1.0, ram->getAsDouble(size3_t(1, 0, 0)));
+        EXPECT_EQ(32.0, ram->getAsDouble(size3_t(0, 0, 1)));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(Python3Numpy, FortranOrderArrayIsCopiedToCOrder) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\n"
+        "a = np.asfortranarray(np.arange(64, dtype=np.int32).reshape((4, 4, 4)))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+        EXPECT_EQ(size3_t(4, 4, 4), volume->getDimensions());
+
+        auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_NE(arr.data(), ram->getData());
+        // Same layout as for the C-contiguous array, the last index is the fastest
+        EXPECT_EQ(0.0, ram->getAsDouble(size3_t(0, 0, 0)));
+        EXPECT_EQ(1.0, ram->getAsDouble(size3_t(1, 0, 0)));
+        EXPECT_EQ(4.0, ram->getAsDouble(size3_t(0, 1, 0)));
+        EXPECT_EQ(16.0, ram->getAsDouble(size3_t(0, 0, 1)));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
 class DTypeTest : public ::testing::TestWithParam<std::string> {
 protected:
     virtual void SetUp() {}
@@ -258,12 +258,13 @@ void TFEditorView::updateHistogram() {
             } else if (!histCalculation_) {
                 histograms_.clear();
                 histCalculation_ = volume->calculateHistograms(2048);
-                histCalculation_->whenDone([this](const HistogramContainer& histograms) {
+                histCalculation_->whenUpdated([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
                     resetCachedContent();
                     update();
-                    histCalculation_.reset();
                 });
+                histCalculation_->whenDone(
+                    [this](const HistogramContainer&) { histCalculation_.reset(); });
             }
         } else {
             histograms_.clear();
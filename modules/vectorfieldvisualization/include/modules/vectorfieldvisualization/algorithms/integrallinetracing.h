@@ -0,0 +1,171 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/util/taskgroup.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * The lines traced from one chunk of consecutive seeds, in seed order. Lines with less than two
+ * positions are discarded and the index of each line is set to the global index of its seed.
+ */
+using IntegralLineChunk = std::vector<IntegralLine>;
+
+/**
+ * A consecutive range [begin, end) of the seeds in seed set `set`. `startID` is the global index
+ * of the first seed in the range.
+ */
+struct SeedRange {
+    size_t set;
+    size_t begin;
+    size_t end;
+    size_t startID;
+};
+
+/**
+ * Split seed sets of the given sizes into ranges of at most chunkSize seeds. Ranges never span two
+ * seed sets. If chunkSize is zero a size giving about 8 chunks per thread in the thread pool is
+ * used, but at least 64 seeds per chunk.
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API std::vector<SeedRange> splitSeeds(
+    const std::vector<size_t>& setSizes, size_t chunkSize = 0);
+
+/**
+ * Append all lines of the chunks to lines, in chunk order.
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API void appendIntegralLines(
+    IntegralLineSet& lines, std::vector<IntegralLineChunk>&& chunks);
+
+/**
+ * Trace the seeds in range with tracer. Each seed is passed through `transform` to get a
+ * Tracer::SpatialVector, and each kept line through `lineOp`, which can be used to compute
+ * additional meta data. Returns an empty chunk if stop is signaled.
+ */
+template <typename Tracer, typename SeedVector, typename Transform, typename LineOp>
+IntegralLineChunk traceSeedRange(const Tracer& tracer, const std::vector<SeedVector>& seeds,
+                                 const SeedRange& range, const Transform& transform,
+                                 const LineOp& lineOp, const pool::Stop* stop = nullptr) {
+    IntegralLineChunk lines;
+    for (size_t i = range.begin; i < range.end; ++i) {
+        if (stop && *stop) return {};
+        IntegralLine line = tracer.traceFrom(transform(seeds[i]));
+        if (line.getPositions().size() > 1) {
+            line.setIndex(range.startID + (i - range.begin));
+            lineOp(line);
+            lines.push_back(std::move(line));
+        }
+    }
+    return lines;
+}
+
+/**
+ * Create one PoolProcessor job per chunk of seeds, see PoolProcessor::dispatchMany. The jobs only
+ * share the tracer and the seeds, which are captured by shared pointer, hence the jobs can outlive
+ * the processor. The results given to the done callback are in seed order and can be merged with
+ * appendIntegralLines.
+ * @see traceSeedRange for a description of transform and lineOp
+ */
+template <typename Tracer, typename SeedVector, typename Transform, typename LineOp>
+std::vector<std::function<IntegralLineChunk(pool::Stop, pool::Progress)>> integralLineTracingJobs(
+    std::shared_ptr<const Tracer> tracer,
+    std::vector<std::shared_ptr<const std::vector<SeedVector>>> seeds, Transform transform,
+    LineOp lineOp, size_t chunkSize = 0) {
+
+    std::vector<size_t> sizes;
+    for (const auto& set : seeds) sizes.push_back(set->size());
+
+    auto sharedSeeds =
+        std::make_shared<const std::vector<std::shared_ptr<const std::vector<SeedVector>>>>(
+            std::move(seeds));
+
+    std::vector<std::function<IntegralLineChunk(pool::Stop, pool::Progress)>> jobs;
+    for (const auto& range : splitSeeds(sizes, chunkSize)) {
+        jobs.push_back([tracer, sharedSeeds, range, transform, lineOp](pool::Stop stop,
+                                                                       pool::Progress progress) {
+            auto lines = traceSeedRange(*tracer, *(*sharedSeeds)[range.set], range, transform,
+                                        lineOp, &stop);
+            progress(1.0f);
+            return lines;
+        });
+    }
+    return jobs;
+}
+
+/**
+ * Trace all seeds on \p pool and append the lines to `lines` in seed order. Blocks until all seeds
+ * are traced, runs serially if \p pool is null. Use integralLineTracingJobs for tracing in the
+ * background.
+ * @see traceSeedRange for a description of transform and lineOp
+ * @see splitSeeds for a description of chunkSize
+ */
+template <typename Tracer, typename SeedVector, typename Transform, typename LineOp>
+void traceIntegralLines(ThreadPool* pool, const Tracer& tracer,
+                        const std::vector<std::shared_ptr<const std::vector<SeedVector>>>& seeds,
+                        Transform transform, LineOp lineOp, IntegralLineSet& lines,
+                        size_t chunkSize = 0) {
+    std::vector<size_t> sizes;
+    for (const auto& set : seeds) sizes.push_back(set->size());
+
+    const auto ranges = splitSeeds(sizes, chunkSize);
+    std::vector<IntegralLineChunk> chunks(ranges.size());
+    util::parallelFor(
+        pool, size_t{0}, ranges.size(),
+        [&](size_t i) {
+            chunks[i] = traceSeedRange(tracer, *seeds[ranges[i].set], ranges[i], transform, lineOp);
+        },
+        1);
+    appendIntegralLines(lines, std::move(chunks));
+}
+
+/**
+ * Overload of traceIntegralLines that uses the InviwoApplication thread pool.
+ */
+template <typename Tracer, typename SeedVector, typename Transform, typename LineOp>
+void traceIntegralLines(const Tracer& tracer,
+                        const std::vector<std::shared_ptr<const std::vector<SeedVector>>>& seeds,
+                        Transform transform, LineOp lineOp, IntegralLineSet& lines) {
+    traceIntegralLines(detail::defaultThreadPool(), tracer, seeds, std::move(transform),
+                       std::move(lineOp), lines);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -74,7 +74,7 @@ public:
     IntegralLineTracer(std::shared_ptr<const Sampler> sampler,
                        const IntegralLineProperties &properties);
 
-    Result traceFrom(const SpatialVector &pIn);
+    Result traceFrom(const SpatialVector &pIn) const;
 
     void addMetaDataSampler(const std::string &name, std::shared_ptr<const Sampler> sampler);
 
@@ -83,13 +83,15 @@ public:
 private:
     inline SpatialVector seedTransform(const SpatialVector &seed) const;
 
-    std::pair<SpatialVector, DataVector> step(const SpatialVector &oldPos, const double stepSize);
+    std::pair<SpatialVector, DataVector> step(const SpatialVector &oldPos,
+                                              const double stepSize) const;
 
-    bool addPoint(IntegralLine &line, const SpatialVector &pos);
-    bool addPoint(IntegralLine &line, const SpatialVector &pos, const DataVector &worldVelocity);
+    bool addPoint(IntegralLine &line, const SpatialVector &pos) const;
+    bool addPoint(IntegralLine &line, const SpatialVector &pos,
+                  const DataVector &worldVelocity) const;
 
     IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine &line,
-                                              bool fwd);
+                                              bool fwd) const;
 
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
@@ -120,7 +122,7 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::IntegralLineTracer(
 
 template <typename SpatialSampler, bool TimeDependent>
 typename IntegralLineTracer<SpatialSampler, TimeDependent>::Result
-IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector &pIn) {
+IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector &pIn) const {
     const SpatialVector p = seedTransform(pIn);
     Result res;
     IntegralLine &line = res.line;
@@ -198,7 +200,7 @@ template <typename SpatialSampler, bool TimeDependent>
 std::pair<typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector,
           typename IntegralLineTracer<SpatialSampler, TimeDependent>::DataVector>
 IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector &oldPos,
-                                                        const double stepSize) {
+                                                        const double stepSize) const {
     auto normalize = [](const auto v) {
         auto l = glm::length(v);
         if (l == 0) return v;
@@ -242,14 +244,13 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector &old
 
 template <typename SpatialSampler, bool TimeDependent>
 bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(IntegralLine &line,
-                                                                 const SpatialVector &pos) {
+                                                                 const SpatialVector &pos) const {
     return addPoint(line, pos, sampler_->sample(pos));
 }
 
 template <typename SpatialSampler, bool TimeDependent>
-bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(IntegralLine &line,
-                                                                 const SpatialVector &pos,
-                                                                 const DataVector &worldVelocity) {
+bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(
+    IntegralLine &line, const SpatialVector &pos, const DataVector &worldVelocity) const {
 
     if (glm::length(worldVelocity) < std::numeric_limits<double>::epsilon()) {
         return false;
@@ -271,7 +272,7 @@ bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(IntegralLine &l
 
 template <typename SpatialSampler, bool TimeDependent>
 IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(
-    size_t steps, SpatialVector pos, IntegralLine &line, bool fwd) {
+    size_t steps, SpatialVector pos, IntegralLine &line, bool fwd) const {
     if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
     for (size_t i = 0; i < steps; i++) {
         if (!sampler_->withinBounds(pos)) {
@@ -32,7 +32,7 @@
 
 #include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/processors/processortraits.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
@@ -40,15 +40,19 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
-#include <inviwo/core/util/foreach.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/algorithms/integrallinetracing.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
 namespace inviwo {
 
+/**
+ * Traces integral lines from all seeds in the background. The seeds are split into chunks that are
+ * traced in parallel on the thread pool, the resulting lines are ordered by seed index.
+ */
 template <typename Tracer>
-class IntegralLineTracerProcessor : public Processor {
+class IntegralLineTracerProcessor : public PoolProcessor {
 public:
     IntegralLineTracerProcessor();
     virtual ~IntegralLineTracerProcessor();
@@ -73,7 +77,8 @@ private:
 
 template <typename Tracer>
 IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
-    : sampler_("sampler")
+    : PoolProcessor()
+    , sampler_("sampler")
     , seeds_("seeds")
     , annotationSamplers_("annotationSamplers")
     , lines_("lines")
@@ -104,39 +109,37 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
     auto sampler = sampler_.getData();
-    auto lines =
-        std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
-
-    Tracer tracer(sampler, properties_);
+    const auto model = sampler->getModelMatrix();
+    const auto world = sampler->getWorldMatrix();
 
+    auto tracer = std::make_shared<Tracer>(sampler, properties_);
     for (auto meta : annotationSamplers_.getSourceVectorData()) {
         auto key = meta.first->getProcessor()->getIdentifier();
         key = util::stripIdentifier(key);
-        tracer.addMetaDataSampler(key, meta.second);
-    }
-
-    std::mutex mutex;
-    size_t startID = 0;
-    for (const auto &seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
-        startID += seeds->size();
+        tracer->addMetaDataSampler(key, meta.second);
     }
 
-    if (calculateCurvature_) {
-        util::curvature(*lines);
-    }
-    if (calculateTortuosity_) {
-        util::tortuosity(*lines);
+    const auto transform = [](const auto &p) { return typename Tracer::SpatialVector(p); };
+    const auto lineOp = [toWorld = dmat4(model), curvature = calculateCurvature_.get(),
+                         tortuosity = calculateTortuosity_.get()](IntegralLine &line) {
+        if (curvature) util::curvature(line, toWorld);
+        if (tortuosity) util::tortuosity(line, toWorld);
+    };
+
+    auto jobs = util::integralLineTracingJobs(std::shared_ptr<const Tracer>(std::move(tracer)),
+                                              seeds_.getVectorData(), transform, lineOp);
+    if (jobs.empty()) {
+        lines_.setData(std::make_shared<IntegralLineSet>(model, world));
+        return;
     }
 
-    lines_.setData(lines);
+    dispatchMany(std::move(jobs),
+                 [this, model, world](std::vector<util::IntegralLineChunk> chunks) {
+                     auto lines = std::make_shared<IntegralLineSet>(model, world);
+                     util::appendIntegralLines(*lines, std::move(chunks));
+                     lines_.setData(lines);
+                     newResults();
+                 });
 }
 
 using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DTracer>;
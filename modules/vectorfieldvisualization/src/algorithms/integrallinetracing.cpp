@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/vectorfieldvisualization/algorithms/integrallinetracing.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace inviwo {
+
+namespace util {
+
+std::vector<SeedRange> splitSeeds(const std::vector<size_t>& setSizes, size_t chunkSize) {
+    if (chunkSize == 0) {
+        const auto total = std::accumulate(setSizes.begin(), setSizes.end(), size_t{0});
+        const auto threads = std::max(size_t{1}, InviwoApplication::isInitialized()
+                                                     ? InviwoApplication::getPtr()->getPoolSize()
+                                                     : size_t{1});
+        chunkSize = std::max(size_t{64}, total / (8 * threads));
+    }
+
+    std::vector<SeedRange> ranges;
+    size_t startID = 0;
+    for (size_t set = 0; set < setSizes.size(); ++set) {
+        for (size_t begin = 0; begin < setSizes[set]; begin += chunkSize) {
+            const auto end = std::min(begin + chunkSize, setSizes[set]);
+            ranges.push_back({set, begin, end, startID + begin});
+        }
+        startID += setSizes[set];
+    }
+    return ranges;
+}
+
+void appendIntegralLines(IntegralLineSet& lines, std::vector<IntegralLineChunk>&& chunks) {
+    auto& vec = lines.getVector();
+    const auto count = std::accumulate(chunks.begin(), chunks.end(), vec.size(),
+                                       [](size_t sum, const auto& c) { return sum + c.size(); });
+    vec.reserve(count);
+    for (auto& chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(vec));
+        chunk.clear();
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -33,6 +33,7 @@
 #include <inviwo/core/util/imagesampler.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/algorithms/integrallinetracing.h>
 #include <inviwo/core/util/zip.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 
@@ -145,22 +146,13 @@ void PathLinesDeprecated::process() {
 
     auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
     std::vector<BasicMesh::Vertex> vertices;
-    size_t startID = 0;
-    for (const auto &seeds : seedPoints_) {
-#pragma omp parallel for
-        for (long long j = 0; j < static_cast<long long>(seeds->size()); j++) {
-            const auto &p = (*seeds)[j];
-            vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec4(vec3(P), pathLineProperties_.getStartT()));
-            auto size = line.getPositions().size();
-            if (size > 1) {
-#pragma omp critical
-                // lines->push_back(line, startID + j);
-                lines->push_back(line, lines->size());
-            };
-        }
-        startID += seeds->size();
-    }
+    util::traceIntegralLines(
+        tracer, seedPoints_.getVectorData(),
+        [m, t = pathLineProperties_.getStartT()](const vec3 &p) {
+            const vec4 P = m * vec4(p, 1.0f);
+            return dvec4(vec4(vec3(P), t));
+        },
+        [](IntegralLine &) {}, *lines);
 
     for (auto &line : *lines) {
         auto size = line.getPositions().size();
@@ -38,10 +38,10 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/imagesampler.h>
 #include <inviwo/core/util/volumesampler.h>
-#include <inviwo/core/util/foreach.h>
 
 #include <modules/vectorfieldvisualization/processors/integrallinetracerprocessor.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/algorithms/integrallinetracing.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 
 #include <bitset>
@@ -139,23 +139,11 @@ void StreamLinesDeprecated::process() {
 
     std::vector<BasicMesh::Vertex> vertices;
 
-    std::mutex mutex;
-
     if (useMutliThreading_) {
-        size_t startID = 0;
-
-        for (const auto &seeds : seedPoints_) {
-            util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-                vec4 P = m * vec4(p, 1.0f);
-                IntegralLine line = tracer.traceFrom(vec3(P));
-                auto size = line.getPositions().size();
-                if (size > 1) {
-                    std::lock_guard<std::mutex> lock(mutex);
-                    lines->push_back(line, startID + i);
-                };
-            });
-            startID += seeds->size();
-        }
+        util::traceIntegralLines(
+            tracer, seedPoints_.getVectorData(),
+            [m](const vec3 &p) { return dvec3(vec3(m * vec4(p, 1.0f))); }, [](IntegralLine &) {},
+            *lines);
     } else {
         size_t startID = 0;
         for (const auto &seeds : seedPoints_) {
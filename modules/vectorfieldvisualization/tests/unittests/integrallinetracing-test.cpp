@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/algorithms/integrallinetracing.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Traces a line along x whose length depends on the seed, seeds with a negative x give a single
+// position and are discarded.
+struct MockTracer {
+    IntegralLine traceFrom(const dvec3& seed) const {
+        IntegralLine line;
+        const auto steps = seed.x < 0.0 ? size_t{1} : 2 + static_cast<size_t>(seed.y) % 5;
+        for (size_t i = 0; i < steps; ++i) {
+            line.getPositions().push_back(seed + dvec3{static_cast<double>(i), 0.0, 0.0});
+        }
+        return line;
+    }
+};
+
+std::vector<std::shared_ptr<const std::vector<dvec3>>> makeSeeds() {
+    std::vector<std::shared_ptr<const std::vector<dvec3>>> seeds;
+    for (size_t size : {1000, 0, 37, 1}) {
+        auto set = std::make_shared<std::vector<dvec3>>();
+        for (size_t i = 0; i < size; ++i) {
+            set->emplace_back(i % 7 == 0 ? -1.0 : 1.0, static_cast<double>(i), 0.0);
+        }
+        seeds.push_back(set);
+    }
+    return seeds;
+}
+
+}  // namespace
+
+TEST(IntegralLineTracing, splitSeeds) {
+    const std::vector<size_t> sizes{10, 0, 3, 7};
+    const auto ranges = util::splitSeeds(sizes, 4);
+
+    size_t startID = 0;
+    size_t set = 0;
+    size_t begin = 0;
+    for (const auto& range : ranges) {
+        while (begin == sizes[set]) {
+            ++set;
+            begin = 0;
+        }
+        EXPECT_EQ(set, range.set);
+        EXPECT_EQ(begin, range.begin);
+        EXPECT_EQ(startID, range.startID);
+        EXPECT_LE(range.end - range.begin, size_t{4});
+        EXPECT_LE(range.end, sizes[set]);
+        startID += range.end - range.begin;
+        begin = range.end;
+    }
+    EXPECT_EQ(size_t{20}, startID);
+}
+
+TEST(IntegralLineTracing, parallelMatchesSerial) {
+    const MockTracer tracer;
+    const auto seeds = makeSeeds();
+    const auto transform = [](const dvec3& seed) { return seed; };
+    const auto lineOp = [](IntegralLine&) {};
+
+    IntegralLineSet serial(mat4(1.0f));
+    size_t id = 0;
+    for (const auto& set : seeds) {
+        for (const auto& seed : *set) {
+            auto line = tracer.traceFrom(seed);
+            if (line.getPositions().size() > 1) {
+                line.setIndex(id);
+                serial.getVector().push_back(std::move(line));
+            }
+            ++id;
+        }
+    }
+
+    ThreadPool pool(4);
+    IntegralLineSet parallel(mat4(1.0f));
+    util::traceIntegralLines(&pool, tracer, seeds, transform, lineOp, parallel, 16);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].getIndex(), parallel[i].getIndex());
+        EXPECT_EQ(serial[i].getPositions(), parallel[i].getPositions());
+    }
+}
+
+}  // namespace inviwo
@@ -59,12 +59,14 @@
 #include <inviwo/core/util/fileobserver.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/rendercontext.h>
+#include <inviwo/core/util/rammemorypool.h>
 #include <inviwo/core/util/settings/settings.h>
 #include <inviwo/core/util/systemcapabilities.h>
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/consolelogger.h>
 #include <inviwo/core/util/filelogger.h>
 #include <inviwo/core/util/timer.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 
 namespace inviwo {
@@ -141,6 +143,9 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , propertyPresetManager_{std::make_unique<PropertyPresetManager>(this)}
     , portInspectorManager_{std::make_unique<PortInspectorManager>(this)} {
 
+    trace::setThreadName("Main");
+    if (!commandLineParser_.getTraceFileName().empty()) trace::setEnabled(true);
+
     // Keep the pool at size 0 if are quiting directly to make sure that we don't have
     // unfinished results in the worker threads
     if (!commandLineParser_.getQuitApplicationAfterStartup()) {
@@ -148,6 +153,24 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         systemSettings_->poolSize_.onChange([this]() { resizePool(systemSettings_->poolSize_); });
     }
 
+    const auto updateEvaluationMode = [this]() {
+        processorNetworkEvaluator_->setEvaluationMode(
+            systemSettings_->parallelEvaluation_
+                ? ProcessorNetworkEvaluator::EvaluationMode::Parallel
+                : ProcessorNetworkEvaluator::EvaluationMode::Serial);
+    };
+    updateEvaluationMode();
+    systemSettings_->parallelEvaluation_.onChange(updateEvaluationMode);
+
+    const auto updateRAMPool = [this]() {
+        auto& pool = util::RAMMemoryPool::getInstance();
+        pool.setCapacity(systemSettings_->ramPoolSize_.get() << 20);
+        pool.setUseHugePages(systemSettings_->ramHugePages_.get());
+    };
+    updateRAMPool();
+    systemSettings_->ramPoolSize_.onChange(updateRAMPool);
+    systemSettings_->ramHugePages_.onChange(updateRAMPool);
+
     resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get());
     systemSettings_->enableResourceManager_.onChange(
         [this]() { resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get()); });
@@ -207,7 +230,23 @@ InviwoApplication::InviwoApplication() : InviwoApplication(0, nullptr, "Inviwo")
 InviwoApplication::InviwoApplication(std::string displayName)
     : InviwoApplication(0, nullptr, displayName) {}
 
-InviwoApplication::~InviwoApplication() { resizePool(0); }
+InviwoApplication::~InviwoApplication() {
+    resizePool(0);
+
+    auto traceFile = commandLineParser_.getTraceFileName();
+    if (!traceFile.empty()) {
+        if (!filesystem::isAbsolutePath(traceFile)) {
+            auto outputDir = commandLineParser_.getOutputPath();
+            traceFile = (outputDir.empty() ? filesystem::getWorkingDirectory() : outputDir) + "/" +
+                        traceFile;
+        }
+        try {
+            trace::saveChromeTrace(traceFile);
+        } catch (const Exception& e) {
+            LogError(e.getMessage());
+        }
+    }
+}
 
 void InviwoApplication::registerModules(
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> moduleFactories) {
@@ -374,6 +413,7 @@ size_t InviwoApplication::processFront() {
                 task = std::move(queue_.tasks.front());
                 queue_.tasks.pop();
             }
+            IVW_TRACE_SCOPE("dispatch", "Front task");
             task();
         }
     }
@@ -36,10 +36,13 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/taskgroup.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/network/processornetwork.h>
 
 #include <string>
 #include <functional>
+#include <chrono>
 
 namespace inviwo {
 
@@ -85,7 +88,10 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
         if (getModuleByIdentifier(obj->name)) continue;  // already loaded
         if (!checkDependencies(*obj)) continue;
         try {
+            IVW_TRACE_SCOPE_DETAIL("modules", "Create module", obj->name);
+            const auto start = std::chrono::steady_clock::now();
             registerModule(obj->create(app_));
+            getTiming(obj->name).create = std::chrono::steady_clock::now() - start;
         } catch (const ModuleInitException& e) {
             auto dereg = deregisterDependetModules(e.getModulesToDeregister());
             auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
@@ -100,13 +106,47 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
     for (auto& module : modules_) {
         for (auto& elem : module->getCapabilities()) {
             elem->retrieveStaticInfo();
-            elem->printInfo();
         }
     }
 
+    // Printing is only informative, postpone it until the application is up and running
+    app_->dispatchFrontAndForget([this]() {
+        for (auto& module : modules_) {
+            for (auto& elem : module->getCapabilities()) {
+                elem->printInfo();
+            }
+        }
+        printTimings();
+    });
+
     onModulesDidRegister_.invoke();
 }
 
+const std::vector<ModuleManager::Timing>& ModuleManager::getTimings() const { return timings_; }
+
+ModuleManager::Timing& ModuleManager::getTiming(const std::string& module) {
+    auto it = util::find_if(timings_, [&](const Timing& t) { return iCaseCmp(t.module, module); });
+    if (it != timings_.end()) return *it;
+    return timings_.emplace_back(Timing{module, {}, {}});
+}
+
+void ModuleManager::printTimings() const {
+    if (timings_.empty()) return;
+
+    auto sorted = timings_;
+    std::sort(sorted.begin(), sorted.end(), [](const Timing& a, const Timing& b) {
+        return a.library + a.create > b.library + b.create;
+    });
+    const auto ms = [](std::chrono::nanoseconds time) { return durationToString(time, false); };
+    std::stringstream message;
+    message << "Module startup times (library / module):";
+    for (const auto& timing : sorted) {
+        message << "\n  " << timing.module << ": " << ms(timing.library + timing.create) << " ("
+                << ms(timing.library) << " / " << ms(timing.create) << ")";
+    }
+    LogInfo(message.str());
+}
+
 std::function<bool(const std::string&)> ModuleManager::getEnabledFilter() {
     // Load enabled modules if file "application_name-enabled-modules.txt" exists,
     // otherwise load all modules
@@ -202,50 +242,82 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isLoaded = [loaded = util::getLoadedLibraries()](const auto& path) {
         return util::contains_if(loaded, [&](const auto& lib) { return iCaseCmp(path, lib); });
     };
-    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
-    for (const auto& filePath : libraryFiles) {
-        const auto tmpPath = [&]() -> std::string {
-            if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
-                auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
-                if (isLoaded(filePath)) {
-                    // Already loaded modules are loaded from the application dir
-                    dstPath = filePath;
-                    protected_.insert(util::stripModuleFileNameDecoration(filePath));
-                } else if (filesystem::fileModificationTime(filePath) !=
-                           filesystem::fileModificationTime(dstPath)) {
-                    // Load a copy of the file to make sure that we can overwrite the file.
-                    filesystem::copyFile(filePath, dstPath);
+    const bool useTmpDir =
+        isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction();
+
+    // Copy and load the libraries, and look up the module creation functions concurrently. The
+    // results are then handled in the order of the files.
+    struct LoadedLibrary {
+        std::string path;
+        bool alreadyLoaded = false;
+        std::unique_ptr<SharedLibrary> library;
+        f_getModule moduleFunc = nullptr;
+        std::string error;
+        std::chrono::nanoseconds time{0};
+    };
+    const std::vector<std::string> files(libraryFiles.begin(), libraryFiles.end());
+    std::vector<LoadedLibrary> loaded(files.size());
+    util::parallelFor(
+        &app_->getThreadPool(), size_t{0}, files.size(),
+        [&](size_t i) {
+            const auto& filePath = files[i];
+            auto& result = loaded[i];
+            const auto fileName = filesystem::getFileNameWithExtension(filePath);
+            IVW_TRACE_SCOPE_DETAIL("modules", "Load library", fileName);
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                result.path = filePath;
+                if (useTmpDir) {
+                    result.path = tmpDir + "/" + fileName;
+                    if (isLoaded(filePath)) {
+                        // Already loaded modules are loaded from the application dir
+                        result.path = filePath;
+                        result.alreadyLoaded = true;
+                    } else if (filesystem::fileModificationTime(filePath) !=
+                               filesystem::fileModificationTime(result.path)) {
+                        // Load a copy of the file to make sure that we can overwrite the file.
+                        filesystem::copyFile(filePath, result.path);
+                    }
                 }
-                return dstPath;
-            } else {
-                return filePath;
+                // Load library. Will throw exception if failed to load
+                result.library = std::make_unique<SharedLibrary>(result.path);
+                result.moduleFunc = result.library->findSymbolTyped<f_getModule>("createModule");
+            } catch (const Exception& e) {
+                result.error = e.getMessage();
             }
-        }();
+            result.time = std::chrono::steady_clock::now() - start;
+        },
+        1);
 
-        try {
-            // Load library. Will throw exception if failed to load
-            auto sharedLib = std::make_unique<SharedLibrary>(tmpPath);
-            // Only consider libraries with Inviwo module creation function
-            if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
-                // Add module factory object
-                modules.emplace_back(moduleFunc());
-                auto moduleName = toLower(modules.back()->name);
-                if (modules.back()->protectedModule == ProtectedModule::on) {
-                    protected_.insert(modules.back()->name);
-                }
-                sharedLibraries_.emplace_back(std::move(sharedLib));
-                if (isRuntimeModuleReloadingEnabled()) {
-                    libraryObserver_.observe(filePath);
-                }
-            } else {
-                LogInfo(
-                    "Could not find 'createModule' function needed for creating the module in "
-                    << tmpPath
-                    << ". Make sure that you have compiled the library and exported the function.");
-            }
-        } catch (const Exception& e) {
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& filePath = files[i];
+        auto& result = loaded[i];
+        if (result.alreadyLoaded) {
+            protected_.insert(util::stripModuleFileNameDecoration(filePath));
+        }
+        if (!result.library) {
             // Library dependency is probably missing. We silently skip this library.
-            LogInfo("Could not load library: " << filePath << " " << e.getMessage());
+            LogInfo("Could not load library: " << filePath << " " << result.error);
+            continue;
+        }
+        // Only consider libraries with Inviwo module creation function
+        if (!result.moduleFunc) {
+            LogInfo("Could not find 'createModule' function needed for creating the module in "
+                    << result.path
+                    << ". Make sure that you have compiled the library and exported the function.");
+            continue;
+        }
+
+        // Add module factory object
+        modules.emplace_back(result.moduleFunc());
+        getTiming(modules.back()->name).library = result.time;
+        if (modules.back()->protectedModule == ProtectedModule::on) {
+            protected_.insert(modules.back()->name);
+        }
+        sharedLibraries_.emplace_back(std::move(result.library));
+        if (isRuntimeModuleReloadingEnabled()) {
+            libraryObserver_.observe(filePath);
         }
     }
 
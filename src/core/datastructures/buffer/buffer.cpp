@@ -38,6 +38,7 @@ namespace inviwo {
 BufferBase::BufferBase(size_t defaultSize, const DataFormatBase* defaultFormat, BufferUsage usage,
                        BufferTarget target)
     : Data<BufferBase, BufferRepresentation>()
+    , HistogramSupplier()
     , defaultSize_(defaultSize)
     , usage_(usage)
     , target_(target)
@@ -84,4 +85,11 @@ const DataFormatBase* BufferBase::getDataFormat() const {
     return defaultDataFormat_;
 }
 
+std::shared_ptr<HistogramCalculationState> BufferBase::calculateHistograms(size_t bins) const {
+    getRepresentation<BufferRAM>();  // make sure lastValidRepresentation_ is BufferRAM
+    auto bufferRam = std::static_pointer_cast<BufferRAM>(lastValidRepresentation_);
+    invalidateHistograms();
+    return HistogramSupplier::startCalculation(bufferRam, bins);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/histogramcalculation.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+dvec2 valueRange(const T* data, size_t size) {
+    constexpr size_t chunkSize = size_t{1} << 16;
+    const size_t chunks = (size + chunkSize - 1) / chunkSize;
+
+    util::DataSummary<T> summary;
+    std::mutex mutex;
+    util::parallelFor(size_t{0}, chunks, [&](size_t chunk) {
+        const auto first = chunk * chunkSize;
+        const auto res = util::summarize(data + first, std::min(chunkSize, size - first));
+        std::scoped_lock lock{mutex};
+        summary.merge(res);
+    });
+
+    if (summary.count == 0) return dvec2{0.0, 1.0};
+
+    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    for (size_t c = 0; c < extent; ++c) {
+        range.x = std::min(range.x, util::glmcomp(summary.min, c));
+        range.y = std::max(range.y, util::glmcomp(summary.max, c));
+    }
+    return range;
+}
+
+}  // namespace
+
+std::optional<HistogramContainer> util::calculateHistograms(const VolumeRAM& volume,
+                                                            dvec2 dataRange, size_t bins,
+                                                            size_t stride,
+                                                            const std::atomic<bool>* stop) {
+    return volume.dispatch<std::optional<HistogramContainer>>([&](auto vr) {
+        return util::calculateHistograms(vr->getDataTyped(), glm::compMul(vr->getDimensions()),
+                                         dataRange, bins, stride, stop);
+    });
+}
+
+std::optional<HistogramContainer> util::calculateHistograms(const LayerRAM& layer,
+                                                            dvec2 dataRange, size_t bins,
+                                                            size_t stride,
+                                                            const std::atomic<bool>* stop) {
+    return layer.dispatch<std::optional<HistogramContainer>>([&](auto lr) {
+        return util::calculateHistograms(lr->getDataTyped(), glm::compMul(lr->getDimensions()),
+                                         dataRange, bins, stride, stop);
+    });
+}
+
+std::optional<HistogramContainer> util::calculateHistograms(const BufferRAM& buffer,
+                                                            dvec2 dataRange, size_t bins,
+                                                            size_t stride,
+                                                            const std::atomic<bool>* stop) {
+    return buffer.dispatch<std::optional<HistogramContainer>>([&](auto br) {
+        return util::calculateHistograms(br->getDataTyped(), br->getSize(), dataRange, bins,
+                                         stride, stop);
+    });
+}
+
+dvec2 util::dataValueRange(const LayerRAM& layer) {
+    return layer.dispatch<dvec2>([](auto lr) {
+        return valueRange(lr->getDataTyped(), glm::compMul(lr->getDimensions()));
+    });
+}
+
+dvec2 util::dataValueRange(const BufferRAM& buffer) {
+    return buffer.dispatch<dvec2>(
+        [](auto br) { return valueRange(br->getDataTyped(), br->getSize()); });
+}
+
+size_t util::histogramSubsampleStride(size_t size, size_t samples) {
+    return std::max(size_t{1}, size / std::max(size_t{1}, samples));
+}
+
+}  // namespace inviwo
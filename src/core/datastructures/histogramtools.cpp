@@ -28,7 +28,9 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/histogramtools.h>
-#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/histogramcalculation.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 namespace inviwo {
@@ -41,34 +43,124 @@ void HistogramCalculationState::whenDone(std::function<void(const HistogramConta
     }
 }
 
-HistogramSupplier::HistogramSupplier() : histograms_{std::make_shared<HistogramContainer>()} {}
+void HistogramCalculationState::whenUpdated(
+    std::function<void(const HistogramContainer&)> callback) {
+    if (auto container = container_.lock(); container && done) {
+        callback(*container);
+    } else {
+        callbackHandles_.push_back(updateCallbacks_.add(callback));
+    }
+}
+
+HistogramSupplier::HistogramSupplier() = default;
 
 HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
-    : histograms_{std::make_shared<HistogramContainer>(*rhs.histograms_)} {}
+    : histograms_{rhs.histograms_ ? std::make_shared<HistogramContainer>(*rhs.histograms_)
+                                  : nullptr} {}
 
 HistogramSupplier& HistogramSupplier::operator=(const HistogramSupplier& that) {
     if (this != &that) {
-        histograms_ = std::make_shared<HistogramContainer>(*that.histograms_);
+        histograms_ = that.histograms_ ? std::make_shared<HistogramContainer>(*that.histograms_)
+                                       : nullptr;
     }
     return *this;
 }
 
+const HistogramContainer& HistogramSupplier::getHistograms() const {
+    static const HistogramContainer empty{};
+    return histograms_ ? *histograms_ : empty;
+}
+
+HistogramContainer& HistogramSupplier::getHistograms() {
+    if (!histograms_) histograms_ = std::make_shared<HistogramContainer>();
+    return *histograms_;
+}
+
 std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const {
-    if (!calculation_ || calculation_->getBins() != bins ||
+    const auto size = glm::compMul(volumeRam->getDimensions());
+    return startCalculation(size, dataRange, bins,
+                            [volumeRam, dataRange, bins](size_t stride, const auto& stop) {
+                                return util::calculateHistograms(*volumeRam, dataRange, bins,
+                                                                 stride, &stop);
+                            });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    std::shared_ptr<const LayerRAM> layerRam, dvec2 dataRange, size_t bins) const {
+    const auto size = glm::compMul(layerRam->getDimensions());
+    return startCalculation(size, dataRange, bins,
+                            [layerRam, dataRange, bins](size_t stride, const auto& stop) {
+                                return util::calculateHistograms(*layerRam, dataRange, bins,
+                                                                 stride, &stop);
+                            });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    std::shared_ptr<const BufferRAM> bufferRam, dvec2 dataRange, size_t bins) const {
+    const auto size = bufferRam->getSize();
+    return startCalculation(size, dataRange, bins,
+                            [bufferRam, dataRange, bins](size_t stride, const auto& stop) {
+                                return util::calculateHistograms(*bufferRam, dataRange, bins,
+                                                                 stride, &stop);
+                            });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    std::shared_ptr<const LayerRAM> layerRam, size_t bins) const {
+    const auto size = glm::compMul(layerRam->getDimensions());
+    // The range is computed once, by the first call, and reused by the refined calculation
+    return startCalculation(size, dvec2{0.0}, bins,
+                            [layerRam, bins, range = std::optional<dvec2>{}](
+                                size_t stride, const auto& stop) mutable {
+                                if (!range) range = util::dataValueRange(*layerRam);
+                                if (stop) return std::optional<HistogramContainer>{};
+                                return util::calculateHistograms(*layerRam, *range, bins, stride,
+                                                                 &stop);
+                            });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    std::shared_ptr<const BufferRAM> bufferRam, size_t bins) const {
+    const auto size = bufferRam->getSize();
+    return startCalculation(size, dvec2{0.0}, bins,
+                            [bufferRam, bins, range = std::optional<dvec2>{}](
+                                size_t stride, const auto& stop) mutable {
+                                if (!range) range = util::dataValueRange(*bufferRam);
+                                if (stop) return std::optional<HistogramContainer>{};
+                                return util::calculateHistograms(*bufferRam, *range, bins, stride,
+                                                                 &stop);
+                            });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    size_t size, dvec2 dataRange, size_t bins, Calculation calculation) const {
+    if (!calculation_ || calculation_->isCancelled() || calculation_->getBins() != bins ||
         calculation_->getDataRange() != dataRange) {
 
+        if (calculation_) calculation_->cancel();
+
         histograms_ = std::make_shared<HistogramContainer>();
         calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
 
         dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
+                      stop = calculation_->stop_, size, calculation = std::move(calculation)]() {
+            // A quick approximation from a subsample of the data, refined below
+            if (const auto stride = util::histogramSubsampleStride(size); stride > 1) {
+                auto coarse = calculation(stride, *stop);
+                if (!coarse || *stop) return;
+                dispatchFrontAndForget([hist = std::move(*coarse), weakState, stop]() {
+                    if (*stop) return;
+                    if (auto s = weakState.lock()) {
+                        update(s, hist);
+                    }
+                });
+            }
+
+            auto histograms = calculation(1, *stop);
+            if (!histograms || *stop) return;
+            dispatchFrontAndForget([hist = std::move(*histograms), weakState, stop]() {
+                if (*stop) return;
                 if (auto s = weakState.lock()) {
                     done(s, std::move(hist));
                 }
@@ -78,8 +170,25 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     return calculation_;
 }
 
+void HistogramSupplier::invalidateHistograms() const {
+    if (calculation_) {
+        calculation_->cancel();
+        calculation_.reset();
+    }
+    histograms_.reset();
+}
+
+void HistogramSupplier::update(std::shared_ptr<HistogramCalculationState> state,
+                               const HistogramContainer& histograms) {
+    // The approximation is only passed on to the callbacks, the container only ever holds the
+    // exact histograms
+    if (state->done) return;
+    state->updateCallbacks_.invoke(histograms);
+}
+
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
                              HistogramContainer histograms) {
+    state->updateCallbacks_.invoke(histograms);
     state->callbacks_.invoke(histograms);
     state->done = true;
     if (auto container = state->container_.lock()) {
@@ -42,6 +42,7 @@ Layer::Layer(size2_t defaultDimensions, const DataFormatBase* defaultFormat, Lay
              const Wrapping2D& wrapping)
     : Data<Layer, LayerRepresentation>{}
     , StructuredGridEntity<2>{}
+    , HistogramSupplier{}
     , defaultLayerType_{type}
     , defaultDimensions_{defaultDimensions}
     , defaultDataFormat_{defaultFormat}
@@ -52,6 +53,7 @@ Layer::Layer(size2_t defaultDimensions, const DataFormatBase* defaultFormat, Lay
 Layer::Layer(std::shared_ptr<LayerRepresentation> in)
     : Data<Layer, LayerRepresentation>{}
     , StructuredGridEntity<2>{}
+    , HistogramSupplier{}
     , defaultLayerType_{in->getLayerType()}
     , defaultDimensions_{in->getDimensions()}
     , defaultDataFormat_{in->getDataFormat()}
@@ -187,6 +189,13 @@ std::unique_ptr<std::vector<unsigned char>> Layer::getAsCodedBuffer(
     return std::unique_ptr<std::vector<unsigned char>>();
 }
 
+std::shared_ptr<HistogramCalculationState> Layer::calculateHistograms(size_t bins) const {
+    getRepresentation<LayerRAM>();  // make sure lastValidRepresentation_ is LayerRAM
+    auto layerRam = std::static_pointer_cast<LayerRAM>(lastValidRepresentation_);
+    invalidateHistograms();
+    return HistogramSupplier::startCalculation(layerRam, bins);
+}
+
 template class IVW_CORE_TMPL_INST DataReaderType<Layer>;
 template class IVW_CORE_TMPL_INST DataWriterType<Layer>;
 
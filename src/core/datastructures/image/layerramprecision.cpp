@@ -42,6 +42,16 @@ struct LayerRAMCreationDispatcher {
         return std::make_shared<LayerRAMPrecision<F>>(dimensions, type, swizzleMask, interpolation,
                                                       wrapping);
     }
+
+    template <typename Result, typename T>
+    std::shared_ptr<LayerRAM> operator()(const size2_t& dimensions, util::DataInitialization init,
+                                         LayerType type, const SwizzleMask& swizzleMask,
+                                         InterpolationType interpolation,
+                                         const Wrapping2D& wrapping) {
+        using F = typename T::type;
+        return std::make_shared<LayerRAMPrecision<F>>(dimensions, init, type, swizzleMask,
+                                                      interpolation, wrapping);
+    }
 };
 
 std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType type,
@@ -54,4 +64,15 @@ std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType ty
         format->getId(), disp, dimensions, type, swizzleMask, interpolation, wrapping);
 }
 
+std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType type,
+                                         const DataFormatBase* format,
+                                         util::DataInitialization init,
+                                         const SwizzleMask& swizzleMask,
+                                         InterpolationType interpolation,
+                                         const Wrapping2D& wrapping) {
+    LayerRAMCreationDispatcher disp;
+    return dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
+        format->getId(), disp, dimensions, init, type, swizzleMask, interpolation, wrapping);
+}
+
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/io/rawvolumeramloader.h>
 
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/memorymappedfile.h>
 
 namespace inviwo {
 
@@ -41,15 +42,30 @@ RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAML
 std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
-    const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
-    auto data = std::make_unique<char[]>(size);
-    util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
-                              src.getDataFormat()->getSize(), data.get());
+    const auto format = src.getDataFormat();
+    const auto size = glm::compMul(src.getDimensions()) * format->getSize();
+
+    // Data in native byte order at an aligned offset can be used directly from a memory mapping
+    const bool needsSwap = !littleEndian_ && format->getSize() > 1;
+    const bool aligned = offset_ % (format->getSize() / format->getComponents()) == 0;
+    if (!needsSwap && aligned && size > 0) {
+        try {
+            auto file = std::make_shared<util::MemoryMappedFile>(rawFile_, offset_, size);
+            auto data = file->data();
+            return createVolumeRAM(src.getDimensions(), format, data, std::move(file),
+                                   src.getSwizzleMask(), src.getInterpolation(),
+                                   src.getWrapping());
+        } catch (const FileException& e) {
+            LogWarn("Could not memory map \"" << rawFile_ << "\", reading it instead: "
+                                               << e.getMessage());
+        }
+    }
 
     auto volumeRAM =
-        createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
-                        src.getInterpolation(), src.getWrapping());
-    data.release();
+        createVolumeRAM(src.getDimensions(), format, util::DataInitialization::Uninitialized,
+                        src.getSwizzleMask(), src.getInterpolation(), src.getWrapping());
+    util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_, format->getSize(),
+                              static_cast<char*>(volumeRAM->getData()));
 
     return volumeRAM;
 }
@@ -0,0 +1,286 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binarydocument.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/serializeconstants.h>
+
+#include <algorithm>
+#include <iterator>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+using Node = BinaryDocument::Node;
+
+void writeVarint(std::string& out, size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+class BinaryWriter : public TiXmlVisitor {
+public:
+    virtual bool VisitEnter(const TiXmlElement& element,
+                            const TiXmlAttribute* firstAttribute) override {
+        nodes_.push_back(static_cast<char>(Node::Element));
+        writeVarint(nodes_, intern(element.ValueStr()));
+
+        size_t count = 0;
+        for (auto attr = firstAttribute; attr; attr = attr->Next()) ++count;
+        writeVarint(nodes_, count);
+        for (auto attr = firstAttribute; attr; attr = attr->Next()) {
+            writeVarint(nodes_, intern(attr->NameTStr()));
+            writeVarint(nodes_, intern(attr->ValueStr()));
+        }
+        return true;
+    }
+    virtual bool VisitExit(const TiXmlElement&) override {
+        nodes_.push_back(static_cast<char>(Node::End));
+        return true;
+    }
+    virtual bool Visit(const TiXmlText& text) override {
+        nodes_.push_back(static_cast<char>(text.CDATA() ? Node::CData : Node::Text));
+        writeVarint(nodes_, intern(text.ValueStr()));
+        return true;
+    }
+    virtual bool Visit(const TiXmlComment& comment) override {
+        nodes_.push_back(static_cast<char>(Node::Comment));
+        writeVarint(nodes_, intern(comment.ValueStr()));
+        return true;
+    }
+
+    void write(std::ostream& stream) {
+        nodes_.push_back(static_cast<char>(Node::End));
+
+        std::string header(std::begin(BinaryDocument::magic), std::end(BinaryDocument::magic));
+        header.push_back(static_cast<char>(BinaryDocument::version));
+        writeVarint(header, strings_.size());
+        for (const auto* str : strings_) {
+            writeVarint(header, str->size());
+            header.append(*str);
+        }
+        stream.write(header.data(), header.size());
+        stream.write(nodes_.data(), nodes_.size());
+    }
+
+private:
+    size_t intern(const std::string& str) {
+        auto [it, inserted] = index_.try_emplace(str, strings_.size());
+        if (inserted) strings_.push_back(&it->first);
+        return it->second;
+    }
+
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<const std::string*> strings_;
+    std::string nodes_;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const std::string& data) : data_{data}, pos_{0} {}
+
+    void read(TxDocument& doc) {
+        if (data_.size() < sizeof(BinaryDocument::magic) + 1 ||
+            !std::equal(std::begin(BinaryDocument::magic), std::end(BinaryDocument::magic),
+                        data_.begin())) {
+            throw SerializationException("Not a binary document", IVW_CONTEXT);
+        }
+        pos_ = sizeof(BinaryDocument::magic);
+        const auto docVersion = static_cast<unsigned char>(data_[pos_++]);
+        if (docVersion != BinaryDocument::version) {
+            throw SerializationException(
+                "Unsupported binary document version: " + std::to_string(docVersion), IVW_CONTEXT);
+        }
+
+        const auto count = readVarint();
+        strings_.reserve(std::min(count, data_.size()));
+        for (size_t i = 0; i < count; ++i) {
+            const auto size = readVarint();
+            if (size > data_.size() - pos_) error();
+            strings_.emplace_back(data_, pos_, size);
+            pos_ += size;
+        }
+
+        auto decl = std::make_unique<TxDeclaration>(SerializeConstants::XmlVersion, "", "");
+        doc.LinkEndChild(decl.get());
+
+        for (auto node = readNode(); node != Node::End; node = readNode()) {
+            switch (node) {
+                case Node::Element: {
+                    auto root = std::make_unique<TxElement>(string());
+                    doc.LinkEndChild(root.get());
+                    readElement(*root);
+                    break;
+                }
+                case Node::Comment: {
+                    auto comment = std::make_unique<TxComment>(string());
+                    doc.LinkEndChild(comment.get());
+                    break;
+                }
+                case Node::Text:
+                case Node::CData:
+                    string();  // Text outside of the root element is dropped, as by TinyXML
+                    break;
+                default:
+                    error();
+            }
+        }
+    }
+
+private:
+    // Builds the children directly in TinyXML, the TiCPP wrappers are created on access
+    class ElementAccess : public TiXmlVisitor {
+    public:
+        virtual bool VisitEnter(const TiXmlElement& element, const TiXmlAttribute*) override {
+            element_ = const_cast<TiXmlElement*>(&element);
+            return false;
+        }
+        TiXmlElement* element_ = nullptr;
+    };
+
+    void readElement(TxElement& root) {
+        ElementAccess access;
+        root.Accept(&access);
+
+        std::vector<TiXmlElement*> stack{access.element_};
+        readAttributes(*stack.back());
+        while (!stack.empty()) {
+            auto parent = stack.back();
+            const auto node = readNode();
+            switch (node) {
+                case Node::Element: {
+                    auto element = new TiXmlElement(string());
+                    parent->LinkEndChild(element);
+                    readAttributes(*element);
+                    stack.push_back(element);
+                    break;
+                }
+                case Node::End:
+                    stack.pop_back();
+                    break;
+                case Node::Text:
+                case Node::CData: {
+                    auto text = new TiXmlText(string());
+                    text->SetCDATA(node == Node::CData);
+                    parent->LinkEndChild(text);
+                    break;
+                }
+                case Node::Comment: {
+                    auto comment = new TiXmlComment();
+                    comment->SetValue(string());
+                    parent->LinkEndChild(comment);
+                    break;
+                }
+                default:
+                    error();
+            }
+        }
+    }
+
+    void readAttributes(TiXmlElement& element) {
+        const auto count = readVarint();
+        for (size_t i = 0; i < count; ++i) {
+            const auto& name = string();
+            element.SetAttribute(name, string());
+        }
+    }
+
+    Node readNode() {
+        if (pos_ >= data_.size()) error();
+        const auto node = static_cast<Node>(data_[pos_++]);
+        if (node > Node::Comment) error();
+        return node;
+    }
+
+    size_t readVarint() {
+        size_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (pos_ >= data_.size()) error();
+            const auto byte = static_cast<unsigned char>(data_[pos_++]);
+            value |= static_cast<size_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        error();
+        return value;
+    }
+
+    const std::string& string() {
+        const auto index = readVarint();
+        if (index >= strings_.size()) error();
+        return strings_[index];
+    }
+
+    [[noreturn]] void error() const {
+        throw SerializationException("Invalid binary document, unexpected data at byte " +
+                                         std::to_string(pos_),
+                                     IVW_CONTEXT);
+    }
+
+    const std::string& data_;
+    size_t pos_;
+    std::vector<std::string> strings_;
+};
+
+}  // namespace
+
+bool isBinaryDocument(std::istream& stream) {
+    return stream.peek() == static_cast<unsigned char>(BinaryDocument::magic[0]);
+}
+
+void writeBinaryDocument(const TxDocument& doc, std::ostream& stream) {
+    BinaryWriter writer;
+    doc.Accept(&writer);
+    writer.write(stream);
+    if (!stream) {
+        throw SerializationException("Could not write binary document",
+                                     IVW_CONTEXT_CUSTOM("writeBinaryDocument"));
+    }
+}
+
+void readBinaryDocument(std::istream& stream, TxDocument& doc) {
+    const std::string data{std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>()};
+    BinaryReader reader(data);
+    reader.read(doc);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/io/serialization/deserializer.h>
 #include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/io/serialization/binarydocument.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processorfactory.h>
@@ -37,6 +38,7 @@
 #include <inviwo/core/ports/portfactory.h>
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stringconversion.h>
 
 namespace inviwo {
@@ -44,7 +46,12 @@ namespace inviwo {
 Deserializer::Deserializer(std::string fileName, bool allowReference)
     : SerializeBase(fileName, allowReference) {
     try {
-        doc_.LoadFile();
+        auto stream = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+        if (stream && util::isBinaryDocument(stream)) {
+            util::readBinaryDocument(stream, doc_);
+        } else {
+            doc_.LoadFile();
+        }
         rootElement_ = doc_.FirstChildElement();
         storeReferences(rootElement_);
         rootElement_->GetAttribute(SerializeConstants::VersionAttribute, &inviwoWorkspaceVersion_,
@@ -34,16 +34,30 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
-#include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/taskgroup.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <atomic>
+#include <unordered_set>
+#include <exception>
 
 namespace inviwo {
 
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , order_()
+    , processorsSorted_()
+    , sortDirty_(true)
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , mode_(EvaluationMode::Serial) {
 
+    processorNetwork_->forEachProcessor([&](Processor* p) { order_.addNode(p); });
+    processorNetwork_->forEachConnection([&](const PortConnection& connection) {
+        order_.addEdge(connection.getOutport()->getProcessor(),
+                       connection.getInport()->getProcessor());
+    });
     processorNetwork_->addObserver(this);
 }
 
@@ -99,88 +113,270 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     notifyObserversProcessorNetworkEvaluationBegin();
 
-    IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    IVW_TRACE_SCOPE("network", "Evaluate");
+
+    updateProcessorOrder();
+
+    auto app = processorNetwork_->getApplication();
+    if (mode_ == EvaluationMode::Parallel && app && app->getPoolSize() > 0 &&
+        util::any_of(processorsSorted_, [this](Processor* p) { return isConcurrent(p); })) {
+        evaluateParallel(app->getThreadPool());
+    } else {
+        evaluateSerial();
+    }
+
+    notifyObserversProcessorNetworkEvaluationEnd();
+}
+
+void ProcessorNetworkEvaluator::updateProcessorOrder() {
+    if (!sortDirty_) return;
+    sortDirty_ = false;
+
+    // Find all processors that a sink depends on through active connections
+    std::unordered_set<Processor*> needed;
+    order_.forEach([&](Processor* p) {
+        if (!p->isSink()) return;
+        util::traverseNetwork<util::TraversalDirection::Up, util::VisitPattern::Pre>(
+            needed, p, [](Processor*) {},
+            [](Processor* p, Inport* from, Outport* to) {
+                return p->isConnectionActive(from, to);
+            });
+    });
 
+    processorsSorted_.clear();
+    processorsSorted_.reserve(needed.size());
+    order_.forEach([&](Processor* p) {
+        if (needed.count(p) != 0) processorsSorted_.push_back(p);
+    });
+}
+
+void ProcessorNetworkEvaluator::evaluateSerial() {
     for (auto processor : processorsSorted_) {
-        if (!processor->isValid()) {
-            if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
-                    }
+        if (prepare(processor)) {
+            process(processor);
+            finish(processor);
+        }
+    }
+}
 
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
-                }
+void ProcessorNetworkEvaluator::evaluateParallel(ThreadPool& pool) {
+    const auto size = processorsSorted_.size();
 
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
+    // Build the dependency graph between the sorted processors
+    std::unordered_map<Processor*, size_t> order;
+    for (size_t i = 0; i < size; ++i) order[processorsSorted_[i]] = i;
+
+    std::vector<std::vector<size_t>> successors(size);
+    std::vector<size_t> blockers(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        auto processor = processorsSorted_[i];
+        for (auto inport : processor->getInports()) {
+            for (auto outport : inport->getConnectedOutports()) {
+                if (!processor->isConnectionActive(inport, outport)) continue;
+                auto it = order.find(outport->getProcessor());
+                if (it == order.end()) continue;
+                successors[it->second].push_back(i);
+                ++blockers[i];
+            }
+        }
+    }
+
+    std::vector<size_t> wave;
+    for (size_t i = 0; i < size; ++i) {
+        if (blockers[i] == 0) wave.push_back(i);
+    }
+
+    std::vector<Processor*> prepared;
+    std::vector<Processor*> concurrent;
+    std::vector<std::exception_ptr> errors;
+    while (!wave.empty()) {
+        // Keep the topological order within the wave to get deterministic notifications
+        std::sort(wave.begin(), wave.end());
+
+        prepared.clear();
+        concurrent.clear();
+        for (auto i : wave) {
+            auto processor = processorsSorted_[i];
+            if (prepare(processor)) {
+                prepared.push_back(processor);
+                if (isConcurrent(processor)) concurrent.push_back(processor);
+            }
+        }
+
+        // Process the thread safe processors concurrently. The main thread takes part in the work
+        // so that we never wait for processors that have not been started yet, even if all the
+        // workers are busy with other jobs.
+        if (concurrent.size() > 1) {
+            errors.assign(concurrent.size(), nullptr);
+            std::atomic<size_t> next{0};
+            const auto work = [&]() {
+                for (auto i = next++; i < concurrent.size(); i = next++) {
+                    try {
+                        IVW_TRACE_SCOPE_DETAIL("processor", "Process",
+                                               concurrent[i]->getIdentifier());
+                        concurrent[i]->process();
+                    } catch (...) {
+                        errors[i] = std::current_exception();
                     }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
                 }
+            };
 
-                processor->notifyObserversAboutToProcess(processor);
+            // Helpers that start after all processors have been taken just drop out. Hence the
+            // helping wait below only runs those on the main thread, and only waits for helpers
+            // that are actually processing.
+            util::TaskGroup group{pool};
+            const auto helpers = std::min(concurrent.size() - 1, pool.getSize());
+            for (size_t i = 0; i < helpers; ++i) {
+                group.run([&work, &next, &concurrent]() {
+                    if (next >= concurrent.size()) return;
+                    work();
+                });
+            }
+            work();
+            group.wait();
 
+            for (size_t i = 0; i < concurrent.size(); ++i) {
+                if (!errors[i]) continue;
                 try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
+                    std::rethrow_exception(errors[i]);
                 } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+                    exceptionHandler_(concurrent[i], EvaluationType::Process, IVW_CONTEXT);
                 }
+            }
+        } else {
+            concurrent.clear();
+        }
 
-                // Set processor as valid only if we still are ready.
-                // Callbacks might have made our inports invalid, if so abort
-                // the evaluation by not setting the processor valid.
-                if (processor->isReady()) processor->setValid();
-
-                processor->notifyObserversFinishedProcess(processor);
+        for (auto processor : prepared) {
+            if (!util::contains(concurrent, processor)) process(processor);
+        }
+        for (auto processor : prepared) {
+            finish(processor);
+        }
 
-            } else {
-                try {
-                    processor->doIfNotReady();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
-                }
+        std::vector<size_t> nextWave;
+        for (auto i : wave) {
+            for (auto j : successors[i]) {
+                if (--blockers[j] == 0) nextWave.push_back(j);
             }
         }
+        std::swap(wave, nextWave);
     }
+}
 
-    notifyObserversProcessorNetworkEvaluationEnd();
+bool ProcessorNetworkEvaluator::prepare(Processor* processor) {
+    if (processor->isValid()) return false;
+
+    if (!processor->isReady()) {
+        try {
+            processor->doIfNotReady();
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+        }
+        return false;
+    }
+
+    try {
+        // re-initialize resources (e.g., shaders) if necessary
+        if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+            IVW_TRACE_SCOPE_DETAIL("processor", "Initialize resources", processor->getIdentifier());
+            processor->initializeResources();
+        }
+
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
+
+    try {
+        // call onChange for all invalid inports
+        IVW_TRACE_SCOPE_DETAIL("processor", "Inport onChange", processor->getIdentifier());
+        for (auto inport : processor->getInports()) {
+            inport->callOnChangeIfChanged();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
+
+    processor->notifyObserversAboutToProcess(processor);
+    return true;
+}
+
+void ProcessorNetworkEvaluator::process(Processor* processor) {
+    try {
+        IVW_TRACE_SCOPE_DETAIL("processor", "Process", processor->getIdentifier());
+        // do the actual processing
+        processor->process();
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+    }
+}
+
+void ProcessorNetworkEvaluator::finish(Processor* processor) {
+    // Set processor as valid only if we still are ready.
+    // Callbacks might have made our inports invalid, if so abort
+    // the evaluation by not setting the processor valid.
+    if (processor->isReady()) processor->setValid();
+
+    processor->notifyObserversFinishedProcess(processor);
+}
+
+bool ProcessorNetworkEvaluator::isConcurrent(Processor* processor) {
+    const auto& traits = getTraits(processor);
+    return traits.threadSafe && !traits.gl;
+}
+
+auto ProcessorNetworkEvaluator::getTraits(Processor* processor) -> const ProcessorTraits& {
+    auto it = traits_.find(processor);
+    if (it == traits_.end()) {
+        const auto info = processor->getProcessorInfo();
+        const ProcessorTraits traits{info.threadSafe, util::contains(info.tags.tags_, Tag::GL)};
+        it = traits_.emplace(processor, traits).first;
+    }
+    return it->second;
 }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::setEvaluationMode(EvaluationMode mode) { mode_ = mode; }
+
+ProcessorNetworkEvaluator::EvaluationMode ProcessorNetworkEvaluator::getEvaluationMode() const {
+    return mode_;
 }
 
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) { sortDirty_ = true; }
+
 void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    order_.addNode(p);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    traits_.erase(p);
+    order_.removeNode(p);
+    sortDirty_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(
+    const PortConnection& connection) {
+    // An edge closing a cycle is kept out of the order, the evaluation then follows the order of
+    // the remaining edges just as the depth first sort did.
+    order_.addEdge(connection.getOutport()->getProcessor(), connection.getInport()->getProcessor());
+    sortDirty_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(
+    const PortConnection& connection) {
+    order_.removeEdge(connection.getOutport()->getProcessor(),
+                      connection.getInport()->getProcessor());
+    sortDirty_ = true;
 }
 
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/network/workspacemanager.h>
 
 #include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/io/serialization/binarydocument.h>
 #include <inviwo/core/common/inviwomodule.h>
 #include <inviwo/core/util/inviwosetupinfo.h>
 #include <inviwo/core/util/filesystem.h>
@@ -137,7 +138,8 @@ WorkspaceManager::~WorkspaceManager() = default;
 void WorkspaceManager::clear() { clears_.invoke(); }
 
 void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
-                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode) {
+                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode,
+                            SerializationFormat format) {
     Serializer serializer(refPath);
 
     if (mode != WorkspaceSaveMode::Undo) {
@@ -146,7 +148,7 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    serializer.writeFile(stream, format);
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
@@ -163,17 +165,23 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 }
 
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
-                            WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+                            WorkspaceSaveMode mode, SerializationFormat format) {
+    auto ostream = format == SerializationFormat::Binary
+                       ? filesystem::ofstream(path, std::ios::out | std::ios::binary)
+                       : filesystem::ofstream(path);
     if (ostream.is_open()) {
-        save(ostream, path, exceptionHandler, mode);
+        save(ostream, path, exceptionHandler, mode, format);
     } else {
         throw AbortException("Could not open workspace file: " + path, IVW_CONTEXT);
     }
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    // Binary workspaces have to be read in binary mode, xml in text mode to convert line endings
+    auto istream = filesystem::ifstream(path, std::ios::in | std::ios::binary);
+    if (istream.is_open() && !util::isBinaryDocument(istream)) {
+        istream = filesystem::ifstream(path);
+    }
     if (istream.is_open()) {
         load(istream, path, exceptionHandler);
     } else {
@@ -33,12 +33,13 @@ namespace inviwo {
 
 ProcessorInfo::ProcessorInfo(std::string aClassIdentifier, std::string aDisplayName,
                              std::string aCategory, CodeState aCodeState, Tags someTags,
-                             bool isVisible)
+                             bool isVisible, bool isThreadSafe)
     : classIdentifier(aClassIdentifier)
     , displayName(aDisplayName)
     , category(aCategory)
     , codeState(aCodeState)
     , tags(someTags)
-    , visible(isVisible) {}
+    , visible(isVisible)
+    , threadSafe(isThreadSafe) {}
 
 }  // namespace inviwo
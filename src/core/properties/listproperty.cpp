@@ -154,9 +154,7 @@ size_t ListProperty::getMaxNumberOfElements() const { return maxNumElements_; }
 
 void ListProperty::clear() {
     NetworkLock l(this);
-    while (size()) {
-        removeProperty(static_cast<size_t>(0));
-    }
+    CompositeProperty::removeProperties(getProperties());
     propertyModified();
 }
 
@@ -234,6 +232,35 @@ void ListProperty::insertProperty(size_t index, Property& property) {
     insertProperty(index, &property, false);
 }
 
+void ListProperty::insertProperties(size_t index, const std::vector<Property*>& properties,
+                                    bool owner) {
+    for (auto property : properties) {
+        if (!util::contains_if(prefabs_, [&, id = property->getClassIdentifier()](auto& elem) {
+                return elem->getClassIdentifier() == id;
+            })) {
+            throw Exception("Unsupported property type, no prefab matching `" +
+                                property->getClassIdentifier() + "`.",
+                            IVW_CONTEXT);
+        }
+    }
+
+    // same limit as in insertProperty, size() + 1 < maxNumElements_
+    size_t count = properties.size();
+    const size_t maxElements = maxNumElements_;
+    if (maxElements != 0) {
+        count = std::min(count, maxElements > size() + 1 ? maxElements - size() - 1 : size_t{0});
+    }
+    if (count < properties.size()) {
+        LogError("Maximum number of list entries reached (" << this->getDisplayName() << ")");
+    }
+    if (count == 0) return;
+
+    const std::vector<Property*> added(properties.begin(), properties.begin() + count);
+    for (auto property : added) property->setSerializationMode(PropertySerializationMode::All);
+    CompositeProperty::insertProperties(index, added, owner);
+    propertyModified();
+}
+
 Property* ListProperty::removeProperty(const std::string& identifier) {
     auto result = CompositeProperty::removeProperty(identifier);
     propertyModified();
@@ -258,6 +285,11 @@ Property* ListProperty::removeProperty(size_t index) {
     return result;
 }
 
+void ListProperty::removeProperties(std::vector<Property*> properties) {
+    CompositeProperty::removeProperties(std::move(properties));
+    propertyModified();
+}
+
 size_t ListProperty::getPrefabCount() const { return prefabs_.size(); }
 
 void ListProperty::addPrefab(std::unique_ptr<Property> p) { prefabs_.emplace_back(std::move(p)); }
@@ -28,12 +28,15 @@
  *********************************************************************************/
 
 #include <inviwo/core/properties/property.h>
+#include <inviwo/core/properties/propertyowner.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/network/networklock.h>
 
+#include <utility>
+
 namespace inviwo {
 
 Property::Property(const std::string& identifier, const std::string& displayName,
@@ -79,9 +82,11 @@ Property::~Property() {
 std::string Property::getIdentifier() const { return identifier_; }
 Property& Property::setIdentifier(const std::string& identifier) {
     if (identifier_ != identifier) {
-        identifier_ = identifier;
-
         util::validateIdentifier(identifier, "Property", IVW_CONTEXT);
+        if (owner_) owner_->checkIdentifier(this, identifier);
+
+        auto old = std::exchange(identifier_, identifier);
+        if (owner_) owner_->onPropertyIdentifierChanged(this, old);
 
         notifyObserversOnSetIdentifier(this, identifier_);
         notifyAboutChange();
@@ -220,6 +225,7 @@ void Property::deserialize(Deserializer& d) {
         auto old = identifier_;
         d.deserialize("identifier", identifier_, SerializationTarget::Attribute);
         if (old != identifier_) {
+            if (owner_) owner_->onPropertyIdentifierChanged(this, old);
             notifyObserversOnSetIdentifier(this, identifier_);
         }
     }
@@ -37,7 +37,9 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/exception.h>
 
+#include <algorithm>
 #include <iterator>
+#include <unordered_set>
 
 namespace inviwo {
 
@@ -51,9 +53,7 @@ PropertyOwner::PropertyOwner(const PropertyOwner& rhs)
 }
 
 PropertyOwner::~PropertyOwner() {
-    while (size() != 0) {
-        removeProperty(begin());
-    }
+    if (!properties_.empty()) removeProperties(properties_);
 }
 
 void PropertyOwner::addProperty(Property* property, bool owner) {
@@ -69,20 +69,20 @@ void PropertyOwner::insertProperty(size_t index, Property* property, bool owner)
         index = properties_.size();
     }
 
-    if (getPropertyByIdentifier(property->getIdentifier()) != nullptr) {
-        throw Exception(
-            "Can't add property, identifier \"" + property->getIdentifier() + "\" already exist.",
-            IVW_CONTEXT);
+    auto identifier = property->getIdentifier();
+    if (propertiesByIdentifier_.count(identifier) != 0) {
+        throw Exception("Can't add property, identifier \"" + identifier + "\" already exist.",
+                        IVW_CONTEXT);
     }
     if (auto parent = dynamic_cast<Property*>(this)) {
         if (parent == property) {
-            throw Exception("Can't add property \"" + property->getIdentifier() + "\" to itself.",
-                            IVW_CONTEXT);
+            throw Exception("Can't add property \"" + identifier + "\" to itself.", IVW_CONTEXT);
         }
     }
 
     notifyObserversWillAddProperty(property, index);
     properties_.insert(properties_.begin() + index, property);
+    propertiesByIdentifier_.emplace(std::move(identifier), property);
     property->setOwner(this);
 
     if (dynamic_cast<EventProperty*>(property)) {
@@ -102,10 +102,55 @@ void PropertyOwner::insertProperty(size_t index, Property& property) {
     insertProperty(index, &property, false);
 }
 
+void PropertyOwner::insertProperties(size_t index, const std::vector<Property*>& properties,
+                                     bool owner) {
+    if (properties.empty()) return;
+    if (index > properties_.size()) {
+        index = properties_.size();
+    }
+
+    std::vector<std::string> identifiers;
+    identifiers.reserve(properties.size());
+    std::unordered_set<std::string> unique;
+    auto parent = dynamic_cast<Property*>(this);
+    for (auto property : properties) {
+        auto identifier = property->getIdentifier();
+        if (propertiesByIdentifier_.count(identifier) != 0 || !unique.insert(identifier).second) {
+            throw Exception(
+                "Can't add properties, identifier \"" + identifier + "\" already exist.",
+                IVW_CONTEXT);
+        }
+        if (parent == property) {
+            throw Exception("Can't add property \"" + identifier + "\" to itself.", IVW_CONTEXT);
+        }
+        identifiers.push_back(std::move(identifier));
+    }
+
+    notifyObserversWillAddProperties(properties, index);
+    properties_.insert(properties_.begin() + index, properties.begin(), properties.end());
+    propertiesByIdentifier_.reserve(propertiesByIdentifier_.size() + properties.size());
+    for (size_t i = 0; i < properties.size(); ++i) {
+        auto property = properties[i];
+        propertiesByIdentifier_.emplace(std::move(identifiers[i]), property);
+        property->setOwner(this);
+
+        if (dynamic_cast<EventProperty*>(property)) {
+            eventProperties_.push_back(static_cast<EventProperty*>(property));
+        }
+        if (dynamic_cast<CompositeProperty*>(property)) {
+            compositeProperties_.push_back(static_cast<CompositeProperty*>(property));
+        }
+        if (owner) {
+            ownedProperties_.emplace_back(property);
+        }
+    }
+    notifyObserversDidAddProperties(properties, index);
+}
+
 Property* PropertyOwner::removeProperty(const std::string& identifier) {
-    return removeProperty(
-        std::find_if(properties_.begin(), properties_.end(),
-                     [&identifier](Property* p) { return p->getIdentifier() == identifier; }));
+    auto it = propertiesByIdentifier_.find(identifier);
+    if (it == propertiesByIdentifier_.end()) return nullptr;
+    return removeProperty(std::find(properties_.begin(), properties_.end(), it->second));
 }
 
 Property* PropertyOwner::removeProperty(Property* property) {
@@ -133,6 +178,10 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
         util::erase_remove(eventProperties_, *it);
         util::erase_remove(compositeProperties_, *it);
 
+        auto indexed = propertiesByIdentifier_.find(prop->getIdentifier());
+        if (indexed != propertiesByIdentifier_.end() && indexed->second == prop) {
+            propertiesByIdentifier_.erase(indexed);
+        }
         prop->setOwner(nullptr);
         properties_.erase(it);
         notifyObserversDidRemoveProperty(prop, index);
@@ -150,6 +199,69 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
     return prop;
 }
 
+void PropertyOwner::removeProperties(std::vector<Property*> properties) {
+    const std::unordered_set<Property*> toRemove(properties.begin(), properties.end());
+
+    properties.clear();
+    std::vector<size_t> indices;
+    for (size_t i = properties_.size(); i-- > 0;) {
+        if (toRemove.count(properties_[i]) != 0) {
+            properties.push_back(properties_[i]);
+            indices.push_back(i);
+        }
+    }
+    if (properties.empty()) return;
+
+    const auto removed = [&](auto* p) { return toRemove.count(p) != 0; };
+
+    notifyObserversWillRemoveProperties(properties, indices);
+    util::erase_remove_if(eventProperties_, removed);
+    util::erase_remove_if(compositeProperties_, removed);
+    for (auto prop : properties) {
+        auto indexed = propertiesByIdentifier_.find(prop->getIdentifier());
+        if (indexed != propertiesByIdentifier_.end() && indexed->second == prop) {
+            propertiesByIdentifier_.erase(indexed);
+        }
+        prop->setOwner(nullptr);
+    }
+    util::erase_remove_if(properties_, removed);
+    notifyObserversDidRemoveProperties(properties, indices);
+
+    // Deletes the owned properties
+    util::erase_remove_if(ownedProperties_,
+                          [&](const std::unique_ptr<Property>& p) { return removed(p.get()); });
+}
+
+void PropertyOwner::checkIdentifier(const Property* property,
+                                    const std::string& identifier) const {
+    auto it = propertiesByIdentifier_.find(identifier);
+    if (it != propertiesByIdentifier_.end() && it->second != property) {
+        throw Exception("Can't rename property \"" + property->getIdentifier() +
+                            "\", identifier \"" + identifier + "\" already exist.",
+                        IVW_CONTEXT);
+    }
+}
+
+void PropertyOwner::onPropertyIdentifierChanged(Property* property,
+                                                const std::string& oldIdentifier) {
+    // Deserialization renames properties without checkIdentifier, such that two properties can
+    // share an identifier for a while, e.g. when swapping identifiers. Always index the renamed
+    // property, and hand its old identifier over to any other property that still uses it.
+    propertiesByIdentifier_.insert_or_assign(property->getIdentifier(), property);
+
+    auto it = propertiesByIdentifier_.find(oldIdentifier);
+    if (it != propertiesByIdentifier_.end() && it->second == property) {
+        auto other = std::find_if(properties_.begin(), properties_.end(), [&](Property* p) {
+            return p->getIdentifier() == oldIdentifier;
+        });
+        if (other != properties_.end()) {
+            it->second = *other;
+        } else {
+            propertiesByIdentifier_.erase(it);
+        }
+    }
+}
+
 const std::vector<Property*>& PropertyOwner::getProperties() const { return properties_; }
 
 const std::vector<CompositeProperty*>& PropertyOwner::getCompositeProperties() const {
@@ -170,9 +282,8 @@ std::vector<Property*> PropertyOwner::getPropertiesRecursive() const {
 
 Property* PropertyOwner::getPropertyByIdentifier(const std::string& identifier,
                                                  bool recursiveSearch) const {
-    for (Property* property : properties_) {
-        if (property->getIdentifier() == identifier) return property;
-    }
+    auto it = propertiesByIdentifier_.find(identifier);
+    if (it != propertiesByIdentifier_.end()) return it->second;
     if (recursiveSearch) {
         for (CompositeProperty* compositeProperty : compositeProperties_) {
             Property* p = compositeProperty->getPropertyByIdentifier(identifier, true);
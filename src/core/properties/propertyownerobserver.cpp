@@ -39,6 +39,26 @@ void PropertyOwnerObserver::onWillRemoveProperty(Property*, size_t) {}
 
 void PropertyOwnerObserver::onDidRemoveProperty(Property*, size_t) {}
 
+void PropertyOwnerObserver::onWillAddProperties(const std::vector<Property*>& properties,
+                                                size_t index) {
+    for (size_t i = 0; i < properties.size(); ++i) onWillAddProperty(properties[i], index + i);
+}
+
+void PropertyOwnerObserver::onDidAddProperties(const std::vector<Property*>& properties,
+                                               size_t index) {
+    for (size_t i = 0; i < properties.size(); ++i) onDidAddProperty(properties[i], index + i);
+}
+
+void PropertyOwnerObserver::onWillRemoveProperties(const std::vector<Property*>& properties,
+                                                   const std::vector<size_t>& indices) {
+    for (size_t i = 0; i < properties.size(); ++i) onWillRemoveProperty(properties[i], indices[i]);
+}
+
+void PropertyOwnerObserver::onDidRemoveProperties(const std::vector<Property*>& properties,
+                                                  const std::vector<size_t>& indices) {
+    for (size_t i = 0; i < properties.size(); ++i) onDidRemoveProperty(properties[i], indices[i]);
+}
+
 void PropertyOwnerObservable::notifyObserversWillAddProperty(Property* property, size_t index) {
     forEachObserver([&](PropertyOwnerObserver* o) { o->onWillAddProperty(property, index); });
 }
@@ -55,4 +75,26 @@ void PropertyOwnerObservable::notifyObserversDidRemoveProperty(Property* propert
     forEachObserver([&](PropertyOwnerObserver* o) { o->onDidRemoveProperty(property, index); });
 }
 
+void PropertyOwnerObservable::notifyObserversWillAddProperties(
+    const std::vector<Property*>& properties, size_t index) {
+    forEachObserver([&](PropertyOwnerObserver* o) { o->onWillAddProperties(properties, index); });
+}
+
+void PropertyOwnerObservable::notifyObserversDidAddProperties(
+    const std::vector<Property*>& properties, size_t index) {
+    forEachObserver([&](PropertyOwnerObserver* o) { o->onDidAddProperties(properties, index); });
+}
+
+void PropertyOwnerObservable::notifyObserversWillRemoveProperties(
+    const std::vector<Property*>& properties, const std::vector<size_t>& indices) {
+    forEachObserver(
+        [&](PropertyOwnerObserver* o) { o->onWillRemoveProperties(properties, indices); });
+}
+
+void PropertyOwnerObservable::notifyObserversDidRemoveProperties(
+    const std::vector<Property*>& properties, const std::vector<size_t>& indices) {
+    forEachObserver(
+        [&](PropertyOwnerObserver* o) { o->onDidRemoveProperties(properties, indices); });
+}
+
 }  // namespace inviwo
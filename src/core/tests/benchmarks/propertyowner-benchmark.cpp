@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/properties/listproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+std::unique_ptr<ListProperty> makeList() {
+    return std::make_unique<ListProperty>("list", "List",
+                                          std::make_unique<IntProperty>("element", "Element"));
+}
+
+std::vector<Property*> makeElements(size_t count) {
+    std::vector<Property*> elements;
+    elements.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        elements.push_back(new IntProperty("element" + std::to_string(i), "Element"));
+    }
+    return elements;
+}
+
+}  // namespace
+
+static void ListPropertyAddProperty(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto list = makeList();
+        const auto elements = makeElements(count);
+        state.ResumeTiming();
+
+        for (auto element : elements) list->addProperty(element, true);
+        benchmark::DoNotOptimize(list->size());
+
+        state.PauseTiming();
+        list.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void ListPropertyInsertProperties(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto list = makeList();
+        const auto elements = makeElements(count);
+        state.ResumeTiming();
+
+        list->insertProperties(0, elements, true);
+        benchmark::DoNotOptimize(list->size());
+
+        state.PauseTiming();
+        list.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void ListPropertyGetPropertyByPath(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    auto list = makeList();
+    list->insertProperties(0, makeElements(count), true);
+
+    std::vector<std::vector<std::string>> paths;
+    for (size_t i = 0; i < count; i += 7) paths.push_back({"element" + std::to_string(i)});
+
+    for (auto _ : state) {
+        for (const auto& path : paths) benchmark::DoNotOptimize(list->getPropertyByPath(path));
+    }
+    state.SetItemsProcessed(state.iterations() * paths.size());
+}
+
+static void ListPropertyClear(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto list = makeList();
+        list->insertProperties(0, makeElements(count), true);
+        state.ResumeTiming();
+
+        list->clear();
+        benchmark::DoNotOptimize(list->size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(ListPropertyAddProperty)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(ListPropertyInsertProperties)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(ListPropertyGetPropertyByPath)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(ListPropertyClear)->RangeMultiplier(10)->Range(100, 10000);
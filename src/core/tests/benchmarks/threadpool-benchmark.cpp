@@ -0,0 +1,229 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * The previous ThreadPool implementation, a single std::queue of std::function guarded by one
+ * mutex. Kept here as the reference to compare against.
+ */
+class SingleQueuePool {
+public:
+    SingleQueuePool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ~SingleQueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    template <class F>
+    std::future<void> enqueue(F&& f) {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::forward<F>(f));
+        auto res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return res;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+constexpr size_t tasksPerIteration = 10000;
+
+}  // namespace
+
+static void EnqueueSingleQueue(benchmark::State& state) {
+    SingleQueuePool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> count{0};
+    for (auto _ : state) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasksPerIteration);
+        for (size_t i = 0; i < tasksPerIteration; ++i) {
+            futures.push_back(pool.enqueue([&count]() { ++count; }));
+        }
+        for (auto& f : futures) f.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * tasksPerIteration);
+}
+
+static void EnqueueWorkStealing(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> count{0};
+    for (auto _ : state) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasksPerIteration);
+        for (size_t i = 0; i < tasksPerIteration; ++i) {
+            futures.push_back(pool.enqueue([&count]() { ++count; }));
+        }
+        for (auto& f : futures) f.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * tasksPerIteration);
+}
+
+static void EnqueueRawWorkStealing(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> count{0};
+    for (auto _ : state) {
+        util::TaskGroup group{pool};
+        for (size_t i = 0; i < tasksPerIteration; ++i) {
+            group.run([&count]() { ++count; });
+        }
+        group.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * tasksPerIteration);
+}
+
+// Sum a large array in fine grained chunks, measures scaling with the number of threads
+static void ChunkedSumSingleQueue(benchmark::State& state) {
+    SingleQueuePool pool(static_cast<size_t>(state.range(0)));
+    std::vector<double> data(1 << 24, 1.0);
+    const size_t grain = 4096;
+    for (auto _ : state) {
+        std::vector<double> partial((data.size() + grain - 1) / grain);
+        std::vector<std::future<void>> futures;
+        for (size_t chunk = 0; chunk < partial.size(); ++chunk) {
+            futures.push_back(pool.enqueue([&, chunk]() {
+                const auto begin = data.begin() + chunk * grain;
+                const auto end = data.begin() + std::min(data.size(), (chunk + 1) * grain);
+                partial[chunk] = std::accumulate(begin, end, 0.0);
+            }));
+        }
+        for (auto& f : futures) f.wait();
+        benchmark::DoNotOptimize(std::accumulate(partial.begin(), partial.end(), 0.0));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(double));
+}
+
+static void ChunkedSumWorkStealing(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::vector<double> data(1 << 24, 1.0);
+    const size_t grain = 4096;
+    for (auto _ : state) {
+        std::vector<double> partial((data.size() + grain - 1) / grain);
+        util::parallelFor(
+            &pool, size_t{0}, data.size(),
+            [&](size_t begin, size_t end) {
+                partial[begin / grain] =
+                    std::accumulate(data.begin() + begin, data.begin() + end, 0.0);
+            },
+            grain);
+        benchmark::DoNotOptimize(std::accumulate(partial.begin(), partial.end(), 0.0));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(double));
+}
+
+// Tasks that spawn tasks, this deadlocks the single queue pool if the tasks wait for their
+// children, hence only the work-stealing pool is measured.
+static void NestedParallelFor(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> count{0};
+    for (auto _ : state) {
+        util::parallelFor(&pool, 0, 256, [&](int) {
+            util::parallelFor(&pool, 0, 256, [&](int) { ++count; });
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * 256 * 256);
+}
+
+static void threadCounts(benchmark::internal::Benchmark* b) {
+    const auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        b->Arg(threads);
+    }
+}
+
+BENCHMARK(EnqueueSingleQueue)->Apply(threadCounts)->UseRealTime();
+BENCHMARK(EnqueueWorkStealing)->Apply(threadCounts)->UseRealTime();
+BENCHMARK(EnqueueRawWorkStealing)->Apply(threadCounts)->UseRealTime();
+
+BENCHMARK(ChunkedSumSingleQueue)->Apply(threadCounts)->UseRealTime();
+BENCHMARK(ChunkedSumWorkStealing)->Apply(threadCounts)->UseRealTime();
+
+BENCHMARK(NestedParallelFor)->Apply(threadCounts)->UseRealTime();
+
+int main(int argc, char** argv) {
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
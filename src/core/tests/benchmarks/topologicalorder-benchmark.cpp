@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/dynamictopologicalorder.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * A sequence of edits resembling how a network is built in the editor. Processors mostly connect to
+ * processors added shortly before them, then new processors are inserted in the middle of existing
+ * connections, which forces the order to be updated.
+ */
+struct Edits {
+    struct Edit {
+        bool add;
+        int from;
+        int to;
+    };
+
+    explicit Edits(int size) : nodes{size + size / 4} {
+        std::mt19937 gen(size);
+        std::uniform_int_distribution<int> back(1, 8);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 1; i < size; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                const auto from = std::max(0, i - back(gen));
+                edges.emplace_back(from, i);
+                edits.push_back({true, from, i});
+            }
+        }
+        for (int node = size; node < nodes; ++node) {
+            std::uniform_int_distribution<size_t> pick(0, edges.size() - 1);
+            auto& edge = edges[pick(gen)];
+            const auto [from, to] = edge;
+            edits.push_back({false, from, to});
+            edits.push_back({true, from, node});
+            edits.push_back({true, node, to});
+            edge = {node, to};
+            edges.emplace_back(from, node);
+        }
+    }
+    int nodes;
+    std::vector<Edit> edits;
+};
+
+// What the network evaluator did before, a depth first sort of the whole network per change.
+void fullSort(const std::vector<std::vector<int>>& in, std::vector<int>& sorted) {
+    std::vector<char> visited(in.size(), 0);
+    sorted.clear();
+    std::vector<std::pair<int, size_t>> stack;
+    for (int root = 0; root < static_cast<int>(in.size()); ++root) {
+        if (visited[root]) continue;
+        visited[root] = 1;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            if (next < in[node].size()) {
+                const auto pred = in[node][next++];
+                if (!visited[pred]) {
+                    visited[pred] = 1;
+                    stack.emplace_back(pred, 0);
+                }
+            } else {
+                sorted.push_back(node);
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+}  // namespace
+
+static void TopologicalOrderFullSort(benchmark::State& state) {
+    const Edits edits(static_cast<int>(state.range(0)));
+    std::vector<int> sorted;
+    for (auto _ : state) {
+        std::vector<std::vector<int>> in(edits.nodes);
+        for (auto& edit : edits.edits) {
+            auto& preds = in[edit.to];
+            if (edit.add) {
+                preds.push_back(edit.from);
+            } else {
+                preds.erase(std::find(preds.begin(), preds.end(), edit.from));
+            }
+            fullSort(in, sorted);
+        }
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * edits.edits.size());
+}
+
+static void TopologicalOrderIncremental(benchmark::State& state) {
+    const Edits edits(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        util::DynamicTopologicalOrder<int> order;
+        for (int i = 0; i < edits.nodes; ++i) order.addNode(i);
+        for (auto& edit : edits.edits) {
+            if (edit.add) {
+                order.addEdge(edit.from, edit.to);
+            } else {
+                order.removeEdge(edit.from, edit.to);
+            }
+        }
+        benchmark::DoNotOptimize(order.size());
+    }
+    state.SetItemsProcessed(state.iterations() * edits.edits.size());
+}
+
+BENCHMARK(TopologicalOrderFullSort)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(TopologicalOrderIncremental)->RangeMultiplier(4)->Range(64, 4096);
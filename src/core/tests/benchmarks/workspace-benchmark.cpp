@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/deserializer.h>
+#include <inviwo/core/io/serialization/binarydocument.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+struct Workspace {
+    std::string path;
+    std::string xml;
+    std::string binary;
+};
+
+// The example workspaces, as xml and converted to the binary format
+const std::vector<Workspace>& workspaces() {
+    static const std::vector<Workspace> result = []() {
+        std::vector<Workspace> list;
+        const auto dir = filesystem::findBasePath() + "/data/workspaces";
+        for (auto& file : filesystem::getDirectoryContentsRecursively(dir)) {
+            if (filesystem::getFileExtension(file) != "inv") continue;
+
+            std::ifstream in(file);
+            std::stringstream xml;
+            xml << in.rdbuf();
+
+            TxDocument doc;
+            std::istringstream docStream{xml.str()};
+            docStream >> doc;
+            std::ostringstream binary;
+            util::writeBinaryDocument(doc, binary);
+
+            list.push_back({file, xml.str(), binary.str()});
+        }
+        return list;
+    }();
+    return result;
+}
+
+std::vector<std::unique_ptr<TxDocument>> parseAll() {
+    std::vector<std::unique_ptr<TxDocument>> docs;
+    for (auto& workspace : workspaces()) {
+        auto doc = std::make_unique<TxDocument>();
+        std::istringstream in{workspace.xml};
+        in >> *doc;
+        docs.push_back(std::move(doc));
+    }
+    return docs;
+}
+
+}  // namespace
+
+static void WorkspaceLoadXml(benchmark::State& state) {
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& workspace : workspaces()) {
+            std::istringstream in{workspace.xml};
+            Deserializer d(in, workspace.path);
+            benchmark::DoNotOptimize(&d);
+            bytes += workspace.xml.size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void WorkspaceLoadBinary(benchmark::State& state) {
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& workspace : workspaces()) {
+            std::istringstream in{workspace.binary};
+            Deserializer d(in, workspace.path);
+            benchmark::DoNotOptimize(&d);
+            bytes += workspace.binary.size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void WorkspaceSaveXml(benchmark::State& state) {
+    const auto docs = parseAll();
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& doc : docs) {
+            TiXmlPrinter printer;
+            printer.SetIndent("    ");
+            doc->Accept(&printer);
+            bytes += printer.Str().size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void WorkspaceSaveBinary(benchmark::State& state) {
+    const auto docs = parseAll();
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& doc : docs) {
+            std::ostringstream out;
+            util::writeBinaryDocument(*doc, out);
+            bytes += static_cast<size_t>(out.tellp());
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK(WorkspaceLoadXml);
+BENCHMARK(WorkspaceLoadBinary);
+BENCHMARK(WorkspaceSaveXml);
+BENCHMARK(WorkspaceSaveBinary);
@@ -0,0 +1,187 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/io/serialization/binarydocument.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::string toXml(TxDocument& doc) {
+    TiXmlPrinter printer;
+    printer.SetIndent("    ");
+    doc.Accept(&printer);
+    return printer.Str();
+}
+
+template <typename T>
+T roundTrip(const T& inValue, SerializationFormat format) {
+    const std::string refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("serializedValue", inValue);
+    serializer.writeFile(ss, format);
+    Deserializer deserializer(ss, refpath);
+    T outValue{};
+    deserializer.deserialize("serializedValue", outValue);
+    return outValue;
+}
+
+template <typename T>
+void expectSameAsXml(const T& inValue) {
+    const auto xml = roundTrip(inValue, SerializationFormat::Xml);
+    const auto binary = roundTrip(inValue, SerializationFormat::Binary);
+    EXPECT_EQ(inValue, xml);
+    EXPECT_EQ(xml, binary);
+}
+
+}  // namespace
+
+TEST(BinaryDocumentTest, DetectFormat) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    serializer.serialize("value", 1);
+
+    std::stringstream xml;
+    serializer.writeFile(xml, SerializationFormat::Xml);
+    EXPECT_FALSE(util::isBinaryDocument(xml));
+    EXPECT_EQ(xml.tellg(), std::streampos{0});
+
+    std::stringstream binary;
+    serializer.writeFile(binary, SerializationFormat::Binary);
+    EXPECT_TRUE(util::isBinaryDocument(binary));
+    EXPECT_EQ(binary.tellg(), std::streampos{0});
+}
+
+TEST(BinaryDocumentTest, Strings) {
+    expectSameAsXml(std::string{});
+    expectSameAsXml(std::string{"plain"});
+    expectSameAsXml(std::string{"<tag attr=\"&amp;\"> & ' \" </tag>"});
+    expectSameAsXml(std::string{"line one\nline two\ttabbed"});
+    expectSameAsXml(std::string{u8"åäö λ ∑"});
+    expectSameAsXml(std::string(1000, 'x'));
+}
+
+TEST(BinaryDocumentTest, Numbers) {
+    expectSameAsXml(3.14f);
+    expectSameAsXml(-6.28);
+    expectSameAsXml(std::numeric_limits<int>::min());
+    expectSameAsXml(std::numeric_limits<unsigned long long>::max());
+    expectSameAsXml(vec3(1.0f, 2.5f, -3.0f));
+    expectSameAsXml(ivec4(1, -2, 3, -4));
+    expectSameAsXml(mat3(2.0f));
+}
+
+TEST(BinaryDocumentTest, Containers) {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 300; ++i) strings.push_back("item" + std::to_string(i % 7));
+
+    const std::string refpath = filesystem::findBasePath();
+    for (auto format : {SerializationFormat::Xml, SerializationFormat::Binary}) {
+        std::stringstream ss;
+        Serializer serializer(refpath);
+        serializer.serialize("strings", strings, "item");
+        serializer.serialize("map", std::map<std::string, int>{{"a", 1}, {"b", 2}}, "entry");
+        serializer.writeFile(ss, format);
+
+        Deserializer deserializer(ss, refpath);
+        std::vector<std::string> outStrings;
+        std::map<std::string, int> outMap;
+        deserializer.deserialize("strings", outStrings, "item");
+        deserializer.deserialize("map", outMap, "entry");
+        EXPECT_EQ(strings, outStrings);
+        EXPECT_EQ((std::map<std::string, int>{{"a", 1}, {"b", 2}}), outMap);
+    }
+}
+
+TEST(BinaryDocumentTest, XmlRoundTripIsIdentical) {
+    const std::string xml =
+        "<?xml version=\"1.0\" ?>\n"
+        "<InviwoWorkspace version=\"2\">\n"
+        "    <!-- a comment -->\n"
+        "    <Processors>\n"
+        "        <Processor type=\"org.inviwo.Test\" identifier=\"A &amp; B\">\n"
+        "            <text>Some &lt;text&gt;</text>\n"
+        "            <cdata><![CDATA[raw <cdata> & stuff]]></cdata>\n"
+        "            <empty />\n"
+        "        </Processor>\n"
+        "    </Processors>\n"
+        "</InviwoWorkspace>\n";
+
+    TxDocument source;
+    std::istringstream in{xml};
+    in >> source;
+
+    std::stringstream binary;
+    util::writeBinaryDocument(source, binary);
+    TxDocument copy;
+    util::readBinaryDocument(binary, copy);
+
+    EXPECT_EQ(toXml(source), toXml(copy));
+}
+
+TEST(BinaryDocumentTest, InvalidInput) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    serializer.serialize("strings", std::vector<std::string>{"a", "b", "c"}, "item");
+    std::stringstream ss;
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    const auto data = ss.str();
+
+    for (size_t size = 0; size < data.size(); ++size) {
+        std::istringstream truncated{data.substr(0, size)};
+        TxDocument doc;
+        EXPECT_THROW(util::readBinaryDocument(truncated, doc), SerializationException) << size;
+    }
+
+    auto badVersion = data;
+    badVersion[4] = static_cast<char>(BinaryDocument::version + 1);
+    std::istringstream badVersionStream{badVersion};
+    TxDocument doc;
+    EXPECT_THROW(util::readBinaryDocument(badVersionStream, doc), SerializationException);
+
+    std::istringstream notBinary{"<?xml version=\"1.0\" ?>"};
+    TxDocument doc2;
+    EXPECT_THROW(util::readBinaryDocument(notBinary, doc2), SerializationException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/dynamictopologicalorder.h>
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+using Edges = std::vector<std::pair<int, int>>;
+
+void checkOrder(const util::DynamicTopologicalOrder<int>& order, const Edges& edges) {
+    std::unordered_map<int, size_t> pos;
+    for (auto n : order.order()) pos[n] = pos.size();
+    ASSERT_EQ(order.size(), pos.size());
+    for (auto& [from, to] : edges) {
+        EXPECT_LT(pos.at(from), pos.at(to)) << "Edge " << from << " -> " << to;
+    }
+}
+
+}  // namespace
+
+TEST(DynamicTopologicalOrder, AddNodes) {
+    util::DynamicTopologicalOrder<int> order;
+    order.addNode(1);
+    order.addNode(2);
+    order.addNode(3);
+    order.addNode(2);
+    EXPECT_EQ(3, order.size());
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), order.order());
+}
+
+TEST(DynamicTopologicalOrder, Reorder) {
+    util::DynamicTopologicalOrder<int> order;
+    for (int i = 0; i < 5; ++i) order.addNode(i);
+
+    Edges edges{{4, 0}, {3, 4}, {1, 3}};
+    for (auto& [from, to] : edges) EXPECT_TRUE(order.addEdge(from, to));
+    checkOrder(order, edges);
+}
+
+TEST(DynamicTopologicalOrder, Cycle) {
+    util::DynamicTopologicalOrder<int> order;
+    for (int i = 0; i < 3; ++i) order.addNode(i);
+
+    Edges edges{{0, 1}, {1, 2}};
+    for (auto& [from, to] : edges) EXPECT_TRUE(order.addEdge(from, to));
+    EXPECT_FALSE(order.addEdge(2, 0));
+    checkOrder(order, edges);
+
+    order.removeEdge(2, 0);
+    order.removeEdge(1, 2);
+    edges.pop_back();
+    EXPECT_TRUE(order.addEdge(2, 0));
+    edges.emplace_back(2, 0);
+    checkOrder(order, edges);
+}
+
+TEST(DynamicTopologicalOrder, RemoveNode) {
+    util::DynamicTopologicalOrder<int> order;
+    for (int i = 0; i < 100; ++i) order.addNode(i);
+    for (int i = 0; i < 99; ++i) order.addEdge(99 - i, 98 - i);
+    for (int i = 0; i < 100; ++i) {
+        if (i % 4 != 1) order.removeNode(i);
+    }
+    EXPECT_EQ(25, order.size());
+    EXPECT_FALSE(order.contains(0));
+    EXPECT_TRUE(order.contains(1));
+
+    Edges edges;
+    for (int i = 1; i < 95; i += 4) {
+        order.addEdge(i, i + 4);
+        edges.emplace_back(i, i + 4);
+    }
+    checkOrder(order, edges);
+}
+
+TEST(DynamicTopologicalOrder, RandomDAG) {
+    constexpr int size = 200;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, size - 1);
+
+    // Generate edges consistent with a random hidden permutation, insert them in random order.
+    std::vector<int> rank(size);
+    for (int i = 0; i < size; ++i) rank[i] = i;
+    std::shuffle(rank.begin(), rank.end(), gen);
+
+    util::DynamicTopologicalOrder<int> order;
+    for (int i = 0; i < size; ++i) order.addNode(i);
+
+    Edges edges;
+    for (int i = 0; i < 2000; ++i) {
+        auto a = dist(gen);
+        auto b = dist(gen);
+        if (a == b) continue;
+        if (rank[a] > rank[b]) std::swap(a, b);
+        EXPECT_TRUE(order.addEdge(a, b));
+        edges.emplace_back(a, b);
+        if (i % 100 == 0) checkOrder(order, edges);
+    }
+    checkOrder(order, edges);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,166 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogramcalculation.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <atomic>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+void expectEqual(const HistogramContainer& expected, const HistogramContainer& result) {
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t c = 0; c < expected.size(); ++c) {
+        EXPECT_EQ(expected[c].getData(), result[c].getData());
+        EXPECT_DOUBLE_EQ(expected[c].stats_.min, result[c].stats_.min);
+        EXPECT_DOUBLE_EQ(expected[c].stats_.max, result[c].stats_.max);
+        EXPECT_NEAR(expected[c].stats_.mean, result[c].stats_.mean, 1e-9);
+        EXPECT_NEAR(expected[c].stats_.standardDeviation, result[c].stats_.standardDeviation,
+                    1e-6);
+    }
+}
+
+}  // namespace
+
+TEST(HistogramCalculation, SameAsHistogramContainer) {
+    // Several chunks, including values outside of the data range
+    std::vector<float> data(300001);
+    std::mt19937 gen(1);
+    std::normal_distribution<float> dist(0.0f, 2.0f);
+    for (auto& v : data) v = dist(gen);
+
+    const dvec2 range{-3.0, 3.0};
+    const HistogramContainer expected(range, 512, data.begin(), data.end());
+    const auto result = util::calculateHistograms(data.data(), data.size(), range, 512);
+    ASSERT_TRUE(result);
+    expectEqual(expected, *result);
+}
+
+TEST(HistogramCalculation, IntegerVectors) {
+    std::vector<u8vec3> data(100000);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& v : data) v = u8vec3(dist(gen), dist(gen), dist(gen));
+
+    // The number of bins is clamped to the size of the integer range
+    const dvec2 range{0.0, 255.0};
+    const HistogramContainer expected(range, 2048, data.begin(), data.end());
+    const auto result = util::calculateHistograms(data.data(), data.size(), range, 2048);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(3, result->size());
+    EXPECT_EQ(256, (*result)[0].getData().size());
+    expectEqual(expected, *result);
+}
+
+TEST(HistogramCalculation, Stride) {
+    std::vector<double> data(200000);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (auto& v : data) v = dist(gen);
+
+    const size_t stride = 7;
+    std::vector<double> subsampled;
+    for (size_t i = 0; i < data.size(); i += stride) subsampled.push_back(data[i]);
+
+    const dvec2 range{0.0, 1.0};
+    const HistogramContainer expected(range, 100, subsampled.begin(), subsampled.end());
+    const auto result = util::calculateHistograms(data.data(), data.size(), range, 100, stride);
+    ASSERT_TRUE(result);
+    expectEqual(expected, *result);
+}
+
+TEST(HistogramCalculation, Stop) {
+    std::vector<float> data(1000, 1.0f);
+    std::atomic<bool> stop{true};
+    EXPECT_FALSE(
+        util::calculateHistograms(data.data(), data.size(), dvec2{0.0, 1.0}, 10, 1, &stop));
+}
+
+TEST(HistogramCalculation, BufferRAM) {
+    BufferRAMPrecision<int> buffer(1000);
+    auto& vec = buffer.getDataContainer();
+    for (size_t i = 0; i < vec.size(); ++i) vec[i] = static_cast<int>(i) - 500;
+
+    const auto range = util::dataValueRange(buffer);
+    EXPECT_EQ(dvec2(-500.0, 499.0), range);
+
+    const HistogramContainer expected(range, 64, vec.begin(), vec.end());
+    const auto result = util::calculateHistograms(buffer, range, 64);
+    ASSERT_TRUE(result);
+    expectEqual(expected, *result);
+}
+
+TEST(HistogramCalculation, LazyContainer) {
+    Buffer<float> buffer(100);
+    EXPECT_FALSE(buffer.hasHistograms());
+    EXPECT_TRUE(std::as_const(buffer).getHistograms().empty());
+
+    const Buffer<float> copy(buffer);
+    EXPECT_FALSE(copy.hasHistograms());
+    EXPECT_TRUE(copy.getHistograms().empty());
+}
+
+TEST(HistogramCalculation, Summarize) {
+    std::vector<vec2> data(1003);
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    for (auto& v : data) v = vec2(dist(gen), dist(gen));
+
+    for (size_t stride : {size_t{1}, size_t{4}}) {
+        dvec2 min{std::numeric_limits<double>::max()};
+        dvec2 max{std::numeric_limits<double>::lowest()};
+        dvec2 sum{0.0};
+        size_t count = 0;
+        for (size_t i = 0; i < data.size(); i += stride) {
+            min = glm::min(min, dvec2(data[i]));
+            max = glm::max(max, dvec2(data[i]));
+            sum += dvec2(data[i]);
+            ++count;
+        }
+        const auto summary = util::summarize(data.data(), data.size(), stride);
+        EXPECT_EQ(count, summary.count);
+        EXPECT_EQ(min, summary.min);
+        EXPECT_EQ(max, summary.max);
+        EXPECT_NEAR(sum.x, summary.sum.x, 1e-9);
+        EXPECT_NEAR(sum.y, summary.sum.y, 1e-9);
+    }
+}
+
+}  // namespace inviwo
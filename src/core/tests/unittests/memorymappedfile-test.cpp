@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(MemoryMappedFile, MapRegion) {
+    util::TempFileHandle tmp("mmap", ".raw");
+    std::vector<unsigned char> bytes(100000);
+    std::iota(bytes.begin(), bytes.end(), static_cast<unsigned char>(0));
+    ASSERT_EQ(bytes.size(), std::fwrite(bytes.data(), 1, bytes.size(), tmp.getHandle()));
+    std::fflush(tmp.getHandle());
+
+    // An offset that is not a multiple of the page size
+    const size_t offset = 12345;
+    const size_t size = 70000;
+    util::MemoryMappedFile file(tmp.getFileName(), offset, size);
+    ASSERT_EQ(size, file.size());
+    EXPECT_EQ(0, std::memcmp(bytes.data() + offset, file.data(), size));
+
+    // Modifications are private
+    static_cast<unsigned char*>(file.data())[0] = 0;
+    util::MemoryMappedFile other(tmp.getFileName(), offset, 1);
+    EXPECT_EQ(bytes[offset], *static_cast<const unsigned char*>(other.data()));
+}
+
+TEST(MemoryMappedFile, Errors) {
+    util::TempFileHandle tmp("mmap", ".raw");
+    const char data[10] = {};
+    std::fwrite(data, 1, sizeof(data), tmp.getHandle());
+    std::fflush(tmp.getHandle());
+
+    EXPECT_THROW(util::MemoryMappedFile(tmp.getFileName(), 5, 10), FileException);
+    EXPECT_THROW(util::MemoryMappedFile(tmp.getFileName() + ".missing", 0, 1), FileException);
+    EXPECT_NO_THROW(util::MemoryMappedFile(tmp.getFileName(), 0, 10));
+}
+
+}  // namespace inviwo
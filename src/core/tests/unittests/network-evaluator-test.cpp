@@ -44,6 +44,9 @@
 #include <inviwo/core/ports/dataoutport.h>
 
 #include <functional>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace inviwo {
 
@@ -80,6 +83,38 @@ const ProcessorInfo TestProcessor::processorInfo_{
     Tags::CPU,                   // Tags
 };
 
+struct ThreadSafeTestProcessor : TestProcessor {
+    using TestProcessor::TestProcessor;
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+};
+
+const ProcessorInfo ThreadSafeTestProcessor::processorInfo_{
+    "org.inviwo.ThreadSafeTestProcessor",  // Class identifier
+    "ThreadSafeTestProcessor",             // Display name
+    "Testing",                             // Category
+    CodeState::Stable,                     // Code state
+    Tags::CPU,                             // Tags
+    true,                                  // Visible
+    true,                                  // Thread safe
+};
+
+struct ThreadSafeGLTestProcessor : TestProcessor {
+    using TestProcessor::TestProcessor;
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+};
+
+const ProcessorInfo ThreadSafeGLTestProcessor::processorInfo_{
+    "org.inviwo.ThreadSafeGLTestProcessor",  // Class identifier
+    "ThreadSafeGLTestProcessor",             // Display name
+    "Testing",                               // Category
+    CodeState::Stable,                       // Code state
+    Tags::GL,                                // Tags
+    true,                                    // Visible
+    true,                                    // Thread safe
+};
+
 struct Instrument {
     Instrument(TestProcessor& p) {
         name = p.getIdentifier();
@@ -257,4 +292,120 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, ParallelEval) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(ProcessorNetworkEvaluator::EvaluationMode::Parallel);
+
+    std::vector<std::string> aboutToProcess;
+    std::vector<std::string> finished;
+    struct Observer : ProcessorObserver {
+        Observer(std::vector<std::string>& about, std::vector<std::string>& done)
+            : about{about}, done{done} {}
+        virtual void onProcessorAboutToProcess(Processor* p) override {
+            about.push_back(p->getIdentifier());
+        }
+        virtual void onProcessorFinishedProcess(Processor* p) override {
+            done.push_back(p->getIdentifier());
+        }
+        std::vector<std::string>& about;
+        std::vector<std::string>& done;
+    } observer{aboutToProcess, finished};
+
+    auto lock = std::make_unique<NetworkLock>(&network);
+
+    auto at = createA();
+    auto a = at.get();
+    Instrument ai(*a);
+    a->onProcess = [func = a->onProcess](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+    };
+    network.addProcessor(std::move(at));
+
+    // Two independent thread safe processors that both depend on a
+    std::vector<TestProcessor*> middle;
+    std::vector<std::unique_ptr<Instrument>> middleInstruments;
+    for (auto id : {"c1", "c2"}) {
+        auto ct = std::make_unique<ThreadSafeTestProcessor>(id);
+        ct->addPort(std::make_unique<DataInport<int>>("in"));
+        ct->addPort(std::make_unique<DataOutport<int>>("out"));
+        auto c = ct.get();
+        middleInstruments.push_back(std::make_unique<Instrument>(*c));
+        c->onProcess = [func = c->onProcess](TestProcessor& p) {
+            func(p);
+            auto in = static_cast<DataInport<int>*>(p.getInports()[0]);
+            static_cast<DataOutport<int>*>(p.getOutports()[0])
+                ->setData(std::make_shared<int>(*in->getData() + 1));
+        };
+        c->ProcessorObservable::addObserver(&observer);
+        network.addProcessor(std::move(ct));
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+        middle.push_back(c);
+    }
+
+    auto dt = std::make_unique<TestProcessor>("d");
+    dt->addPort(std::make_unique<DataInport<int>>("in1"));
+    dt->addPort(std::make_unique<DataInport<int>>("in2"));
+    auto d = dt.get();
+    Instrument di(*d);
+    int sum = 0;
+    d->onProcess = [func = d->onProcess, &sum](TestProcessor& p) {
+        func(p);
+        sum = *static_cast<DataInport<int>*>(p.getInports()[0])->getData() +
+              *static_cast<DataInport<int>*>(p.getInports()[1])->getData();
+    };
+    network.addProcessor(std::move(dt));
+    network.addConnection(middle[0]->getOutports()[0], d->getInports()[0]);
+    network.addConnection(middle[1]->getOutports()[0], d->getInports()[1]);
+
+    {
+        SCOPED_TRACE("Unlock network");
+        lock.reset();
+        ai.checkAndReset(1, 1, 0);
+        middleInstruments[0]->checkAndReset(1, 1, 0);
+        middleInstruments[1]->checkAndReset(1, 1, 0);
+        di.checkAndReset(1, 1, 0);
+        EXPECT_EQ(4, sum);
+        EXPECT_TRUE(d->isValid());
+    }
+    {
+        SCOPED_TRACE("Notifications in topological order");
+        EXPECT_EQ(size_t{2}, aboutToProcess.size());
+        EXPECT_EQ(aboutToProcess, finished);
+    }
+}
+
+TEST(NetworkEvaluator, ParallelEvalGLOnMainThread) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(ProcessorNetworkEvaluator::EvaluationMode::Parallel);
+
+    auto lock = std::make_unique<NetworkLock>(&network);
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+    };
+    network.addProcessor(std::move(at));
+
+    // Thread safe processors tagged GL must still be processed on the main thread
+    const auto mainThread = std::this_thread::get_id();
+    std::vector<std::thread::id> threads(3);
+    for (size_t i = 0; i < threads.size(); ++i) {
+        auto gt = std::make_unique<ThreadSafeGLTestProcessor>("g" + toString(i));
+        gt->addPort(std::make_unique<DataInport<int>>("in"));
+        auto g = gt.get();
+        g->onProcess = [&threads, i](TestProcessor&) { threads[i] = std::this_thread::get_id(); };
+        network.addProcessor(std::move(gt));
+        network.addConnection(a->getOutports()[0], g->getInports()[0]);
+    }
+
+    lock.reset();
+    for (auto& thread : threads) {
+        EXPECT_EQ(mainThread, thread);
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,185 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/listproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/propertyownerobserver.h>
+#include <inviwo/core/io/serialization/serialization.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+struct CountingObserver : PropertyOwnerObserver {
+    virtual void onDidAddProperty(Property*, size_t index) override {
+        addedIndices.push_back(index);
+    }
+    virtual void onDidRemoveProperty(Property*, size_t index) override {
+        removedIndices.push_back(index);
+    }
+    virtual void onDidAddProperties(const std::vector<Property*>& properties,
+                                    size_t index) override {
+        ++batches;
+        PropertyOwnerObserver::onDidAddProperties(properties, index);
+    }
+    virtual void onDidRemoveProperties(const std::vector<Property*>& properties,
+                                       const std::vector<size_t>& indices) override {
+        ++batches;
+        PropertyOwnerObserver::onDidRemoveProperties(properties, indices);
+    }
+
+    int batches = 0;
+    std::vector<size_t> addedIndices;
+    std::vector<size_t> removedIndices;
+};
+
+std::vector<Property*> makeInts(size_t count, const std::string& prefix = "int") {
+    std::vector<Property*> properties;
+    for (size_t i = 0; i < count; ++i) {
+        properties.push_back(new IntProperty(prefix + std::to_string(i), "Int"));
+    }
+    return properties;
+}
+
+}  // namespace
+
+TEST(PropertyOwner, IdentifierIndex) {
+    CompositeProperty comp("comp", "Comp");
+    auto sub = new CompositeProperty("sub", "Sub");
+    comp.addProperty(sub);
+    auto a = new IntProperty("a", "A");
+    sub->addProperty(a);
+
+    EXPECT_EQ(sub, comp.getPropertyByIdentifier("sub"));
+    EXPECT_EQ(nullptr, comp.getPropertyByIdentifier("a"));
+    EXPECT_EQ(a, comp.getPropertyByIdentifier("a", true));
+    EXPECT_EQ(a, comp.getPropertyByPath({"sub", "a"}));
+
+    a->setIdentifier("b");
+    EXPECT_EQ(nullptr, sub->getPropertyByIdentifier("a"));
+    EXPECT_EQ(a, sub->getPropertyByIdentifier("b"));
+    EXPECT_EQ(a, comp.getPropertyByPath({"sub", "b"}));
+
+    sub->addProperty(new IntProperty("c", "C"));
+    EXPECT_THROW(a->setIdentifier("c"), Exception);
+    EXPECT_EQ("b", a->getIdentifier());
+    IntProperty b("b", "B");
+    EXPECT_THROW(sub->addProperty(b), Exception);
+
+    delete sub->removeProperty("b");
+    EXPECT_EQ(nullptr, sub->getPropertyByIdentifier("b"));
+    EXPECT_EQ(1u, sub->size());
+}
+
+TEST(PropertyOwner, IdentifierIndexDeserializeSwap) {
+    CompositeProperty comp("comp", "Comp");
+    auto x = new IntProperty("x", "X");
+    auto y = new IntProperty("y", "Y");
+    comp.addProperty(x);
+    comp.addProperty(y);
+
+    // Deserializing swapped identifiers makes x and y share the identifier "y" in between
+    std::stringstream ss;
+    Serializer s("");
+    s.serialize("first", IntProperty("y", "Y"));
+    s.serialize("second", IntProperty("x", "X"));
+    s.writeFile(ss);
+    Deserializer d(ss, "");
+    d.deserialize("first", *x);
+    EXPECT_EQ(x, comp.getPropertyByIdentifier("y"));
+    EXPECT_EQ(nullptr, comp.getPropertyByIdentifier("x"));
+    d.deserialize("second", *y);
+
+    EXPECT_EQ("y", x->getIdentifier());
+    EXPECT_EQ("x", y->getIdentifier());
+    EXPECT_EQ(x, comp.getPropertyByIdentifier("y"));
+    EXPECT_EQ(y, comp.getPropertyByIdentifier("x"));
+}
+
+TEST(PropertyOwner, InsertAndRemoveProperties) {
+    CompositeProperty comp("comp", "Comp");
+    comp.addProperty(new IntProperty("first", "First"));
+    comp.addProperty(new IntProperty("last", "Last"));
+
+    CountingObserver observer;
+    comp.addObserver(&observer);
+
+    const auto ints = makeInts(3);
+    comp.insertProperties(1, ints);
+    EXPECT_EQ(1, observer.batches);
+    EXPECT_EQ((std::vector<size_t>{1, 2, 3}), observer.addedIndices);
+    ASSERT_EQ(5u, comp.size());
+    EXPECT_EQ(ints[0], comp[1]);
+    EXPECT_EQ(ints[2], comp[3]);
+    EXPECT_EQ(ints[1], comp.getPropertyByIdentifier("int1"));
+
+    auto duplicates = makeInts(2, "last");
+    duplicates.push_back(new IntProperty("int0", "Int"));
+    EXPECT_THROW(comp.insertProperties(0, duplicates, false), Exception);
+    EXPECT_EQ(5u, comp.size());
+    for (auto p : duplicates) delete p;
+
+    comp.removeProperties({ints[2], comp[0], ints[0]});
+    EXPECT_EQ(2, observer.batches);
+    EXPECT_EQ((std::vector<size_t>{3, 1, 0}), observer.removedIndices);
+    ASSERT_EQ(2u, comp.size());
+    EXPECT_EQ(ints[1], comp[0]);
+    EXPECT_EQ(nullptr, comp.getPropertyByIdentifier("first"));
+    EXPECT_EQ(nullptr, comp.getPropertyByIdentifier("int0"));
+
+    comp.removeObserver(&observer);
+}
+
+TEST(ListProperty, InsertProperties) {
+    ListProperty list("list", "List", std::make_unique<IntProperty>("int", "Int"), 4);
+    list.insertProperties(0, makeInts(2));
+    EXPECT_EQ(2u, list.size());
+
+    // The list holds at most 3 elements, see ListProperty::insertProperty
+    auto more = makeInts(2, "more");
+    list.insertProperties(0, more, false);
+    ASSERT_EQ(3u, list.size());
+    EXPECT_EQ(more[0], list[0]);
+    EXPECT_EQ(nullptr, list.getPropertyByIdentifier("more1"));
+    delete more[1];
+
+    list.clear();
+    EXPECT_EQ(0u, list.size());
+    delete more[0];
+}
+
+}  // namespace inviwo
@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/rammemorypool.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+TEST(RAMMemoryPool, SizeClasses) {
+    EXPECT_EQ(64, util::RAMMemoryPool::sizeClass(0));
+    EXPECT_EQ(128, util::RAMMemoryPool::sizeClass(65));
+    EXPECT_EQ(65536, util::RAMMemoryPool::sizeClass(65536));
+    EXPECT_EQ(65536 + 16384, util::RAMMemoryPool::sizeClass(65537));
+
+    for (size_t bytes = 1000; bytes < (size_t{1} << 34); bytes = bytes * 3 / 2) {
+        const auto size = util::RAMMemoryPool::sizeClass(bytes);
+        EXPECT_GE(size, bytes);
+        EXPECT_LE(size, std::max(size_t{64}, bytes + bytes / 4 + 64));
+    }
+}
+
+TEST(RAMMemoryPool, Reuse) {
+    util::RAMMemoryPool pool(size_t{64} << 20);
+
+    auto a = pool.allocate(1000000);
+    EXPECT_EQ(1, pool.getStats().liveBlocks);
+    pool.deallocate(a, 1000000);
+    auto stats = pool.getStats();
+    EXPECT_EQ(0, stats.liveBytes);
+    EXPECT_EQ(1, stats.pooledBlocks);
+
+    // Same size class
+    auto b = pool.allocate(999000);
+    EXPECT_EQ(a, b);
+    stats = pool.getStats();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(0, stats.pooledBytes);
+    pool.deallocate(b, 999000);
+
+    // Small blocks are never pooled
+    pool.deallocate(pool.allocate(100), 100);
+    EXPECT_EQ(1, pool.getStats().pooledBlocks);
+
+    pool.clear();
+    EXPECT_EQ(0, pool.getStats().pooledBytes);
+}
+
+TEST(RAMMemoryPool, Capacity) {
+    util::RAMMemoryPool pool(size_t{4} << 20);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 8; ++i) blocks.push_back(pool.allocate(size_t{1} << 20));
+    for (auto block : blocks) pool.deallocate(block, size_t{1} << 20);
+    EXPECT_EQ(size_t{4} << 20, pool.getStats().pooledBytes);
+
+    pool.setCapacity(size_t{1} << 20);
+    EXPECT_EQ(size_t{1} << 20, pool.getStats().pooledBytes);
+
+    pool.setCapacity(0);
+    EXPECT_EQ(0, pool.getStats().pooledBytes);
+    pool.deallocate(pool.allocate(size_t{1} << 20), size_t{1} << 20);
+    EXPECT_EQ(0, pool.getStats().pooledBytes);
+}
+
+TEST(RAMMemoryPool, HugePages) {
+    util::RAMMemoryPool pool(0, true);
+    const auto bytes = 3 * util::RAMMemoryPool::hugePageSize;
+    auto ptr = pool.allocate(bytes);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ptr) % util::RAMMemoryPool::hugePageSize);
+    pool.deallocate(ptr, bytes);
+}
+
+TEST(RAMMemoryPool, Threads) {
+    util::RAMMemoryPool pool(size_t{16} << 20);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool]() {
+            for (size_t i = 0; i < 500; ++i) {
+                const auto bytes = (i % 37) * 5000 + 10;
+                auto ptr = static_cast<char*>(pool.allocate(bytes));
+                ptr[bytes - 1] = 1;
+                pool.deallocate(ptr, bytes);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const auto stats = pool.getStats();
+    EXPECT_EQ(0, stats.liveBytes);
+    EXPECT_LE(stats.pooledBytes, size_t{16} << 20);
+}
+
+TEST(RAMMemoryPool, VolumeRAM) {
+    const size3_t dims{64, 64, 64};
+    {
+        VolumeRAMPrecision<float> volume(dims);
+        auto data = volume.getDataTyped();
+        EXPECT_TRUE(
+            std::all_of(data, data + glm::compMul(dims), [](float v) { return v == 0.0f; }));
+        std::fill(data, data + glm::compMul(dims), 1.0f);
+    }
+    // A reused block has to be cleared again
+    VolumeRAMPrecision<float> zeroed(dims);
+    auto data = zeroed.getDataTyped();
+    EXPECT_TRUE(std::all_of(data, data + glm::compMul(dims), [](float v) { return v == 0.0f; }));
+
+    VolumeRAMPrecision<float> uninitialized(dims, util::DataInitialization::Uninitialized);
+    EXPECT_EQ(dims, uninitialized.getDimensions());
+
+    // Representations still take ownership of data allocated with new[]
+    VolumeRAMPrecision<float> adopted(new float[8], size3_t{2, 2, 2});
+    adopted.setData(new float[27], size3_t{3, 3, 3});
+    EXPECT_EQ(size3_t(3, 3, 3), adopted.getDimensions());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,164 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/taskgroup.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ThreadPoolTests, Enqueue) {
+    ThreadPool pool(4);
+    auto res = pool.enqueue([](int a, int b) { return a + b; }, 40, 2);
+    EXPECT_EQ(42, res.get());
+
+    auto err = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(err.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTests, ManyTasks) {
+    ThreadPool pool(4);
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < 10000; ++i) {
+        futures.push_back(pool.enqueue([i]() { return i; }));
+    }
+    size_t sum = 0;
+    for (auto& f : futures) sum += f.get();
+    EXPECT_EQ(10000 * 9999 / 2, sum);
+}
+
+TEST(ThreadPoolTests, ResizeRunsAllTasks) {
+    ThreadPool pool(4);
+    std::atomic<size_t> count{0};
+    for (size_t i = 0; i < 10000; ++i) {
+        pool.enqueueRaw([&count]() { ++count; });
+    }
+    while (pool.trySetSize(0) != 0) std::this_thread::yield();
+    EXPECT_EQ(10000, count);
+
+    // Without workers tasks are run directly
+    pool.enqueueRaw([&count]() { ++count; });
+    EXPECT_EQ(10001, count);
+}
+
+TEST(ThreadPoolTests, LargeCapture) {
+    ThreadPool pool(2);
+    std::array<double, 64> data{};
+    data.back() = 1.0;
+    auto res = pool.enqueue([data]() { return data.back(); });
+    EXPECT_EQ(1.0, res.get());
+}
+
+TEST(ThreadPoolTests, TaskGroup) {
+    ThreadPool pool(4);
+    std::atomic<size_t> count{0};
+    util::TaskGroup group{pool};
+    for (size_t i = 0; i < 1000; ++i) {
+        group.run([&count]() { ++count; });
+    }
+    group.wait();
+    EXPECT_EQ(1000, count);
+
+    group.run([]() { throw std::runtime_error("error"); });
+    EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST(ThreadPoolTests, TaskGroupOnlyHelpsWithOwnTasks) {
+    ThreadPool pool(2);
+    std::mutex mutex;
+    std::atomic<size_t> count{0};
+    for (size_t i = 0; i < 100; ++i) {
+        // A pool job that needs the lock the waiting thread holds. If wait() would run it, this
+        // would deadlock.
+        auto res = pool.enqueue([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++count;
+        });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            util::TaskGroup group{pool};
+            for (size_t j = 0; j < 10; ++j) {
+                group.run([&count]() { ++count; });
+            }
+            group.wait();
+        }
+        res.get();
+    }
+    EXPECT_EQ(1100, count);
+}
+
+TEST(ThreadPoolTests, ParallelFor) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(100000);
+    util::parallelFor(&pool, size_t{0}, hits.size(), [&](size_t i) { ++hits[i]; });
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](auto& h) { return h == 1; }));
+
+    std::atomic<size_t> sum{0};
+    util::parallelFor(
+        &pool, size_t{0}, size_t{1000},
+        [&](size_t begin, size_t end) {
+            size_t local = 0;
+            for (auto i = begin; i < end; ++i) local += i;
+            sum += local;
+        },
+        7);
+    EXPECT_EQ(1000 * 999 / 2, sum);
+}
+
+TEST(ThreadPoolTests, NestedParallelFor) {
+    ThreadPool pool(4);
+    std::atomic<size_t> count{0};
+    util::parallelFor(&pool, 0, 64, [&](int) {
+        util::parallelFor(&pool, 0, 1000, [&](int) { ++count; });
+    });
+    EXPECT_EQ(64000, count);
+}
+
+TEST(ThreadPoolTests, ParallelForException) {
+    ThreadPool pool(4);
+    EXPECT_THROW(util::parallelFor(&pool, 0, 1000,
+                                   [](int i) {
+                                       if (i == 500) throw std::runtime_error("error");
+                                   }),
+                 std::runtime_error);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<trace::Event> testEvents(const std::vector<trace::ThreadTrace>& traces) {
+    std::vector<trace::Event> events;
+    for (auto& trace : traces) {
+        for (auto& event : trace.events) {
+            if (std::strcmp(event.category, "test") == 0) events.push_back(event);
+        }
+    }
+    return events;
+}
+
+}  // namespace
+
+TEST(TracingTest, DisabledRecordsNothing) {
+    trace::setEnabled(false);
+    trace::clear();
+    { IVW_TRACE_SCOPE("test", "Disabled"); }
+    EXPECT_TRUE(testEvents(trace::collect()).empty());
+}
+
+TEST(TracingTest, RecordSpans) {
+    trace::clear();
+    trace::setEnabled(true);
+    util::OnScopeExit disable{[]() { trace::setEnabled(false); }};
+
+    const std::string identifier = "Processor1";
+    {
+        IVW_TRACE_SCOPE("test", "Outer");
+        IVW_TRACE_SCOPE_DETAIL("test", "Inner", identifier);
+    }
+
+    const auto events = testEvents(trace::collect());
+    ASSERT_EQ(2, events.size());
+    // The inner span ends first
+    EXPECT_STREQ("Inner", events[0].name);
+    EXPECT_STREQ("Processor1", events[0].detail);
+    EXPECT_STREQ("Outer", events[1].name);
+    EXPECT_STREQ("", events[1].detail);
+    EXPECT_LE(events[1].start, events[0].start);
+    EXPECT_GE(events[1].start + events[1].duration, events[0].start + events[0].duration);
+}
+
+TEST(TracingTest, LongDetailIsTruncated) {
+    trace::clear();
+    trace::setEnabled(true);
+    util::OnScopeExit disable{[]() { trace::setEnabled(false); }};
+
+    const std::string detail(200, 'x');
+    { IVW_TRACE_SCOPE_DETAIL("test", "Long", detail); }
+
+    const auto events = testEvents(trace::collect());
+    ASSERT_EQ(1, events.size());
+    EXPECT_EQ(detail.substr(0, trace::Event::detailSize - 1), events[0].detail);
+}
+
+TEST(TracingTest, ThreadsAndRingBuffer) {
+    trace::clear();
+    trace::setEnabled(true);
+    util::OnScopeExit disable{[]() { trace::setEnabled(false); }};
+
+    const size_t count = trace::eventsPerThread + 100;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([i, count]() {
+            trace::setThreadName("Test thread " + std::to_string(i));
+            for (size_t j = 0; j < count; ++j) {
+                IVW_TRACE_SCOPE("test", "Work");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto traces = trace::collect();
+    size_t named = 0;
+    for (auto& trace : traces) {
+        if (trace.name.rfind("Test thread ", 0) != 0) continue;
+        ++named;
+        // Only the newest events are kept
+        EXPECT_LE(trace.events.size(), trace::eventsPerThread);
+        EXPECT_GE(trace.events.size(), trace::eventsPerThread - 1);
+        for (size_t i = 1; i < trace.events.size(); ++i) {
+            EXPECT_LE(trace.events[i - 1].start, trace.events[i].start);
+        }
+    }
+    EXPECT_EQ(4, named);
+
+    // The threads have exited, clearing forgets them
+    trace::clear();
+    for (auto& trace : trace::collect()) {
+        EXPECT_NE(0, trace.name.rfind("Test thread ", 0));
+        EXPECT_TRUE(testEvents({trace}).empty());
+    }
+}
+
+TEST(TracingTest, ChromeTrace) {
+    trace::clear();
+    trace::setEnabled(true);
+    util::OnScopeExit disable{[]() { trace::setEnabled(false); }};
+
+    const std::string identifier = "Quote\"Processor";
+    { IVW_TRACE_SCOPE_DETAIL("test", "Process", identifier); }
+
+    std::stringstream ss;
+    trace::writeChromeTrace(ss);
+    const auto json = ss.str();
+    EXPECT_EQ(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"M\""));
+    EXPECT_NE(std::string::npos,
+              json.find("{\"name\":\"Process Quote\\\"Processor\",\"cat\":\"test\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"detail\":\"Quote\\\"Processor\"}"));
+    EXPECT_EQ(json.size() - 4, json.rfind("\n]}\n"));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+std::shared_ptr<Volume> createVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(0, 100);
+    for (size_t i = 0; i < dims.x * dims.y * dims.z; ++i) {
+        data[i] = T(static_cast<typename util::value_type<T>::type>(dist(gen)));
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+// Reference trilinear sampling through the virtual VolumeRAM accessors
+dvec3 reference(const VolumeRAM& ram, const dvec3& pos) {
+    const auto dims = ram.getDimensions();
+    const dvec3 samplePos = pos * dvec3(dims - size3_t(1));
+    const size3_t index{samplePos};
+    const dvec3 t = samplePos - dvec3(index);
+    auto get = [&](size3_t offset) {
+        return ram.getAsDVec3(glm::min(index + offset, dims - size3_t(1)));
+    };
+    const auto x00 = glm::mix(get({0, 0, 0}), get({1, 0, 0}), t.x);
+    const auto x10 = glm::mix(get({0, 1, 0}), get({1, 1, 0}), t.x);
+    const auto x01 = glm::mix(get({0, 0, 1}), get({1, 0, 1}), t.x);
+    const auto x11 = glm::mix(get({0, 1, 1}), get({1, 1, 1}), t.x);
+    return glm::mix(glm::mix(x00, x10, t.y), glm::mix(x01, x11, t.y), t.z);
+}
+
+template <typename T>
+void testSampler(size3_t dims) {
+    const auto volume = createVolume<T>(dims);
+    const auto ram = volume->template getRepresentation<VolumeRAM>();
+    VolumeDoubleSampler<3> sampler(volume);
+
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<dvec3> positions(100);
+    for (auto& p : positions) p = dvec3(dist(gen), dist(gen), dist(gen));
+    positions.push_back(dvec3(0.0));
+    positions.push_back(dvec3(1.0));
+
+    std::vector<dvec3> batch(positions.size());
+    sampler.sample(positions, batch);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = reference(*ram, positions[i]);
+        const auto single = sampler.sample(positions[i]);
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_NEAR(expected[c], single[c], 1e-9);
+            EXPECT_DOUBLE_EQ(single[c], batch[i][c]);
+        }
+    }
+
+    EXPECT_EQ(dvec3(0.0), sampler.sample(dvec3(1.5, 0.5, 0.5)));
+}
+
+}  // namespace
+
+TEST(VolumeSamplerTests, UInt8) { testSampler<unsigned char>(size3_t(7, 5, 3)); }
+
+TEST(VolumeSamplerTests, Vec3) { testSampler<vec3>(size3_t(4, 6, 5)); }
+
+TEST(VolumeSamplerTests, IVec2Flat) { testSampler<ivec2>(size3_t(5, 4, 1)); }
+
+}  // namespace inviwo
@@ -67,7 +67,9 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     , helpQuiet_("h", "help", "")
     , versionQuiet_("v", "version", "")
     , disableResourceManager_("", "no-resource-manager",
-                              "Pass this flag to disable the resource manager") {
+                              "Pass this flag to disable the resource manager")
+    , traceFile_("", "trace", "Record a trace and write it to file on exit (Chrome trace json)",
+                 false, "", "trace file") {
     cmdQuiet_.add(workspace_);
     cmdQuiet_.add(outputPath_);
     cmdQuiet_.add(quitAfterStartup_);
@@ -77,6 +79,7 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmdQuiet_.add(helpQuiet_);
     cmdQuiet_.add(versionQuiet_);
     cmdQuiet_.add(disableResourceManager_);
+    cmdQuiet_.add(traceFile_);
     cmdQuiet_.add(wildcard_);
 
     cmd_.add(workspace_);
@@ -86,6 +89,7 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmd_.add(logfile_);
     cmd_.add(logConsole_);
     cmd_.add(disableResourceManager_);
+    cmd_.add(traceFile_);
 
     parse(Mode::Quiet);
 }
@@ -184,6 +188,10 @@ bool CommandLineParser::getDisableResourceManager() const {
     return disableResourceManager_.isSet();
 }
 
+const std::string CommandLineParser::getTraceFileName() const {
+    return traceFile_.isSet() ? traceFile_.getValue() : "";
+}
+
 int CommandLineParser::getARGC() const { return argc_; }
 
 char** CommandLineParser::getARGV() const { return argv_; }
@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#ifdef WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+#ifdef WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path, size_t offset, size_t size)
+    : base_{nullptr}, mappedSize_{0}, data_{nullptr}, size_{size} {
+
+    const auto file = CreateFileW(toWstring(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw FileException("Could not open file: " + path, IVW_CONTEXT);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) ||
+        static_cast<unsigned long long>(fileSize.QuadPart) < offset + size) {
+        CloseHandle(file);
+        throw FileException("File is smaller than expected: " + path, IVW_CONTEXT);
+    }
+    if (size == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        throw FileException("Could not map file: " + path, IVW_CONTEXT);
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const size_t alignedOffset = offset - offset % info.dwAllocationGranularity;
+    mappedSize_ = size + (offset - alignedOffset);
+    base_ = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(alignedOffset >> 32),
+                          static_cast<DWORD>(alignedOffset & 0xFFFFFFFF), mappedSize_);
+    // The view keeps the mapping alive
+    CloseHandle(mapping);
+    if (!base_) {
+        throw FileException("Could not map file: " + path, IVW_CONTEXT);
+    }
+    data_ = static_cast<char*>(base_) + (offset - alignedOffset);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (base_) UnmapViewOfFile(base_);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path, size_t offset, size_t size)
+    : base_{nullptr}, mappedSize_{0}, data_{nullptr}, size_{size} {
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw FileException("Could not open file: " + path, IVW_CONTEXT);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < offset + size) {
+        ::close(fd);
+        throw FileException("File is smaller than expected: " + path, IVW_CONTEXT);
+    }
+    if (size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    const auto pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = offset - offset % pageSize;
+    mappedSize_ = size + (offset - alignedOffset);
+    void* base = ::mmap(nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                        static_cast<off_t>(alignedOffset));
+    // The mapping keeps the file alive
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw FileException("Could not map file: " + path, IVW_CONTEXT);
+    }
+    base_ = base;
+    data_ = static_cast<char*>(base_) + (offset - alignedOffset);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (base_) ::munmap(base_, mappedSize_);
+}
+
+#endif
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,198 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/rammemorypool.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr size_t cacheLineSize = 64;
+
+size_t roundUp(size_t value, size_t multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+void* alignedAllocate(size_t bytes, bool hugePages) {
+    const auto alignment = hugePages && bytes >= RAMMemoryPool::hugePageSize
+                               ? RAMMemoryPool::hugePageSize
+                               : cacheLineSize;
+#ifdef WIN32
+    return _aligned_malloc(bytes, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, bytes) != 0) return nullptr;
+#if defined(MADV_HUGEPAGE)
+    if (alignment == RAMMemoryPool::hugePageSize) {
+        // Only a hint, failure just means that we get regular pages
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return ptr;
+#endif
+}
+
+void alignedFree(void* ptr) {
+#ifdef WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+RAMMemoryPool& RAMMemoryPool::getInstance() {
+    static RAMMemoryPool* pool = new RAMMemoryPool();
+    return *pool;
+}
+
+RAMMemoryPool::RAMMemoryPool(size_t capacity, bool hugePages)
+    : capacity_{capacity}, hugePages_{hugePages} {}
+
+RAMMemoryPool::~RAMMemoryPool() { clear(); }
+
+size_t RAMMemoryPool::sizeClass(size_t bytes) {
+    if (bytes < minPooledSize) return std::max(cacheLineSize, roundUp(bytes, cacheLineSize));
+
+    // Four size classes per power of two
+    size_t pow2 = minPooledSize;
+    while (pow2 <= bytes / 2) pow2 *= 2;
+    return roundUp(bytes, pow2 / 4);
+}
+
+void* RAMMemoryPool::allocate(size_t bytes) {
+    const auto size = sizeClass(bytes);
+    bool hugePages = false;
+    {
+        std::scoped_lock lock{mutex_};
+        if (auto it = pool_.find(size); it != pool_.end()) {
+            auto ptr = it->second;
+            pool_.erase(it);
+            stats_.pooledBytes -= size;
+            --stats_.pooledBlocks;
+            ++stats_.hits;
+            stats_.liveBytes += size;
+            ++stats_.liveBlocks;
+            stats_.peakBytes = std::max(stats_.peakBytes, stats_.liveBytes);
+            return ptr;
+        }
+        ++stats_.misses;
+        hugePages = hugePages_;
+    }
+
+    auto ptr = alignedAllocate(size, hugePages);
+    if (!ptr) {
+        // The pooled memory might be what is missing
+        clear();
+        ptr = alignedAllocate(size, hugePages);
+        if (!ptr) throw std::bad_alloc();
+    }
+
+    std::scoped_lock lock{mutex_};
+    stats_.liveBytes += size;
+    ++stats_.liveBlocks;
+    stats_.peakBytes = std::max(stats_.peakBytes, stats_.liveBytes);
+    return ptr;
+}
+
+void RAMMemoryPool::deallocate(void* ptr, size_t bytes) noexcept {
+    if (!ptr) return;
+    const auto size = sizeClass(bytes);
+
+    std::scoped_lock lock{mutex_};
+    stats_.liveBytes -= size;
+    --stats_.liveBlocks;
+    if (size >= minPooledSize && size <= capacity_) {
+        pool_.emplace(size, ptr);
+        stats_.pooledBytes += size;
+        ++stats_.pooledBlocks;
+        trim(capacity_);
+    } else {
+        alignedFree(ptr);
+    }
+}
+
+void RAMMemoryPool::setCapacity(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    capacity_ = bytes;
+    trim(capacity_);
+}
+
+size_t RAMMemoryPool::getCapacity() const {
+    std::scoped_lock lock{mutex_};
+    return capacity_;
+}
+
+void RAMMemoryPool::setUseHugePages(bool enable) {
+    std::scoped_lock lock{mutex_};
+    hugePages_ = enable;
+}
+
+bool RAMMemoryPool::getUseHugePages() const {
+    std::scoped_lock lock{mutex_};
+    return hugePages_;
+}
+
+void RAMMemoryPool::clear() {
+    std::scoped_lock lock{mutex_};
+    trim(0);
+}
+
+RAMMemoryPool::Stats RAMMemoryPool::getStats() const {
+    std::scoped_lock lock{mutex_};
+    return stats_;
+}
+
+void RAMMemoryPool::trim(size_t capacity) {
+    // Evict the largest blocks first, they free the most memory per block
+    while (stats_.pooledBytes > capacity) {
+        auto it = std::prev(pool_.end());
+        alignedFree(it->second);
+        stats_.pooledBytes -= it->first;
+        --stats_.pooledBlocks;
+        pool_.erase(it);
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/logstream.h>
+#include <inviwo/core/util/rammemorypool.h>
 
 namespace inviwo {
 
@@ -41,6 +42,10 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , ramPoolSize_("ramPoolSize", "RAM Pool Size (MB)",
+                   util::RAMMemoryPool::defaultCapacity >> 20, 0, 65536)
+    , ramHugePages_("ramHugePages", "Use Huge Pages for Large Data", false)
+    , parallelEvaluation_("parallelEvaluation", "Parallel Network Evaluation", false)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -66,6 +71,9 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(workspaceAuthor_);
     addProperty(applicationUsageMode_);
     addProperty(poolSize_);
+    addProperty(ramPoolSize_);
+    addProperty(ramHugePages_);
+    addProperty(parallelEvaluation_);
     addProperty(enablePortInspectors_);
     addProperty(portInspectorSize_);
     addProperty(enableTouchProperty_);
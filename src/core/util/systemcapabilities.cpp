@@ -33,6 +33,7 @@
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/assertion.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/rammemorypool.h>
 #ifdef IVW_SIGAR
 #include <sigar/include/sigar.h>
 #endif
@@ -265,6 +266,15 @@ void SystemCapabilities::printInfo() {
     } else {
         LogInfoCustom("SystemInfo", "Processor Memory: Info could not be retrieved");
     }
+
+    const auto pool = util::RAMMemoryPool::getInstance().getStats();
+    LogInfoCustom("SystemInfo", "RAM Pool: Live - "
+                                    << util::formatBytesToString(pool.liveBytes) << " in "
+                                    << pool.liveBlocks << " blocks, Pooled - "
+                                    << util::formatBytesToString(pool.pooledBytes) << " in "
+                                    << pool.pooledBlocks << " blocks, Peak - "
+                                    << util::formatBytesToString(pool.peakBytes) << ", Reused - "
+                                    << pool.hits << " of " << pool.hits + pool.misses);
 }
 
 int SystemCapabilities::numberOfCores() const {
@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/taskgroup.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+namespace inviwo {
+
+namespace util {
+
+TaskGroup::TaskGroup()
+    : pool_{detail::defaultThreadPool()}, state_{std::make_shared<State>()} {}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : pool_{&pool}, state_{std::make_shared<State>()} {}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+bool TaskGroup::State::runOne() noexcept {
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (queue.empty()) return false;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        if (!cancelled) {
+            try {
+                task();
+            } catch (...) {
+                setException(std::current_exception());
+            }
+        }
+    }
+    // Completion is decided under the mutex, wait() can not observe a zero count until the last
+    // task is done with the group.
+    std::unique_lock<std::mutex> lock(mutex);
+    if (--remaining == 0) condition.notify_all();
+    return true;
+}
+
+void TaskGroup::State::setException(std::exception_ptr e) noexcept {
+    cancelled = true;
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!exception) exception = e;
+}
+
+void TaskGroup::wait(bool help) {
+    auto& state = *state_;
+    if (pool_) {
+        // Help out with our own pending tasks instead of blocking.
+        while (help && state.runOne()) {
+        }
+        // Wait for tasks running on other threads.
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.condition.wait(lock, [&state]() { return state.remaining == 0; });
+    }
+
+    std::exception_ptr e;
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        std::swap(e, state.exception);
+    }
+    state.cancelled = false;
+    if (e) std::rethrow_exception(e);
+}
+
+ThreadPool* detail::defaultThreadPool() {
+    if (InviwoApplication::isInitialized()) {
+        return &InviwoApplication::getPtr()->getThreadPool();
+    }
+    return nullptr;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -29,93 +29,242 @@
 
 #include <inviwo/core/util/threadpool.h>
 #include <inviwo/core/util/raiiutils.h>
-#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <iterator>
 
 namespace inviwo {
 
+namespace {
+
+// Keeps track of which pool and worker the current thread belongs to, if any.
+struct WorkerContext {
+    const ThreadPool* pool = nullptr;
+    void* worker = nullptr;
+    size_t victim = 0;
+};
+thread_local WorkerContext workerContext;
+
+}  // namespace
+
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
-    : onThreadStart_{std::move(onThreadStart)}, onThreadStop_{std::move(onThreadStop)} {
+    : pending{0}
+    , next{0}
+    , sleepers{0}
+    , onThreadStart_{std::move(onThreadStart)}
+    , onThreadStop_{std::move(onThreadStop)} {
+    std::unique_lock<std::shared_mutex> lock(workers_mutex);
     while (workers.size() < threads) {
         workers.push_back(std::make_unique<Worker>(*this));
     }
 }
 
 size_t ThreadPool::trySetSize(size_t size) {
-    while (workers.size() < size) {
-        workers.push_back(std::make_unique<Worker>(*this));
-    }
+    std::vector<std::unique_ptr<Worker>> done;
+    std::vector<Task> leftovers;
+    size_t result = 0;
+    {
+        std::unique_lock<std::shared_mutex> lock(workers_mutex);
+        while (workers.size() < size) {
+            workers.push_back(std::make_unique<Worker>(*this));
+        }
 
-    if (workers.size() > size) {
-        auto active = workers.size();
-        for (auto& worker : workers) {
-            auto exprected = State::Free;
-            if (worker->state.compare_exchange_strong(exprected, State::Stop)) {
-                --active;
-            } else if (exprected == State::Stop || exprected == State::Done) {
-                --active;
+        if (workers.size() > size) {
+            auto active = workers.size();
+            for (auto& worker : workers) {
+                auto exprected = State::Free;
+                if (worker->state.compare_exchange_strong(exprected, State::Stop)) {
+                    --active;
+                } else if (exprected == State::Stop || exprected == State::Done) {
+                    --active;
+                }
+                if (active <= size) break;
             }
-            if (active <= size) break;
-        }
 
-        condition.notify_all();
+            notify(true);
 
-        util::erase_remove_if(
-            workers, [](std::unique_ptr<Worker>& worker) { return worker->state == State::Done; });
+            auto it = std::stable_partition(
+                workers.begin(), workers.end(),
+                [](std::unique_ptr<Worker>& worker) { return worker->state != State::Done; });
+            std::move(it, workers.end(), std::back_inserter(done));
+            workers.erase(it, workers.end());
+
+            // A task might have been pushed to a worker just as it stopped, hand those over to
+            // the remaining workers.
+            for (auto& worker : done) {
+                std::unique_lock<std::mutex> queueLock(worker->queue.mutex);
+                for (auto& task : worker->queue.tasks) {
+                    if (workers.empty()) {
+                        --pending;
+                        leftovers.push_back(std::move(task));
+                    } else {
+                        auto& target = workers[next++ % workers.size()];
+                        std::unique_lock<std::mutex> targetLock(target->queue.mutex);
+                        target->queue.tasks.push_back(std::move(task));
+                    }
+                }
+                worker->queue.tasks.clear();
+            }
+        }
+        result = workers.size();
     }
+    notify(true);
+
+    for (auto& task : leftovers) runTask(task);
+    done.clear();  // this will join the stopped threads.
+
+    return result;
+}
+
+size_t ThreadPool::getSize() const {
+    std::shared_lock<std::shared_mutex> lock(workers_mutex);
     return workers.size();
 }
 
-size_t ThreadPool::getSize() const { return workers.size(); }
+size_t ThreadPool::getQueueSize() { return pending; }
 
-size_t ThreadPool::getQueueSize() {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
-}
+bool ThreadPool::isWorkerThread() const { return workerContext.pool == this; }
 
 ThreadPool::~ThreadPool() {
-    for (auto& worker : workers) worker->state = State::Abort;
-    condition.notify_all();
-    workers.clear();  // this will join all threads.
+    std::vector<std::unique_ptr<Worker>> toJoin;
+    {
+        std::unique_lock<std::shared_mutex> lock(workers_mutex);
+        for (auto& worker : workers) worker->state = State::Abort;
+        toJoin.swap(workers);
+    }
+    notify(true);
+    toJoin.clear();  // this will join all threads.
 }
 
 ThreadPool::Worker::~Worker() { thread.join(); }
 
 ThreadPool::Worker::Worker(ThreadPool& pool)
     : state{State::Free}, thread{[this, &pool]() {
+        workerContext.pool = &pool;
+        workerContext.worker = this;
+        trace::setThreadName("Pool worker");
         pool.onThreadStart_();
-        util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
+        util::OnScopeExit cleanup{[&pool]() {
+            pool.onThreadStop_();
+            workerContext = WorkerContext{};
+        }};
 
+        Task task;
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
-            {
-                std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
-                });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
-            }
-            state = State::Working;
-            try {
-                task();
-            } catch (...) {  // Make sure we don't leak any exceptions.
+            if (state == State::Abort) break;
+            if (pool.pop(this, task)) {
+                auto expected = State::Free;
+                state.compare_exchange_strong(expected, State::Working);
+                pool.runTask(task);
+                expected = State::Working;
+                state.compare_exchange_strong(expected, State::Free);
+                continue;
             }
+            if (state == State::Stop) break;
+
+            std::unique_lock<std::mutex> lock(pool.sleep_mutex);
+            ++pool.sleepers;
+            pool.condition.wait(lock, [this, &pool] {
+                return state == State::Abort || state == State::Stop || pool.pending > 0;
+            });
+            --pool.sleepers;
         }
         state = State::Done;
     }} {}
 
-void ThreadPool::enqueueRaw(std::function<void()> task) {
-    if (workers.empty()) {
-        task();  // No worker threads, just run the task.
+bool ThreadPool::push(Task& task) {
+    {
+        std::shared_lock<std::shared_mutex> lock(workers_mutex);
+        if (workers.empty()) return false;
+
+        Worker* target = nullptr;
+        if (isWorkerThread()) {
+            // Keep tasks spawned from a worker local to that worker, other workers will steal
+            // them if they run out of work.
+            target = static_cast<Worker*>(workerContext.worker);
+        } else {
+            const auto size = workers.size();
+            const auto start = next++;
+            for (size_t i = 0; i < size; ++i) {
+                auto& worker = workers[(start + i) % size];
+                const auto state = worker->state.load();
+                if (state == State::Free || state == State::Working) {
+                    target = worker.get();
+                    break;
+                }
+            }
+            if (!target) target = workers[start % size].get();
+        }
+
+        std::unique_lock<std::mutex> queueLock(target->queue.mutex);
+        target->queue.tasks.push_back(std::move(task));
+        ++pending;
+    }
+    notify(false);
+    return true;
+}
+
+bool ThreadPool::pop(Worker* self, Task& task) {
+    // Look in our own queue first, newest task first. That is usually the task we just pushed,
+    // the smallest part of a nested split, whose data is still in our cache.
+    if (self) {
+        std::unique_lock<std::mutex> queueLock(self->queue.mutex);
+        if (!self->queue.tasks.empty()) {
+            task = std::move(self->queue.tasks.back());
+            self->queue.tasks.pop_back();
+            --pending;
+            return true;
+        }
+    }
+    if (pending == 0) return false;
+
+    // Try to steal the oldest task from one of the other workers, the largest part of a nested
+    // split, so that the thief stays busy for a while and does not touch the victim's hot data.
+    std::shared_lock<std::shared_mutex> lock(workers_mutex);
+    const auto size = workers.size();
+    const auto start = workerContext.victim++;
+    for (size_t i = 0; i < size; ++i) {
+        auto& victim = workers[(start + i) % size];
+        if (victim.get() == self) continue;
+        std::unique_lock<std::mutex> queueLock(victim->queue.mutex);
+        if (!victim->queue.tasks.empty()) {
+            task = std::move(victim->queue.tasks.front());
+            victim->queue.tasks.pop_front();
+            --pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::notify(bool all) {
+    // Only touch the sleep mutex if there is someone to wake up, the lock makes sure a worker
+    // can't miss the notification between checking for work and going to sleep.
+    if (sleepers == 0) return;
+    { std::unique_lock<std::mutex> lock(sleep_mutex); }
+    if (all) {
+        condition.notify_all();
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        condition.notify_one();
+    }
+}
+
+void ThreadPool::runTask(Task& task) {
+    try {
+        IVW_TRACE_SCOPE("threadpool", "Task");
+        task();
+    } catch (...) {  // Make sure we don't leak any exceptions.
+    }
+    task.reset();
+}
+
+void ThreadPool::enqueueRaw(Task task) {
+    if (!push(task)) {
+        runTask(task);  // No worker threads, just run the task.
     }
-    condition.notify_one();
 }
 
 }  // namespace inviwo
@@ -0,0 +1,263 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace inviwo {
+
+namespace trace {
+
+namespace {
+
+const auto epoch = std::chrono::steady_clock::now();
+
+// Events are only written by the owning thread. The head is published with release semantics
+// after an event is written, readers copy the events before the head and then check that the
+// copied slots were not overwritten in the meantime.
+struct ThreadBuffer {
+    ThreadBuffer(size_t id, std::string name)
+        : id{id}, name{std::move(name)}, events{std::make_unique<Event[]>(eventsPerThread)} {}
+
+    const size_t id;
+    std::string name;  // guarded by Registry::mutex
+    std::unique_ptr<Event[]> events;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> cleared{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t nextId = 1;
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+struct ThreadState {
+    std::string name;
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+thread_local ThreadState threadState;
+
+ThreadBuffer& threadBuffer() {
+    if (!threadState.buffer) {
+        auto& reg = registry();
+        std::scoped_lock lock{reg.mutex};
+        auto name = threadState.name.empty() ? "Thread " + std::to_string(reg.nextId)
+                                             : threadState.name;
+        threadState.buffer = std::make_shared<ThreadBuffer>(reg.nextId++, std::move(name));
+        reg.buffers.push_back(threadState.buffer);
+    }
+    return *threadState.buffer;
+}
+
+void writeJsonString(std::ostream& os, std::string_view str) {
+    static constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for (auto c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+// Chrome traces use microseconds, keep the nanoseconds as decimals
+void writeMicroseconds(std::ostream& os, std::int64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                  static_cast<long long>(ns % 1000));
+    os << buffer;
+}
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                epoch)
+        .count();
+}
+
+void record(const char* category, const char* name, std::int64_t start,
+            std::string_view detail) {
+    const auto end = now();
+    auto& buffer = threadBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& event = buffer.events[head % eventsPerThread];
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    const auto size = std::min(detail.size(), Event::detailSize - 1);
+    std::memcpy(event.detail, detail.data(), size);
+    event.detail[size] = '\0';
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+}  // namespace detail
+
+void setEnabled(bool enabled) { detail::enabled.store(enabled); }
+
+void setThreadName(std::string_view name) {
+    threadState.name = name;
+    if (threadState.buffer) {
+        std::scoped_lock lock{registry().mutex};
+        threadState.buffer->name = name;
+    }
+}
+
+void clear() {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+    for (auto& buffer : reg.buffers) {
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire));
+    }
+    // Buffers only referenced by the registry belong to threads that have exited
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                                     [](auto& buffer) { return buffer.use_count() == 1; }),
+                      reg.buffers.end());
+}
+
+std::vector<ThreadTrace> collect() {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+
+    std::vector<ThreadTrace> traces;
+    traces.reserve(reg.buffers.size());
+    for (auto& buffer : reg.buffers) {
+        ThreadTrace trace{buffer->id, buffer->name, {}};
+
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        const auto oldest = head > eventsPerThread ? head - eventsPerThread : size_t{0};
+        const auto first = std::max(buffer->cleared.load(), oldest);
+        trace.events.reserve(head - first);
+        for (auto i = first; i < head; ++i) {
+            trace.events.push_back(buffer->events[i % eventsPerThread]);
+        }
+
+        // The writer might have overwritten the oldest slots while we were copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto newHead = buffer->head.load(std::memory_order_relaxed);
+        if (newHead >= first + eventsPerThread) {
+            const auto overwritten = std::min(newHead - eventsPerThread + 1 - first, head - first);
+            trace.events.erase(trace.events.begin(),
+                               trace.events.begin() + static_cast<std::ptrdiff_t>(overwritten));
+        }
+        traces.push_back(std::move(trace));
+    }
+    return traces;
+}
+
+void writeChromeTrace(std::ostream& os) {
+    const auto traces = collect();
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&]() {
+        if (!first) os << ",";
+        os << "\n";
+        first = false;
+    };
+    for (auto& trace : traces) {
+        separator();
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace.id
+           << ",\"args\":{\"name\":";
+        writeJsonString(os, trace.name);
+        os << "}}";
+
+        for (auto& event : trace.events) {
+            separator();
+            os << "{\"name\":";
+            if (event.detail[0] == '\0') {
+                writeJsonString(os, event.name);
+            } else {
+                writeJsonString(os, std::string{event.name} + " " + event.detail);
+            }
+            os << ",\"cat\":";
+            writeJsonString(os, event.category);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace.id << ",\"ts\":";
+            writeMicroseconds(os, event.start);
+            os << ",\"dur\":";
+            writeMicroseconds(os, event.duration);
+            if (event.detail[0] != '\0') {
+                os << ",\"args\":{\"detail\":";
+                writeJsonString(os, event.detail);
+                os << "}";
+            }
+            os << "}";
+        }
+    }
+    os << "\n]}\n";
+}
+
+void saveChromeTrace(const std::string& path) {
+    auto os = filesystem::ofstream(path);
+    if (!os) {
+        throw FileException("Could not open file \"" + path + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("trace::saveChromeTrace"));
+    }
+    writeChromeTrace(os);
+}
+
+}  // namespace trace
+
+}  // namespace inviwo
@@ -54,6 +54,15 @@ void saveNetwork(ProcessorNetwork* network, std::string filename) {
 
 void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const std::string& name,
                      const std::string& ext, bool onlyActiveCanvases) {
+    for (auto& [cp, path] : getCanvasSavePaths(network, dir, name, ext, onlyActiveCanvases)) {
+        LogInfoCustom("util::saveAllCanvases", "Saving canvas to: " + path);
+        cp->saveImageLayer(path);
+    }
+}
+
+std::vector<std::pair<CanvasProcessor*, std::string>> getCanvasSavePaths(
+    ProcessorNetwork* network, const std::string& dir, const std::string& name,
+    const std::string& ext, bool onlyActiveCanvases) {
 
     // Get all canvases, possibly only the active ones. We need their count below.
     std::vector<CanvasProcessor*> allCanvases =
@@ -68,7 +77,7 @@ void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const st
         allConsideredCanvases = allCanvases;
     }
 
-    // Save them
+    std::vector<std::pair<CanvasProcessor*, std::string>> result;
     int i = 0;
     for (auto cp : allConsideredCanvases) {
         if (!cp->isValid() || !cp->isReady()) {
@@ -91,12 +100,11 @@ void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const st
                 ss << name << ((allConsideredCanvases.size() > 1) ? std::to_string(i + 1) : "");
             }
             ss << ((ext.size() && ext[0] != '.') ? "." : "") << ext;
-
-            LogInfoCustom("util::saveAllCanvases", "Saving canvas to: " + ss.str());
-            cp->saveImageLayer(ss.str());
+            result.emplace_back(cp, ss.str());
         }
         i++;
     }
+    return result;
 }
 
 bool isValidIdentifierCharacter(char c, const std::string& extra) {
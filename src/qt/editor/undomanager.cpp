@@ -58,7 +58,8 @@ public:
         : path_{filesystem::getPath(PathType::Settings)}
         , restored_{[this]() -> std::optional<std::string> {
             if (filesystem::fileExists(path_ + "/autosave.inv")) {
-                auto ifstream = filesystem::ifstream(path_ + "/autosave.inv");
+                auto ifstream =
+                    filesystem::ifstream(path_ + "/autosave.inv", std::ios::in | std::ios::binary);
                 std::stringstream buffer;
                 buffer << ifstream.rdbuf();
                 return std::move(buffer).str();
@@ -86,7 +87,8 @@ public:
                 }
 
                 if (str) {
-                    auto ofstream = filesystem::ofstream(path_ + "/autosave.inv.tmp");
+                    auto ofstream = filesystem::ofstream(path_ + "/autosave.inv.tmp",
+                                                         std::ios::out | std::ios::binary);
                     ofstream << *str;
                     filesystem::copyFile(path_ + "/autosave.inv.tmp", path_ + "/autosave.inv");
                 }
@@ -163,8 +165,9 @@ void UndoManager::pushState() {
 
     std::stringstream stream;
     try {
+        // The undo states are only read back by us, use the faster binary format
         manager_->save(stream, refPath_, [](ExceptionContext context) -> void { throw; },
-                       WorkspaceSaveMode::Undo);
+                       WorkspaceSaveMode::Undo, SerializationFormat::Binary);
     } catch (...) {
         return;
     }